@@ -96,6 +96,31 @@ void __vortex_sigpipe_do_nothing (int _signal)
 }
 #endif
 
+/** 
+ * @internal Recomputes the set of levels that currently pass the log
+ * configuration (enabled status and filter). vortex_log checks this
+ * mask before evaluating its arguments, so it must be updated each
+ * time the log configuration changes.
+ *
+ * @param ctx The context to update.
+ */
+void __vortex_log_update_mask (VortexCtx * ctx)
+{
+#ifdef ENABLE_VORTEX_LOG
+	int mask = 0;
+
+	if (vortex_log_is_enabled (ctx)) {
+		/* all levels, less those filtered */
+		mask = VORTEX_LEVEL_DEBUG | VORTEX_LEVEL_WARNING | VORTEX_LEVEL_CRITICAL;
+		if (vortex_log_filter_is_enabled (ctx))
+			mask &= ~ ctx->debug_filter;
+	} /* end if */
+
+	ctx->log_mask = mask;
+#endif
+	return;
+}
+
 /** 
  * @brief Allows to get current status for log debug info to console.
  * 
@@ -157,6 +182,40 @@ axl_bool      vortex_log2_is_enabled (VortexCtx * ctx)
 #endif
 }
 
+/** 
+ * @brief Allows to check if a log message with the provided level
+ * would be reported, taking into account log activation (\ref
+ * vortex_log_enable) and level filtering (\ref
+ * vortex_log_filter_level).
+ *
+ * This is the check done by vortex_log before evaluating the message
+ * arguments. You can use it to skip building expensive log content.
+ *
+ * @param ctx The context where the check will be implemented.
+ *
+ * @param level The log level to check.
+ * 
+ * @return axl_true if messages at the provided level are reported,
+ * otherwise axl_false.
+ */
+axl_bool      vortex_log_level_is_enabled (VortexCtx        * ctx,
+					   VortexDebugLevel   level)
+{
+#ifdef ENABLE_VORTEX_LOG
+	/* no context, no log */
+	if (ctx == NULL)
+		return axl_false;
+
+	/* resolve log configuration if not done yet */
+	if (ctx->log_mask == VORTEX_LOG_MASK_UNCHECKED)
+		__vortex_log_update_mask (ctx);
+
+	return (ctx->log_mask & level) == level;
+#else
+	return axl_false;
+#endif
+}
+
 /** 
  * @brief Enable console vortex log.
  *
@@ -176,6 +235,9 @@ void     vortex_log_enable       (VortexCtx * ctx, axl_bool      status)
 
 	ctx->debug         = status;
 	ctx->debug_checked = axl_true;
+
+	/* update levels checked by vortex_log */
+	__vortex_log_update_mask (ctx);
 	return;
 #else
 	/* just return */
@@ -304,6 +366,7 @@ void     vortex_log_filter_level (VortexCtx * ctx, const char * filter_string)
 	/* enable all levels */
 	if (filter_string == NULL) {
 		ctx->debug_filter_is_enabled = axl_false;
+		__vortex_log_update_mask (ctx);
 		return;
 	} /* end if */
 
@@ -317,6 +380,9 @@ void     vortex_log_filter_level (VortexCtx * ctx, const char * filter_string)
 
 	/* set as enabled */
 	ctx->debug_filter_is_enabled = axl_true;
+
+	/* update levels checked by vortex_log */
+	__vortex_log_update_mask (ctx);
 	return;
 }
 
@@ -740,6 +806,10 @@ void _vortex_log_common (VortexCtx        * ctx,
 	struct timeval stamp;
 	char   buffer[1024];
 
+	/* resolve levels checked by vortex_log on first use */
+	if (ctx != NULL && ctx->log_mask == VORTEX_LOG_MASK_UNCHECKED)
+		__vortex_log_update_mask (ctx);
+
 	/* if not VORTEX_DEBUG FLAG, do not output anything */
 	if (! vortex_log_is_enabled (ctx)) {
 		return;
@@ -756,6 +826,10 @@ void _vortex_log_common (VortexCtx        * ctx,
 			return;
 	} /* end if */
 
+	/* deliver through the async log writer if enabled */
+	if (ctx->log_async != NULL && __vortex_log_async_push (ctx, file, line, log_level, message, args))
+		return;
+
 	/* acquire the mutex so multiple threads will not mix their
 	 * log messages together */
 	use_log_mutex = ctx->use_log_mutex;
@@ -265,6 +265,10 @@ BEGIN_C_DECLS
 #include <vortex_channel_pool.h>
 #include <vortex_errno.h>
 #include <vortex_payload_feeder.h>
+#include <vortex_payload_sink.h>
+#include <vortex_log_async.h>
+#include <vortex_metrics.h>
+#include <vortex_trace.h>
 
 END_C_DECLS
 
@@ -301,10 +305,23 @@ END_C_DECLS
  *
  * If enabled, the log reporting is activated as usual. If log is
  * stripped from vortex building all instructions are removed.
+ *
+ * The level is checked against the context log mask before message
+ * arguments are evaluated, so a disabled level only costs a test
+ * (modules including vortex_ctx_private.h read the mask inline). If
+ * VORTEX_LOG_DISABLE_DEBUG is defined (--disable-vortex-log-debug),
+ * debug messages are removed at compile time while warning and
+ * critical messages are kept.
  */
 #if defined(ENABLE_VORTEX_LOG)
-# define vortex_log(l, m, ...)   do{_vortex_log  (ctx, __AXL_FILE__, __AXL_LINE__, l, m, ##__VA_ARGS__);}while(0)
-# define vortex_log2(l, m, ...)   do{_vortex_log2  (ctx, __AXL_FILE__, __AXL_LINE__, l, m, ##__VA_ARGS__);}while(0)
+# if defined(VORTEX_LOG_DISABLE_DEBUG)
+#   define VORTEX_LOG_LEVEL_COMPILED(l) ((l) != VORTEX_LEVEL_DEBUG)
+# else
+#   define VORTEX_LOG_LEVEL_COMPILED(l) (axl_true)
+# endif
+# define VORTEX_LOG_LEVEL_ENABLED(c, l) (vortex_log_level_is_enabled (c, l))
+# define vortex_log(l, m, ...)   do{if (VORTEX_LOG_LEVEL_COMPILED (l) && VORTEX_LOG_LEVEL_ENABLED (ctx, l)) _vortex_log  (ctx, __AXL_FILE__, __AXL_LINE__, l, m, ##__VA_ARGS__);}while(0)
+# define vortex_log2(l, m, ...)   do{if (VORTEX_LOG_LEVEL_COMPILED (l) && VORTEX_LOG_LEVEL_ENABLED (ctx, l)) _vortex_log2  (ctx, __AXL_FILE__, __AXL_LINE__, l, m, ##__VA_ARGS__);}while(0)
 #else
 # if defined(AXL_OS_WIN32) && !( defined(__GNUC__) || _MSC_VER >= 1400)
 /* default case where '...' is not supported but log is still
@@ -388,6 +405,9 @@ axl_bool vortex_log_is_enabled       (VortexCtx * ctx);
 
 axl_bool vortex_log2_is_enabled      (VortexCtx * ctx);
 
+axl_bool vortex_log_level_is_enabled (VortexCtx        * ctx,
+				      VortexDebugLevel   level);
+
 void     vortex_log_enable           (VortexCtx * ctx, 
 				      axl_bool    status);
 
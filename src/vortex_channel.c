@@ -49,6 +49,7 @@
 /* local include */
 #include <vortex_ctx_private.h>
 #include <vortex_payload_feeder_private.h>
+#include <vortex_payload_sink_private.h>
 #include <vortex_connection_private.h>
 
 /** 
@@ -100,6 +101,14 @@ struct _VortexChannel {
 	unsigned int            consumed_seqno;
 	unsigned int            seq_no_window;
 
+	/** 
+	 * @internal Mutex used to update the incoming window and send
+	 * the SEQ frame as a whole: the reader and the payload sink
+	 * worker report consumed content, and SEQ frames must reach
+	 * the remote peer in order.
+	 */
+	VortexMutex             seq_mutex;
+
 	/** 
 	 * @internal attribute that tracks the remote last seqno value
 	 * accepted due to a seq frame received. This value together
@@ -356,6 +365,40 @@ struct _VortexChannel {
 	axlHash              * serialize_hash;
 	unsigned int           serialize_next_seqno;
 
+	/** 
+	 * @internal Payload sink installed to receive the next
+	 * incoming message (or the message being received) and flag
+	 * to track that a message is being delivered as usual, so
+	 * the sink is only used for the next one.
+	 */
+	VortexMutex            payload_sink_mutex;
+	VortexPayloadSink    * payload_sink;
+	axl_bool               payload_sink_skip;
+
+	/** 
+	 * @internal Frames pending to be written into payload sinks
+	 * by the sink worker (a thread pool task, running while
+	 * payload_sink_running is axl_true), so the reader never
+	 * blocks on sink writes. Protected by payload_sink_mutex.
+	 */
+	VortexQueue          * payload_sink_pending;
+	axl_bool               payload_sink_running;
+
+	/** 
+	 * @internal Reference to the profile running on this channel
+	 * (owned) and the profile registry epoch it was resolved
+	 * on. See __vortex_profiles_get_cached.
+	 */
+	axlPointer             profile_cache;
+	int                    profile_cache_epoch;
+
+	/** 
+	 * @internal Metrics series where values measured on this
+	 * channel are accounted (by profile). Resolved once, see
+	 * vortex_channel_get_metrics_series.
+	 */
+	VortexMetricsSeries  * metrics_series;
+
 	/* the pool
 	 *
 	 * If the channel was created inside a pool this variable will
@@ -397,8 +440,44 @@ struct _VortexChannel {
 	 * it can be used on this channel.
 	 */
 	int                     last_fixed_more_msg_no;
+
+	/** 
+	 * @internal When MSG were sent (VortexChannelSentStamp),
+	 * protected by outstanding_msg_mutex, and when the channel
+	 * got stalled, protected by ref_mutex. Only configured while
+	 * metrics are enabled (see vortex_metrics_enable).
+	 */
+	axlList               * outstanding_stamps;
+	struct timeval          stall_stamp;
 };
 
+typedef struct _VortexChannelSentStamp {
+	int                     msg_no;
+	struct timeval          stamp;
+} VortexChannelSentStamp;
+
+/** 
+ * @internal Records when the MSG provided was sent so its round trip
+ * is accounted once replied (see
+ * vortex_channel_remove_first_outstanding_msg_no). Must be called
+ * with outstanding_msg_mutex acquired.
+ */
+void __vortex_channel_push_sent_stamp (VortexChannel * channel, int msg_no)
+{
+	VortexChannelSentStamp * sent;
+
+	if (! vortex_metrics_is_enabled (channel->ctx))
+		return;
+
+	sent = axl_new (VortexChannelSentStamp, 1);
+	if (sent == NULL)
+		return;
+	sent->msg_no = msg_no;
+	gettimeofday (&sent->stamp, NULL);
+	axl_list_append (channel->outstanding_stamps, sent);
+	return;
+}
+
 typedef struct _VortexChannelData {
 	VortexConnection        * connection;
 	int                       channel_num;
@@ -425,8 +504,239 @@ struct _WaitReplyData {
 	VortexMutex         mutex;
 	int                 refcount;
 	VortexChannel     * channel;
+	/* reply future this wait reply is embedded into (no queue
+	 * is used in that case) */
+	VortexReply       * reply;
+};
+
+/** 
+ * @internal Max number of released reply futures kept by the context
+ * to be reused.
+ */
+#define VORTEX_REPLY_POOL_MAX 256
+
+/** 
+ * @internal Thread waiting for one or several reply futures (see
+ * vortex_reply_wait_any). It is registered on each reply waited and
+ * only signaled by them.
+ */
+typedef struct _VortexReplyWaiter {
+	VortexMutex          mutex;
+	VortexCond           cond;
+	axl_bool             signaled;
+} VortexReplyWaiter;
+
+/** 
+ * @internal Reply future definition. All fields but wait are
+ * protected by its mutex.
+ */
+struct _VortexReply {
+	VortexCtx          * ctx;
+	VortexMutex          mutex;
+	/* embedded wait reply used to get the frame from the channel */
+	WaitReplyData        wait;
+	int                  refcount;
+	int                  msg_no;
+	axl_bool             done;
+	VortexFrame        * frame;
+	/* thread waiting for this reply (if any) */
+	VortexReplyWaiter  * waiter;
+	VortexReplyHandler   handler;
+	axlPointer           handler_data;
+	/* next reply in the context pool */
+	VortexReply        * next;
 };
 
+/** 
+ * @internal Gets a reply future from the context pool (or creates a
+ * new one). The reply is returned with two references: one for the
+ * caller and one for the embedded wait reply.
+ */
+VortexReply * __vortex_reply_new (VortexCtx * ctx)
+{
+	VortexReply * reply;
+
+	vortex_mutex_lock (&ctx->reply_mutex);
+	reply = ctx->reply_pool;
+	if (reply != NULL) {
+		ctx->reply_pool = reply->next;
+		ctx->reply_pool_size--;
+	} /* end if */
+	vortex_mutex_unlock (&ctx->reply_mutex);
+
+	if (reply == NULL) {
+		reply = axl_new (VortexReply, 1);
+		if (reply == NULL)
+			return NULL;
+		vortex_mutex_create (&reply->mutex);
+		vortex_mutex_create (&reply->wait.mutex);
+	} /* end if */
+
+	reply->ctx               = ctx;
+	reply->next              = NULL;
+	reply->refcount          = 2;
+	reply->msg_no            = -1;
+	reply->done              = axl_false;
+
+	reply->wait.msg_no_reply = -1;
+	reply->wait.queue        = NULL;
+	reply->wait.refcount     = 1;
+	reply->wait.channel      = NULL;
+	reply->wait.reply        = reply;
+
+	return reply;
+}
+
+/** 
+ * @internal Releases a reference to the reply future, returning it to
+ * the context pool once the last one is gone.
+ */
+void __vortex_reply_unref (VortexReply * reply)
+{
+	VortexCtx        * ctx = reply->ctx;
+	VortexFrame      * frame;
+
+	vortex_mutex_lock (&reply->mutex);
+	reply->refcount--;
+	if (reply->refcount != 0) {
+		vortex_mutex_unlock (&reply->mutex);
+		return;
+	} /* end if */
+
+	frame               = reply->frame;
+	reply->frame        = NULL;
+	reply->waiter       = NULL;
+	reply->handler      = NULL;
+	reply->handler_data = NULL;
+	vortex_mutex_unlock (&reply->mutex);
+
+	/* keep it for later reuse if the pool isn't full */
+	vortex_mutex_lock (&ctx->reply_mutex);
+	if (ctx->reply_pool_size < VORTEX_REPLY_POOL_MAX) {
+		reply->next     = ctx->reply_pool;
+		ctx->reply_pool = reply;
+		ctx->reply_pool_size++;
+		reply           = NULL;
+	} /* end if */
+	vortex_mutex_unlock (&ctx->reply_mutex);
+
+	vortex_frame_unref (frame);
+	if (reply != NULL) {
+		vortex_mutex_destroy (&reply->mutex);
+		vortex_mutex_destroy (&reply->wait.mutex);
+		axl_free (reply);
+	} /* end if */
+	return;
+}
+
+/** 
+ * @internal Thread pool task used to run the continuation handler
+ * configured on a reply future.
+ */
+axlPointer __vortex_reply_invoke_handler (VortexReply * reply)
+{
+	reply->handler (reply, reply->frame, reply->handler_data);
+
+	/* release reference acquired by __vortex_reply_signal */
+	__vortex_reply_unref (reply);
+	return NULL;
+}
+
+/** 
+ * @internal Marks the reply future as completed with the frame
+ * provided (NULL to signal the reply will never come), waking up the
+ * waiter and dispatching the continuation. Only the first completion
+ * takes effect, later ones release the frame received.
+ */
+void __vortex_reply_signal (VortexReply * reply, VortexFrame * frame)
+{
+	VortexCtx * ctx      = reply->ctx;
+	axl_bool    dispatch = axl_false;
+
+	vortex_mutex_lock (&reply->mutex);
+	if (reply->done) {
+		vortex_mutex_unlock (&reply->mutex);
+		vortex_frame_unref (frame);
+		return;
+	} /* end if */
+
+	reply->done  = axl_true;
+	reply->frame = frame;
+
+	/* wake up the thread waiting (if any): it can't unregister
+	 * while the reply is locked */
+	if (reply->waiter != NULL) {
+		vortex_mutex_lock (&reply->waiter->mutex);
+		reply->waiter->signaled = axl_true;
+		vortex_cond_signal (&reply->waiter->cond);
+		vortex_mutex_unlock (&reply->waiter->mutex);
+	} /* end if */
+
+	/* acquire a reference for the continuation */
+	if (reply->handler != NULL) {
+		reply->refcount++;
+		dispatch = axl_true;
+	} /* end if */
+	vortex_mutex_unlock (&reply->mutex);
+
+	if (dispatch)
+		vortex_thread_pool_new_task (ctx, (VortexThreadFunc) __vortex_reply_invoke_handler, reply);
+	return;
+}
+
+/** 
+ * @internal Connection data key used to flag that the close handler
+ * failing pending reply futures is already installed.
+ */
+#define VORTEX_REPLY_WATCH "vo:reply:watch"
+
+/** 
+ * @internal Foreach handler used by __vortex_reply_connection_broken
+ * to fail all reply futures still pending on the channel.
+ */
+axl_bool __vortex_reply_fail_channel (axlPointer key, axlPointer data, axlPointer user_data)
+{
+	VortexChannel * channel = data;
+	WaitReplyData * wait_reply;
+	int             length;
+	int             iterator;
+
+	vortex_mutex_lock (&channel->receive_mutex);
+	if (channel->waiting_msgno != NULL) {
+		/* rotate the queue once, keeping the order, to visit
+		 * every pending wait reply */
+		length = vortex_queue_get_length (channel->waiting_msgno);
+		for (iterator = 0; iterator < length; iterator++) {
+			wait_reply = vortex_queue_pop (channel->waiting_msgno);
+			if (wait_reply->reply != NULL)
+				__vortex_reply_signal (wait_reply->reply, NULL);
+			vortex_queue_push (channel->waiting_msgno, wait_reply);
+		} /* end for */
+	} /* end if */
+	vortex_mutex_unlock (&channel->receive_mutex);
+
+	return axl_false; /* keep on iterating */
+}
+
+/** 
+ * @internal Close handler installed once per connection by
+ * vortex_channel_send_msg_future to complete, without reply, all
+ * futures pending on its channels when the connection breaks.
+ */
+void __vortex_reply_connection_broken (VortexConnection * conn, axlPointer data)
+{
+	VortexCtx * ctx = vortex_connection_get_ctx (conn);
+
+	/* handler is removed once executed: allow installing it
+	 * again if the connection is reconnected */
+	vortex_mutex_lock (&ctx->reply_mutex);
+	vortex_connection_set_data (conn, VORTEX_REPLY_WATCH, NULL);
+	vortex_mutex_unlock (&ctx->reply_mutex);
+
+	vortex_hash_foreach (conn->channels, __vortex_reply_fail_channel, NULL);
+	return;
+}
+
 /** 
  * @internal
  *
@@ -1095,6 +1405,149 @@ axlPointer __vortex_channel_new (VortexChannelData * data)
 	return channel;
 }
 
+/** 
+ * @internal Sends a channel start request over the provided
+ * connection without waiting for its reply. Used by the pipelined
+ * connect mode (\ref VORTEX_OPTS_PIPELINED_START) to queue the
+ * &lt;start> request right after client greetings, before remote
+ * greetings are received.
+ *
+ * The caller must complete the operation with \ref
+ * __vortex_channel_new_pipelined_finish (even if the connection fails
+ * in the middle).
+ *
+ * @param connection The connection where the channel will be created.
+ * @param serverName Optional serverName to be requested.
+ * @param profile The profile to be started.
+ * @param msg_no Reference where the start msgno is reported.
+ * @param wait_reply Reference where the wait reply object is reported.
+ *
+ * @return The channel being created or NULL if the start request
+ * could not be sent.
+ */
+VortexChannel * __vortex_channel_new_pipelined (VortexConnection  * connection,
+						const char        * serverName,
+						const char        * profile,
+						int               * msg_no,
+						WaitReplyData    ** wait_reply)
+{
+	VortexCtx        * ctx         = vortex_connection_get_ctx (connection);
+	VortexChannel    * channel;
+	VortexChannel    * channel0;
+	char             * start_msg;
+	int                channel_num;
+
+	v_return_val_if_fail (connection && profile && msg_no && wait_reply, NULL);
+
+	/* get channel 0 and next channel number available */
+	channel0    = vortex_connection_get_channel (connection, 0);
+	channel_num = vortex_connection_get_next_channel (connection);
+	if (channel0 == NULL || channel_num == -1) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to get channel 0 or next channel number for pipelined start (conn-id=%d)",
+			    vortex_connection_get_id (connection));
+		return NULL;
+	} /* end if */
+
+	/* check profile was registered, if not, register it with
+	 * default start and close handlers as vortex_channel_new does */
+	if (! vortex_profiles_is_registered (ctx, profile)) {
+		vortex_profiles_register (ctx, profile,
+					  NULL, NULL,
+					  NULL, NULL,
+					  NULL, NULL);
+	} /* end if */
+
+	/* create the channel and add it to the connection */
+	channel = vortex_channel_empty_new (channel_num, profile, connection);
+	if (! vortex_connection_add_channel (connection, channel)) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "failed to add pipelined channel %p into connection id=%d, cancelling",
+			    channel, vortex_connection_get_id (connection));
+		vortex_channel_unref2 (channel, "new channel");
+		return NULL;
+	} /* end if */
+
+	/* ensure we don't loose reference during creation */
+	vortex_channel_ref2 (channel, "new channel");
+	vortex_channel_set_data_full (channel, "vo:chan:srvName", axl_strdup (serverName), NULL, axl_free);
+
+	/* create wait reply and send start message */
+	(*wait_reply) = vortex_channel_create_wait_reply ();
+	start_msg     = vortex_frame_get_start_message (channel_num, serverName, profile, EncodingUnknown, NULL, 0);
+	if (! vortex_channel_send_msg_and_wait (channel0, start_msg, strlen (start_msg), msg_no, (*wait_reply))) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to send pipelined start message for channel %d and profile %s",
+			    channel_num, profile);
+		axl_free (start_msg);
+
+		/* release wait reply and channel */
+		vortex_channel_free_wait_reply (*wait_reply);
+		(*wait_reply) = NULL;
+		vortex_connection_remove_channel (connection, channel);
+		vortex_channel_unref2 (channel, "new channel");
+		return NULL;
+	} /* end if */
+	axl_free (start_msg);
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "pipelined start for channel=%d profile=%s queued with msgno=%d (conn-id=%d)",
+		    channel_num, profile, *msg_no, vortex_connection_get_id (connection));
+
+	return channel;
+}
+
+/** 
+ * @internal Completes a channel start initiated by \ref
+ * __vortex_channel_new_pipelined, waiting for its reply. The function
+ * releases the wait reply object and the reference acquired on the
+ * channel during creation.
+ *
+ * @param channel The channel being created.
+ * @param msg_no The start msgno reported.
+ * @param wait_reply The wait reply object reported.
+ *
+ * @return axl_true if the channel was accepted by the remote
+ * peer. Otherwise axl_false is returned and the channel is removed
+ * from the connection.
+ */
+axl_bool        __vortex_channel_new_pipelined_finish (VortexChannel * channel,
+						       int             msg_no,
+						       WaitReplyData * wait_reply)
+{
+	VortexConnection * conn     = vortex_channel_get_connection (channel);
+	VortexChannel    * channel0 = vortex_connection_get_channel (conn, 0);
+	VortexFrame      * frame    = NULL;
+	VortexCtx        * ctx      = vortex_channel_get_ctx (channel);
+	axl_bool           result   = axl_false;
+
+	/* wait for start reply (returns NULL right away if the
+	 * connection was broken during greetings) */
+	if (channel0 != NULL)
+		frame = vortex_channel_wait_reply (channel0, msg_no, wait_reply);
+	if (frame == NULL) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "failed to receive pipelined start reply for channel %d under profile %s",
+			    vortex_channel_get_number (channel), vortex_channel_get_profile (channel));
+		vortex_channel_free_wait_reply (wait_reply);
+		vortex_connection_remove_channel (conn, channel);
+		goto __vortex_channel_new_pipelined_release;
+	} /* end if */
+
+	/* check start reply data (frame released by the function) */
+	if (! __vortex_channel_validate_start_reply (frame, channel->profile, channel)) {
+		vortex_log (VORTEX_LEVEL_WARNING, "pipelined channel start for profile %s was denied by remote peer (conn-id=%d)",
+			    vortex_channel_get_profile (channel), vortex_connection_get_id (conn));
+		vortex_connection_remove_channel (conn, channel);
+		goto __vortex_channel_new_pipelined_release;
+	} /* end if */
+
+	/* register serverName requested */
+	if (channel->is_opened) 
+		vortex_connection_set_server_name (conn, vortex_channel_get_data (channel, "vo:chan:srvName"));
+	result = axl_true;
+
+ __vortex_channel_new_pipelined_release:
+	/* release reference acquired during creation */
+	vortex_channel_unref2 (channel, "new channel");
+	return result;
+}
+
 /** 
  * @brief Creates a new channel over the given connection.
  *
@@ -1603,6 +2056,7 @@ VortexChannel * vortex_channel_empty_new (int                channel_num,
 	/* outgoing message check support */
 	channel->outstanding_msg                = axl_list_new (axl_list_always_return_1, NULL);
 	channel->outstanding_msg_cursor         = axl_list_cursor_new (channel->outstanding_msg);
+	channel->outstanding_stamps             = axl_list_new (axl_list_always_return_1, axl_free);
 	vortex_mutex_create (&channel->outstanding_msg_mutex);
 
 	channel->waiting_msgno                  = vortex_queue_new ();
@@ -1616,12 +2070,22 @@ VortexChannel * vortex_channel_empty_new (int                channel_num,
 	vortex_mutex_create (&channel->ref_mutex);
 	channel->ref_count                      = 1; /* one reference */
 	vortex_mutex_create (&channel->serialize_mutex);
+	vortex_mutex_create (&channel->payload_sink_mutex);
+	vortex_mutex_create (&channel->seq_mutex);
+	channel->payload_sink_pending           = vortex_queue_new ();
 	channel->serialize                      = axl_false;
 	channel->serialize_next_seqno           = 0;
 	channel->waiting_replies                = axl_false;
 	channel->data                           = vortex_hash_new_full (axl_hash_string, axl_hash_equal_string, NULL, NULL);
 	channel->stored_replies                 = axl_hash_new (axl_hash_int, axl_hash_equal_int);
 
+	/* resolve the profile now so frame dispatch doesn't have to */
+	channel->profile_cache_epoch            = -1;
+	vortex_profiles_resolve_channel (channel);
+
+	/* same for the metrics series (if metrics were enabled) */
+	channel->metrics_series                 = __vortex_metrics_series_resolve (ctx, channel->profile);
+
 	/* check alloc references */
 	if (channel->previous_frame         == NULL ||
 	    channel->pending_messages       == NULL ||
@@ -1629,6 +2093,7 @@ VortexChannel * vortex_channel_empty_new (int                channel_num,
 	    channel->incoming_msg_cursor    == NULL ||
 	    channel->outstanding_msg        == NULL ||
 	    channel->outstanding_msg_cursor == NULL ||
+	    channel->outstanding_stamps     == NULL ||
 	    channel->waiting_msgno          == NULL ||
 	    channel->data                   == NULL ||
 	    channel->stored_replies         == NULL) {
@@ -1975,6 +2440,37 @@ void               vortex_channel_set_complete_frame_limit     (VortexChannel *
 	return;
 }
 
+/** 
+ * @brief Allows to get the complete frame limit applied to the
+ * provided channel, considering the limit configured at channel
+ * level (\ref vortex_channel_set_complete_frame_limit) and at
+ * connection level (\ref vortex_connection_set_complete_frame_limit).
+ *
+ * The function is useful for profiles that collect a message split
+ * across several frames by their own (without the complete flag
+ * enabled) but still want to honor the limits configured.
+ *
+ * @param channel The channel to get the complete frame limit from.
+ *
+ * @return The limit applied or -1 if no limit is configured.
+ */
+int                vortex_channel_get_complete_frame_limit     (VortexChannel * channel)
+{
+        int complete_frame_limit = -1;
+
+	if (channel == NULL)
+		return -1;
+
+	/* setup complete frame limit from channel */
+	if (channel->complete_frame_limit > 0)
+	        complete_frame_limit = channel->complete_frame_limit;
+	/* take value from connection level if bigger and defined */
+	if (channel->connection && channel->connection->complete_frame_limit > complete_frame_limit)
+	        complete_frame_limit = channel->connection->complete_frame_limit;
+
+	return complete_frame_limit;
+}
+
 /** 
  * @internal
  * @brief Returns if the given channel have stored a previous channel.
@@ -2042,12 +2538,8 @@ void               vortex_channel_store_previous_frame           (VortexCtx
 	/* configure new previous frame */
 	axl_list_append (channel->previous_frame, new_frame);
 
-	/* setup complete frame limit from channel */
-	if (channel->complete_frame_limit > 0)
-	        complete_frame_limit = channel->complete_frame_limit;
-	/* take value from connection level if bigger and defined */
-	if (channel->connection && channel->connection->complete_frame_limit > complete_frame_limit)
-	        complete_frame_limit = channel->connection->complete_frame_limit;
+	/* setup complete frame limit from channel (or connection) */
+	complete_frame_limit = vortex_channel_get_complete_frame_limit (channel);
 
 	/* check limit and close the connection if reached */
 	vortex_log (VORTEX_LEVEL_DEBUG, "Checking complete frame limit=%d (current bytes: %d) for channel=%d on conection id=%d",
@@ -2202,6 +2694,359 @@ axl_bool             vortex_channel_have_complete_flag           (VortexChannel
 	return (channel->complete_flag); 
 }
 
+/** 
+ * @internal Returns the profile reference cached on the channel (see
+ * vortex_profiles_resolve_channel).
+ *
+ * @param channel The channel to get the cache from.
+ *
+ * @param epoch Reference where the registry epoch the profile was
+ * resolved on is reported (-1 if never resolved).
+ *
+ * @return The profile cached (can be NULL).
+ */
+axlPointer         vortex_channel_get_profile_cache            (VortexChannel     * channel,
+								int               * epoch)
+{
+	if (channel == NULL) {
+		(* epoch) = -1;
+		return NULL;
+	} /* end if */
+
+	(* epoch) = channel->profile_cache_epoch;
+	return channel->profile_cache;
+}
+
+/** 
+ * @internal Configures the profile reference cached on the channel,
+ * releasing the previous one.
+ *
+ * @param channel The channel to configure.
+ *
+ * @param profile The profile reference (owned by the channel from now on).
+ *
+ * @param epoch The registry epoch the profile was resolved on.
+ */
+void               vortex_channel_set_profile_cache            (VortexChannel     * channel,
+								axlPointer          profile,
+								int                 epoch)
+{
+	axlPointer previous;
+
+	if (channel == NULL) {
+		vortex_profiles_release_cache (profile);
+		return;
+	} /* end if */
+
+	previous                     = channel->profile_cache;
+	channel->profile_cache       = profile;
+	channel->profile_cache_epoch = epoch;
+
+	/* release previous reference */
+	vortex_profiles_release_cache (previous);
+	return;
+}
+
+/** 
+ * @internal Returns the metrics series where values measured on the
+ * channel are accounted. The series is resolved when the channel is
+ * created or, if metrics weren't enabled at that time, the first time
+ * it is requested while metrics are enabled.
+ *
+ * @param channel The channel to get the series from.
+ *
+ * @return The series or NULL if metrics were never enabled.
+ */
+VortexMetricsSeries * vortex_channel_get_metrics_series        (VortexChannel     * channel)
+{
+	if (channel == NULL)
+		return NULL;
+	if (channel->metrics_series == NULL)
+		channel->metrics_series = __vortex_metrics_series_resolve (channel->ctx, channel->profile);
+	return channel->metrics_series;
+}
+
+/** 
+ * @brief Installs a payload sink on the channel that will receive
+ * the content of the next incoming message (MSG, RPY or ANS).
+ *
+ * Rather than delivering the message to the frame received handler
+ * (either frame by frame or joined in memory, see \ref
+ * vortex_channel_set_complete_flag), frames are written into the sink
+ * as they arrive. Writes are done by a thread pool task (never by
+ * the vortex reader) and the channel window is only advanced (SEQ
+ * frame sent) once each frame was written into the sink, so memory
+ * used is bounded by the window size no matter the message size and
+ * a slow sink only throttles its own channel.
+ *
+ * Once the message is completely received, the sink is removed from
+ * the channel, its finished handler is called (\ref
+ * vortex_payload_sink_set_on_finished) with the total size received
+ * and the sink is released. If the message received was a MSG, the
+ * finished handler is the place to reply to it.
+ *
+ * If a message is being received when the sink is installed, the
+ * sink will be used for the next one. Frames written into a sink
+ * aren't delivered to \ref vortex_channel_wait_reply or to reply
+ * futures.
+ *
+ * See also \ref vortex_profiles_set_payload_sink_handler to create
+ * sinks for all messages received on channels running a profile.
+ *
+ * @param channel The channel to configure.
+ *
+ * @param sink The sink to install (the channel owns the reference
+ * provided) or NULL to remove the current one.
+ *
+ * @return axl_true if the sink was installed, otherwise axl_false is
+ * returned (a previous sink is currently receiving a message).
+ */
+axl_bool           vortex_channel_set_payload_sink              (VortexChannel     * channel,
+								 VortexPayloadSink * sink)
+{
+	VortexPayloadSink * previous;
+
+	if (channel == NULL)
+		return axl_false;
+
+	vortex_mutex_lock (&channel->payload_sink_mutex);
+	if (__vortex_payload_sink_is_bound (channel->payload_sink, NULL)) {
+		vortex_mutex_unlock (&channel->payload_sink_mutex);
+		return axl_false;
+	} /* end if */
+
+	/* replace the sink */
+	previous              = channel->payload_sink;
+	channel->payload_sink = sink;
+	vortex_mutex_unlock (&channel->payload_sink_mutex);
+
+	/* release previous sink */
+	vortex_payload_sink_unref (previous);
+
+	return axl_true;
+}
+
+/** 
+ * @brief Returns the payload sink installed on the channel (see \ref
+ * vortex_channel_set_payload_sink).
+ *
+ * @param channel The channel to check.
+ *
+ * @return A reference to the sink (not owned by the caller) or NULL.
+ */
+VortexPayloadSink * vortex_channel_get_payload_sink             (VortexChannel     * channel)
+{
+	VortexPayloadSink * sink;
+
+	if (channel == NULL)
+		return NULL;
+
+	vortex_mutex_lock (&channel->payload_sink_mutex);
+	sink = channel->payload_sink;
+	vortex_mutex_unlock (&channel->payload_sink_mutex);
+
+	return sink;
+}
+
+/** 
+ * @internal Allows the vortex reader to check if the frame received
+ * must be written into a payload sink. For the first frame of a
+ * message, the sink installed on the channel is bound to the
+ * message (or a sink is created if the profile has a sink handler).
+ *
+ * @param channel The channel where the frame was received.
+ *
+ * @param frame The frame received.
+ *
+ * @return axl_true if the frame must be written with \ref
+ * vortex_channel_payload_sink_write, otherwise axl_false.
+ */
+axl_bool           vortex_channel_payload_sink_accepts          (VortexChannel     * channel,
+								 VortexFrame       * frame)
+{
+	VortexFrameType     type;
+	VortexPayloadSink * sink;
+	axl_bool            result = axl_false;
+
+	if (channel == NULL || frame == NULL || channel->channel_num == 0)
+		return axl_false;
+
+	/* only messages with content are written into sinks */
+	type = vortex_frame_get_type (frame);
+	if (type != VORTEX_FRAME_TYPE_MSG && type != VORTEX_FRAME_TYPE_RPY && type != VORTEX_FRAME_TYPE_ANS)
+		return axl_false;
+
+	/* check if a message is starting without sink to ask the
+	 * profile to create one */
+	vortex_mutex_lock (&channel->payload_sink_mutex);
+	if (channel->payload_sink == NULL && ! channel->payload_sink_skip) {
+		vortex_mutex_unlock (&channel->payload_sink_mutex);
+
+		/* call without the lock acquired */
+		sink = vortex_profiles_create_payload_sink (channel, frame);
+
+		vortex_mutex_lock (&channel->payload_sink_mutex);
+		if (channel->payload_sink == NULL) {
+			channel->payload_sink = sink;
+			sink                  = NULL;
+		} /* end if */
+
+		/* release sink if another was installed meanwhile */
+		vortex_payload_sink_unref (sink);
+	} /* end if */
+
+	sink = channel->payload_sink;
+	if (__vortex_payload_sink_is_bound (sink, NULL)) {
+		/* frame must belong to the message being received */
+		result = __vortex_payload_sink_is_bound (sink, frame);
+	} else if (sink != NULL && ! channel->payload_sink_skip) {
+		/* first frame of a message, bind the sink */
+		__vortex_payload_sink_bind (sink, channel, frame);
+		result = axl_true;
+	} /* end if */
+
+	/* track messages delivered as usual */
+	if (! result)
+		channel->payload_sink_skip = vortex_frame_get_more_flag (frame);
+	vortex_mutex_unlock (&channel->payload_sink_mutex);
+
+	return result;
+}
+
+/** 
+ * @internal Frame pending to be written into a payload sink by the
+ * sink worker (owns a reference to both).
+ */
+typedef struct _VortexPayloadSinkWrite {
+	VortexPayloadSink * sink;
+	VortexFrame       * frame;
+} VortexPayloadSinkWrite;
+
+/** 
+ * @internal Payload sink worker: thread pool task that writes the
+ * frames queued on the channel into their sinks, in order, reporting
+ * the window as consumed (SEQ frame) once each frame is written and
+ * completing the sink with the last frame of the message.
+ */
+axlPointer __vortex_channel_payload_sink_worker (VortexChannel * channel)
+{
+#if defined(ENABLE_VORTEX_LOG)
+	VortexCtx              * ctx        = vortex_channel_get_ctx (channel);
+#endif
+	VortexConnection       * connection = channel->connection;
+	VortexPayloadSinkWrite * pending;
+	char                     seq_frame[50];
+
+	while (axl_true) {
+		/* get next frame or flag the worker as finished */
+		vortex_mutex_lock (&channel->payload_sink_mutex);
+		pending = vortex_queue_pop (channel->payload_sink_pending);
+		if (pending == NULL)
+			channel->payload_sink_running = axl_false;
+		vortex_mutex_unlock (&channel->payload_sink_mutex);
+
+		if (pending == NULL)
+			break;
+
+		/* write content */
+		__vortex_payload_sink_write (pending->sink, pending->frame);
+
+		/* content written won't be delivered, so update
+		 * serialize next seqno to not block next deliveries */
+		if (channel->serialize) {
+			vortex_mutex_lock (&channel->serialize_mutex);
+			if (channel->serialize_next_seqno == vortex_frame_get_seqno (pending->frame))
+				channel->serialize_next_seqno = vortex_frame_get_seqno (pending->frame) + vortex_frame_get_content_size (pending->frame);
+			vortex_mutex_unlock (&channel->serialize_mutex);
+		} /* end if */
+
+		/* and only now report the window as consumed, so the
+		 * remote peer is throttled by the sink speed */
+		if (vortex_connection_is_ok (connection, axl_false) &&
+		    ! vortex_channel_notify_incoming_buffer (channel, pending->frame, seq_frame)) {
+			vortex_log (VORTEX_LEVEL_CRITICAL, "unable to notify SEQ channel status after payload sink write, connection broken or protocol violation");
+		} /* end if */
+
+		/* notify message completed (reference is passed) */
+		if (vortex_frame_get_more_flag (pending->frame))
+			vortex_payload_sink_unref (pending->sink);
+		else
+			__vortex_payload_sink_finish (pending->sink);
+
+		vortex_frame_unref (pending->frame);
+		axl_free (pending);
+	} /* end while */
+
+	/* release references acquired by
+	 * vortex_channel_payload_sink_write */
+	vortex_channel_unref2 (channel, "payload sink");
+	vortex_connection_unref (connection, "payload sink");
+	return NULL;
+}
+
+/** 
+ * @internal Queues the frame received to be written into the channel
+ * payload sink by the sink worker, which completes the sink with the
+ * last frame of the message and reports the window as consumed once
+ * the content is written. The reference to the frame is owned by
+ * this function.
+ *
+ * @param channel The channel where the frame was received.
+ *
+ * @param frame The frame received (accepted by \ref
+ * vortex_channel_payload_sink_accepts).
+ */
+void               vortex_channel_payload_sink_write            (VortexChannel     * channel,
+								 VortexFrame       * frame)
+{
+	VortexCtx              * ctx     = vortex_channel_get_ctx (channel);
+	VortexPayloadSinkWrite * pending;
+	axl_bool                 start   = axl_false;
+
+	pending = axl_new (VortexPayloadSinkWrite, 1);
+	if (pending == NULL) {
+		vortex_frame_unref (frame);
+		return;
+	} /* end if */
+	pending->frame = frame;
+
+	/* get the sink, removing it from the channel if the message
+	 * is completed (its reference is passed to the worker) */
+	vortex_mutex_lock (&channel->payload_sink_mutex);
+	pending->sink = channel->payload_sink;
+	if (! vortex_frame_get_more_flag (frame))
+		channel->payload_sink = NULL;
+	else if (! vortex_payload_sink_ref (pending->sink))
+		pending->sink = NULL;
+
+	if (pending->sink != NULL) {
+		vortex_queue_push (channel->payload_sink_pending, pending);
+
+		/* start the worker if it isn't running: it owns a
+		 * reference to the channel and the connection */
+		if (! channel->payload_sink_running &&
+		    vortex_channel_ref2 (channel, "payload sink")) {
+			if (vortex_connection_uncheck_ref (channel->connection)) {
+				channel->payload_sink_running = axl_true;
+				start                         = axl_true;
+			} else
+				vortex_channel_unref2 (channel, "payload sink");
+		} /* end if */
+	} /* end if */
+	vortex_mutex_unlock (&channel->payload_sink_mutex);
+
+	if (pending->sink == NULL) {
+		vortex_frame_unref (frame);
+		axl_free (pending);
+		return;
+	} /* end if */
+
+	if (start)
+		vortex_thread_pool_new_task (ctx, (VortexThreadFunc) __vortex_channel_payload_sink_worker, channel);
+
+	return;
+}
+
 /** 
  * @brief Returns the channel number for selected channel.
  * 
@@ -2386,6 +3231,64 @@ axl_bool vortex_channel_check_msg_no_find_item_outgoing (VortexCtx * ctx, Vortex
 	return axl_false;
 }
 
+/** 
+ * @internal Checks, with the channel send mutex acquired, that the
+ * outstanding limit allows <b>amount</b> more MSG to be sent,
+ * blocking until it does unless the channel is configured to fail
+ * when the limit is reached.
+ *
+ * @return axl_true if the messages can be sent, otherwise axl_false
+ * is returned (limit reached and fail on limit configured).
+ */
+axl_bool __vortex_channel_wait_outstanding_limit (VortexChannel * channel, int amount)
+{
+#if defined(ENABLE_VORTEX_LOG)
+	VortexCtx * ctx = vortex_channel_get_ctx (channel);
+#endif
+
+	/* check outstanding limit to be enabled */
+	if (channel->outstanding_limit <= 0)
+		return axl_true;
+
+	/* now check limit */
+	while ((vortex_channel_get_outstanding_messages (channel, NULL) + amount) > channel->outstanding_limit) {
+		/* check if we have to fail or wait */
+		if (channel->fail_on_limit) {
+			vortex_log (VORTEX_LEVEL_WARNING, "unable to send MSG request, channel outstanding limit reached (%d)",
+				    channel->outstanding_limit);
+			return axl_false;
+		} /* end if */
+
+		/* wait until condition satisfies */
+		vortex_log (VORTEX_LEVEL_WARNING, "Blocking send MSG request, channel outstanding limit reached (%d)",
+			    channel->outstanding_limit);
+		VORTEX_COND_WAIT (&channel->send_cond, &channel->send_mutex);
+	} /* end while */
+
+	return axl_true;
+}
+
+/** 
+ * @internal Registers the msgno provided as pending to be replied.
+ */
+void __vortex_channel_push_outstanding (VortexChannel * channel, int msg_no)
+{
+#if defined(ENABLE_VORTEX_LOG)
+	VortexCtx * ctx = vortex_channel_get_ctx (channel);
+#endif
+
+	/* update pending messages to be replied */
+	vortex_mutex_lock (&channel->outstanding_msg_mutex);
+	axl_list_append (channel->outstanding_msg, INT_TO_PTR (msg_no));
+	__vortex_channel_push_sent_stamp (channel, msg_no);
+	vortex_log (VORTEX_LEVEL_DEBUG, "channel=%d append pending msg no to be replied: %d (length: %d), first: %d",
+		    channel->channel_num, msg_no, axl_list_length (channel->outstanding_msg), 
+		    PTR_TO_INT (axl_list_get_first (channel->outstanding_msg)));
+	vortex_mutex_unlock (&channel->outstanding_msg_mutex);
+
+	return;
+}
+
 /** 
  * @internal
  * @brief Common function support other function to send message.
@@ -2459,30 +3362,15 @@ axl_bool    vortex_channel_send_msg_common (VortexChannel       * channel,
 	/* lock send mutex */
 	vortex_mutex_lock (&channel->send_mutex);
 
-	/* check outstanding limit to be enabled */
-check_limit:
-	if (channel->outstanding_limit > 0) {
-		/* now check limit */
-		if (vortex_channel_get_outstanding_messages (channel, NULL) >= channel->outstanding_limit) {
-			/* check if we have to fail or wait */
-			if (channel->fail_on_limit) {
-				vortex_log (VORTEX_LEVEL_WARNING, "unable to send MSG request, channel outstanding limit reached (%d)",
-					    channel->outstanding_limit);
-				vortex_mutex_unlock (&channel->send_mutex);
-
-				/* release channel */
-				vortex_channel_unref2 (channel, "send-msg");
+	/* check outstanding limit */
+	if (! __vortex_channel_wait_outstanding_limit (channel, 1)) {
+		vortex_mutex_unlock (&channel->send_mutex);
 
-				return axl_false;
-			} /* end if */
+		/* release channel */
+		vortex_channel_unref2 (channel, "send-msg");
 
-			/* wait until condition satisfies */
-			vortex_log (VORTEX_LEVEL_WARNING, "Blocking send MSG request, channel outstanding limit reached (%d)",
-				    channel->outstanding_limit);
-			VORTEX_COND_WAIT (&channel->send_cond, &channel->send_mutex);
-			goto check_limit;
-		}
-	}
+		return axl_false;
+	} /* end if */
 
 	/* get current mime header configuration */
 	if (channel->last_fixed_more_msg_no >= 0) {
@@ -2616,17 +3504,8 @@ check_limit:
 	/* update channel status but only if it is not a feeder and
 	   close_transfer was not activated so, the expected message
 	   is already placed on the list */
-	if (update_msg_no) {
-		/* update pending messages to be replied */
-		vortex_mutex_lock (&channel->outstanding_msg_mutex);
-		axl_list_append (channel->outstanding_msg, INT_TO_PTR (data->msg_no));
-		vortex_log (VORTEX_LEVEL_DEBUG, "channel=%d append pending msg no to be replied: %d (length: %d), first: %d",
-			    channel->channel_num, data->msg_no, axl_list_length (channel->outstanding_msg), 
-			    PTR_TO_INT (axl_list_get_first (channel->outstanding_msg)));
- 
-		vortex_mutex_unlock (&channel->outstanding_msg_mutex);
-
-	} /* end if */
+	if (update_msg_no)
+		__vortex_channel_push_outstanding (channel, data->msg_no);
 
 	/* queue request */
 	if (! vortex_sequencer_queue_data (ctx, data)) {
@@ -2771,6 +3650,222 @@ axl_bool        vortex_channel_send_msg   (VortexChannel    * channel,
 	return vortex_channel_send_msg_common (channel, message, message_size, -1, msg_no, NULL, NULL, axl_false);
 }
 
+/** 
+ * @brief Sends several messages over the provided channel with a
+ * single send operation.
+ *
+ * This function works like calling \ref vortex_channel_send_msg for
+ * each entry but it is intended for bursts of small messages: message
+ * numbers are reserved as a contiguous range and all messages are
+ * queued into the sequencer with a single lock acquisition and a
+ * single sequencer signal. Combined with \ref
+ * vortex_connection_set_write_coalescing, the sequencer packs the
+ * frames produced into as few writes as the channel window allows.
+ *
+ * \code
+ * VortexMessageEntry entries[3];
+ * int                first_msg_no;
+ *
+ * entries[0].message = "first";  entries[0].message_size = 5;
+ * entries[1].message = "second"; entries[1].message_size = 6;
+ * entries[2].message = "third";  entries[2].message_size = 5;
+ *
+ * if (! vortex_channel_send_msg_batch (channel, entries, 3, &first_msg_no)) {
+ *      // failed to send messages
+ * }
+ * // messages were sent using first_msg_no, first_msg_no + 1, ...
+ * \endcode
+ *
+ * The outstanding limit (\ref vortex_channel_set_outstanding_limit)
+ * is checked for each entry: once reached, the entries already
+ * accepted are sent and the function waits for replies to accept
+ * the rest (if the channel is configured to fail on limit, the
+ * whole batch must fit or no message is sent). The function can't be used
+ * while a transfer started with \ref vortex_channel_send_msg_more is
+ * not finished.
+ *
+ * @param channel The channel where the messages will be sent.
+ *
+ * @param entries The messages to be sent (content is copied).
+ *
+ * @param count Number of entries.
+ *
+ * @param first_msg_no Optional reference to get the message number
+ * used by the first entry (next entries use consecutive message
+ * numbers).
+ *
+ * @return axl_true if all messages were queued to be sent, otherwise
+ * axl_false is returned (no message is sent unless the batch was
+ * split by the outstanding limit and the sequencer failed after).
+ *
+ * <i><b>NOTE:</b> See MIME considerations described at \ref
+ * vortex_channel_send_msg which also applies to this function.</i>
+ */
+axl_bool        vortex_channel_send_msg_batch (VortexChannel      * channel,
+					       VortexMessageEntry * entries,
+					       int                  count,
+					       int                * first_msg_no)
+{
+	VortexSequencerData ** batch;
+	VortexSequencerData  * data;
+	int                    mime_header_size;
+	int                    iterator;
+	int                    queued  = 0;
+	VortexCtx            * ctx     = vortex_channel_get_ctx (channel);
+
+	v_return_val_if_fail (channel,                           axl_false);
+	v_return_val_if_fail (entries && count > 0,              axl_false);
+	v_return_val_if_fail (channel->is_opened,                axl_false);
+
+	if (channel->channel_num != 0) {
+		v_return_val_if_fail (! channel->being_closed,   axl_false);
+	} /* end if */
+
+	/* a single message needs no batching */
+	if (count == 1)
+		return vortex_channel_send_msg (channel, entries[0].message, entries[0].message_size, first_msg_no);
+
+	/* check if the connection is ok */
+	if (! vortex_connection_is_ok (channel->connection, axl_false)) {
+		vortex_log (VORTEX_LEVEL_WARNING, "received a MSG batch request to be sent over a non connected session, dropping messages");
+		return axl_false;
+	}
+
+	/* acquire reference to the channel during the send
+	 * operation */
+	if (! vortex_channel_ref2 (channel, "send-msg")) {
+		vortex_log (VORTEX_LEVEL_WARNING, "received a MSG batch request but failed to acquire a reference to the channel object (%p)",
+			    channel);
+		return axl_false;
+	} /* end if */
+
+	batch = axl_new (VortexSequencerData *, count);
+	if (batch == NULL) {
+		vortex_channel_unref2 (channel, "send-msg");
+		return axl_false;
+	} /* end if */
+
+	/* lock send mutex */
+	vortex_mutex_lock (&channel->send_mutex);
+
+	/* when failing on limit, the whole batch must fit */
+	if (channel->fail_on_limit && ! __vortex_channel_wait_outstanding_limit (channel, count))
+		goto failed;
+
+	/* messages of a batch can't be mixed with a pending more
+	 * transfer */
+	if (channel->last_fixed_more_msg_no >= 0) {
+		vortex_log (VORTEX_LEVEL_WARNING, "unable to send MSG batch over channel=%d while a fixed more transfer is in progress (msgno=%d)",
+			    channel->channel_num, channel->last_fixed_more_msg_no);
+		goto failed;
+	} /* end if */
+
+	/* get current mime header configuration */
+	mime_header_size  = __vortex_channel_get_mime_headers_size (ctx, channel);
+
+	/* prepare all messages before reserving message numbers */
+	for (iterator = 0; iterator < count; iterator++) {
+		if (entries[iterator].message_size > 0 && entries[iterator].message == NULL) {
+			vortex_log (VORTEX_LEVEL_CRITICAL, "received a MSG batch with an undefined message at position %d", iterator);
+			goto failed;
+		} /* end if */
+
+		data = axl_new (VortexSequencerData, 1);
+		if (data == NULL)
+			goto failed;
+		batch[iterator]    = data;
+
+		data->channel      = channel;
+		data->type         = VORTEX_FRAME_TYPE_MSG;
+		data->channel_num  = channel->channel_num;
+		data->message_size = entries[iterator].message_size + mime_header_size;
+		data->message      = axl_new (char, data->message_size + 1);
+		if (data->message == NULL)
+			goto failed;
+
+		/* according to mime headers size */
+		if (mime_header_size > 0)
+			__vortex_channel_get_mime_headers (channel, data->message);
+		memcpy (data->message + mime_header_size, entries[iterator].message, entries[iterator].message_size);
+	} /* end for */
+
+	/* reserve consecutive message numbers */
+	for (iterator = 0; iterator < count; iterator++)
+		batch[iterator]->msg_no = vortex_channel_get_next_msg_no (channel);
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "new MSG batch to be sent over channel=%d: %d messages, msgno %d..%d",
+		    channel->channel_num, count, batch[0]->msg_no, batch[count - 1]->msg_no);
+
+	/* return back first message no used */
+	if (first_msg_no != NULL)
+		(* first_msg_no) = batch[0]->msg_no;
+
+	/* reserve an outstanding slot for each message, registering
+	 * it as pending to be replied */
+	for (iterator = 0; iterator < count; iterator++) {
+		/* limit reached: send messages already accepted so
+		 * their replies release slots (released by the
+		 * sequencer if it fails) */
+		if (iterator > queued && channel->outstanding_limit > 0 &&
+		    vortex_channel_get_outstanding_messages (channel, NULL) >= channel->outstanding_limit) {
+			if (! vortex_sequencer_queue_data_batch (ctx, batch + queued, iterator - queued))
+				goto queue_failed;
+			queued = iterator;
+		} /* end if */
+
+		/* can't fail: fail on limit was checked for the whole
+		 * batch */
+		__vortex_channel_wait_outstanding_limit (channel, 1);
+		__vortex_channel_push_outstanding (channel, batch[iterator]->msg_no);
+	} /* end for */
+
+	/* queue pending messages (released by the sequencer if it
+	 * fails) */
+	iterator = count;
+	if (! vortex_sequencer_queue_data_batch (ctx, batch + queued, count - queued)) 
+		goto queue_failed;
+
+	/* unlock send mutex */
+	vortex_mutex_unlock (&channel->send_mutex);
+
+	/* release channel */
+	vortex_channel_unref2 (channel, "send-msg");
+
+	axl_free (batch);
+	return axl_true;
+
+ queue_failed:
+	vortex_log (VORTEX_LEVEL_CRITICAL, "Failed to send MSG batch over channel=%d (conn-id=%d), unable to queue messages into sequencer",
+		    channel->channel_num, vortex_connection_get_id (channel->connection));
+
+	/* release messages not handed to the sequencer */
+	for (; iterator < count; iterator++) {
+		axl_free (batch[iterator]->message);
+		axl_free (batch[iterator]);
+	} /* end for */
+	axl_free (batch);
+
+	vortex_mutex_unlock (&channel->send_mutex);
+	vortex_channel_unref2 (channel, "send-msg");
+	return axl_false;
+
+ failed:
+	/* release messages prepared */
+	for (iterator = 0; iterator < count && batch[iterator] != NULL; iterator++) {
+		axl_free (batch[iterator]->message);
+		axl_free (batch[iterator]);
+	} /* end for */
+	axl_free (batch);
+
+	/* unlock send mutex */
+	vortex_mutex_unlock (&channel->send_mutex);
+
+	/* release channel */
+	vortex_channel_unref2 (channel, "send-msg");
+
+	return axl_false;
+}
+
 /** 
  * @brief Allows to send a message, producing required fragments, but
  * ensuring all frames have more flag enabled.
@@ -4101,6 +5196,7 @@ void vortex_channel_update_remote_incoming_buffer (VortexChannel * channel,
 #endif
 	unsigned int   max_remote_seq_no;
 	int            window_available;
+	struct timeval stall_stamp;
 
 	/* check reference */
 	if (channel == NULL)
@@ -4159,15 +5255,41 @@ void vortex_channel_update_remote_incoming_buffer (VortexChannel * channel,
  	vortex_log (VORTEX_LEVEL_DEBUG, "received SEQ frame, updated maximum seq no allowed from %u to %u",
   		    max_remote_seq_no, (ackno + window -1));
 	
- 	/* update size allowed */
+ 	/* update size allowed (getting when the channel got stalled
+	 * if it was) */
 	vortex_mutex_lock (&channel->ref_mutex);
 	channel->remote_consumed_seq_no = ackno;
 	channel->remote_window          = window;
+	stall_stamp                     = channel->stall_stamp;
+	channel->stall_stamp.tv_sec     = 0;
 	vortex_mutex_unlock   (&channel->ref_mutex);
+
+	/* account time the channel was stalled */
+	__vortex_metrics_record_since (channel->ctx, VORTEX_METRIC_SEQ_STALL, vortex_channel_get_metrics_series (channel), &stall_stamp);
  
 	return;
 }
 
+/** 
+ * @internal Records the moment the channel got stalled (remote window
+ * exhausted) to account how long it takes to receive a SEQ frame
+ * opening it again. Called by the sequencer. Does nothing if metrics
+ * are not enabled or the channel was already stalled.
+ *
+ * @param channel The channel that got stalled.
+ */
+void __vortex_channel_stall_begin (VortexChannel * channel)
+{
+	if (channel == NULL || ! vortex_metrics_is_enabled (channel->ctx))
+		return;
+
+	vortex_mutex_lock (&channel->ref_mutex);
+	if (channel->stall_stamp.tv_sec == 0)
+		gettimeofday (&channel->stall_stamp, NULL);
+	vortex_mutex_unlock (&channel->ref_mutex);
+	return;
+}
+
 /** 
  * @internal
  *
@@ -4494,6 +5616,86 @@ axl_bool      vortex_channel_update_incoming_buffer (VortexChannel * channel,
 	return axl_false;
 }
 
+/** 
+ * @internal Reports the frame provided as consumed, updating the
+ * channel incoming buffer and sending a SEQ frame to the remote peer
+ * if the window must be advanced. Used by the vortex reader and the
+ * payload sink worker: both steps are done under the channel seq
+ * mutex so SEQ frames are sent in order, and frames already covered
+ * by a later acknowledgement are skipped.
+ *
+ * @param channel The channel where the frame was received.
+ *
+ * @param frame The frame consumed (not released).
+ *
+ * @param buffer Buffer of 50 bytes used to build the SEQ frame.
+ *
+ * @return axl_false if the SEQ frame couldn't be sent, otherwise
+ * axl_true.
+ */
+axl_bool      vortex_channel_notify_incoming_buffer (VortexChannel * channel,
+						     VortexFrame   * frame,
+						     char          * buffer)
+{
+#if defined(ENABLE_VORTEX_LOG)
+	VortexCtx        * ctx     = vortex_channel_get_ctx (channel);
+#endif
+	VortexChannel    * channel0;
+	VortexWriterData   writer;
+	unsigned int       consumed_seqno;
+	unsigned int       ackno;
+	int                window;
+	axl_bool           result  = axl_true;
+
+	if (channel == NULL || frame == NULL || buffer == NULL)
+		return axl_false;
+
+	vortex_mutex_lock (&channel->seq_mutex);
+
+	/* skip frames already acknowledged by a later SEQ frame (the
+	 * sink worker may report after the reader) */
+	consumed_seqno = vortex_frame_get_seqno (frame) + vortex_frame_get_content_size (frame);
+	if (channel->consumed_seqno != consumed_seqno &&
+	    (unsigned int) (channel->consumed_seqno - consumed_seqno) < (MAX_SEQ_NO / 2)) {
+		vortex_mutex_unlock (&channel->seq_mutex);
+		return axl_true;
+	} /* end if */
+
+	if (vortex_channel_update_incoming_buffer (channel, frame, &ackno, &window)) {
+		/* It seems there are something to report.
+		 * 
+		 * Now create a SEQ frame with higher priority to
+		 * report remote side that the current max seq no
+		 * value have been updated. */
+		writer.type        = VORTEX_FRAME_TYPE_SEQ;
+		writer.msg_no      = 0;
+		writer.the_frame   = vortex_frame_seq_build_up_from_params_buffer (vortex_channel_get_number (channel),
+										   ackno,
+										   window,
+										   buffer,
+										   50,
+										   &(writer.the_size));
+		writer.is_complete   = axl_true;
+		writer.sendfile_size = 0;
+		writer.trace_stamp.tv_sec  = 0;
+		writer.trace_stamp.tv_usec = 0;
+		vortex_log (VORTEX_LEVEL_DEBUG, "notifying remote side that current buffer status is %s",
+			    writer.the_frame);
+		/* Queue the vortex writer message to be sent with
+		 * higher priority, currently, the following function
+		 * will check if the packet to send is a SEQ frame to
+		 * apply this priority. */
+		channel0 = vortex_connection_get_channel (channel->connection, 0);
+		if ((channel0 == NULL) || ! vortex_sequencer_direct_send (channel->connection, channel0, &writer)) {
+			vortex_log (VORTEX_LEVEL_CRITICAL, "unable to queue a SEQ frame");
+			result = axl_false;
+		} /* end if */
+	} /* end if */
+
+	vortex_mutex_unlock (&channel->seq_mutex);
+	return result;
+}
+
 /** 
  * @internal
  *
@@ -4580,6 +5782,34 @@ void               vortex_channel_queue_pending_message         (VortexChannel *
 	return;
 }
 
+/** 
+ * @internal
+ *
+ * @brief Allows to queue several messages pending to be sequenced
+ * with a single lock operation.
+ * 
+ * @param channel The channel where the messages are going to be queued.
+ * @param messages The messages to be queued (in order).
+ * @param count Number of messages.
+ */
+void               vortex_channel_queue_pending_messages        (VortexChannel * channel,
+								 axlPointer    * messages,
+								 int             count)
+{
+	int iterator;
+
+	/* check reference received */
+	if (channel == NULL || messages == NULL)
+		return;
+
+	/* lock the message */
+	vortex_mutex_lock (&channel->pending_messages_m);
+	for (iterator = 0; iterator < count; iterator++) 
+		axl_list_append (channel->pending_messages, messages[iterator]);
+	vortex_mutex_unlock (&channel->pending_messages_m);
+	return;
+}
+
 /** 
  * @internal
  *
@@ -5210,9 +6440,11 @@ axl_bool vortex_channel_remove_first_pending_msg_no (VortexChannel * channel, in
  */
 axl_bool vortex_channel_remove_first_outstanding_msg_no (VortexChannel * channel, int msg_no_rpy)
 {
-	axl_bool    result;
+	axl_bool                 result;
+	VortexChannelSentStamp * sent;
+	struct timeval           stamp = {0, 0};
 #if defined(ENABLE_VORTEX_LOG)
-	VortexCtx * ctx;
+	VortexCtx              * ctx;
 #endif
 	v_return_val_if_fail (channel, -1);
 
@@ -5230,6 +6462,13 @@ axl_bool vortex_channel_remove_first_outstanding_msg_no (VortexChannel * channel
 		vortex_log (VORTEX_LEVEL_DEBUG, "channel=%d, removing first pending message to receive reply: %d",
 			    channel->channel_num, msg_no_rpy);
 		axl_list_remove_first (channel->outstanding_msg);
+
+		/* get when the message was sent (if recorded) */
+		sent = axl_list_get_first (channel->outstanding_stamps);
+		if (sent != NULL && sent->msg_no == msg_no_rpy) {
+			stamp = sent->stamp;
+			axl_list_remove_first (channel->outstanding_stamps);
+		} /* end if */
 	} else {
 		/* close connection and drop a log */
 		__vortex_connection_shutdown_and_record_error (
@@ -5241,6 +6480,9 @@ axl_bool vortex_channel_remove_first_outstanding_msg_no (VortexChannel * channel
 	/* unlock mutex */
 	vortex_mutex_unlock (&channel->outstanding_msg_mutex);
 
+	/* account round trip */
+	__vortex_metrics_record_since (channel->ctx, VORTEX_METRIC_ROUND_TRIP, vortex_channel_get_metrics_series (channel), &stamp);
+
 	if (result) {
 		/* notify oustanding list reduced */
 		vortex_mutex_lock   (&channel->send_mutex);
@@ -6375,6 +7617,8 @@ axlPointer __vortex_channel_invoke_received_handler (ReceivedInvokeData * data)
 	VortexConnection * connection   = vortex_channel_get_connection (channel);
 	VortexFrame      * frame        = data->frame;
 	axl_bool           is_connected;
+	axl_bool           metrics;
+	struct timeval     stamp;
 #if defined(ENABLE_VORTEX_LOG)
 	VortexFrameType    type;
 	char             * raw_frame    = NULL;
@@ -6447,7 +7691,13 @@ axlPointer __vortex_channel_invoke_received_handler (ReceivedInvokeData * data)
 
 	/* invoke handler */
 	if (channel->received) {
+		/* measure handler execution if metrics are enabled */
+		metrics = __vortex_metrics_handler_start (ctx, frame, vortex_channel_get_metrics_series (channel), &stamp);
+		VORTEX_TRACE_FRAME (ctx, connection, frame, VORTEX_TRACE_FRAME_DEQUEUED);
 		channel->received (channel, channel->connection, frame, channel->received_user_data);
+		VORTEX_TRACE_FRAME (ctx, connection, frame, VORTEX_TRACE_FRAME_HANDLED);
+		if (metrics)
+			__vortex_metrics_record_since (ctx, VORTEX_METRIC_HANDLER, vortex_channel_get_metrics_series (channel), &stamp);
 #if defined(ENABLE_VORTEX_LOG)
  		if (vortex_log_is_enabled (ctx)) {
  			/* get type */
@@ -6590,8 +7840,12 @@ axl_bool      vortex_channel_invoke_received_handler (VortexConnection * connect
 		/* remove waiting reply data */
 		vortex_queue_pop (channel->waiting_msgno);
 
-		/* queue frame received */
-		QUEUE_PUSH (wait_reply->queue, frame);
+		/* queue frame received or complete the reply future
+		 * it belongs to */
+		if (wait_reply->reply != NULL)
+			__vortex_reply_signal (wait_reply->reply, frame);
+		else
+			QUEUE_PUSH (wait_reply->queue, frame);
 
 		/* decrease wait reply reference counting */
 		vortex_channel_free_wait_reply (wait_reply);
@@ -7947,6 +9201,14 @@ void vortex_channel_free (VortexChannel * channel)
 	axl_hash_free (channel->serialize_hash);
 	axl_hash_free (channel->stored_replies);
 
+	/* release payload sink not completed */
+	vortex_payload_sink_unref (channel->payload_sink);
+	channel->payload_sink = NULL;
+	vortex_queue_free (channel->payload_sink_pending);
+	channel->payload_sink_pending = NULL;
+	vortex_mutex_destroy (&channel->payload_sink_mutex);
+	vortex_mutex_destroy (&channel->seq_mutex);
+
 	vortex_log (VORTEX_LEVEL_DEBUG, "freeing ref_mutex");
 	vortex_mutex_destroy (&channel->ref_mutex);
 
@@ -7959,6 +9221,10 @@ void vortex_channel_free (VortexChannel * channel)
 	axl_free              (channel->profile);
 	channel->profile = NULL;
 
+	/* release cached profile */
+	vortex_profiles_release_cache (channel->profile_cache);
+	channel->profile_cache = NULL;
+
 	/* destroy pending piggyback */
 	if (vortex_channel_have_piggyback (channel))
 		vortex_frame_unref (vortex_channel_get_piggyback (channel));
@@ -8007,6 +9273,7 @@ void vortex_channel_free (VortexChannel * channel)
  
  	axl_list_free        (channel->outstanding_msg);
  	axl_list_cursor_free (channel->outstanding_msg_cursor);
+	axl_list_free        (channel->outstanding_stamps);
  	vortex_mutex_destroy (&channel->outstanding_msg_mutex);
 
 	/* more fixed indication */
@@ -8075,6 +9342,17 @@ void     vortex_channel_free_wait_reply (WaitReplyData * wait_reply)
 
 	/* perform dealloc operations if refcount reaches 0 */
 
+	/* wait reply embedded into a reply future: signal the reply
+	 * will not come (if it wasn't received) and release the
+	 * reference owned */
+	if (wait_reply->reply != NULL) {
+		vortex_mutex_unlock (&wait_reply->mutex);
+
+		__vortex_reply_signal (wait_reply->reply, NULL);
+		__vortex_reply_unref (wait_reply->reply);
+		return;
+	} /* end if */
+
 	/* free the queue */
 	while (vortex_async_queue_items (wait_reply->queue) > 0) {
 		/* get the frame and unref */
@@ -8708,6 +9986,342 @@ VortexFrame   * vortex_channel_wait_reply              (VortexChannel * channel,
 	return frame;
 }
 
+/** 
+ * @brief Sends a message and returns a reply future that allows to
+ * get the reply without blocking a thread per message.
+ *
+ * This works like \ref vortex_channel_send_msg_and_wait followed by
+ * \ref vortex_channel_wait_reply but, rather than blocking, a \ref
+ * VortexReply handle is returned that can be:
+ *
+ * - polled: \ref vortex_reply_is_ready
+ * - waited with a timeout: \ref vortex_reply_wait
+ * - waited together with other replies: \ref vortex_reply_wait_any
+ * - configured with a continuation: \ref vortex_reply_set_handler
+ *
+ * Reply futures are taken from a pool kept by the context so
+ * sending with this function in a loop doesn't allocate once the
+ * pool is warm. Here is an example:
+ *
+ * \code
+ * VortexReply * replies[2];
+ * VortexReply * reply;
+ *
+ * replies[0] = vortex_channel_send_msg_future (channel, "first", 5, NULL);
+ * replies[1] = vortex_channel_send_msg_future (channel2, "second", 6, NULL);
+ *
+ * // get the first reply received
+ * reply = vortex_reply_wait_any (replies, 2, 0);
+ * if (reply != NULL)
+ *     printf ("Received: %s\n", (char*) vortex_frame_get_payload (vortex_reply_get_frame (reply)));
+ *
+ * vortex_reply_release (replies[0]);
+ * vortex_reply_release (replies[1]);
+ * \endcode
+ *
+ * @param channel The channel where the message will be sent.
+ * @param message The message to send.
+ * @param message_size The message size.
+ * @param msg_no Optional reference to get the message number used.
+ *
+ * @return A new reply future that must be released with \ref
+ * vortex_reply_release or NULL if the message couldn't be sent.
+ */
+VortexReply   * vortex_channel_send_msg_future         (VortexChannel * channel,
+							const void    * message,
+							size_t          message_size,
+							int           * msg_no)
+{
+	VortexReply * reply;
+	VortexCtx   * ctx     = vortex_channel_get_ctx (channel);
+	axl_bool      watch;
+
+	if (channel == NULL)
+		return NULL;
+
+	if (! vortex_connection_is_ok (channel->connection, axl_false)) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "Unable to send message with reply future because the connection is not operational");
+		return NULL;
+	} /* end if */
+
+	/* get a reply future from the pool */
+	reply = __vortex_reply_new (ctx);
+	if (reply == NULL)
+		return NULL;
+
+	/* watch the connection (only once, no matter how many futures
+	 * are pending) to complete pending replies if it breaks */
+	vortex_mutex_lock (&ctx->reply_mutex);
+	watch = (vortex_connection_get_data (channel->connection, VORTEX_REPLY_WATCH) == NULL);
+	if (watch)
+		vortex_connection_set_data (channel->connection, VORTEX_REPLY_WATCH, INT_TO_PTR (axl_true));
+	vortex_mutex_unlock (&ctx->reply_mutex);
+	if (watch)
+		vortex_connection_set_on_close_full2 (channel->connection, __vortex_reply_connection_broken, axl_false, NULL);
+
+	if (! vortex_channel_send_msg_and_wait (channel, message, message_size, &reply->msg_no, &reply->wait)) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "Failed to send message with reply future over channel=%d", channel->channel_num);
+
+		/* release embedded wait reply (completing the reply
+		 * if it wasn't queued) and the caller reference */
+		vortex_channel_free_wait_reply (&reply->wait);
+		vortex_reply_release (reply);
+		return NULL;
+	} /* end if */
+
+	/* return back message no used */
+	if (msg_no != NULL)
+		(* msg_no) = reply->msg_no;
+
+	/* the connection may have broken before the reply was queued
+	 * (close handlers already executed) */
+	if (! vortex_connection_is_ok (channel->connection, axl_false))
+		__vortex_reply_signal (reply, NULL);
+
+	/* release our reference to the embedded wait reply: the
+	 * channel keeps its own until the reply is received */
+	vortex_channel_free_wait_reply (&reply->wait);
+
+	return reply;
+}
+
+/** 
+ * @brief Allows to check if the reply future was completed (either
+ * because the reply was received or because the connection was
+ * broken), without blocking.
+ *
+ * @param reply The reply future to check.
+ *
+ * @return axl_true if completed, otherwise axl_false is returned.
+ */
+axl_bool        vortex_reply_is_ready                  (VortexReply * reply)
+{
+	axl_bool result;
+
+	if (reply == NULL)
+		return axl_false;
+
+	vortex_mutex_lock (&reply->mutex);
+	result = reply->done;
+	vortex_mutex_unlock (&reply->mutex);
+
+	return result;
+}
+
+/** 
+ * @brief Returns the frame received for the reply future provided.
+ *
+ * @param reply The reply future to get the frame from.
+ *
+ * @return The reply frame (RPY or ERR) or NULL if the reply wasn't
+ * received yet or the connection was broken. The frame is owned by
+ * the reply future (use \ref vortex_frame_ref to keep it after \ref
+ * vortex_reply_release).
+ */
+VortexFrame   * vortex_reply_get_frame                 (VortexReply * reply)
+{
+	VortexFrame * frame;
+
+	if (reply == NULL)
+		return NULL;
+
+	vortex_mutex_lock (&reply->mutex);
+	frame = reply->frame;
+	vortex_mutex_unlock (&reply->mutex);
+
+	return frame;
+}
+
+/** 
+ * @brief Returns the message number the reply future is waiting
+ * for.
+ *
+ * @param reply The reply future.
+ *
+ * @return The message number or -1 if it fails.
+ */
+int             vortex_reply_get_msg_no                (VortexReply * reply)
+{
+	if (reply == NULL)
+		return -1;
+	return reply->msg_no;
+}
+
+/** 
+ * @brief Waits until any of the reply futures provided is completed.
+ *
+ * A single thread can use this function to wait for several
+ * outstanding replies, even sent over different channels and
+ * connections (as long as they belong to the same context). Only one
+ * thread should wait on a given reply future at a time.
+ *
+ * @param replies Array of reply futures to wait for. NULL entries
+ * are skipped.
+ *
+ * @param count Number of entries in replies.
+ *
+ * @param microseconds Max amount of time to wait. If 0 or less is
+ * provided the default connection timeout is used (\ref
+ * vortex_connection_get_timeout).
+ *
+ * @return The first reply future found completed or NULL if the
+ * timeout was reached. Note the reply returned could have been
+ * completed because the connection was broken (\ref
+ * vortex_reply_get_frame returns NULL in that case).
+ */
+VortexReply   * vortex_reply_wait_any                  (VortexReply ** replies,
+							int            count,
+							long           microseconds)
+{
+	VortexCtx         * ctx    = NULL;
+	VortexReply       * result = NULL;
+	VortexReply       * reply;
+	VortexReplyWaiter   waiter;
+	struct timeval      start;
+	struct timeval      now;
+	struct timeval      diff;
+	long                remaining;
+	int                 iterator;
+
+	if (replies == NULL || count <= 0)
+		return NULL;
+
+	/* get context from the first reply */
+	for (iterator = 0; iterator < count && ctx == NULL; iterator++) {
+		if (replies[iterator] != NULL)
+			ctx = replies[iterator]->ctx;
+	} /* end for */
+	if (ctx == NULL)
+		return NULL;
+
+	if (microseconds <= 0)
+		microseconds = vortex_connection_get_timeout (ctx);
+
+	vortex_mutex_create (&waiter.mutex);
+	vortex_cond_create (&waiter.cond);
+	waiter.signaled = axl_false;
+	gettimeofday (&start, NULL);
+
+	/* register as waiter on each reply, stopping at the first one
+	 * found completed */
+	for (iterator = 0; iterator < count && result == NULL; iterator++) {
+		reply = replies[iterator];
+		if (reply == NULL)
+			continue;
+		vortex_mutex_lock (&reply->mutex);
+		if (reply->done)
+			result = reply;
+		else
+			reply->waiter = &waiter;
+		vortex_mutex_unlock (&reply->mutex);
+	} /* end for */
+
+	while (result == NULL) {
+		/* check remaining time */
+		gettimeofday (&now, NULL);
+		vortex_timeval_substract (&now, &start, &diff);
+		remaining = microseconds - ((diff.tv_sec * 1000000) + diff.tv_usec);
+		if (remaining <= 0)
+			break;
+
+		/* wait for any reply to signal us */
+		vortex_mutex_lock (&waiter.mutex);
+		if (! waiter.signaled)
+			vortex_cond_timedwait (&waiter.cond, &waiter.mutex, remaining);
+		waiter.signaled = axl_false;
+		vortex_mutex_unlock (&waiter.mutex);
+
+		/* check for replies completed */
+		for (iterator = 0; iterator < count && result == NULL; iterator++) {
+			if (vortex_reply_is_ready (replies[iterator]))
+				result = replies[iterator];
+		} /* end for */
+	} /* end while */
+
+	/* unregister */
+	for (iterator = 0; iterator < count; iterator++) {
+		reply = replies[iterator];
+		if (reply == NULL)
+			continue;
+		vortex_mutex_lock (&reply->mutex);
+		if (reply->waiter == &waiter)
+			reply->waiter = NULL;
+		vortex_mutex_unlock (&reply->mutex);
+	} /* end for */
+
+	vortex_cond_destroy (&waiter.cond);
+	vortex_mutex_destroy (&waiter.mutex);
+	return result;
+}
+
+/** 
+ * @brief Waits for the reply future to be completed.
+ *
+ * @param reply The reply future to wait for.
+ *
+ * @param microseconds Max amount of time to wait. If 0 or less is
+ * provided the default connection timeout is used (\ref
+ * vortex_connection_get_timeout).
+ *
+ * @return The reply frame received or NULL if the timeout was reached
+ * or the connection was broken. The frame is owned by the reply
+ * future (see \ref vortex_reply_get_frame).
+ */
+VortexFrame   * vortex_reply_wait                      (VortexReply * reply,
+							long          microseconds)
+{
+	if (vortex_reply_wait_any (&reply, 1, microseconds) == NULL)
+		return NULL;
+	return vortex_reply_get_frame (reply);
+}
+
+/** 
+ * @brief Configures a continuation handler to be called once the
+ * reply future is completed.
+ *
+ * The handler is called from the vortex thread pool. If the reply
+ * was already completed, the handler is called by the caller thread
+ * before this function returns. The caller still owns its reference
+ * to the reply future (it can be released from inside the handler).
+ *
+ * @param reply The reply future to configure.
+ * @param handler The handler to be called.
+ * @param user_data User defined pointer passed to the handler.
+ */
+void            vortex_reply_set_handler               (VortexReply        * reply,
+							VortexReplyHandler   handler,
+							axlPointer           user_data)
+{
+	axl_bool done;
+
+	if (reply == NULL || handler == NULL)
+		return;
+
+	vortex_mutex_lock (&reply->mutex);
+	reply->handler      = handler;
+	reply->handler_data = user_data;
+	done                = reply->done;
+	vortex_mutex_unlock (&reply->mutex);
+
+	if (done)
+		handler (reply, reply->frame, user_data);
+	return;
+}
+
+/** 
+ * @brief Releases the reply future (and the frame it holds). The
+ * reply future is returned to the context pool for later reuse.
+ *
+ * @param reply The reply future to release.
+ */
+void            vortex_reply_release                   (VortexReply * reply)
+{
+	if (reply == NULL)
+		return;
+	__vortex_reply_unref (reply);
+	return;
+}
+
 /** 
  * @internal
  *
@@ -9106,6 +10720,7 @@ void                vortex_channel_init                           (VortexCtx * c
 	v_return_if_fail (ctx);
 
 	vortex_mutex_create (&ctx->channel_start_reply_cache_mutex);
+	vortex_mutex_create (&ctx->reply_mutex);
 
 	/* init hash only if it wasn't */
 	if (ctx->channel_start_reply_cache == NULL)
@@ -9122,12 +10737,25 @@ void                vortex_channel_init                           (VortexCtx * c
  */
 void                vortex_channel_cleanup                        (VortexCtx * ctx)
 {
+	VortexReply * reply;
+
 	v_return_if_fail (ctx);
 
 	vortex_mutex_destroy (&ctx->channel_start_reply_cache_mutex);
 	axl_hash_free (ctx->channel_start_reply_cache);
 	ctx->channel_start_reply_cache = NULL;
 
+	/* release reply futures pool */
+	while (ctx->reply_pool != NULL) {
+		reply           = ctx->reply_pool;
+		ctx->reply_pool = reply->next;
+		vortex_mutex_destroy (&reply->mutex);
+		vortex_mutex_destroy (&reply->wait.mutex);
+		axl_free (reply);
+	} /* end while */
+	ctx->reply_pool_size = 0;
+	vortex_mutex_destroy (&ctx->reply_mutex);
+
 	return;
 }
 
@@ -125,6 +125,8 @@ void               vortex_channel_set_complete_flag            (VortexChannel *
 void               vortex_channel_set_complete_frame_limit     (VortexChannel * channel,
 								int             max_payload_size);
 
+int                vortex_channel_get_complete_frame_limit     (VortexChannel * channel);
+
 axl_bool           vortex_channel_have_previous_frame          (VortexChannel * channel);
 
 VortexFrame      * vortex_channel_get_previous_frame           (VortexChannel * channel);
@@ -137,6 +139,26 @@ VortexFrame      * vortex_channel_build_single_pending_frame   (VortexChannel *
 
 axl_bool           vortex_channel_have_complete_flag           (VortexChannel * channel);
 
+axlPointer         vortex_channel_get_profile_cache            (VortexChannel     * channel,
+								int               * epoch);
+
+void               vortex_channel_set_profile_cache            (VortexChannel     * channel,
+								axlPointer          profile,
+								int                 epoch);
+
+VortexMetricsSeries * vortex_channel_get_metrics_series        (VortexChannel     * channel);
+
+axl_bool           vortex_channel_set_payload_sink             (VortexChannel     * channel,
+								VortexPayloadSink * sink);
+
+VortexPayloadSink * vortex_channel_get_payload_sink            (VortexChannel     * channel);
+
+axl_bool           vortex_channel_payload_sink_accepts         (VortexChannel     * channel,
+								VortexFrame       * frame);
+
+void               vortex_channel_payload_sink_write           (VortexChannel     * channel,
+								VortexFrame       * frame);
+
 void               vortex_channel_update_status                (VortexChannel * channel, 
 								unsigned int    frame_size,
 								int             msg_no,
@@ -211,9 +233,17 @@ axl_bool           vortex_channel_update_incoming_buffer       (VortexChannel *
 								unsigned int  * ackno,
 								int           * window);
 
+axl_bool           vortex_channel_notify_incoming_buffer       (VortexChannel * channel, 
+								VortexFrame   * frame,
+								char          * buffer);
+
 void               vortex_channel_queue_pending_message        (VortexChannel * channel,
 								axlPointer      message);
 
+void               vortex_channel_queue_pending_messages       (VortexChannel * channel,
+								axlPointer    * messages,
+								int             count);
+
 axl_bool           vortex_channel_is_empty_pending_message     (VortexChannel * channel);
 
 axlPointer         vortex_channel_next_pending_message         (VortexChannel * channel);
@@ -274,6 +304,11 @@ axl_bool           vortex_channel_send_msgv                       (VortexChannel
 								   const char    * format,
 								   ...);
 
+axl_bool           vortex_channel_send_msg_batch                  (VortexChannel      * channel,
+								   VortexMessageEntry * entries,
+								   int                  count,
+								   int                * first_msg_no);
+
 axl_bool           vortex_channel_send_msg_and_wait               (VortexChannel     * channel,
 								   const void        * message,
 								   size_t              message_size,
@@ -381,6 +416,30 @@ axl_bool           vortex_channel_wait_reply_ref                 (WaitReplyData
 
 void               vortex_channel_free_wait_reply                (WaitReplyData * wait_reply);
 
+VortexReply      * vortex_channel_send_msg_future                (VortexChannel * channel,
+								  const void    * message,
+								  size_t          message_size,
+								  int           * msg_no);
+
+axl_bool           vortex_reply_is_ready                         (VortexReply * reply);
+
+VortexFrame      * vortex_reply_get_frame                        (VortexReply * reply);
+
+int                vortex_reply_get_msg_no                       (VortexReply * reply);
+
+VortexReply      * vortex_reply_wait_any                         (VortexReply ** replies,
+								  int            count,
+								  long           microseconds);
+
+VortexFrame      * vortex_reply_wait                             (VortexReply * reply,
+								  long          microseconds);
+
+void               vortex_reply_set_handler                      (VortexReply        * reply,
+								  VortexReplyHandler   handler,
+								  axlPointer           user_data);
+
+void               vortex_reply_release                          (VortexReply * reply);
+
 axl_bool           vortex_channel_is_ready                       (VortexChannel * channel);
 
 void               vortex_channel_queue_reply                    (VortexChannel    * channel,
@@ -481,6 +540,8 @@ axl_bool            vortex_channel_check_incoming_seqno            (VortexChanne
 
 axl_bool            vortex_channel_is_stalled                      (VortexChannel  * channel);
 
+void                __vortex_channel_stall_begin                   (VortexChannel  * channel);
+
 axl_bool            vortex_channel_remove_first_pending_msg_no     (VortexChannel * channel, 
  								    int             msg_no_rpy);
 
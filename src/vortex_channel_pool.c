@@ -39,6 +39,10 @@
 #include <vortex.h>
 #define LOG_DOMAIN "vortex-channel-pool"
 
+/* max period (seconds) used to check for idle channels, so the
+ * period in microseconds fits into a 32 bits long */
+#define VORTEX_CHANNEL_POOL_SHRINK_MAX_PERIOD 1800
+
 
 /**
  * \defgroup vortex_channel_pool Vortex Channel Pool: Channel Pool management function.
@@ -50,6 +54,37 @@
  */
 
 
+/* node that tracks each channel inside the pool, allowing to keep
+ * channels not in use (idle) on a list that is updated in O(1) when
+ * channels are acquired and released */
+typedef struct _VortexChannelPoolItem VortexChannelPoolItem;
+struct _VortexChannelPoolItem {
+	VortexChannel          * channel;
+
+	/* links on the idle list */
+	VortexChannelPoolItem  * next;
+	VortexChannelPoolItem  * previous;
+	axl_bool                 idle;
+
+	/* the thread that released the channel the last time */
+	axlPointer               thread_key;
+
+	/* when the channel was placed on the idle list */
+	struct timeval           idle_since;
+};
+
+/* additional connection used by a channel pool (see
+ * vortex_channel_pool_add_connection) */
+typedef struct _VortexChannelPoolMember {
+	VortexConnection       * connection;
+
+	/* the pool created on the connection or -1 if none */
+	int                      pool_id;
+
+	/* axl_true while the connection is being reconnected */
+	axl_bool                 reconnecting;
+} VortexChannelPoolMember;
+
 /* the channel pool type */
 struct _VortexChannelPool {
 	/* the unique channel pool identifier */
@@ -77,6 +112,50 @@ struct _VortexChannelPool {
 	/* create channel handler */
 	VortexChannelPoolCreate  create_channel;
 	axlPointer               create_channel_user_data;
+
+	/* items for all channels in the pool, indexed by channel
+	 * number */
+	axlHash                * items;
+
+	/* channels not in use, the most recently released first */
+	VortexChannelPoolItem  * idle_first;
+
+	/* per-thread affinity: last item released by each thread */
+	axl_bool                 thread_affinity;
+	axlHash                * affinity;
+	int                      idle_count;
+
+	/* growth and shrink policy (see vortex_channel_pool_set_policy) */
+	int                      min_channels;
+	int                      max_channels;
+	int                      target_idle;
+	long                     idle_timeout;
+
+	/* channels being created (room reserved inside the pool,
+	 * see __vortex_channel_pool_reserve), updated with the pool
+	 * lock acquired */
+	int                      growing;
+
+	/* axl_true if the idle shrink event is installed */
+	axl_bool                 shrinking;
+
+	/* time waited to get channels (see
+	 * vortex_channel_pool_get_wait_histogram) */
+	long                     wait_histogram[VORTEX_CHANNEL_POOL_WAIT_BUCKETS];
+
+	/* references to the pool, which is released once the pool is
+	 * closed and background tasks are finished */
+	int                      ref_count;
+	VortexMutex              ref_mutex;
+
+	/* channels acquired (not released yet) */
+	int                      in_use;
+
+	/* additional connections (VortexChannelPoolMember) the pool
+	 * spans, or NULL, and the pool that created this one as a
+	 * member */
+	axlList                * members;
+	VortexChannelPool      * parent;
 };
 
 
@@ -122,6 +201,228 @@ axl_bool      __vortex_channel_pool_is_ready (VortexChannel * channel)
 		(vortex_channel_get_data (channel, "status_busy") == NULL));
 }
 
+/** 
+ * @internal Places the item provided at the head of the idle
+ * list. Must be called with the channel pool lock acquired.
+ */
+void __vortex_channel_pool_idle_push (VortexChannelPool * pool, VortexChannelPoolItem * item)
+{
+	if (item->idle)
+		return;
+
+	item->previous = NULL;
+	item->next     = pool->idle_first;
+	if (pool->idle_first != NULL)
+		pool->idle_first->previous = item;
+	pool->idle_first = item;
+	item->idle       = axl_true;
+	pool->idle_count++;
+	gettimeofday (&item->idle_since, NULL);
+
+	return;
+}
+
+/** 
+ * @internal Removes the item provided from the idle list. Must be
+ * called with the channel pool lock acquired.
+ */
+void __vortex_channel_pool_idle_unlink (VortexChannelPool * pool, VortexChannelPoolItem * item)
+{
+	if (! item->idle)
+		return;
+
+	if (item->previous != NULL)
+		item->previous->next = item->next;
+	else
+		pool->idle_first     = item->next;
+	if (item->next != NULL)
+		item->next->previous = item->previous;
+	item->next     = NULL;
+	item->previous = NULL;
+	item->idle     = axl_false;
+	pool->idle_count--;
+
+	return;
+}
+
+/** 
+ * @internal Returns the item associated to the channel or NULL if
+ * the channel is not in the pool. Must be called with the channel
+ * pool lock acquired.
+ */
+VortexChannelPoolItem * __vortex_channel_pool_item_get (VortexChannelPool * pool, VortexChannel * channel)
+{
+	return axl_hash_get (pool->items, INT_TO_PTR (vortex_channel_get_number (channel)));
+}
+
+/** 
+ * @internal Registers a channel added to the pool, which is
+ * available to be used (idle). Must be called with the channel pool
+ * lock acquired.
+ */
+VortexChannelPoolItem * __vortex_channel_pool_item_add (VortexChannelPool * pool, VortexChannel * channel)
+{
+	VortexChannelPoolItem * item;
+
+	item          = axl_new (VortexChannelPoolItem, 1);
+	item->channel = channel;
+	axl_hash_insert_full (pool->items, INT_TO_PTR (vortex_channel_get_number (channel)), NULL, item, axl_free);
+
+	/* available to be used */
+	__vortex_channel_pool_idle_push (pool, item);
+	return item;
+}
+
+/** 
+ * @internal Unregisters a channel removed from the pool. Must be
+ * called with the channel pool lock acquired.
+ */
+void __vortex_channel_pool_item_remove (VortexChannelPool * pool, VortexChannel * channel)
+{
+	VortexChannelPoolItem * item = __vortex_channel_pool_item_get (pool, channel);
+
+	if (item == NULL)
+		return;
+
+	/* remove from idle list and affinity references */
+	if (! item->idle)
+		pool->in_use--;
+	__vortex_channel_pool_idle_unlink (pool, item);
+	if (item->thread_key != NULL && axl_hash_get (pool->affinity, item->thread_key) == item)
+		axl_hash_remove (pool->affinity, item->thread_key);
+
+	/* release the item */
+	axl_hash_remove (pool->items, INT_TO_PTR (vortex_channel_get_number (channel)));
+	return;
+}
+
+/** 
+ * @internal Acquires the item provided, removing it from the idle
+ * list. Must be called with the channel pool lock acquired.
+ */
+VortexChannel * __vortex_channel_pool_item_acquire (VortexChannelPool * pool, VortexChannelPoolItem * item)
+{
+	__vortex_channel_pool_idle_unlink (pool, item);
+	pool->in_use++;
+
+	/* flag this channel to be busy */
+	vortex_channel_set_data (item->channel, "status_busy", INT_TO_PTR (axl_true));
+	return item->channel;
+}
+
+/** 
+ * @internal Selects the next channel ready to be used from the idle
+ * list (checking first the channel last released by the calling
+ * thread, if thread affinity is enabled), flagging it as busy. Must
+ * be called with the channel pool lock acquired.
+ *
+ * Because channels released are usually ready, the channel at the
+ * head of the list is usually selected, without walking the rest of
+ * the pool.
+ *
+ * @return The channel acquired or NULL if no channel is ready.
+ */
+VortexChannel * __vortex_channel_pool_acquire (VortexChannelPool * pool)
+{
+	VortexChannelPoolItem * item;
+
+	/* check the channel last used by this thread */
+	if (pool->thread_affinity) {
+		item = axl_hash_get (pool->affinity, __vortex_thread_self_key ());
+		if (item != NULL && item->idle && __vortex_channel_pool_is_ready (item->channel))
+			return __vortex_channel_pool_item_acquire (pool, item);
+	} /* end if */
+
+	/* get the first idle channel ready to be used (idle channels
+	 * may be waiting for replies or being closed) */
+	item = pool->idle_first;
+	while (item != NULL) {
+		if (__vortex_channel_pool_is_ready (item->channel))
+			return __vortex_channel_pool_item_acquire (pool, item);
+		item = item->next;
+	} /* end while */
+
+	return NULL;
+}
+
+/** 
+ * @internal
+ *
+ * Creates a new channel with the pool configuration (not adding it
+ * to the pool).
+ *
+ * @param pool The pool the channel is created for.
+ *
+ * @param connection The connection where the channel is created.
+ *
+ * @param user_data User defined data to be passed to the create
+ * channel handler.
+ *
+ * @return The channel created or NULL if it fails.
+ */
+VortexChannel * __vortex_channel_pool_create_channel (VortexChannelPool * pool, VortexConnection * connection, axlPointer user_data)
+{
+	VortexChannel  * channel  = NULL;
+
+	/* check if the channel creation handler is defined */
+	if (pool->create_channel != NULL) {
+		/* call to create */
+		channel = pool->create_channel (connection,
+						/* channel num (let vortex to pick one for us) */
+						0,
+						pool->profile,
+						/* close handler stuff */
+						pool->close, pool->close_user_data,
+						/* received handler stuff */
+						pool->received, pool->received_user_data,
+						/* the following the user data pointer defined at vortex_channel_pool_new_full */
+						pool->create_channel_user_data,
+						/* the following is an optional pointer defined at vortex_channel_pool_get_next_ready_full */
+						user_data);
+						
+
+	} else {
+		/* create the channel */
+		channel = vortex_channel_new (connection, 
+					      /* channel num (let vortex to pick one for us) */
+					      0,
+					      pool->profile,
+					      /* close handler stuff */
+					      pool->close, pool->close_user_data,
+					      /* received handler stuff */
+					      pool->received, pool->received_user_data,
+					      /* on created handler not defined */
+					      NULL, NULL);
+	} /* end if */
+
+	return channel;
+}
+
+/** 
+ * @internal Reserves room for <b>num</b> channels about to be created
+ * for the pool, accounting them as being created (growing). This is
+ * the only place where the max channels configured is enforced. Must
+ * be called with the channel pool lock acquired.
+ *
+ * @return The number of channels that can be created (room
+ * reserved), which can be less than requested.
+ */
+int __vortex_channel_pool_reserve (VortexChannelPool * pool, int num)
+{
+	int available;
+
+	if (pool->max_channels > 0) {
+		available = pool->max_channels - (axl_list_length (pool->channels) + pool->growing);
+		if (num > available)
+			num = available;
+	} /* end if */
+	if (num <= 0)
+		return 0;
+
+	pool->growing += num;
+	return num;
+}
+
 /** 
  * @internal
  * 
@@ -146,38 +447,16 @@ VortexChannel * __vortex_channel_pool_add_channels (VortexChannelPool * pool, in
 	VortexCtx      * ctx      = vortex_connection_get_ctx (pool->connection);
 #endif
 
+	/* reserve room for the channels (never exceeding the max
+	 * channels configured) */
+	vortex_connection_lock_channel_pool (pool->connection);
+	init_num = __vortex_channel_pool_reserve (pool, init_num);
+	vortex_connection_unlock_channel_pool (pool->connection);
+
 	/* start channels */
 	while (iterator < init_num) {
-		/* check if the channel creation handler is defined */
-		if (pool->create_channel != NULL) {
-			/* call to create */
-			channel = pool->create_channel (pool->connection,
-							/* channel num (let vortex to pick one for us) */
-							0,
-							pool->profile,
-							/* close handler stuff */
-							pool->close, pool->close_user_data,
-							/* received handler stuff */
-							pool->received, pool->received_user_data,
-							/* the following the user data pointer defined at vortex_channel_pool_new_full */
-							pool->create_channel_user_data,
-							/* the following is an optional pointer defined at vortex_channel_pool_get_next_ready_full */
-							user_data);
-							
-
-		} else {
-			/* create the channel */
-			channel = vortex_channel_new (pool->connection, 
-						      /* channel num (let vortex to pick one for us) */
-						      0,
-						      pool->profile,
-						      /* close handler stuff */
-						      pool->close, pool->close_user_data,
-						      /* received handler stuff */
-						      pool->received, pool->received_user_data,
-						      /* on created handler not defined */
-						      NULL, NULL);
-		} /* end if */
+		/* create the channel */
+		channel = __vortex_channel_pool_create_channel (pool, pool->connection, user_data);
 		
 		/* check if the channel have been created if not
 		 * break-the-loop */ 
@@ -194,7 +473,9 @@ VortexChannel * __vortex_channel_pool_add_channels (VortexChannelPool * pool, in
 		/* lock */
 		vortex_connection_lock_channel_pool (pool->connection);
 
+		pool->growing--;
 		axl_list_append (pool->channels, channel);
+		__vortex_channel_pool_item_add (pool, channel);
 
 		/* unlock */
 		vortex_connection_unlock_channel_pool (pool->connection);
@@ -206,11 +487,262 @@ VortexChannel * __vortex_channel_pool_add_channels (VortexChannelPool * pool, in
 		iterator++;
 	}
 
+	/* release room reserved for channels not created */
+	if (iterator < init_num) {
+		vortex_connection_lock_channel_pool (pool->connection);
+		pool->growing -= (init_num - iterator);
+		vortex_connection_unlock_channel_pool (pool->connection);
+	} /* end if */
+
 	vortex_log (VORTEX_LEVEL_DEBUG, "channels added %d to the pool id=%d", iterator, pool->id);
 	
 	return channel;
 }
 
+/** 
+ * @internal Increases the references to the pool.
+ */
+void __vortex_channel_pool_ref (VortexChannelPool * pool)
+{
+	vortex_mutex_lock (&pool->ref_mutex);
+	pool->ref_count++;
+	vortex_mutex_unlock (&pool->ref_mutex);
+	return;
+}
+
+/** 
+ * @internal Decreases the references to the pool, releasing it once
+ * the last one is dropped (the pool must be already closed).
+ */
+void __vortex_channel_pool_unref (VortexChannelPool * pool)
+{
+	axl_bool release;
+
+	vortex_mutex_lock (&pool->ref_mutex);
+	pool->ref_count--;
+	release = (pool->ref_count == 0);
+	vortex_mutex_unlock (&pool->ref_mutex);
+
+	if (! release)
+		return;
+
+	vortex_mutex_destroy (&pool->ref_mutex);
+	if (pool->members != NULL)
+		axl_list_free (pool->members);
+	axl_list_free (pool->channels);
+	axl_hash_free (pool->affinity);
+	axl_hash_free (pool->items);
+	axl_free (pool->profile);
+	axl_free (pool);
+	return;
+}
+
+/** 
+ * @internal Returns a reference to the pool connection (that must be
+ * released with vortex_connection_unref) or NULL if the pool is
+ * closed or the connection is not working. Used by background tasks
+ * which can't assume the pool connection to be available.
+ */
+VortexConnection * __vortex_channel_pool_connection_ref (VortexChannelPool * pool)
+{
+	VortexConnection * connection;
+
+	vortex_mutex_lock (&pool->ref_mutex);
+	connection = pool->connection;
+	if (connection != NULL && ! vortex_connection_ref (connection, "channel pool task"))
+		connection = NULL;
+	vortex_mutex_unlock (&pool->ref_mutex);
+
+	return connection;
+}
+
+/** 
+ * @internal Background task that creates a channel, adding it to the
+ * pool as idle.
+ */
+axlPointer __vortex_channel_pool_grow_task (VortexChannelPool * pool)
+{
+	VortexConnection * connection = __vortex_channel_pool_connection_ref (pool);
+	VortexChannel    * channel    = NULL;
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+	VortexCtx        * ctx;
+#endif
+
+	/* create the channel */
+	if (connection != NULL)
+		channel = __vortex_channel_pool_create_channel (pool, connection, NULL);
+
+	if (connection != NULL) {
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+		ctx = vortex_connection_get_ctx (connection);
+#endif
+		vortex_connection_lock_channel_pool (connection);
+		pool->growing--;
+		if (channel != NULL && pool->connection != NULL) {
+			/* add the channel to the pool */
+			vortex_channel_ref2 (channel, "channel pool");
+			axl_list_append (pool->channels, channel);
+			__vortex_channel_pool_item_add (pool, channel);
+			vortex_channel_set_pool (channel, pool);
+
+			vortex_log (VORTEX_LEVEL_DEBUG, "channel id=%d created in background for pool id=%d",
+				    vortex_channel_get_number (channel), pool->id);
+			channel = NULL;
+		} /* end if */
+		vortex_connection_unlock_channel_pool (connection);
+
+		/* the pool was closed while the channel was created */
+		if (channel != NULL)
+			vortex_channel_close (channel, NULL);
+		vortex_connection_unref (connection, "channel pool task");
+	} /* end if */
+
+	/* without connection, the pool was closed (growing is no
+	 * longer used and the pool can't be locked) */
+
+	__vortex_channel_pool_unref (pool);
+	return NULL;
+}
+
+/** 
+ * @internal Starts creating channels in background (in parallel)
+ * when the pool has fewer idle channels than the target configured,
+ * or fewer channels than the minimum, without exceeding the
+ * maximum. Must be called with the channel pool lock acquired.
+ */
+void __vortex_channel_pool_grow (VortexChannelPool * pool)
+{
+	VortexCtx * ctx;
+	int         total;
+	int         needed;
+
+	if (pool->connection == NULL || (pool->min_channels == 0 && pool->target_idle == 0))
+		return;
+
+	/* channels created or being created */
+	total  = axl_list_length (pool->channels) + pool->growing;
+	needed = pool->target_idle - (pool->idle_count + pool->growing);
+	if (needed < pool->min_channels - total)
+		needed = pool->min_channels - total;
+
+	/* reserve room for them (limited by max channels) */
+	needed = __vortex_channel_pool_reserve (pool, needed);
+
+	ctx = vortex_connection_get_ctx (pool->connection);
+	while (needed > 0) {
+		vortex_log (VORTEX_LEVEL_DEBUG, "growing pool id=%d in background (channels=%d, idle=%d, growing=%d)",
+			    pool->id, axl_list_length (pool->channels), pool->idle_count, pool->growing);
+
+		/* the task holds a reference to the pool */
+		__vortex_channel_pool_ref (pool);
+		vortex_thread_pool_new_task (ctx, (VortexThreadFunc) __vortex_channel_pool_grow_task, pool);
+
+		needed--;
+	} /* end while */
+
+	return;
+}
+
+/** 
+ * @internal Task that closes the channels (list) removed from a pool
+ * by the idle shrink event, which can't block the thread pool event
+ * thread.
+ */
+axlPointer __vortex_channel_pool_close_task (axlList * expired)
+{
+	VortexChannel * channel;
+	int             iterator;
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+	VortexCtx     * ctx;
+#endif
+
+	for (iterator = 0; iterator < axl_list_length (expired); iterator++) {
+		channel = axl_list_get_nth (expired, iterator);
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+		ctx     = vortex_channel_get_ctx (channel);
+#endif
+		vortex_log (VORTEX_LEVEL_DEBUG, "closing idle channel id=%d removed from its pool",
+			    vortex_channel_get_number (channel));
+		vortex_channel_close (channel, NULL);
+		vortex_channel_unref2 (channel, "channel pool");
+	} /* end for */
+
+	axl_list_free (expired);
+	return NULL;
+}
+
+/** 
+ * @internal Event that closes channels idle for longer than the
+ * timeout configured, keeping at least the minimum channels and the
+ * target idle channels configured.
+ */
+axl_bool __vortex_channel_pool_shrink_event (VortexCtx * ctx, axlPointer _pool, axlPointer user_data2)
+{
+	VortexChannelPool     * pool       = _pool;
+	VortexConnection      * connection = __vortex_channel_pool_connection_ref (pool);
+	VortexChannelPoolItem * item;
+	VortexChannelPoolItem * next;
+	VortexChannel         * channel;
+	axlList               * expired;
+	struct timeval          now;
+	struct timeval          idle;
+	int                     removable;
+
+	/* the pool was closed */
+	if (connection == NULL) {
+		__vortex_channel_pool_unref (pool);
+		return axl_true;
+	} /* end if */
+
+	gettimeofday (&now, NULL);
+	expired = axl_list_new (axl_list_always_return_1, NULL);
+
+	vortex_connection_lock_channel_pool (connection);
+	if (pool->idle_timeout <= 0) {
+		/* policy disabled */
+		pool->shrinking = axl_false;
+		vortex_connection_unlock_channel_pool (connection);
+		axl_list_free (expired);
+		vortex_connection_unref (connection, "channel pool task");
+		__vortex_channel_pool_unref (pool);
+		return axl_true;
+	} /* end if */
+
+	/* channels that can be closed */
+	removable = axl_list_length (pool->channels) - pool->min_channels;
+	if (removable > pool->idle_count - pool->target_idle)
+		removable = pool->idle_count - pool->target_idle;
+
+	item = pool->idle_first;
+	while (item != NULL && removable > 0) {
+		next = item->next;
+		vortex_timeval_substract (&now, &item->idle_since, &idle);
+		if (idle.tv_sec >= pool->idle_timeout && __vortex_channel_pool_is_ready (item->channel)) {
+			/* remove the channel from the pool */
+			channel = item->channel;
+			__vortex_channel_pool_item_remove (pool, channel);
+			axl_list_unlink_ptr (pool->channels, channel);
+			vortex_channel_set_pool (channel, NULL);
+			axl_list_append (expired, channel);
+			removable--;
+		} /* end if */
+		item = next;
+	} /* end while */
+	vortex_connection_unlock_channel_pool (connection);
+
+	/* close channels removed (outside the event thread, channel
+	 * close blocks until the remote peer replies) */
+	if (axl_list_length (expired) > 0) {
+		vortex_log (VORTEX_LEVEL_DEBUG, "closing %d idle channels from pool id=%d",
+			    axl_list_length (expired), pool->id);
+		vortex_thread_pool_new_task (ctx, (VortexThreadFunc) __vortex_channel_pool_close_task, expired);
+	} else
+		axl_list_free (expired);
+
+	vortex_connection_unref (connection, "channel pool task");
+	return axl_false;
+}
+
 /** 
  * @internal
  *
@@ -268,6 +800,10 @@ axlPointer __vortex_channel_pool_new (VortexChannelPoolData * data)
 	channel_pool->create_channel           = create_channel;
 	channel_pool->create_channel_user_data = create_channel_user_data;
 	channel_pool->channels                 = axl_list_new (axl_list_always_return_1, NULL);
+	channel_pool->items                    = axl_hash_new (axl_hash_int, axl_hash_equal_int);
+	channel_pool->affinity                 = axl_hash_new (axl_hash_int, axl_hash_equal_int);
+	channel_pool->ref_count                = 1;
+	vortex_mutex_create (&channel_pool->ref_mutex);
 
 	/* init: create channels for the pool */
 	__vortex_channel_pool_add_channels (channel_pool, init_num, NULL);
@@ -605,14 +1141,21 @@ axl_bool  __count_ready (axlPointer channel, int * _count)
  */
 int                 vortex_channel_pool_get_available_num (VortexChannelPool * pool)
 {
-	int  num = 0;
+	int                     num = 0;
+	VortexChannelPoolItem * item;
+
 	if (pool == NULL)
 		return -1;
 
 	vortex_connection_lock_channel_pool   (pool->connection);
 
-	/* count all ready channels at this moment */
-	axl_list_lookup (pool->channels, (axlLookupFunc) __count_ready, &num);
+	/* count all ready channels at this moment (only channels not
+	 * in use are checked) */
+	item = pool->idle_first;
+	while (item != NULL) {
+		__count_ready (item->channel, &num);
+		item = item->next;
+	} /* end while */
 
 	vortex_connection_unlock_channel_pool (pool->connection);
 
@@ -722,6 +1265,7 @@ void __vortex_channel_pool_remove (VortexChannelPool * pool, int  num)
 			
 			/* remove the channel from the channel pool */
 			axl_list_cursor_unlink (cursor);
+			__vortex_channel_pool_item_remove (pool, channel);
 
 			/* remove the channel from the pool after calling to close */
 			vortex_channel_set_pool (channel, NULL);
@@ -778,6 +1322,217 @@ void                vortex_channel_pool_remove         (VortexChannelPool * pool
 	return;
 }
 
+/** 
+ * @internal Creates the pool used on an additional connection, with
+ * the same configuration as the parent pool.
+ *
+ * @return The pool created or NULL if it fails.
+ */
+VortexChannelPool * __vortex_channel_pool_new_member (VortexChannelPool * parent, VortexConnection * connection, int init_num)
+{
+	VortexChannelPool * pool;
+
+	pool = vortex_channel_pool_new_full (connection, parent->profile, init_num,
+					     parent->create_channel, parent->create_channel_user_data,
+					     parent->close, parent->close_user_data,
+					     parent->received, parent->received_user_data,
+					     /* create the pool in a blocking manner */
+					     NULL, NULL);
+	if (pool == NULL)
+		return NULL;
+
+	/* configure it like the parent */
+	pool->parent          = parent;
+	pool->thread_affinity = parent->thread_affinity;
+	return pool;
+}
+
+/** 
+ * @internal Releases an additional connection record.
+ */
+void __vortex_channel_pool_member_free (axlPointer _member)
+{
+	VortexChannelPoolMember * member = _member;
+
+	vortex_connection_unref (member->connection, "channel pool member");
+	axl_free (member);
+	return;
+}
+
+/** 
+ * @internal Data passed to reconnect additional connections.
+ */
+typedef struct _VortexChannelPoolReconnect {
+	VortexChannelPool       * pool;
+	VortexChannelPoolMember * member;
+} VortexChannelPoolReconnect;
+
+/** 
+ * @internal Background task that reconnects an additional connection
+ * lost unexpectedly, creating again the pool on it (pools are removed
+ * on reconnect). It is also used to create again the pool on a
+ * working connection where it failed to be created.
+ */
+axlPointer __vortex_channel_pool_reconnect_task (VortexChannelPoolReconnect * data)
+{
+	VortexChannelPool       * pool       = data->pool;
+	VortexChannelPoolMember * member     = data->member;
+	VortexConnection        * connection = __vortex_channel_pool_connection_ref (pool);
+	VortexChannelPool       * created    = NULL;
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+	VortexCtx               * ctx        = vortex_connection_get_ctx (member->connection);
+#endif
+
+	axl_free (data);
+
+	/* reconnect unless the pool was closed */
+	if (connection != NULL) {
+		vortex_log (VORTEX_LEVEL_WARNING, "restoring connection id=%d used by pool id=%d",
+			    vortex_connection_get_id (member->connection), pool->id);
+		if (vortex_connection_is_ok (member->connection, axl_false) ||
+		    vortex_connection_reconnect (member->connection, NULL, NULL))
+			created = __vortex_channel_pool_new_member (pool, member->connection, 1);
+
+		/* update the member */
+		vortex_connection_lock_channel_pool (connection);
+		member->pool_id      = created ? vortex_channel_pool_get_id (created) : -1;
+		member->reconnecting = axl_false;
+		vortex_connection_unlock_channel_pool (connection);
+
+		vortex_connection_unref (connection, "channel pool task");
+	} /* end if */
+
+	__vortex_channel_pool_unref (pool);
+	return NULL;
+}
+
+/** 
+ * @internal Returns the pool to be used to get the next channel: the
+ * one, among the pool and the pools on its additional connections,
+ * with fewer channels in use. Additional connections lost
+ * unexpectedly are skipped and reconnected in background, while
+ * those closed on purpose (\ref vortex_connection_close on the
+ * connection or \ref vortex_channel_pool_close on its pool) are
+ * removed.
+ *
+ * The pool is returned with a reference acquired (under the pool
+ * lock) that the caller must release with \ref
+ * __vortex_channel_pool_unref once done with it.
+ */
+VortexChannelPool * __vortex_channel_pool_select (VortexChannelPool * pool)
+{
+	VortexChannelPool          * selected = NULL;
+	VortexChannelPool          * candidate;
+	VortexChannelPoolMember    * member;
+	VortexChannelPoolReconnect * data;
+	axlList                    * removed  = NULL;
+	axl_bool                     is_ok;
+	int                          iterator;
+
+	if (pool->connection == NULL) {
+		__vortex_channel_pool_ref (pool);
+		return pool;
+	} /* end if */
+
+	/* the pool itself */
+	if (vortex_connection_is_ok (pool->connection, axl_false))
+		selected = pool;
+
+	vortex_connection_lock_channel_pool (pool->connection);
+	for (iterator = 0; iterator < axl_list_length (pool->members); iterator++) {
+		member = axl_list_get_nth (pool->members, iterator);
+		if (member->reconnecting)
+			continue;
+
+		/* check the connection is working */
+		candidate = NULL;
+		is_ok     = vortex_connection_is_ok (member->connection, axl_false);
+		if (is_ok)
+			candidate = vortex_connection_get_channel_pool (member->connection, member->pool_id);
+
+		/* closed on purpose: remove it (released once the
+		 * lock is released) */
+		if (candidate == NULL &&
+		    ((is_ok && member->pool_id != -1) ||
+		     (! is_ok && vortex_connection_get_status (member->connection) == VortexConnectionCloseCalled))) {
+			if (removed == NULL)
+				removed = axl_list_new (axl_list_always_return_1, __vortex_channel_pool_member_free);
+			axl_list_unlink_ptr (pool->members, member);
+			axl_list_append (removed, member);
+			iterator--;
+			continue;
+		} /* end if */
+
+		if (candidate == NULL) {
+			/* reconnect in background */
+			data                 = axl_new (VortexChannelPoolReconnect, 1);
+			data->pool           = pool;
+			data->member         = member;
+			member->reconnecting = axl_true;
+			__vortex_channel_pool_ref (pool);
+			vortex_thread_pool_new_task (vortex_connection_get_ctx (pool->connection),
+						     (VortexThreadFunc) __vortex_channel_pool_reconnect_task, data);
+			continue;
+		} /* end if */
+
+		/* select the one with fewer channels in use */
+		if (selected == NULL || candidate->in_use < selected->in_use)
+			selected = candidate;
+	} /* end for */
+
+	/* acquire a reference to the pool selected before releasing
+	 * the lock */
+	if (selected == NULL)
+		selected = pool;
+	__vortex_channel_pool_ref (selected);
+	vortex_connection_unlock_channel_pool (pool->connection);
+
+	/* release members removed */
+	if (removed != NULL)
+		axl_list_free (removed);
+
+	return selected;
+}
+
+/** 
+ * @internal Closes pools created on additional connections and
+ * releases references to them (called while the pool is closed).
+ * Member pools are collected with the pool lock acquired but closed
+ * after releasing it (closing them blocks).
+ */
+void __vortex_channel_pool_close_members (VortexChannelPool * pool, VortexConnection * connection)
+{
+	VortexChannelPoolMember * member;
+	VortexChannelPool       * member_pool;
+	axlList                 * member_pools;
+	int                       iterator;
+
+	member_pools = axl_list_new (axl_list_always_return_1, NULL);
+	vortex_connection_lock_channel_pool (connection);
+	for (iterator = 0; iterator < axl_list_length (pool->members); iterator++) {
+		member = axl_list_get_nth (pool->members, iterator);
+
+		/* get the pool (if it was not removed) */
+		member_pool = vortex_connection_get_channel_pool (member->connection, member->pool_id);
+		if (member_pool != NULL) {
+			__vortex_channel_pool_ref (member_pool);
+			axl_list_append (member_pools, member_pool);
+		} /* end if */
+		member->pool_id = -1;
+	} /* end for */
+	vortex_connection_unlock_channel_pool (connection);
+
+	/* close member pools */
+	for (iterator = 0; iterator < axl_list_length (member_pools); iterator++) {
+		member_pool = axl_list_get_nth (member_pools, iterator);
+		vortex_channel_pool_close (member_pool);
+		__vortex_channel_pool_unref (member_pool);
+	} /* end for */
+	axl_list_free (member_pools);
+
+	return;
+}
+
 /** 
  * @internal Common function used to dettach a pool from the
  * connection, allowing to configure if the connection is called back
@@ -801,14 +1556,15 @@ void           __vortex_channel_pool_close_common (VortexChannelPool * pool,
 		return;
 
 	/* check if the channel pool is already being called to be
-	 * closed */
-	connection = pool->connection;
+	 * closed (nullifying the connection so background tasks
+	 * stop using it) */
+	vortex_mutex_lock (&pool->ref_mutex);
+	connection       = pool->connection;
+	pool->connection = NULL;
+	vortex_mutex_unlock (&pool->ref_mutex);
 	if (connection == NULL)
 		return;
 
-	/* nullify */
-	pool->connection = NULL;
-
 	vortex_connection_lock_channel_pool   (connection);  
 	vortex_log (VORTEX_LEVEL_DEBUG, "closing channel pool id=%d", pool->id);
 	
@@ -851,9 +1607,12 @@ void           __vortex_channel_pool_close_common (VortexChannelPool * pool,
 	if (deattach_from_connection)
 		vortex_connection_remove_channel_pool (connection, pool);
 
-	axl_list_free (pool->channels);
-	axl_free (pool->profile);
-	axl_free (pool);
+	/* close pools created on additional connections */
+	if (pool->members != NULL)
+		__vortex_channel_pool_close_members (pool, connection);
+
+	/* release the pool (once background tasks are finished) */
+	__vortex_channel_pool_unref (pool);
 
 	return;	
 }
@@ -1014,6 +1773,7 @@ void                vortex_channel_pool_attach         (VortexChannelPool * pool
 	 * the channel. */
 	vortex_channel_ref2 (channel, "channel pool");
 	axl_list_append (pool->channels, channel);
+	__vortex_channel_pool_item_add (pool, channel);
 
 	vortex_connection_unlock_channel_pool (pool->connection);
 
@@ -1077,6 +1837,7 @@ void                vortex_channel_pool_deattach       (VortexChannelPool * pool
 		/* check the channel and remove from the list if found */
 		if (vortex_channel_are_equal (channel, channel_aux)) {
 			/* decrease reference */
+			__vortex_channel_pool_item_remove (pool, channel);
 			vortex_channel_unref2 (channel, "channel pool");
 			axl_list_cursor_unlink (cursor);
 			break;
@@ -1148,6 +1909,100 @@ void __vortex_channel_pool_print_status (VortexChannelPool * pool, char  * actio
 }
 
 
+/**
+ * @brief Allows to extend the channel pool to use an additional
+ * connection, so channels are created on several connections to the
+ * same peer.
+ *
+ * Once added, \ref vortex_channel_pool_get_next_ready and \ref
+ * vortex_channel_pool_get_next_ready_full select, for each call, the
+ * connection with fewer channels in use (acquired and not released),
+ * spreading the load on the available connections without changing
+ * the code using the pool. Channels returned must be released with
+ * \ref vortex_channel_pool_release_channel on the pool provided (the
+ * one created on the first connection).
+ *
+ * A pool with the same configuration (profile, handlers and create
+ * channel handler) is created on the connection provided, with
+ * <b>init_num</b> channels. If an additional connection is lost
+ * unexpectedly, it is reconnected in background (\ref
+ * vortex_connection_reconnect) and its pool created again, while the
+ * rest of connections are used. Connections closed on purpose by the
+ * application (\ref vortex_connection_close) or whose pool was
+ * closed (\ref vortex_channel_pool_close) are removed from the pool
+ * instead.
+ *
+ * \ref vortex_channel_pool_get_num, \ref
+ * vortex_channel_pool_get_available_num and the rest of functions
+ * operate on the channels of the pool connection. Additional
+ * connections are released when the pool is closed.
+ *
+ * @param pool The channel pool to extend.
+ *
+ * @param connection An additional connection to the same peer (the
+ * function acquires a reference to it).
+ *
+ * @param init_num Number of channels to create on the connection.
+ *
+ * @return axl_true if the connection was added, otherwise axl_false is
+ * returned.
+ */
+axl_bool            vortex_channel_pool_add_connection    (VortexChannelPool * pool,
+							   VortexConnection  * connection,
+							   int                 init_num)
+{
+	VortexChannelPoolMember * member;
+	VortexChannelPool       * member_pool;
+
+	if (pool == NULL || pool->connection == NULL || pool->parent != NULL || init_num <= 0)
+		return axl_false;
+	if (connection == NULL || connection == pool->connection ||
+	    ! vortex_connection_ref (connection, "channel pool member"))
+		return axl_false;
+
+	/* create the pool on the connection */
+	member_pool = __vortex_channel_pool_new_member (pool, connection, init_num);
+	if (member_pool == NULL) {
+		vortex_connection_unref (connection, "channel pool member");
+		return axl_false;
+	} /* end if */
+
+	member             = axl_new (VortexChannelPoolMember, 1);
+	member->connection = connection;
+	member->pool_id    = vortex_channel_pool_get_id (member_pool);
+
+	vortex_connection_lock_channel_pool   (pool->connection);
+	if (pool->members == NULL)
+		pool->members = axl_list_new (axl_list_always_return_1, __vortex_channel_pool_member_free);
+	axl_list_append (pool->members, member);
+	vortex_connection_unlock_channel_pool (pool->connection);
+
+	return axl_true;
+}
+
+/**
+ * @brief Returns the number of connections used by the channel pool
+ * (see \ref vortex_channel_pool_add_connection).
+ *
+ * @param pool The channel pool to check.
+ *
+ * @return The number of connections (1 plus additional connections)
+ * or -1 if it fails.
+ */
+int                 vortex_channel_pool_get_connection_num (VortexChannelPool * pool)
+{
+	int num;
+
+	if (pool == NULL || pool->connection == NULL)
+		return -1;
+
+	vortex_connection_lock_channel_pool   (pool->connection);
+	num = 1 + (pool->members ? axl_list_length (pool->members) : 0);
+	vortex_connection_unlock_channel_pool (pool->connection);
+
+	return num;
+}
+
 /**
  * @brief Returns the next "ready to use" channel from the given pool.
  * 
@@ -1201,66 +2056,33 @@ VortexChannel     * vortex_channel_pool_get_next_ready (VortexChannelPool * pool
 	return vortex_channel_pool_get_next_ready_full (pool, auto_inc, NULL);
 }
 
-axl_bool  __find_ready (axlPointer channel, axlPointer data)
-{
-#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
-	VortexCtx * ctx = vortex_channel_get_ctx (channel);
-#endif
-
-	if (__vortex_channel_pool_is_ready (channel)) {
-		/* ok!, we have found a channel that is ready
-		 * to be use. */
-		vortex_log (VORTEX_LEVEL_DEBUG, "channel id=%d is ready to be used, flagged as busy",
-			    vortex_channel_get_number (channel));
-		return axl_true;
-	}
-	vortex_log (VORTEX_LEVEL_DEBUG, "channel id=%d is not ready",
-		    vortex_channel_get_number (channel));
-	return axl_false;
-	
-} /* end __find_ready */
-
 
 /** 
- * @brief Allows to get the next channel available on the provided
- * pool, providing a pointer that will be passed to the \ref VortexChannelPoolCreate "create channel" handler.
- *
- * This function works the same way like \ref
- * vortex_channel_pool_get_next_ready but allows to provide a pointer
- * that is passed to the VortexChannelPoolCreate handler configured at
- * \ref vortex_channel_pool_new_full. In the case you didn't configure
- * a creation channel handler, this function is not useful. 
- *
- * Once the channel was used, you should use \ref
- * vortex_channel_pool_release_channel to return the channel to the
- * pool, making it usable by other invocation. The concept is to
- * release the channel as soon as possible.
- *
- * See \ref vortex_channel_pool_get_next_ready function for more information.
- * 
- * @param pool The channel pool where a ready channel is required.
- *
- * @param auto_inc axl_true to signal the function to create a new channel
- * if there is not available.
- *
- * @param user_data User defined data to be passed to the \ref
- * VortexChannelPoolCreate function.
- * 
- * @return A newly allocated channel ready to use, or NULL if it
- * fails.
+ * @internal Implementation of \ref
+ * vortex_channel_pool_get_next_ready_full for the channels created on
+ * the connection of the provided pool.
  */
-VortexChannel     * vortex_channel_pool_get_next_ready_full (VortexChannelPool * pool,
-							     axl_bool            auto_inc,
-							     axlPointer          user_data)
+VortexChannel     * __vortex_channel_pool_get_next_ready_internal (VortexChannelPool * pool,
+								   axl_bool            auto_inc,
+								   axlPointer          user_data)
 {
-	VortexChannel * channel   = NULL;
+	VortexChannel         * channel   = NULL;
+	VortexChannelPoolItem * item;
+	struct timeval          start;
+	struct timeval          stop;
+	struct timeval          waited;
+	long                    usecs;
+	int                     bucket;
 #if defined(ENABLE_VORTEX_LOG)
-	VortexCtx     * ctx;
+	VortexCtx             * ctx;
 #endif
 
 	if (pool == NULL)
 		return NULL;
 
+	/* record when the request started */
+	gettimeofday (&start, NULL);
+
 #if defined(ENABLE_VORTEX_LOG)
 	/* get the context */
 	ctx = vortex_connection_get_ctx (pool->connection);
@@ -1272,9 +2094,12 @@ VortexChannel     * vortex_channel_pool_get_next_ready_full (VortexChannelPool *
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "getting next channel to use");
 	
-	/* for each channel inside the pool check is some one is
-	 * ready */
-	channel  = axl_list_lookup (pool->channels, __find_ready, NULL);
+	/* get the next channel ready from those not in use (flagged
+	 * as busy before releasing the lock) */
+	channel  = __vortex_channel_pool_acquire (pool);
+
+	/* create channels in background before the pool runs dry */
+	__vortex_channel_pool_grow (pool);
 
 	/* unlock operations */
 	vortex_connection_unlock_channel_pool (pool->connection);	
@@ -1283,17 +2108,27 @@ VortexChannel     * vortex_channel_pool_get_next_ready_full (VortexChannelPool *
 		vortex_log (VORTEX_LEVEL_DEBUG, "it seems there is no channel ready to use, check auto_inc flag");
 		/* it seems there is no channel available so check
 		 * auto_inc var to create a new channel or simply
-		 * return */
+		 * return (the channel is not created if the pool
+		 * reached its maximum size) */
 		if (auto_inc) {
 			vortex_log (VORTEX_LEVEL_DEBUG, "we have auto_inc flag to axl_true, creating a new channel");
 			channel = __vortex_channel_pool_add_channels (pool, 1, user_data);
+
+			/* acquire the channel created unless other
+			 * thread got it first */
+			if (channel != NULL) {
+				vortex_connection_lock_channel_pool   (pool->connection);
+				item = __vortex_channel_pool_item_get (pool, channel);
+				if (item != NULL && item->idle)
+					__vortex_channel_pool_item_acquire (pool, item);
+				else
+					channel = NULL;
+				vortex_connection_unlock_channel_pool (pool->connection);
+			} /* end if */
 		} /* end if */
 	} /* end if */
 
 	if (channel != NULL) {
-		/* flag this channel to be busy */
-		vortex_channel_set_data (channel, "status_busy", INT_TO_PTR (axl_true));
-
 		vortex_log (VORTEX_LEVEL_DEBUG, "returning channel id=%d for pool id=%d connection id=%d",
 			    vortex_channel_get_number (channel), pool->id, 
 			    vortex_connection_get_id (pool->connection));
@@ -1302,10 +2137,75 @@ VortexChannel     * vortex_channel_pool_get_next_ready_full (VortexChannelPool *
 	} else {
 		vortex_log (VORTEX_LEVEL_DEBUG, "unable to return a channel, pool is empty");
 	} /* end if */
+
+	/* account the time waited (bucket 0 for less than 1us,
+	 * bucket N for less than 2^N us) */
+	gettimeofday (&stop, NULL);
+	vortex_timeval_substract (&stop, &start, &waited);
+	usecs  = (waited.tv_sec * 1000000) + waited.tv_usec;
+	bucket = 0;
+	while (usecs > 0 && bucket < (VORTEX_CHANNEL_POOL_WAIT_BUCKETS - 1)) {
+		usecs = usecs >> 1;
+		bucket++;
+	} /* end while */
+	vortex_connection_lock_channel_pool   (pool->connection);
+	pool->wait_histogram[bucket]++;
+	vortex_connection_unlock_channel_pool (pool->connection);
 	
 	return channel;
 }
 
+/** 
+ * @brief Allows to get the next channel available on the provided
+ * pool, providing a pointer that will be passed to the \ref VortexChannelPoolCreate "create channel" handler.
+ *
+ * This function works the same way like \ref
+ * vortex_channel_pool_get_next_ready but allows to provide a pointer
+ * that is passed to the VortexChannelPoolCreate handler configured at
+ * \ref vortex_channel_pool_new_full. In the case you didn't configure
+ * a creation channel handler, this function is not useful. 
+ *
+ * Once the channel was used, you should use \ref
+ * vortex_channel_pool_release_channel to return the channel to the
+ * pool, making it usable by other invocation. The concept is to
+ * release the channel as soon as possible.
+ *
+ * See \ref vortex_channel_pool_get_next_ready function for more information.
+ * 
+ * @param pool The channel pool where a ready channel is required.
+ *
+ * @param auto_inc axl_true to signal the function to create a new channel
+ * if there is not available.
+ *
+ * @param user_data User defined data to be passed to the \ref
+ * VortexChannelPoolCreate function.
+ * 
+ * @return A newly allocated channel ready to use, or NULL if it
+ * fails.
+ */
+VortexChannel     * vortex_channel_pool_get_next_ready_full (VortexChannelPool * pool,
+							     axl_bool            auto_inc,
+							     axlPointer          user_data)
+{
+	VortexChannel     * channel;
+
+	if (pool == NULL)
+		return NULL;
+
+	/* select the least loaded connection if the pool spans
+	 * several */
+	if (pool->members == NULL)
+		return __vortex_channel_pool_get_next_ready_internal (pool, auto_inc, user_data);
+
+	pool    = __vortex_channel_pool_select (pool);
+	channel = __vortex_channel_pool_get_next_ready_internal (pool, auto_inc, user_data);
+
+	/* release reference acquired by the select */
+	__vortex_channel_pool_unref (pool);
+
+	return channel;
+}
+
 /** 
  * @brief Release a channel from the channel pool.
  * 
@@ -1321,13 +2221,20 @@ VortexChannel     * vortex_channel_pool_get_next_ready_full (VortexChannelPool *
 void                vortex_channel_pool_release_channel   (VortexChannelPool * pool,
 							   VortexChannel     * channel)
 {
+	VortexChannelPoolItem * item;
 #if defined(ENABLE_VORTEX_LOG)
-	VortexCtx * ctx;
+	VortexCtx             * ctx;
 #endif
 
 	if (pool == NULL || channel == NULL)
 		return;
 
+	/* channels from additional connections are released on the
+	 * pool created on them */
+	if (pool->members != NULL && vortex_channel_get_pool (channel) != NULL &&
+	    vortex_channel_get_pool (channel)->parent == pool)
+		pool = vortex_channel_get_pool (channel);
+
 #if defined(ENABLE_VORTEX_LOG)
 	/* get the context */
 	ctx = vortex_connection_get_ctx (pool->connection);
@@ -1344,14 +2251,27 @@ void                vortex_channel_pool_release_channel   (VortexChannelPool * p
 	vortex_connection_lock_channel_pool (pool->connection);	
 
 	/* check if the channel to add doesn't exist on the pool */
-	if (!__vortex_channel_pool_channel_exists (pool, channel)) {
+	item = __vortex_channel_pool_item_get (pool, channel);
+	if (item == NULL || ! vortex_channel_are_equal (item->channel, channel)) {
 		vortex_log (VORTEX_LEVEL_WARNING, "trying to release a channel which doesn't exists on the channel pool");
 		vortex_connection_unlock_channel_pool (pool->connection);
 		return;
 	} /* end if */
 
-	/* unflag channel to be choosable */
+	/* unflag channel to be choosable, placing it the first on
+	 * the idle list so it is reused while still hot */
 	vortex_channel_set_data (channel, "status_busy", NULL);
+	if (! item->idle)
+		pool->in_use--;
+	__vortex_channel_pool_idle_push (pool, item);
+
+	/* record the thread releasing the channel */
+	if (pool->thread_affinity) {
+		if (item->thread_key != NULL && axl_hash_get (pool->affinity, item->thread_key) == item)
+			axl_hash_remove (pool->affinity, item->thread_key);
+		item->thread_key = __vortex_thread_self_key ();
+		axl_hash_insert (pool->affinity, item->thread_key, item);
+	} /* end if */
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "channel id=%d for pool id=%d connection id=%d was released", 
 	       vortex_channel_get_number (channel), pool->id, vortex_connection_get_id (pool->connection));
@@ -1364,6 +2284,158 @@ void                vortex_channel_pool_release_channel   (VortexChannelPool * p
 	return;
 }
 
+/**
+ * @brief Allows to configure how the channel pool grows and shrinks.
+ *
+ * By default a channel pool only grows when requested (\ref
+ * vortex_channel_pool_add or \ref vortex_channel_pool_get_next_ready
+ * with auto_inc), creating one channel at a time while the caller
+ * waits. Once a policy is configured, the pool creates channels in
+ * background (several in parallel, using the vortex thread pool) to
+ * keep at least <b>min_channels</b> channels and
+ * <b>target_idle</b> channels not in use, so channels are
+ * available before the pool runs dry.
+ *
+ * The pool never grows beyond <b>max_channels</b> (auto_inc and \ref
+ * vortex_channel_pool_add included: in that case \ref
+ * vortex_channel_pool_get_next_ready returns NULL if no channel is
+ * ready and \ref vortex_channel_pool_add creates fewer channels than
+ * requested).
+ *
+ * Channels not used for <b>idle_timeout</b> seconds are closed,
+ * keeping the minimum and target idle channels configured.
+ *
+ * @param pool The channel pool to configure.
+ *
+ * @param min_channels Minimum number of channels (0 for no minimum).
+ *
+ * @param max_channels Maximum number of channels (0 for no maximum).
+ *
+ * @param target_idle Number of channels not in use to keep available
+ * (0 to disable background growth).
+ *
+ * @param idle_timeout Seconds a channel can be unused before it is
+ * closed (0 to never close idle channels).
+ */
+void                vortex_channel_pool_set_policy        (VortexChannelPool * pool,
+							   int                 min_channels,
+							   int                 max_channels,
+							   int                 target_idle,
+							   long                idle_timeout)
+{
+	VortexCtx * ctx;
+	axl_bool    shrink = axl_false;
+	long        period;
+
+	if (pool == NULL || pool->connection == NULL)
+		return;
+
+	vortex_connection_lock_channel_pool   (pool->connection);
+	pool->min_channels = (min_channels > 0) ? min_channels : 0;
+	pool->max_channels = (max_channels > 0) ? max_channels : 0;
+	pool->target_idle  = (target_idle  > 0) ? target_idle  : 0;
+	pool->idle_timeout = (idle_timeout > 0) ? idle_timeout : 0;
+	if (pool->max_channels > 0 && pool->min_channels > pool->max_channels)
+		pool->min_channels = pool->max_channels;
+
+	/* pre-warm the pool */
+	__vortex_channel_pool_grow (pool);
+
+	/* install the shrink event if it is not running */
+	if (pool->idle_timeout > 0 && ! pool->shrinking) {
+		pool->shrinking = axl_true;
+		shrink          = axl_true;
+	} /* end if */
+	vortex_connection_unlock_channel_pool (pool->connection);
+
+	if (shrink) {
+		/* the event holds a reference to the pool, checking
+		 * idle channels twice per timeout period (limiting
+		 * the period so it doesn't overflow) */
+		if (pool->idle_timeout > (VORTEX_CHANNEL_POOL_SHRINK_MAX_PERIOD * 2))
+			period = VORTEX_CHANNEL_POOL_SHRINK_MAX_PERIOD * 1000000L;
+		else
+			period = pool->idle_timeout * 500000L;
+		__vortex_channel_pool_ref (pool);
+		ctx = vortex_connection_get_ctx (pool->connection);
+		vortex_thread_pool_new_event (ctx, period, __vortex_channel_pool_shrink_event, pool, NULL);
+	} /* end if */
+
+	return;
+}
+
+/**
+ * @brief Allows to get the histogram of times waited to get a
+ * channel from the pool (\ref vortex_channel_pool_get_next_ready).
+ *
+ * Each bucket counts the requests completed within a range of
+ * time: bucket 0 counts requests completed in less than 1
+ * microsecond and bucket N (N > 0) those completed in less than 2^N
+ * microseconds (and at least 2^(N-1)). The last bucket (\ref
+ * VORTEX_CHANNEL_POOL_WAIT_BUCKETS - 1) also counts longer
+ * requests.
+ *
+ * @param pool The channel pool to get the histogram from.
+ *
+ * @param buckets Array where the buckets are copied.
+ *
+ * @param size Number of positions available in buckets.
+ *
+ * @return The number of buckets copied or -1 if it fails.
+ */
+int                 vortex_channel_pool_get_wait_histogram (VortexChannelPool * pool,
+							    long              * buckets,
+							    int                 size)
+{
+	int iterator;
+
+	if (pool == NULL || pool->connection == NULL || buckets == NULL || size < 0)
+		return -1;
+	if (size > VORTEX_CHANNEL_POOL_WAIT_BUCKETS)
+		size = VORTEX_CHANNEL_POOL_WAIT_BUCKETS;
+
+	vortex_connection_lock_channel_pool   (pool->connection);
+	for (iterator = 0; iterator < size; iterator++)
+		buckets[iterator] = pool->wait_histogram[iterator];
+	vortex_connection_unlock_channel_pool (pool->connection);
+
+	return size;
+}
+
+/**
+ * @brief Allows to configure per-thread affinity on the channel pool
+ * provided.
+ *
+ * When enabled, \ref vortex_channel_pool_get_next_ready returns, if
+ * it is ready, the channel that was released the last time by the
+ * calling thread, so the same thread tends to reuse the same
+ * channel. Otherwise the channel released most recently is returned.
+ *
+ * Affinity is disabled by default.
+ *
+ * @param pool The channel pool to configure.
+ *
+ * @param enable axl_true to enable per-thread affinity, axl_false to
+ * disable it.
+ */
+void                vortex_channel_pool_set_thread_affinity (VortexChannelPool * pool,
+							     axl_bool            enable)
+{
+	if (pool == NULL || pool->connection == NULL)
+		return;
+
+	vortex_connection_lock_channel_pool   (pool->connection);
+	pool->thread_affinity = enable;
+	if (! enable) {
+		/* forget previous thread references */
+		axl_hash_free (pool->affinity);
+		pool->affinity = axl_hash_new (axl_hash_int, axl_hash_equal_int);
+	} /* end if */
+	vortex_connection_unlock_channel_pool (pool->connection);
+
+	return;
+}
+
 /**
  * @brief Return the channel pool unique identifier.
  * 
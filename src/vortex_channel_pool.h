@@ -41,6 +41,12 @@
 
 #include <vortex.h>
 
+/**
+ * @brief Number of buckets of the channel pool wait time histogram
+ * (see \ref vortex_channel_pool_get_wait_histogram).
+ */
+#define VORTEX_CHANNEL_POOL_WAIT_BUCKETS 24
+
 VortexChannelPool * vortex_channel_pool_new               (VortexConnection           * connection,
 							   const char                 * profile,
 							   int                          init_num,
@@ -95,6 +101,25 @@ VortexChannel     * vortex_channel_pool_get_next_ready_full (VortexChannelPool *
 void                vortex_channel_pool_release_channel   (VortexChannelPool * pool,
 							   VortexChannel     * channel);
 
+void                vortex_channel_pool_set_policy        (VortexChannelPool * pool,
+							   int                 min_channels,
+							   int                 max_channels,
+							   int                 target_idle,
+							   long                idle_timeout);
+
+int                 vortex_channel_pool_get_wait_histogram (VortexChannelPool * pool,
+							    long              * buckets,
+							    int                 size);
+
+void                vortex_channel_pool_set_thread_affinity (VortexChannelPool * pool,
+							     axl_bool            enable);
+
+axl_bool            vortex_channel_pool_add_connection    (VortexChannelPool * pool,
+							   VortexConnection  * connection,
+							   int                 init_num);
+
+int                 vortex_channel_pool_get_connection_num (VortexChannelPool * pool);
+
 int                 vortex_channel_pool_get_id            (VortexChannelPool * pool);
 
 VortexConnection  * vortex_channel_pool_get_connection    (VortexChannelPool * pool);
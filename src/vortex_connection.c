@@ -80,6 +80,12 @@ struct _VortexConnectionOpts {
 	 * on connection creation.
 	 */
 	axl_bool     release_opts;
+
+	/** 
+	 * @internal Profile to be started in pipelined mode along with
+	 * client greetings (see \ref VORTEX_OPTS_PIPELINED_START).
+	 */
+	char       * pipelined_profile;
 };
 
 /** 
@@ -121,6 +127,11 @@ VortexConnectionOpts * __vortex_connection_opts_process (VortexConnectionOptItem
 			/* check release status */
 			opts->release_opts = va_arg (args, axl_bool);
 			break;
+		case VORTEX_OPTS_PIPELINED_START:
+			/* get profile to be started with greetings */
+			opts->pipelined_profile = (char *) va_arg (args, const char *);
+			opts->pipelined_profile = axl_strdup (opts->pipelined_profile);
+			break;
 		} /* end switch */
 
 		/* get next option */
@@ -269,6 +280,7 @@ void vortex_connection_opts_free (VortexConnectionOpts * conn_opts)
 	if (conn_opts == NULL)
 		return;
 	axl_free (conn_opts->serverName);
+	axl_free (conn_opts->pipelined_profile);
 	axl_free (conn_opts);
 	return;
 }
@@ -395,6 +407,74 @@ int  vortex_connection_default_send (VortexConnection * connection,
 	return send (connection->session, buffer, buffer_len, 0);
 }
 
+/** 
+ * @internal Replaces the connection send handler with the new one
+ * provided, only if the current handler is the expected one. The
+ * swap is done under the connection op_mutex so it doesn't race with
+ * other handler changes during pipelined connect.
+ *
+ * @return axl_true if the handler was replaced.
+ */
+axl_bool __vortex_connection_swap_send (VortexConnection  * connection,
+					VortexSendHandler   expected,
+					VortexSendHandler   send_handler)
+{
+	axl_bool result = axl_false;
+
+	vortex_mutex_lock (&connection->op_mutex);
+	if (connection->send == expected) {
+		connection->send = send_handler;
+		result           = axl_true;
+	} /* end if */
+	vortex_mutex_unlock (&connection->op_mutex);
+
+	return result;
+}
+
+/** 
+ * @internal Pushes data held by the kernel after a write flagged with
+ * MSG_MORE (see \ref __vortex_connection_pipelined_send). Enabling
+ * TCP_NODELAY pushes pending segments; the value previously
+ * configured on the socket is restored afterwards.
+ */
+void __vortex_connection_push_pending (VortexConnection * connection)
+{
+#if defined(MSG_MORE)
+	int       flag   = 0;
+	socklen_t length = sizeof (flag);
+
+	if (getsockopt (connection->session, IPPROTO_TCP, TCP_NODELAY, &flag, &length) != 0)
+		return;
+
+	/* push and restore previous value */
+	vortex_connection_set_sock_tcp_nodelay (connection->session, axl_true);
+	if (! flag)
+		vortex_connection_set_sock_tcp_nodelay (connection->session, axl_false);
+#endif
+	return;
+}
+
+/** 
+ * @internal Send handler installed during pipelined connect
+ * (\ref VORTEX_OPTS_PIPELINED_START) to write client greetings
+ * flagged with MSG_MORE, so they leave in the same segment with the
+ * &lt;start> request that follows. The default handler is restored
+ * after the first write.
+ */
+int  __vortex_connection_pipelined_send (VortexConnection * connection,
+					 const char       * buffer,
+					 int                buffer_len)
+{
+	/* restore default handler for next writes */
+	__vortex_connection_swap_send (connection, __vortex_connection_pipelined_send, vortex_connection_default_send);
+
+#if defined(MSG_MORE)
+	return send (connection->session, buffer, buffer_len, MSG_MORE);
+#else
+	return send (connection->session, buffer, buffer_len, 0);
+#endif
+}
+
 /** 
  * @internal
  * @brief Default handler to be used while receiving data
@@ -1766,14 +1846,46 @@ axl_bool vortex_connection_do_greetings_exchange (VortexCtx             * ctx,
 {
 	VortexFrame          * frame;
 	int                    err;
+	VortexChannel        * pipelined  = NULL;
+	WaitReplyData        * wait_reply = NULL;
+	int                    msg_no     = 0;
 
 	v_return_val_if_fail (vortex_connection_is_ok (connection, axl_false), axl_false);
 
+	/* check here connection options like CONN_OPTS_SERVERNAME OR
+	   CONN_OPTS_SERVERNAME_ACQUIRE (configured before sending
+	   anything so a pipelined start can use them) */
+	if (options) {
+		if (options->serverName_acquire) 
+			vortex_connection_set_data (connection, CONN_OPTS_SERVERNAME_ACQUIRE, INT_TO_PTR (axl_true));
+		if (options->serverName) 
+			vortex_connection_set_data_full (connection, CONN_OPTS_SERVERNAME, axl_strdup (options->serverName), NULL, axl_free);
+	} /* end if */
+
+	/* in pipelined mode, ask the kernel to hold greetings until
+	 * the <start> request is written (default send handler only) */
+	if (options && options->pipelined_profile)
+		__vortex_connection_swap_send (connection, vortex_connection_default_send, __vortex_connection_pipelined_send);
+
 	/* now we have to send greetings and process them */
 	if (! vortex_greetings_client_send (connection, options)) {
 		vortex_log (VORTEX_LEVEL_DEBUG, vortex_connection_get_message (connection));
 		return axl_false;
 	}
+
+	/* queue channel start right after greetings without waiting
+	 * for remote greetings */
+	if (options && options->pipelined_profile) {
+		pipelined = __vortex_channel_new_pipelined (connection, vortex_connection_opts_get_serverName (connection),
+							  options->pipelined_profile, &msg_no, &wait_reply);
+		if (pipelined == NULL) {
+			vortex_log (VORTEX_LEVEL_WARNING, "unable to queue pipelined start for profile %s, continuing with plain greetings (conn-id=%d)",
+				    options->pipelined_profile, connection->id);
+			/* restore send handler and flush held greetings */
+			__vortex_connection_swap_send (connection, __vortex_connection_pipelined_send, vortex_connection_default_send);
+			__vortex_connection_push_pending (connection);
+		} /* end if */
+	} /* end if */
 	
 	vortex_log (VORTEX_LEVEL_DEBUG, "greetings sent, waiting for reply");
 
@@ -1822,7 +1934,7 @@ axl_bool vortex_connection_do_greetings_exchange (VortexCtx             * ctx,
 				connection->is_connected = axl_false;
 
 				/* error found, stop greetings process */
-				return axl_false;
+				goto __vortex_connection_do_greetings_exchange_failed;
 			} /* end if */
 				
 			vortex_log (VORTEX_LEVEL_DEBUG,
@@ -1853,7 +1965,7 @@ axl_bool vortex_connection_do_greetings_exchange (VortexCtx             * ctx,
 				connection->status       = VortexConnectionError;
 			} /* end if */
 			connection->is_connected = axl_false;
-			return axl_false;
+			goto __vortex_connection_do_greetings_exchange_failed;
 		} /* end if */
 		
 	} /* end while */
@@ -1864,19 +1976,25 @@ axl_bool vortex_connection_do_greetings_exchange (VortexCtx             * ctx,
 	
 	/* process frame response */
 	if (!vortex_connection_parse_greetings_and_enable (connection, frame))
-		return axl_false;
+		goto __vortex_connection_do_greetings_exchange_failed;
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "greetings exchange ok");
 
-	/* check here connection options like CONN_OPTS_SERVERNAME OR
-	   CONN_OPTS_SERVERNAME_ACQUIRE */
-	if (options) {
-		if (options->serverName_acquire) 
-			vortex_connection_set_data (connection, CONN_OPTS_SERVERNAME_ACQUIRE, INT_TO_PTR (axl_true));
-		if (options->serverName) 
-			vortex_connection_set_data_full (connection, CONN_OPTS_SERVERNAME, axl_strdup (options->serverName), NULL, axl_free);
+	/* now the connection is watched by the reader, complete
+	 * pipelined start (the reply is probably already here) */
+	if (pipelined) {
+		if (! __vortex_channel_new_pipelined_finish (pipelined, msg_no, wait_reply))
+			vortex_log (VORTEX_LEVEL_WARNING, "pipelined channel start for profile %s failed (conn-id=%d)",
+				    options->pipelined_profile, connection->id);
 	} /* end if */
 	return axl_true;
+
+ __vortex_connection_do_greetings_exchange_failed:
+	/* release pipelined channel start (connection is not
+	 * operational, so finish returns right away) */
+	if (pipelined)
+		__vortex_channel_new_pipelined_finish (pipelined, msg_no, wait_reply);
+	return axl_false;
 } 
 
 /** 
@@ -3554,6 +3672,14 @@ void               vortex_connection_free (VortexConnection * connection)
 	axl_free (connection->pending_line);
 	connection->pending_line = NULL;
 
+	/* free write coalescing buffers (no signal is pending at this
+	 * point because the sequencer holds a reference while frames
+	 * are coalesced) */
+	axl_free (connection->batch_buffer);
+	connection->batch_buffer = NULL;
+	axl_free (connection->batch_signals);
+	connection->batch_signals = NULL;
+
 	vortex_log (VORTEX_LEVEL_DEBUG, "freeing connection channel pools id=%d", connection->id);
 	/* free channel pools */
 	if (connection->channel_pools) {
@@ -5308,6 +5434,22 @@ axl_bool             vortex_connection_is_blocked                   (VortexConne
 	return conn->is_blocked;
 }
 
+/** 
+ * @internal Same as \ref vortex_connection_block but without
+ * restarting the vortex reader, so it can be called from inside the
+ * vortex reader thread (for example, from a preread handler). The
+ * new state is considered by the reader on its next loop.
+ */
+void                __vortex_connection_set_blocked                (VortexConnection * conn,
+								    axl_bool           enable)
+{
+	v_return_if_fail (conn);
+
+	/* set blocking state */
+	conn->is_blocked = enable;
+	return;
+}
+
 /** 
  * @brief Allows to check if the provided connection is still in
  * transit of being accepted.
@@ -6487,6 +6629,93 @@ VortexReceiveHandler   vortex_connection_set_receive_handler (VortexConnection
 	return previous_handler;
 }
 
+/** 
+ * @brief Allows to configure the handler used by the vortex reader to
+ * check if the receive handler has content buffered that can be read
+ * without waiting (see \ref VortexPendingInputHandler).
+ *
+ * This is required by receive handlers that read from the socket
+ * more content than requested (or that decode several messages from
+ * the same read operation, like TLS records), because that content
+ * is no longer notified by the I/O waiting mechanism.
+ * 
+ * @param connection The connection where the handler will be set.
+ * @param pending_input The handler to be set or NULL to remove it.
+ * 
+ * @return Returns previous handler configured (or NULL).
+ */
+VortexPendingInputHandler vortex_connection_set_pending_input_handler (VortexConnection          * connection,
+								       VortexPendingInputHandler   pending_input)
+{
+	VortexPendingInputHandler previous_handler;
+
+	/* check parameters received */
+	if (connection == NULL)
+		return NULL;
+
+	/* save previous handler defined */
+	previous_handler          = connection->pending_input;
+	connection->pending_input = pending_input;
+
+	/* returns previous handler */
+	return previous_handler;
+}
+
+/** 
+ * @internal Checks if the connection has input already buffered by
+ * its receive handler (see \ref
+ * vortex_connection_set_pending_input_handler).
+ */
+axl_bool            vortex_connection_has_pending_input   (VortexConnection * connection)
+{
+	if (connection == NULL || connection->pending_input == NULL)
+		return axl_false;
+	return connection->pending_input (connection);
+}
+
+/** 
+ * @brief Enables write coalescing for the provided connection.
+ *
+ * By default, the vortex sequencer writes each frame built into the
+ * connection with a separate send operation. Once write coalescing
+ * is enabled, frames built by the sequencer for the connection are
+ * accumulated (up to max_size bytes) and written with a single send
+ * operation once the buffer is full or at the end of the sequencer
+ * pass over the channels with frames ready to be sent.
+ *
+ * This is mainly useful for transports where each send operation has
+ * a fixed cost (like TLS, where each send operation produces at
+ * least one record with its own header and MAC).
+ *
+ * @param connection The connection to configure.
+ *
+ * @param max_size Max amount of bytes to accumulate before writing
+ * them. Use 0 to disable write coalescing.
+ */
+void                vortex_connection_set_write_coalescing (VortexConnection * connection,
+							    int                max_size)
+{
+	if (connection == NULL || max_size < 0)
+		return;
+	connection->batch_max = max_size;
+	return;
+}
+
+/** 
+ * @brief Returns current write coalescing size configured (see \ref
+ * vortex_connection_set_write_coalescing).
+ *
+ * @param connection The connection to check.
+ *
+ * @return Max size configured or 0 if it is disabled.
+ */
+int                 vortex_connection_get_write_coalescing (VortexConnection * connection)
+{
+	if (connection == NULL)
+		return 0;
+	return connection->batch_max;
+}
+
 /** 
  * @brief Set default IO handlers to be used while sending and
  * receiving data for the given connection.
@@ -6525,14 +6754,38 @@ void                   vortex_connection_set_default_io_handler (VortexConnectio
 #endif
 
 	/* set default send and receive handlers */
-	connection->send       = vortex_connection_default_send;
-	connection->receive    = vortex_connection_default_receive;
+	connection->send          = vortex_connection_default_send;
+	connection->receive       = vortex_connection_default_receive;
+	connection->pending_input = NULL;
 	vortex_log (VORTEX_LEVEL_DEBUG, "restoring default IO handlers for connection id=%d", 
 		    connection->id);
 
 	return;
 }
 
+/** 
+ * @brief Allows to check if the provided connection is using the
+ * default IO handlers (plain socket send and receive, without any
+ * tuning profile like TLS or a transport like WebSocket installed).
+ *
+ * This is useful to know if it is possible to operate directly with
+ * the connection socket, skipping send and receive handlers.
+ * 
+ * @param connection The connection to check.
+ *
+ * @return axl_true if the connection uses default IO handlers,
+ * otherwise axl_false is returned.
+ */
+axl_bool               vortex_connection_has_default_io_handler (VortexConnection * connection)
+{
+	if (connection == NULL)
+		return axl_false;
+
+	return connection->send          == vortex_connection_default_send &&
+	       connection->receive       == vortex_connection_default_receive &&
+	       connection->pending_input == NULL;
+}
+
 /** 
  * @brief Allows to set a new on close handler to be executed only
  * once the connection is being closed.
@@ -344,10 +344,26 @@ VortexCtx         * vortex_connection_get_ctx                (VortexConnection *
 VortexSendHandler      vortex_connection_set_send_handler    (VortexConnection * connection,
 							      VortexSendHandler  send_handler);
 
+int                    vortex_connection_default_send        (VortexConnection * connection,
+							      const char       * buffer,
+							      int                buffer_len);
+
 VortexReceiveHandler   vortex_connection_set_receive_handler (VortexConnection * connection,
 							      VortexReceiveHandler receive_handler);
 
+VortexPendingInputHandler vortex_connection_set_pending_input_handler (VortexConnection          * connection,
+								       VortexPendingInputHandler   pending_input);
+
+axl_bool               vortex_connection_has_pending_input   (VortexConnection * connection);
+
+void                   vortex_connection_set_write_coalescing (VortexConnection * connection,
+							       int                max_size);
+
+int                    vortex_connection_get_write_coalescing (VortexConnection * connection);
+
 void                   vortex_connection_set_default_io_handler (VortexConnection * connection);
+
+axl_bool               vortex_connection_has_default_io_handler (VortexConnection * connection);
 								 
 
 void                   vortex_connection_set_on_close       (VortexConnection * connection,
@@ -97,6 +97,15 @@ void freeaddrinfo(struct addrinfo *ai);
 #  endif
 #endif
 
+/** 
+ * @internal Reply sent notification that is delayed until the frames
+ * coalesced by the sequencer are actually written.
+ */
+typedef struct _VortexConnectionBatchSignal {
+	VortexChannel * channel;
+	int             msg_no;
+} VortexConnectionBatchSignal;
+
 /** 
  * @internal
  * @brief Internal VortexConnection representation.
@@ -321,6 +330,12 @@ struct _VortexConnection {
 	 */
 	VortexReceiveHandler receive;
 
+	/** 
+	 * @internal Optional handler used by the vortex reader to
+	 * check for buffered content at the receive handler.
+	 */
+	VortexPendingInputHandler pending_input;
+
 	/** 
 	 * @brief On close handler
 	 */
@@ -447,6 +462,31 @@ struct _VortexConnection {
 	 * vortex_connection_set_complete_frame_limit to limit at
 	 * global connection frame limits. */
         int                          complete_frame_limit;
+
+	/** @internal Write coalescing support (see \ref
+	 * vortex_connection_set_write_coalescing). These fields are
+	 * only used by the vortex sequencer thread (but batch_max). */
+	int                          batch_max;
+	char                       * batch_buffer;
+	int                          batch_buffer_size;
+	int                          batch_size;
+	VortexConnectionBatchSignal * batch_signals;
+	int                          batch_signals_count;
+	int                          batch_signals_size;
 };
 
+void            __vortex_connection_set_blocked       (VortexConnection * conn,
+						       axl_bool           enable);
+
+/* pipelined channel start support (see VORTEX_OPTS_PIPELINED_START) */
+VortexChannel * __vortex_channel_new_pipelined        (VortexConnection  * connection,
+						       const char        * serverName,
+						       const char        * profile,
+						       int               * msg_no,
+						       WaitReplyData    ** wait_reply);
+
+axl_bool        __vortex_channel_new_pipelined_finish (VortexChannel * channel,
+						       int             msg_no,
+						       WaitReplyData * wait_reply);
+
 #endif /* __VORTEX_CONNECTION_PRIVATE_H__ */
@@ -84,6 +84,9 @@ VortexCtx * vortex_ctx_new (void)
 	/* create a new context */
 	ctx           = axl_new (VortexCtx, 1);
 	VORTEX_CHECK_REF (ctx, NULL);
+
+	/* log configuration is resolved on first use */
+	ctx->log_mask = VORTEX_LOG_MASK_UNCHECKED;
 	vortex_log (VORTEX_LEVEL_DEBUG, "created VortexCtx reference %p", ctx);
 
 	/* create the hash to store data */
@@ -803,6 +806,12 @@ void        vortex_ctx_free2 (VortexCtx * ctx, const char * who)
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "finishing VortexCtx %p", ctx);
 
+	/* stop async log writer (flushing pending records) */
+	__vortex_log_async_cleanup (ctx);
+
+	/* release metrics collected */
+	__vortex_metrics_cleanup (ctx);
+
 	/* release log mutex */
 	vortex_mutex_destroy (&ctx->log_mutex);
 	
@@ -50,6 +50,10 @@ typedef struct _VortexSequencerState {
 	VortexMutex     mutex;
 	VortexCond      cond;
 
+	/* connections with frames coalesced pending to be written
+	 * (only used by the sequencer thread) */
+	axlList       * batched;
+
 	axl_bool        exit;
 } VortexSequencerState;
 
@@ -114,6 +118,20 @@ struct _VortexCtx {
 	axl_bool             debug_filter_checked;
 	axl_bool             debug_filter_is_enabled;
 
+	/* levels that currently pass, checked by vortex_log before
+	 * evaluating its arguments (see __vortex_log_update_mask) */
+	int                  log_mask;
+
+	/* asynchronous log delivery (vortex_log_async.c) */
+	VortexLogAsync     * log_async;
+
+	/* metrics registry (vortex_metrics.c) */
+	VortexMetrics      * metrics;
+
+	/* tracing hooks (vortex_trace.c) */
+	VortexTraceHandler   trace_handler;
+	axlPointer           trace_handler_data;
+
 	/*** global handlers */
 	/* @internal Finish handler */
 	VortexOnFinishHandler             finish_handler;
@@ -196,6 +214,16 @@ struct _VortexCtx {
 	VortexMutex          channel_start_reply_cache_mutex;
 	axlHash           *  channel_start_reply_cache;
 
+	/** 
+	 * @internal Reply futures state: reply_mutex protects the
+	 * pool of released VortexReply objects (reply_pool, linked
+	 * through its next pointer) and the flag installed on each
+	 * connection watched (each reply has its own mutex).
+	 */
+	VortexMutex          reply_mutex;
+	VortexReply       *  reply_pool;
+	int                  reply_pool_size;
+
 	/**** vortex frame module state ****/
 	/** 
 	 * @internal
@@ -215,6 +243,10 @@ struct _VortexCtx {
 	VortexHash        * registered_profiles;
 	axlList           * profiles_list;
 	VortexMutex         profiles_list_mutex;
+	/* updated each time a profile is added or removed from
+	 * registered_profiles so channels know when the profile
+	 * reference they cache must be resolved again */
+	int                 profiles_epoch;
 
 	/**** vortex io waiting module state ****/
 	VortexIoCreateFdGroup  waiting_create;
@@ -320,5 +352,17 @@ struct _VortexCtx {
 	axl_bool                disable_conn_close_on_write_timeout;
 };
 
+/** 
+ * @internal Value of VortexCtx.log_mask until the log configuration
+ * (VORTEX_DEBUG, VORTEX_DEBUG_FILTER) is resolved on the first log.
+ */
+#define VORTEX_LOG_MASK_UNCHECKED (-1)
+
+/* modules with access to the context check the log mask inline */
+#if defined(ENABLE_VORTEX_LOG)
+# undef  VORTEX_LOG_LEVEL_ENABLED
+# define VORTEX_LOG_LEVEL_ENABLED(c, l) ((c) != NULL && ((c)->log_mask & (l)))
+#endif
+
 #endif /* __VORTEX_CTX_PRIVATE_H__ */
 
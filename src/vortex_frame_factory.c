@@ -275,6 +275,20 @@ struct _VortexFrame {
 	 * be shared with other frames, mostly due to
 	 * vortex_frame_copy and vortex_frame_join* functions */
 	VortexMimeStatus   * mime_headers;
+
+	/* MIME body was located (content and mime_headers_size are
+	 * configured) but headers weren't parsed into mime_headers
+	 * yet. See vortex_frame_mime_process_lazy */
+	axl_bool             mime_lazy;
+
+	/* when the reader finished reading the frame (only
+	 * configured while metrics are enabled). See
+	 * vortex_frame_set_received_stamp */
+	struct timeval       received_stamp;
+
+	/* last trace point reached by the frame (only configured
+	 * while tracing, see vortex_trace_set_handler) */
+	struct timeval       trace_stamp;
 };
 
 /** 
@@ -858,6 +872,70 @@ char  * vortex_frame_build_up_from_params_s_buffer (VortexFrameType   type,
 	return value;	
 }
 
+/** 
+ * @internal Builds only the BEEP header for a frame with the provided
+ * values (without payload and trailer) into the buffer
+ * provided. Used by the vortex sequencer to send payload content
+ * directly from a file descriptor.
+ *
+ * @param type The frame type (MSG, RPY, ANS or ERR).
+ * @param channel The channel number.
+ * @param msgno The message number.
+ * @param more More flag status.
+ * @param seqno Sequence number for the frame.
+ * @param size The frame payload size.
+ * @param ansno The answer number (only used by ANS frames).
+ * @param buffer The buffer where the header will be placed.
+ * @param buffer_size The buffer size.
+ *
+ * @return The header size (including its trailing \\r\\n) or -1 if
+ * it fails.
+ */
+int     vortex_frame_build_header_s_buffer         (VortexFrameType   type,
+						    int               channel,
+						    int               msgno,
+						    axl_bool          more,
+						    unsigned int      seqno,
+						    int               size,
+						    int               ansno,
+						    char         *    buffer,
+						    int               buffer_size)
+{
+	char * message_type;
+	int    header_length;
+	int    real_size = 0;
+
+	switch (type) {
+	case VORTEX_FRAME_TYPE_MSG:
+		message_type = "MSG";
+		break;
+	case VORTEX_FRAME_TYPE_RPY:
+		message_type = "RPY";
+		break;
+	case VORTEX_FRAME_TYPE_ANS:
+		message_type = "ANS";
+		break;
+	case VORTEX_FRAME_TYPE_ERR:
+		message_type = "ERR";
+		break;
+	default:
+		return -1;
+	} /* end switch */
+
+	if (buffer == NULL || buffer_size <= 0)
+		return -1;
+
+	header_length = vortex_frame_build_header (buffer, buffer_size, &real_size,
+						   message_type, channel, msgno,
+						   more, seqno, size,
+						   type == VORTEX_FRAME_TYPE_ANS ? ansno : -1,
+						   NULL, NULL);
+	if (header_length < 0 || real_size >= buffer_size)
+		return -1;
+
+	return header_length;
+}
+
 /** 
  * @brief Creates a new frame from using the given data and returning
  * current frame size resulting from the operation.
@@ -1232,6 +1310,9 @@ VortexFrame * vortex_frame_copy                 (VortexFrame      * frame)
  		/* configure the reference */
  		result->mime_headers = frame->mime_headers;
  	} /* end if */
+
+	/* headers still not parsed are parsed by the copy on demand */
+	result->mime_lazy = frame->mime_lazy;
  
 	/* set same channel */
 	result->channel_ref = frame->channel_ref;
@@ -1948,11 +2029,16 @@ axl_bool             vortex_frame_send_raw     (VortexConnection * connection, c
  	int          tries    = (ctx->conn_close_on_write_timeout > 0) ? ctx->conn_close_on_write_timeout : 3 ;
 
  	axlPointer   on_write = NULL;
+	axl_bool     metrics;
+	struct timeval stamp;
 
 	v_return_val_if_fail (connection, axl_false);
 	v_return_val_if_fail (vortex_connection_is_ok (connection, axl_false), axl_false);
 	v_return_val_if_fail (a_frame, axl_false);
 
+	/* measure write time if metrics are enabled */
+	metrics = __vortex_metrics_start (ctx, &stamp);
+
  again:
 	if ((bytes = vortex_connection_invoke_send (connection, a_frame + total, frame_size - total)) < 0) {
 		if (errno == VORTEX_EINTR)
@@ -2059,6 +2145,12 @@ axl_bool             vortex_frame_send_raw     (VortexConnection * connection, c
  	/* clear waiting set before returning */
  	if (on_write)
  		vortex_io_waiting_invoke_destroy_fd_group (ctx, on_write);
+
+	if (metrics) {
+		__vortex_metrics_record_since (ctx, VORTEX_METRIC_SEND, NULL, &stamp);
+		__vortex_metrics_count_series (ctx, NULL, VORTEX_COUNTER_FRAMES_SENT, 1);
+		__vortex_metrics_count_series (ctx, NULL, VORTEX_COUNTER_BYTES_SENT, total);
+	} /* end if */
 	
  	return (total == frame_size);
 }
@@ -2239,6 +2331,7 @@ VortexFrame * __vortex_frame_join_common (VortexFrame * a, VortexFrame * b, axl_
 	/* because mime headers are found at the begining of the
 	 * frame, joing operations will move headers */
 	result->mime_headers = a->mime_headers;
+	result->mime_lazy    = a->mime_lazy;
 	a->mime_headers      = NULL;
 
 	return result;
@@ -3234,6 +3327,67 @@ void vortex_frame_reconfigure_mime (VortexFrame * frame, int iterator, int step)
 	return;
 }
 
+/** 
+ * @internal Parses MIME headers found by \ref
+ * vortex_frame_mime_process_lazy, if they weren't parsed yet. Called
+ * by functions accessing MIME headers.
+ *
+ * @param frame The frame to process.
+ */
+void          vortex_frame_mime_parse_pending    (VortexFrame * frame)
+{
+	axlPointer   payload;
+	int          size;
+	int          iterator = 0;
+	char       * headers;
+#if defined(ENABLE_VORTEX_LOG)
+	VortexCtx  * ctx;
+#endif
+
+	if (frame == NULL || ! frame->mime_lazy)
+		return;
+#if defined(ENABLE_VORTEX_LOG)
+	ctx = frame->ctx;
+#endif
+	frame->mime_lazy = axl_false;
+
+	/* check to initialize the mime header internal hash */
+	if (frame->mime_headers == NULL)
+		frame->mime_headers = vortex_frame_mime_status_new ();
+
+	/* make the header parser to work over the header block
+	 * (including the empty line that terminates it) */
+	payload        = frame->payload;
+	size           = frame->size;
+	frame->payload = frame->content;
+	frame->size    = frame->mime_headers_size;
+	headers        = frame->payload;
+
+	while (iterator < frame->size) {
+		/* check to terminate mime header block */
+		if ((headers[iterator] == '\x0A') || 
+		    (headers[iterator] == '\x0D' && headers[iterator + 1] == '\x0A'))
+			break;
+
+		/* parse next MIME header found */
+		if (vortex_frame_read_mime_header (frame, &iterator) != 1) {
+			vortex_log (VORTEX_LEVEL_WARNING, "found MIME format error while parsing headers for frame id=%d",
+				    frame->id);
+
+			/* clear all MIME headers */
+			vortex_frame_mime_status_free (frame->mime_headers);
+			frame->mime_headers = NULL;
+			break;
+		} /* end if */
+	} /* end while */
+
+	/* restore body references */
+	frame->payload = payload;
+	frame->size    = size;
+
+	return;
+}
+
 /** 
  * @brief Function that prepares MIME status for the frame received,
  * configuring variables, content, etc.
@@ -3362,6 +3516,71 @@ axl_bool           vortex_frame_mime_process          (VortexFrame * frame)
 	return axl_false;
 }
 
+/** 
+ * @brief Lazy version of \ref vortex_frame_mime_process: it only
+ * locates the MIME body part, leaving MIME headers to be parsed the
+ * first time they are accessed (\ref vortex_frame_get_mime_header,
+ * \ref vortex_frame_get_content_type...).
+ *
+ * The body is located by jumping from one LF to the next one
+ * (memchr) until an empty line is found, so frames whose MIME
+ * headers are never read don't pay for parsing and allocating
+ * them. MIME header format errors are not reported by this function
+ * but when headers are parsed (they are found empty).
+ *
+ * This is used by the vortex reader for profiles configured with
+ * \ref VORTEX_AUTOMATIC_MIME_LAZY_PARSE (see \ref
+ * vortex_profiles_set_automatic_mime).
+ * 
+ * @param frame The frame to be reconfigured.
+ * 
+ * @return axl_true if the frame processing was ok, otherwise axl_false is
+ * returned.
+ */
+axl_bool           vortex_frame_mime_process_lazy     (VortexFrame * frame)
+{
+	char      * payload;
+	char      * cursor;
+	int         iterator;
+
+	/* check reference */
+	v_return_val_if_fail (frame, axl_false);
+
+	/* MIME message without headers (or wrong frame type): there
+	 * is nothing to defer */
+	payload  = frame->payload;
+	if (frame->type == VORTEX_FRAME_TYPE_SEQ || frame->size <= 1 ||
+	    (payload[0] == '\x0D' && payload[1] == '\x0A') || payload[0] == '\x0A')
+		return vortex_frame_mime_process (frame);
+
+	/* find the empty line that terminates MIME headers */
+	cursor = payload;
+	while ((cursor = memchr (cursor, '\x0A', frame->size - (cursor - payload))) != NULL) {
+		/* position after the LF */
+		iterator = (cursor - payload) + 1;
+
+		/* check to stop processing: LF */
+		if (iterator < frame->size && payload[iterator] == '\x0A') {
+			vortex_frame_reconfigure_mime (frame, iterator, 1);
+			frame->mime_lazy = axl_true;
+			return axl_true;
+		} /* end if */
+
+		/* check to stop processing: CR-LF */
+		if ((iterator + 1) < frame->size && payload[iterator] == '\x0D' && payload[iterator + 1] == '\x0A') {
+			vortex_frame_reconfigure_mime (frame, iterator, 2);
+			frame->mime_lazy = axl_true;
+			return axl_true;
+		} /* end if */
+
+		/* next line */
+		cursor++;
+	} /* end while */
+
+	/* no body found, let the full parser to report the error */
+	return vortex_frame_mime_process (frame);
+}
+
 /** 
  * @brief Allows to configure a new MIME header on the provided \ref
  * VortexFrame reference.
@@ -3398,6 +3617,9 @@ void          vortex_frame_set_mime_header       (VortexFrame * frame,
 	v_return_if_fail (frame);
 	v_return_if_fail (mime_header);
 
+	/* parse headers received not parsed yet */
+	vortex_frame_mime_parse_pending (frame);
+
 	/* check if the mime header hash is created */
 	if (frame->mime_headers == NULL)
 		frame->mime_headers = vortex_frame_mime_status_new ();
@@ -3536,6 +3758,9 @@ VortexMimeHeader *  vortex_frame_get_mime_header       (VortexFrame * frame,
 	v_return_val_if_fail (frame,       NULL);
 	v_return_val_if_fail (mime_header, NULL);
 
+	/* parse headers received not parsed yet */
+	vortex_frame_mime_parse_pending (frame);
+
 	/* check basic case where the hash wasn't created */
 	if (frame->mime_headers == NULL)
 		return NULL;
@@ -3654,7 +3879,51 @@ axl_bool                vortex_frame_mime_status_is_available  (VortexFrame * fr
 {
 	v_return_val_if_fail (frame, axl_false);
 	/* return a reference check */
-	return (frame->mime_headers != NULL);
+	return (frame->mime_headers != NULL) || frame->mime_lazy;
+}
+
+/** 
+ * @internal Records current time as the moment the frame was
+ * received (used to measure how long it waits before being
+ * delivered, see \ref vortex_metrics_enable).
+ * 
+ * @param frame The frame to update.
+ */
+void                    vortex_frame_set_received_stamp  (VortexFrame * frame)
+{
+	if (frame == NULL)
+		return;
+	gettimeofday (&frame->received_stamp, NULL);
+	return;
+}
+
+/** 
+ * @internal Returns the stamp configured by \ref
+ * vortex_frame_set_received_stamp.
+ * 
+ * @param frame The frame to check.
+ * 
+ * @return A reference to the stamp (tv_sec is 0 if it was never
+ * configured) or NULL if the frame is NULL.
+ */
+struct timeval        * vortex_frame_get_received_stamp  (VortexFrame * frame)
+{
+	v_return_val_if_fail (frame, NULL);
+	return &frame->received_stamp;
+}
+
+/** 
+ * @internal Returns a reference to the stamp updated by trace points
+ * (see \ref vortex_trace_set_handler).
+ * 
+ * @param frame The frame to check.
+ * 
+ * @return A reference to the stamp or NULL if the frame is NULL.
+ */
+struct timeval        * vortex_frame_get_trace_stamp     (VortexFrame * frame)
+{
+	v_return_val_if_fail (frame, NULL);
+	return &frame->trace_stamp;
 }
 
 /* @} */
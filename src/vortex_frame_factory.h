@@ -80,6 +80,16 @@ char  * vortex_frame_build_up_from_params_s_buffer (VortexFrameType   type,
  						    char         *    buffer,
  						    int               buffer_size);
 
+int     vortex_frame_build_header_s_buffer         (VortexFrameType   type,
+						    int               channel,
+						    int               msgno,
+						    axl_bool          more,
+						    unsigned int      seqno,
+						    int               size,
+						    int               ansno,
+						    char         *    buffer,
+						    int               buffer_size);
+
 char  *        vortex_frame_seq_build_up_from_params (int           channel_num,
 						      unsigned int  ackno,
 						      int           window_size);
@@ -227,6 +237,10 @@ axl_bool      vortex_frame_is_mime_message       (VortexFrame * frame);
 
 axl_bool      vortex_frame_mime_process          (VortexFrame * frame);
 
+axl_bool      vortex_frame_mime_process_lazy     (VortexFrame * frame);
+
+void          vortex_frame_mime_parse_pending    (VortexFrame * frame);
+
 void          vortex_frame_set_mime_header       (VortexFrame * frame,
 						  const char  * mime_header,
 						  const char  * mime_header_content);
@@ -264,6 +278,12 @@ int                vortex_frame_mime_header_count      (VortexMimeHeader * heade
 
 axl_bool           vortex_frame_mime_status_is_available  (VortexFrame * frame);
 
+void               vortex_frame_set_received_stamp     (VortexFrame * frame);
+
+struct timeval   * vortex_frame_get_received_stamp     (VortexFrame * frame);
+
+struct timeval   * vortex_frame_get_trace_stamp        (VortexFrame * frame);
+
 /* @} */
 
 #endif
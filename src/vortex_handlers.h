@@ -525,6 +525,23 @@ typedef int      (*VortexReceiveHandler)         (VortexConnection * connection,
 						  char             * buffer,
 						  int                buffer_len);
 
+/** 
+ * @brief Defines the handler used by the vortex reader to check if
+ * the receive handler configured on a connection has content already
+ * buffered that can be read without waiting (and that is not
+ * notified by the I/O waiting mechanism because it was already
+ * removed from the socket, for example, decrypted TLS records).
+ *
+ * This handler is used by:
+ *  - \ref vortex_connection_set_pending_input_handler
+ *
+ * @param connection The Vortex connection to check.
+ *
+ * @return axl_true if there is content that can be read right now,
+ * otherwise axl_false.
+ */
+typedef axl_bool (*VortexPendingInputHandler)    (VortexConnection * connection);
+
 /** 
  * @brief Allows to set a handler that will be called when a
  * connection is about being closed.
@@ -1207,6 +1224,62 @@ typedef void (* VortexPayloadFeederFinishedHandler) (VortexChannel        * chan
 						     VortexPayloadFeeder  * feeder,
 						     axlPointer             user_data);
 
+/** 
+ * @brief Function used to write content received into a \ref
+ * VortexPayloadSink. The handler receives the operation to implement
+ * (\ref VortexPayloadSinkOp) and its parameters.
+ *
+ * The handler is called from the vortex reader thread so it must
+ * not block more than required to write the content provided.
+ */
+typedef axl_bool (* VortexPayloadSinkHandler) (VortexCtx              * ctx,
+					       VortexPayloadSinkOp      op_type,
+					       VortexPayloadSink      * sink,
+					       axlPointer               param1,
+					       axlPointer               param2,
+					       axlPointer               user_data);
+
+/** 
+ * @brief Handler used to get a notification when a payload sink has
+ * received the complete message.
+ *
+ * This handler is used by:
+ *
+ * - \ref vortex_payload_sink_set_on_finished
+ *
+ * @param channel The channel where the message was received.
+ * @param sink The sink that received the content.
+ * @param msg_no The message number of the message received.
+ * @param total_size Total amount of bytes written into the sink.
+ * @param status axl_true if all content was written, otherwise axl_false.
+ * @param user_data User defined pointer.
+ */
+typedef void (* VortexPayloadSinkFinishedHandler) (VortexChannel        * channel,
+						   VortexPayloadSink    * sink,
+						   int                    msg_no,
+						   long                   total_size,
+						   axl_bool               status,
+						   axlPointer             user_data);
+
+/** 
+ * @brief Handler used to create payload sinks for incoming messages
+ * on channels running a particular profile.
+ *
+ * This handler is used by:
+ *
+ * - \ref vortex_profiles_set_payload_sink_handler
+ *
+ * @param channel The channel where a new message is starting to be received.
+ * @param frame The first frame of the message.
+ * @param user_data User defined pointer.
+ *
+ * @return A new sink that will receive the message content or NULL
+ * to deliver the message as usual.
+ */
+typedef VortexPayloadSink * (* VortexPayloadSinkCreateHandler) (VortexChannel  * channel,
+								VortexFrame    * frame,
+								axlPointer       user_data);
+
 /** 
  * @brief Port sharing handler definition used by those functions that
  * tries to detect alternative transports that must be activated
@@ -1239,6 +1312,47 @@ typedef void (* VortexPayloadFeederFinishedHandler) (VortexChannel        * chan
  */
 typedef int (*VortexPortShareHandler) (VortexCtx * ctx, VortexConnection * listener, VortexConnection * conn, VORTEX_SOCKET _session, const char * bytes, axlPointer user_data);
 
+/** 
+ * @brief Continuation handler called when a \ref VortexReply
+ * completes.
+ *
+ * This handler is used by:
+ *
+ * - \ref vortex_reply_set_handler
+ *
+ * The handler is executed from the vortex thread pool, so it may
+ * block or send new messages.
+ *
+ * @param reply The reply future that was completed.
+ *
+ * @param frame The reply received (RPY or ERR) or NULL if the
+ * connection was broken before the reply arrived. The frame is owned
+ * by the reply object: it is released by \ref vortex_reply_release.
+ *
+ * @param user_data User defined pointer.
+ */
+typedef void (* VortexReplyHandler) (VortexReply * reply,
+				     VortexFrame * frame,
+				     axlPointer    user_data);
+
+/** 
+ * @brief Handler called each time a frame or message reaches a trace
+ * point (see \ref vortex_trace_set_handler).
+ *
+ * The handler is called from the thread that reached the point
+ * (reader, thread pool or sequencer) so it must be thread safe and
+ * return quickly (for example, copying the span into a ring buffer).
+ *
+ * @param ctx The context where the span was recorded.
+ *
+ * @param span The span recorded (only valid during the call).
+ *
+ * @param user_data User defined pointer.
+ */
+typedef void (* VortexTraceHandler) (VortexCtx       * ctx,
+				     VortexTraceSpan * span,
+				     axlPointer        user_data);
+
 				      
 /** 
  * @internal Handler used for debugging. Not really useful for end user application.
@@ -0,0 +1,515 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+#define LOG_DOMAIN "vortex-log-async"
+
+#include <vortex_log_async.h>
+
+/* local private header */
+#include <vortex_ctx_private.h>
+
+/** 
+ * @internal Number of rings used to store pending records. Each
+ * thread always writes into the same ring (selected from its thread
+ * key) so threads logging at the same time rarely share a ring.
+ */
+#define VORTEX_LOG_ASYNC_RINGS        16
+
+/** 
+ * @internal Default amount of records per ring.
+ */
+#define VORTEX_LOG_ASYNC_RING_SIZE    128
+
+/** 
+ * @internal Max size of a preformatted message (longer messages are
+ * truncated).
+ */
+#define VORTEX_LOG_ASYNC_MESSAGE_SIZE 512
+
+/** 
+ * @internal Period (microseconds) used by the writer thread to drain
+ * rings.
+ */
+#define VORTEX_LOG_ASYNC_PERIOD       100000
+
+#if ! defined(va_copy)
+/* platforms without va_copy (where va_list can be assigned) */
+#define va_copy(dest, src) ((dest) = (src))
+#endif
+
+typedef struct _VortexLogAsyncRecord {
+	struct timeval     stamp;
+	const char       * file;
+	int                line;
+	VortexDebugLevel   level;
+	char               message[VORTEX_LOG_ASYNC_MESSAGE_SIZE];
+} VortexLogAsyncRecord;
+
+typedef struct _VortexLogAsyncRing {
+	VortexMutex            mutex;
+	VortexLogAsyncRecord * records;
+	int                    head;
+	int                    count;
+	long                   dropped;
+} VortexLogAsyncRing;
+
+struct _VortexLogAsync {
+	VortexCtx            * ctx;
+	axl_bool               active;
+	int                    ring_size;
+	VortexLogAsyncRing     rings[VORTEX_LOG_ASYNC_RINGS];
+
+	/* writer thread */
+	VortexThread           writer;
+	VortexMutex            mutex;
+	VortexCond             cond;
+	VortexLogAsyncRecord * batch;
+	FILE                 * file;
+	long                   dropped_reported;
+};
+
+/** 
+ * @internal Calls the handlers configured with a message already
+ * formatted. Handlers expecting a prepared string (\ref
+ * vortex_log_set_prepare_log) get it as is, otherwise they get "%s"
+ * with the message as argument (passed by the caller as the only
+ * variable argument).
+ */
+void __vortex_log_async_notify (VortexCtx * ctx, VortexLogAsyncRecord * record, ...)
+{
+	va_list      args;
+	const char * message = ctx->prepare_log_string ? record->message : "%s";
+
+	va_start (args, record);
+	if (ctx->debug_handler)
+		ctx->debug_handler (record->file, record->line, record->level, message, args);
+	va_end (args);
+
+	va_start (args, record);
+	if (ctx->debug_handler2)
+		ctx->debug_handler2 (ctx, record->file, record->line, record->level, message, ctx->debug_handler2_user_data, args);
+	va_end (args);
+
+	return;
+}
+
+/** 
+ * @internal Writes a record into the file configured, the handlers
+ * installed or the console, in that order.
+ */
+void __vortex_log_async_write (VortexLogAsync * async, VortexLogAsyncRecord * record)
+{
+	VortexCtx  * ctx  = async->ctx;
+	FILE       * out  = async->file ? async->file : stdout;
+	const char * level;
+
+	/* no file configured: use handlers if defined */
+	if (async->file == NULL && (ctx->debug_handler || ctx->debug_handler2)) {
+		__vortex_log_async_notify (ctx, record, record->message);
+		return;
+	} /* end if */
+
+	switch (record->level) {
+	case VORTEX_LEVEL_WARNING:
+		level = "warning";
+		break;
+	case VORTEX_LEVEL_CRITICAL:
+		level = "critical";
+		break;
+	default:
+		level = "debug";
+		break;
+	} /* end switch */
+
+	fprintf (out, "(%d.%d proc %d): (%s) %s:%d %s\n",
+		 (int) record->stamp.tv_sec, (int) record->stamp.tv_usec, getpid (), level,
+		 record->file ? record->file : "", record->line, record->message);
+	return;
+}
+
+/** 
+ * @internal Moves all pending records from every ring into the writer
+ * batch and writes them. Ring locks are only held while copying.
+ */
+void __vortex_log_async_drain (VortexLogAsync * async)
+{
+	VortexLogAsyncRing   * ring;
+	VortexLogAsyncRecord   record;
+	int                    iterator;
+	int                    count;
+	int                    first;
+	int                    size;
+	long                   dropped = 0;
+
+	for (iterator = 0; iterator < VORTEX_LOG_ASYNC_RINGS; iterator++) {
+		ring = &async->rings[iterator];
+
+		/* copy pending records (in two parts if the ring wraps) */
+		vortex_mutex_lock (&ring->mutex);
+		count = ring->count;
+		first = async->ring_size - ring->head;
+		if (first > count)
+			first = count;
+		memcpy (async->batch, ring->records + ring->head, sizeof (VortexLogAsyncRecord) * first);
+		memcpy (async->batch + first, ring->records, sizeof (VortexLogAsyncRecord) * (count - first));
+		ring->head  = (ring->head + count) % async->ring_size;
+		ring->count = 0;
+		dropped    += ring->dropped;
+		vortex_mutex_unlock (&ring->mutex);
+
+		/* write them without holding the ring */
+		for (first = 0; first < count; first++)
+			__vortex_log_async_write (async, &async->batch[first]);
+	} /* end for */
+
+	/* report records dropped since last drain */
+	if (dropped > async->dropped_reported) {
+		memset (&record, 0, sizeof (VortexLogAsyncRecord));
+		gettimeofday (&record.stamp, NULL);
+		record.file  = __AXL_FILE__;
+		record.line  = __AXL_LINE__;
+		record.level = VORTEX_LEVEL_WARNING;
+		axl_stream_printf_buffer (record.message, VORTEX_LOG_ASYNC_MESSAGE_SIZE, &size,
+					  "async log rings full, %ld records dropped (%ld total)",
+					  dropped - async->dropped_reported, dropped);
+		__vortex_log_async_write (async, &record);
+		async->dropped_reported = dropped;
+	} /* end if */
+
+	if (async->file)
+		fflush (async->file);
+	else if (! (async->ctx->debug_handler || async->ctx->debug_handler2))
+		fflush (stdout);
+	return;
+}
+
+/** 
+ * @internal Writer thread: drains rings periodically until the sink
+ * is disabled, draining them one last time before finishing.
+ */
+axlPointer __vortex_log_async_run (VortexLogAsync * async)
+{
+	vortex_mutex_lock (&async->mutex);
+	while (async->active) {
+		vortex_mutex_unlock (&async->mutex);
+		__vortex_log_async_drain (async);
+		vortex_mutex_lock (&async->mutex);
+
+		/* wait for next period (or a stop notification) */
+		if (async->active)
+			vortex_cond_timedwait (&async->cond, &async->mutex, VORTEX_LOG_ASYNC_PERIOD);
+	} /* end while */
+	vortex_mutex_unlock (&async->mutex);
+
+	/* flush records pushed before the sink was disabled */
+	__vortex_log_async_drain (async);
+	return NULL;
+}
+
+/** 
+ * @brief Enables asynchronous log delivery on the provided context.
+ *
+ * Once enabled, each log message that passes current log
+ * configuration (see \ref vortex_log_enable and \ref
+ * vortex_log_filter_level) is formatted by the calling thread into a
+ * preallocated ring record and returned immediately: the calling
+ * thread never writes to the console or file, nor waits for other
+ * threads doing so. A background writer thread drains records
+ * periodically and writes them to the file provided or, if no file
+ * is provided, to the handlers configured (\ref
+ * vortex_log_set_handler, \ref vortex_log_set_handler_full) or to the
+ * console.
+ *
+ * When a ring is full, new records are dropped instead of waiting
+ * for the writer. Dropped records are counted (\ref
+ * vortex_log_async_get_dropped) and reported by the writer.
+ *
+ * Some considerations:
+ *
+ * - Handlers are called from the writer thread with the message
+ * already formatted: as is if \ref vortex_log_set_prepare_log is
+ * enabled, otherwise as the argument of a "%s" format.
+ *
+ * - Messages longer than 512 bytes are truncated.
+ *
+ * - Delivery is delayed up to 100ms.
+ *
+ * @param ctx The context where the async log will be enabled.
+ *
+ * @param file_path Optional file where records are appended. If NULL
+ * is provided, handlers or the console are used.
+ *
+ * @param ring_size Amount of records each ring can hold before
+ * dropping (or -1 to use default value: 128). The value is only
+ * used the first time async log is enabled on a context.
+ *
+ * @return axl_true if async log was enabled, otherwise axl_false is
+ * returned (already enabled, file can't be opened or writer thread
+ * failed to start).
+ */
+axl_bool     vortex_log_async_enable      (VortexCtx    * ctx,
+					   const char   * file_path,
+					   int            ring_size)
+{
+	VortexLogAsync * async;
+	int              iterator;
+
+	v_return_val_if_fail (ctx, axl_false);
+
+	/* check it is not already enabled */
+	async = ctx->log_async;
+	if (async != NULL && async->active)
+		return axl_false;
+
+	/* first time, create rings */
+	if (async == NULL) {
+		async            = axl_new (VortexLogAsync, 1);
+		VORTEX_CHECK_REF (async, axl_false);
+		async->ctx       = ctx;
+		async->ring_size = ring_size > 0 ? ring_size : VORTEX_LOG_ASYNC_RING_SIZE;
+		async->batch     = axl_new (VortexLogAsyncRecord, async->ring_size);
+		VORTEX_CHECK_REF2 (async->batch, axl_false, async, axl_free);
+
+		for (iterator = 0; iterator < VORTEX_LOG_ASYNC_RINGS; iterator++) {
+			async->rings[iterator].records = axl_new (VortexLogAsyncRecord, async->ring_size);
+			vortex_mutex_create (&async->rings[iterator].mutex);
+		} /* end for */
+		vortex_mutex_create (&async->mutex);
+		vortex_cond_create (&async->cond);
+
+		/* rings are never released until the context is
+		 * finished (see __vortex_log_async_cleanup) so a thread
+		 * racing with disable never uses released memory */
+		ctx->log_async = async;
+	} /* end if */
+
+	/* open the file requested */
+	if (file_path != NULL) {
+		async->file = fopen (file_path, "a");
+		if (async->file == NULL) {
+			vortex_log (VORTEX_LEVEL_CRITICAL, "unable to open async log file %s, errno=%d", file_path, errno);
+			return axl_false;
+		} /* end if */
+	} /* end if */
+
+	/* start the writer */
+	async->active = axl_true;
+	if (! vortex_thread_create (&async->writer,
+				    (VortexThreadFunc) __vortex_log_async_run,
+				    async,
+				    VORTEX_THREAD_CONF_END)) {
+		async->active = axl_false;
+		if (async->file)
+			fclose (async->file);
+		async->file = NULL;
+		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to start async log writer thread");
+		return axl_false;
+	} /* end if */
+
+	return axl_true;
+}
+
+/** 
+ * @brief Disables asynchronous log delivery, writing pending records
+ * and stopping the writer thread. Log messages produced after this
+ * call are written as usual by the calling thread.
+ *
+ * @param ctx The context where the async log will be disabled.
+ */
+void         vortex_log_async_disable     (VortexCtx    * ctx)
+{
+	VortexLogAsync * async;
+
+	v_return_if_fail (ctx);
+
+	async = ctx->log_async;
+	if (async == NULL || ! async->active)
+		return;
+
+	/* flag as not active: threads pushing check it with the ring
+	 * locked, so after the writer's last drain no record is left */
+	vortex_mutex_lock (&async->mutex);
+	async->active = axl_false;
+	vortex_cond_signal (&async->cond);
+	vortex_mutex_unlock (&async->mutex);
+
+	/* wait writer to finish */
+	vortex_thread_destroy (&async->writer, axl_false);
+
+	/* close file */
+	if (async->file)
+		fclose (async->file);
+	async->file = NULL;
+
+	return;
+}
+
+/** 
+ * @brief Allows to check if asynchronous log delivery is enabled
+ * (\ref vortex_log_async_enable).
+ *
+ * @param ctx The context to check.
+ *
+ * @return axl_true if enabled, otherwise axl_false.
+ */
+axl_bool     vortex_log_async_is_enabled  (VortexCtx    * ctx)
+{
+	v_return_val_if_fail (ctx, axl_false);
+	return ctx->log_async != NULL && ctx->log_async->active;
+}
+
+/** 
+ * @brief Returns the amount of log records dropped because rings
+ * were full since async log was first enabled on the provided
+ * context.
+ *
+ * @param ctx The context to check.
+ *
+ * @return Records dropped or 0 if async log was never enabled.
+ */
+long         vortex_log_async_get_dropped (VortexCtx    * ctx)
+{
+	VortexLogAsync * async;
+	int              iterator;
+	long             dropped = 0;
+
+	v_return_val_if_fail (ctx, 0);
+
+	async = ctx->log_async;
+	if (async == NULL)
+		return 0;
+
+	for (iterator = 0; iterator < VORTEX_LOG_ASYNC_RINGS; iterator++) {
+		vortex_mutex_lock (&async->rings[iterator].mutex);
+		dropped += async->rings[iterator].dropped;
+		vortex_mutex_unlock (&async->rings[iterator].mutex);
+	} /* end for */
+
+	return dropped;
+}
+
+/** 
+ * @internal Stores a log message into the ring associated to the
+ * calling thread. Called by _vortex_log_common once the message
+ * passed log configuration.
+ *
+ * @return axl_true if the message was handled (stored or dropped
+ * because the ring was full), axl_false if async log is not active
+ * (or was disabled meanwhile) and the message must be written by the
+ * caller (args are left untouched).
+ */
+axl_bool     __vortex_log_async_push      (VortexCtx        * ctx,
+					   const char       * file,
+					   int                line,
+					   VortexDebugLevel   log_level,
+					   const char       * message,
+					   va_list            args)
+{
+	VortexLogAsync       * async = ctx->log_async;
+	VortexLogAsyncRing   * ring;
+	VortexLogAsyncRecord * record;
+	char                   buffer[VORTEX_LOG_ASYNC_MESSAGE_SIZE];
+	struct timeval         stamp;
+	va_list                copy;
+
+	if (async == NULL || ! async->active)
+		return axl_false;
+
+	/* format outside the ring lock (on a copy, so the caller can
+	 * still use args if the message isn't stored) */
+	gettimeofday (&stamp, NULL);
+	va_copy (copy, args);
+	vsnprintf (buffer, VORTEX_LOG_ASYNC_MESSAGE_SIZE, message, copy);
+	va_end (copy);
+
+	/* select the ring for this thread */
+	ring = &async->rings[__vortex_thread_self_index (VORTEX_LOG_ASYNC_RINGS)];
+
+	vortex_mutex_lock (&ring->mutex);
+	if (! async->active) {
+		/* disabled meanwhile: writer may have done its last
+		 * drain, let the caller write it synchronously */
+		vortex_mutex_unlock (&ring->mutex);
+		return axl_false;
+	} /* end if */
+
+	if (ring->count == async->ring_size) {
+		/* full: drop record */
+		ring->dropped++;
+		vortex_mutex_unlock (&ring->mutex);
+		return axl_true;
+	} /* end if */
+
+	record        = &ring->records[(ring->head + ring->count) % async->ring_size];
+	record->stamp = stamp;
+	record->file  = file;
+	record->line  = line;
+	record->level = log_level;
+	memcpy (record->message, buffer, VORTEX_LOG_ASYNC_MESSAGE_SIZE);
+	ring->count++;
+	vortex_mutex_unlock (&ring->mutex);
+
+	return axl_true;
+}
+
+/** 
+ * @internal Stops async log (if enabled) and releases its rings. Called
+ * when the context is finished.
+ */
+void         __vortex_log_async_cleanup   (VortexCtx    * ctx)
+{
+	VortexLogAsync * async;
+	int              iterator;
+
+	if (ctx == NULL || ctx->log_async == NULL)
+		return;
+
+	vortex_log_async_disable (ctx);
+
+	async          = ctx->log_async;
+	ctx->log_async = NULL;
+	for (iterator = 0; iterator < VORTEX_LOG_ASYNC_RINGS; iterator++) {
+		vortex_mutex_destroy (&async->rings[iterator].mutex);
+		axl_free (async->rings[iterator].records);
+	} /* end for */
+	vortex_mutex_destroy (&async->mutex);
+	vortex_cond_destroy (&async->cond);
+	axl_free (async->batch);
+	axl_free (async);
+
+	return;
+}
@@ -0,0 +1,73 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+
+#ifndef __VORTEX_LOG_ASYNC_H__
+#define __VORTEX_LOG_ASYNC_H__
+
+#include <vortex.h>
+
+/** 
+ * \addtogroup vortex_log_async Vortex Async Log: deferred log delivery through a background writer
+ * @{
+ */
+
+axl_bool     vortex_log_async_enable      (VortexCtx    * ctx,
+					   const char   * file_path,
+					   int            ring_size);
+
+void         vortex_log_async_disable     (VortexCtx    * ctx);
+
+axl_bool     vortex_log_async_is_enabled  (VortexCtx    * ctx);
+
+long         vortex_log_async_get_dropped (VortexCtx    * ctx);
+
+/* internal API */
+axl_bool     __vortex_log_async_push      (VortexCtx        * ctx,
+					   const char       * file,
+					   int                line,
+					   VortexDebugLevel   log_level,
+					   const char       * message,
+					   va_list            args);
+
+void         __vortex_log_async_cleanup   (VortexCtx    * ctx);
+
+#endif
+
+/** 
+ * @}
+ */
@@ -0,0 +1,915 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+#define LOG_DOMAIN "vortex-metrics"
+
+#include <vortex_metrics.h>
+
+/* local private header */
+#include <vortex_ctx_private.h>
+
+/** 
+ * @internal Number of shards used by each series. Each thread always
+ * records into the same shard (selected from its thread key) so
+ * threads recording at the same time rarely share a lock.
+ */
+#define VORTEX_METRICS_SHARDS     8
+
+/** 
+ * @internal Histogram buckets: values 0..3 usecs get their own
+ * bucket and, after that, each power of two is split into 4 linear
+ * sub-buckets (HDR style, 25% precision) up to 2^30 usecs (~18
+ * minutes). Longer values are accounted in the last bucket.
+ */
+#define VORTEX_METRICS_MAGNITUDES 28
+#define VORTEX_METRICS_BUCKETS    (4 + VORTEX_METRICS_MAGNITUDES * 4)
+
+typedef struct _VortexMetricsHistogram {
+	long      count;
+	long      sum;
+	long      max;
+	long      buckets[VORTEX_METRICS_BUCKETS];
+} VortexMetricsHistogram;
+
+typedef struct _VortexMetricsShard {
+	VortexMutex              mutex;
+	VortexMetricsHistogram   histograms[VORTEX_METRIC_LAST];
+	long                     counters[VORTEX_COUNTER_LAST];
+} VortexMetricsShard;
+
+struct _VortexMetricsSeries {
+	char                   * profile;
+	VortexMetricsShard       shards[VORTEX_METRICS_SHARDS];
+};
+
+struct _VortexMetrics {
+	axl_bool                 enabled;
+	VortexMutex              mutex;
+	/* series without profile */
+	VortexMetricsSeries    * global;
+	/* series by profile: hash for lookups, list to keep order */
+	axlHash                * profiles;
+	axlList                * series;
+};
+
+/** 
+ * @internal Returns the bucket where the value provided is accounted.
+ */
+int __vortex_metrics_bucket (long usecs)
+{
+	int magnitude = 0;
+
+	if (usecs < 4)
+		return usecs < 0 ? 0 : (int) usecs;
+
+	/* find the power of two, keeping two bits of precision */
+	while (usecs >= 8) {
+		usecs >>= 1;
+		magnitude++;
+	} /* end while */
+
+	if (magnitude >= VORTEX_METRICS_MAGNITUDES)
+		return VORTEX_METRICS_BUCKETS - 1;
+	return 4 + magnitude * 4 + (int) (usecs - 4);
+}
+
+/** 
+ * @internal Returns the highest value (usecs) accounted by the bucket
+ * provided.
+ */
+long __vortex_metrics_bucket_limit (int bucket)
+{
+	if (bucket < 4)
+		return bucket;
+	return ((long) (5 + ((bucket - 4) % 4)) << ((bucket - 4) / 4)) - 1;
+}
+
+VortexMetricsSeries * __vortex_metrics_series_new (const char * profile)
+{
+	VortexMetricsSeries * series;
+	int                   iterator;
+
+	series          = axl_new (VortexMetricsSeries, 1);
+	if (series == NULL)
+		return NULL;
+	series->profile = axl_strdup (profile);
+	for (iterator = 0; iterator < VORTEX_METRICS_SHARDS; iterator++)
+		vortex_mutex_create (&series->shards[iterator].mutex);
+
+	return series;
+}
+
+void __vortex_metrics_series_free (VortexMetricsSeries * series)
+{
+	int iterator;
+
+	if (series == NULL)
+		return;
+	for (iterator = 0; iterator < VORTEX_METRICS_SHARDS; iterator++)
+		vortex_mutex_destroy (&series->shards[iterator].mutex);
+	axl_free (series->profile);
+	axl_free (series);
+	return;
+}
+
+/** 
+ * @internal Returns the series where values for the profile provided
+ * are accounted, creating it if required.
+ */
+VortexMetricsSeries * __vortex_metrics_series_get (VortexMetrics * metrics, const char * profile, axl_bool create)
+{
+	VortexMetricsSeries * series;
+
+	if (profile == NULL)
+		return metrics->global;
+
+	vortex_mutex_lock (&metrics->mutex);
+	series = axl_hash_get (metrics->profiles, (axlPointer) profile);
+	if (series == NULL && create) {
+		series = __vortex_metrics_series_new (profile);
+		if (series != NULL) {
+			axl_hash_insert (metrics->profiles, series->profile, series);
+			axl_list_append (metrics->series, series);
+		} /* end if */
+	} /* end if */
+	vortex_mutex_unlock (&metrics->mutex);
+
+	return series;
+}
+
+/** 
+ * @internal Returns the series where values for the profile provided
+ * (or without profile if NULL) are accounted, creating it if
+ * required, or NULL if metrics were never enabled. Used by channels
+ * to resolve their series once.
+ */
+VortexMetricsSeries * __vortex_metrics_series_resolve (VortexCtx     * ctx,
+						       const char    * profile)
+{
+	if (ctx == NULL || ctx->metrics == NULL)
+		return NULL;
+	return __vortex_metrics_series_get (ctx->metrics, profile, axl_true);
+}
+
+/** 
+ * @internal Returns the shard of the series provided used by the
+ * calling thread.
+ */
+VortexMetricsShard * __vortex_metrics_shard (VortexMetricsSeries * series)
+{
+	return &series->shards[__vortex_thread_self_index (VORTEX_METRICS_SHARDS)];
+}
+
+/** 
+ * @internal Adds all shards for the counter provided.
+ */
+long __vortex_metrics_series_counter (VortexMetricsSeries * series, VortexMetricCounter counter)
+{
+	long result = 0;
+	int  iterator;
+
+	for (iterator = 0; iterator < VORTEX_METRICS_SHARDS; iterator++) {
+		vortex_mutex_lock (&series->shards[iterator].mutex);
+		result += series->shards[iterator].counters[counter];
+		vortex_mutex_unlock (&series->shards[iterator].mutex);
+	} /* end for */
+
+	return result;
+}
+
+/** 
+ * @internal Merges all shards for the metric provided into the
+ * histogram provided.
+ */
+void __vortex_metrics_series_merge (VortexMetricsSeries * series, VortexMetric metric, VortexMetricsHistogram * result)
+{
+	VortexMetricsShard     * shard;
+	VortexMetricsHistogram * histogram;
+	int                      iterator;
+	int                      bucket;
+
+	for (iterator = 0; iterator < VORTEX_METRICS_SHARDS; iterator++) {
+		shard     = &series->shards[iterator];
+		histogram = &shard->histograms[metric];
+
+		vortex_mutex_lock (&shard->mutex);
+		result->count += histogram->count;
+		result->sum   += histogram->sum;
+		if (histogram->max > result->max)
+			result->max = histogram->max;
+		for (bucket = 0; bucket < VORTEX_METRICS_BUCKETS; bucket++)
+			result->buckets[bucket] += histogram->buckets[bucket];
+		vortex_mutex_unlock (&shard->mutex);
+	} /* end for */
+
+	return;
+}
+
+/** 
+ * @internal Returns the value (usecs) under which the percentage of
+ * values provided were accounted.
+ */
+long __vortex_metrics_percentile (VortexMetricsHistogram * histogram, int percentage)
+{
+	long rank;
+	long accum = 0;
+	long limit;
+	int  bucket;
+
+	if (histogram->count == 0)
+		return 0;
+
+	rank = (histogram->count * percentage + 99) / 100;
+	for (bucket = 0; bucket < VORTEX_METRICS_BUCKETS; bucket++) {
+		accum += histogram->buckets[bucket];
+		if (accum >= rank) {
+			limit = __vortex_metrics_bucket_limit (bucket);
+			return limit < histogram->max ? limit : histogram->max;
+		} /* end if */
+	} /* end for */
+
+	return histogram->max;
+}
+
+/** 
+ * @internal Returns the name used to export the counter provided and
+ * its help string.
+ */
+const char * __vortex_metrics_counter_name (VortexMetricCounter counter, const char ** help)
+{
+	switch (counter) {
+	case VORTEX_COUNTER_FRAMES_RECEIVED:
+		(*help) = "Frames read from connections.";
+		return "vortex_frames_received_total";
+	case VORTEX_COUNTER_BYTES_RECEIVED:
+		(*help) = "Payload bytes of the frames read.";
+		return "vortex_received_bytes_total";
+	case VORTEX_COUNTER_FRAMES_SENT:
+		(*help) = "Frames written into connections.";
+		return "vortex_frames_sent_total";
+	case VORTEX_COUNTER_BYTES_SENT:
+		(*help) = "Bytes written into connections.";
+		return "vortex_sent_bytes_total";
+	default:
+		break;
+	} /* end switch */
+
+	(*help) = "";
+	return "vortex_unknown_total";
+}
+
+/** 
+ * @internal Returns the name used to export the metric provided and
+ * its help string.
+ */
+const char * __vortex_metrics_name (VortexMetric metric, const char ** help)
+{
+	switch (metric) {
+	case VORTEX_METRIC_FRAME_PARSE:
+		(*help) = "Time spent reading and parsing incoming frames.";
+		return "vortex_frame_parse_seconds";
+	case VORTEX_METRIC_READER_QUEUE:
+		(*help) = "Time since a frame is read until its frame received handler starts.";
+		return "vortex_reader_queue_seconds";
+	case VORTEX_METRIC_HANDLER:
+		(*help) = "Time spent inside frame received handlers.";
+		return "vortex_handler_seconds";
+	case VORTEX_METRIC_SEQUENCER_QUEUE:
+		(*help) = "Time since a message is queued until the sequencer sends its first frame.";
+		return "vortex_sequencer_queue_seconds";
+	case VORTEX_METRIC_SEND:
+		(*help) = "Time spent writing frames into the socket.";
+		return "vortex_send_seconds";
+	case VORTEX_METRIC_SEQ_STALL:
+		(*help) = "Time channels were stalled waiting for a SEQ frame.";
+		return "vortex_seq_stall_seconds";
+	case VORTEX_METRIC_ROUND_TRIP:
+		(*help) = "Time since a MSG is sent until its reply is received.";
+		return "vortex_round_trip_seconds";
+	case VORTEX_METRIC_READER_LOOP:
+		(*help) = "Time spent by the reader loop on each wakeup, excluding the I/O wait.";
+		return "vortex_reader_loop_seconds";
+	default:
+		break;
+	} /* end switch */
+
+	(*help) = "";
+	return "vortex_unknown_seconds";
+}
+
+/** 
+ * @brief Enables or disables metrics collection on the provided
+ * context.
+ *
+ * Once enabled, the library measures where time goes while
+ * processing frames (see \ref VortexMetric for the list of
+ * measurements) and accounts values in latency histograms, by
+ * profile when it applies, together with some counters (see \ref
+ * VortexMetricCounter). Metrics are disabled by default: while
+ * disabled, instrumented code only checks a flag.
+ *
+ * Use \ref vortex_metrics_get to get a snapshot of a metric, \ref
+ * vortex_metrics_get_counter to get a counter or \ref
+ * vortex_metrics_export to get all of them in Prometheus text format.
+ *
+ * Disabling metrics keeps values collected until the context is
+ * finished or \ref vortex_metrics_reset is called.
+ *
+ * @param ctx The context where the operation will be performed.
+ *
+ * @param enable axl_true to enable collection, axl_false to stop it.
+ *
+ * @return axl_true if the operation was completed, otherwise
+ * axl_false is returned (memory allocation failure).
+ */
+axl_bool     vortex_metrics_enable       (VortexCtx             * ctx,
+					  axl_bool                enable)
+{
+	VortexMetrics * metrics;
+
+	v_return_val_if_fail (ctx, axl_false);
+
+	/* first time: create global series. It is not released until
+	 * the context is finished so threads checking the flag never
+	 * use released memory */
+	if (ctx->metrics == NULL && enable) {
+		metrics           = axl_new (VortexMetrics, 1);
+		VORTEX_CHECK_REF (metrics, axl_false);
+		metrics->global   = __vortex_metrics_series_new (NULL);
+		VORTEX_CHECK_REF2 (metrics->global, axl_false, metrics, axl_free);
+		metrics->profiles = axl_hash_new (axl_hash_string, axl_hash_equal_string);
+		metrics->series   = axl_list_new (axl_list_always_return_1, (axlDestroyFunc) __vortex_metrics_series_free);
+		vortex_mutex_create (&metrics->mutex);
+		ctx->metrics      = metrics;
+	} /* end if */
+
+	if (ctx->metrics != NULL)
+		ctx->metrics->enabled = enable;
+	return axl_true;
+}
+
+/** 
+ * @brief Allows to check if metrics collection is enabled (see \ref
+ * vortex_metrics_enable).
+ *
+ * @param ctx The context to check.
+ *
+ * @return axl_true if enabled, otherwise axl_false.
+ */
+axl_bool     vortex_metrics_is_enabled   (VortexCtx             * ctx)
+{
+	return ctx != NULL && ctx->metrics != NULL && ctx->metrics->enabled;
+}
+
+/** 
+ * @brief Clears all values collected on the provided context.
+ *
+ * @param ctx The context where the operation will be performed.
+ */
+void         vortex_metrics_reset        (VortexCtx             * ctx)
+{
+	VortexMetricsSeries * series;
+	int                   iterator;
+	int                   shard;
+
+	if (ctx == NULL || ctx->metrics == NULL)
+		return;
+
+	for (iterator = -1; ; iterator++) {
+		/* global series first, then profiles (series list
+		 * may grow meanwhile) */
+		vortex_mutex_lock (&ctx->metrics->mutex);
+		if (iterator >= axl_list_length (ctx->metrics->series)) {
+			vortex_mutex_unlock (&ctx->metrics->mutex);
+			break;
+		} /* end if */
+		series = iterator < 0 ? ctx->metrics->global : axl_list_get_nth (ctx->metrics->series, iterator);
+		vortex_mutex_unlock (&ctx->metrics->mutex);
+
+		for (shard = 0; shard < VORTEX_METRICS_SHARDS; shard++) {
+			vortex_mutex_lock (&series->shards[shard].mutex);
+			memset (series->shards[shard].histograms, 0, sizeof (series->shards[shard].histograms));
+			memset (series->shards[shard].counters, 0, sizeof (series->shards[shard].counters));
+			vortex_mutex_unlock (&series->shards[shard].mutex);
+		} /* end for */
+	} /* end for */
+
+	return;
+}
+
+/** 
+ * @brief Accounts a value for the metric provided. This is used by
+ * the library to record its own measurements but it can also be
+ * used by profile implementations to account their own values
+ * (for example, \ref VORTEX_METRIC_HANDLER for work done outside
+ * the frame received handler).
+ *
+ * The function does nothing if metrics are not enabled.
+ *
+ * @param ctx The context where the value will be accounted.
+ *
+ * @param metric The metric to update.
+ *
+ * @param profile Optional profile the value applies to (NULL to
+ * account it without profile).
+ *
+ * @param usecs The value measured (microseconds).
+ */
+void         vortex_metrics_record       (VortexCtx             * ctx,
+					  VortexMetric            metric,
+					  const char            * profile,
+					  long                    usecs)
+{
+	if (! vortex_metrics_is_enabled (ctx))
+		return;
+
+	__vortex_metrics_record_series (ctx, __vortex_metrics_series_get (ctx->metrics, profile, axl_true), metric, usecs);
+	return;
+}
+
+/** 
+ * @internal Accounts a value for the metric provided into the series
+ * provided (NULL to account it without profile). Only the shard of
+ * the calling thread is locked.
+ */
+void         __vortex_metrics_record_series (VortexCtx          * ctx,
+					     VortexMetricsSeries * series,
+					     VortexMetric         metric,
+					     long                 usecs)
+{
+	VortexMetricsShard     * shard;
+	VortexMetricsHistogram * histogram;
+
+	if (! vortex_metrics_is_enabled (ctx) || metric < 0 || metric >= VORTEX_METRIC_LAST)
+		return;
+
+	if (series == NULL)
+		series = ctx->metrics->global;
+	shard = __vortex_metrics_shard (series);
+
+	if (usecs < 0)
+		usecs = 0;
+
+	vortex_mutex_lock (&shard->mutex);
+	histogram = &shard->histograms[metric];
+	histogram->count++;
+	histogram->sum += usecs;
+	if (usecs > histogram->max)
+		histogram->max = usecs;
+	histogram->buckets[__vortex_metrics_bucket (usecs)]++;
+	vortex_mutex_unlock (&shard->mutex);
+
+	return;
+}
+
+/** 
+ * @brief Increases the counter provided. Like \ref
+ * vortex_metrics_record, used by the library for its own counters
+ * and available to profile implementations.
+ *
+ * The function does nothing if metrics are not enabled.
+ *
+ * @param ctx The context where the value will be accounted.
+ *
+ * @param counter The counter to update.
+ *
+ * @param profile Optional profile the value applies to (NULL to
+ * account it without profile).
+ *
+ * @param value The amount to add.
+ */
+void         vortex_metrics_count        (VortexCtx             * ctx,
+					  VortexMetricCounter     counter,
+					  const char            * profile,
+					  long                    value)
+{
+	if (! vortex_metrics_is_enabled (ctx))
+		return;
+
+	__vortex_metrics_count_series (ctx, __vortex_metrics_series_get (ctx->metrics, profile, axl_true), counter, value);
+	return;
+}
+
+/** 
+ * @internal Increases the counter provided on the series provided
+ * (NULL to account it without profile).
+ */
+void         __vortex_metrics_count_series  (VortexCtx          * ctx,
+					     VortexMetricsSeries * series,
+					     VortexMetricCounter  counter,
+					     long                 value)
+{
+	VortexMetricsShard * shard;
+
+	if (! vortex_metrics_is_enabled (ctx) || counter < 0 || counter >= VORTEX_COUNTER_LAST)
+		return;
+
+	if (series == NULL)
+		series = ctx->metrics->global;
+	shard = __vortex_metrics_shard (series);
+
+	vortex_mutex_lock (&shard->mutex);
+	shard->counters[counter] += value;
+	vortex_mutex_unlock (&shard->mutex);
+
+	return;
+}
+
+/** 
+ * @brief Returns the current value of the counter provided.
+ *
+ * @param ctx The context where the counter was collected.
+ *
+ * @param counter The counter to report.
+ *
+ * @param profile Optional profile to report. If NULL is provided,
+ * values accounted for all profiles (and without profile) are
+ * reported together.
+ *
+ * @return The counter value (0 if metrics were never enabled).
+ */
+long         vortex_metrics_get_counter  (VortexCtx             * ctx,
+					  VortexMetricCounter     counter,
+					  const char            * profile)
+{
+	VortexMetricsSeries * series;
+	long                  result = 0;
+	int                   iterator;
+
+	v_return_val_if_fail (ctx && ctx->metrics, 0);
+	v_return_val_if_fail (counter >= 0 && counter < VORTEX_COUNTER_LAST, 0);
+
+	if (profile != NULL) {
+		series = __vortex_metrics_series_get (ctx->metrics, profile, axl_false);
+		if (series != NULL)
+			result = __vortex_metrics_series_counter (series, counter);
+	} else {
+		/* all series */
+		result = __vortex_metrics_series_counter (ctx->metrics->global, counter);
+		vortex_mutex_lock (&ctx->metrics->mutex);
+		for (iterator = 0; iterator < axl_list_length (ctx->metrics->series); iterator++) 
+			result += __vortex_metrics_series_counter (axl_list_get_nth (ctx->metrics->series, iterator), counter);
+		vortex_mutex_unlock (&ctx->metrics->mutex);
+	} /* end if */
+
+	return result;
+}
+
+/** 
+ * @brief Gets a snapshot for the metric provided.
+ *
+ * @param ctx The context where the metric was collected.
+ *
+ * @param metric The metric to report.
+ *
+ * @param profile Optional profile to report. If NULL is provided,
+ * values accounted for all profiles (and without profile) are
+ * reported together.
+ *
+ * @param snapshot Caller's structure where the snapshot is
+ * placed. All values are reported in microseconds.
+ *
+ * @return axl_true if the snapshot was filled, otherwise axl_false
+ * (metrics never enabled or wrong parameters).
+ */
+axl_bool     vortex_metrics_get          (VortexCtx             * ctx,
+					  VortexMetric            metric,
+					  const char            * profile,
+					  VortexMetricsSnapshot * snapshot)
+{
+	VortexMetricsHistogram   histogram;
+	VortexMetricsSeries    * series;
+	int                      iterator;
+
+	v_return_val_if_fail (ctx && ctx->metrics && snapshot, axl_false);
+	v_return_val_if_fail (metric >= 0 && metric < VORTEX_METRIC_LAST, axl_false);
+
+	memset (&histogram, 0, sizeof (VortexMetricsHistogram));
+	if (profile != NULL) {
+		series = __vortex_metrics_series_get (ctx->metrics, profile, axl_false);
+		if (series != NULL)
+			__vortex_metrics_series_merge (series, metric, &histogram);
+	} else {
+		/* all series */
+		__vortex_metrics_series_merge (ctx->metrics->global, metric, &histogram);
+		vortex_mutex_lock (&ctx->metrics->mutex);
+		for (iterator = 0; iterator < axl_list_length (ctx->metrics->series); iterator++) 
+			__vortex_metrics_series_merge (axl_list_get_nth (ctx->metrics->series, iterator), metric, &histogram);
+		vortex_mutex_unlock (&ctx->metrics->mutex);
+	} /* end if */
+
+	snapshot->count = histogram.count;
+	snapshot->sum   = histogram.sum;
+	snapshot->max   = histogram.max;
+	snapshot->p50   = __vortex_metrics_percentile (&histogram, 50);
+	snapshot->p90   = __vortex_metrics_percentile (&histogram, 90);
+	snapshot->p99   = __vortex_metrics_percentile (&histogram, 99);
+
+	return axl_true;
+}
+
+/** 
+ * @internal Appends content into the export buffer. Once the buffer
+ * is full, written is set to -1 and later calls do nothing.
+ */
+void __vortex_metrics_append (char * buffer, int buffer_size, int * written, const char * format, ...)
+{
+	va_list args;
+	int     result;
+
+	if ((*written) < 0)
+		return;
+
+	va_start (args, format);
+	result = vsnprintf (buffer + (*written), buffer_size - (*written), format, args);
+	va_end (args);
+
+	if (result < 0 || result >= (buffer_size - (*written))) {
+		(*written) = -1;
+		return;
+	} /* end if */
+
+	(*written) += result;
+	return;
+}
+
+/** 
+ * @internal Writes one series of the metric provided in Prometheus
+ * text format.
+ */
+void __vortex_metrics_export_series (VortexMetricsSeries * series, VortexMetric metric, const char * name,
+				     char * buffer, int buffer_size, int * written)
+{
+	VortexMetricsHistogram   histogram;
+	const char             * label_sep;
+	const char             * label;
+	long                     accum;
+	long                     limit;
+	int                      bucket;
+
+	memset (&histogram, 0, sizeof (VortexMetricsHistogram));
+	__vortex_metrics_series_merge (series, metric, &histogram);
+
+	/* skip series without values */
+	if (histogram.count == 0 && series->profile != NULL)
+		return;
+
+	label     = series->profile ? series->profile : "";
+	label_sep = series->profile ? "\"," : "";
+
+	/* cumulative buckets at each power of two */
+	accum = 0;
+	for (bucket = 0; bucket < VORTEX_METRICS_BUCKETS; bucket++) {
+		accum += histogram.buckets[bucket];
+		if (bucket < 4 || ((bucket - 4) % 4) != 3)
+			continue;
+		limit = __vortex_metrics_bucket_limit (bucket) + 1;
+		__vortex_metrics_append (buffer, buffer_size, written, "%s_bucket{%s%s%sle=\"%ld.%06ld\"} %ld\n",
+					 name, series->profile ? "profile=\"" : "", label, label_sep,
+					 limit / 1000000, limit % 1000000, accum);
+	} /* end for */
+	__vortex_metrics_append (buffer, buffer_size, written, "%s_bucket{%s%s%sle=\"+Inf\"} %ld\n",
+				 name, series->profile ? "profile=\"" : "", label, label_sep, histogram.count);
+
+	/* sum and count */
+	__vortex_metrics_append (buffer, buffer_size, written, "%s_sum%s%s%s %ld.%06ld\n",
+				 name, series->profile ? "{profile=\"" : "", label, series->profile ? "\"}" : "",
+				 histogram.sum / 1000000, histogram.sum % 1000000);
+	__vortex_metrics_append (buffer, buffer_size, written, "%s_count%s%s%s %ld\n",
+				 name, series->profile ? "{profile=\"" : "", label, series->profile ? "\"}" : "",
+				 histogram.count);
+	return;
+}
+
+/** 
+ * @internal Writes one series of the counter provided in Prometheus
+ * text format.
+ */
+void __vortex_metrics_export_counter (VortexMetricsSeries * series, VortexMetricCounter counter, const char * name,
+				      char * buffer, int buffer_size, int * written)
+{
+	long value = __vortex_metrics_series_counter (series, counter);
+
+	/* skip series without values */
+	if (value == 0 && series->profile != NULL)
+		return;
+
+	__vortex_metrics_append (buffer, buffer_size, written, "%s%s%s%s %ld\n",
+				 name, series->profile ? "{profile=\"" : "", series->profile ? series->profile : "",
+				 series->profile ? "\"}" : "", value);
+	return;
+}
+
+/** 
+ * @brief Writes all metrics collected in Prometheus text exposition
+ * format into the buffer provided. Each \ref VortexMetric is exported
+ * as a histogram (in seconds) and each \ref VortexMetricCounter as a
+ * counter, with a profile label for values accounted by profile.
+ *
+ * @param ctx The context where metrics were collected.
+ *
+ * @param buffer The buffer where content is written (nul terminated).
+ *
+ * @param buffer_size The buffer size.
+ *
+ * @return Bytes written (without the trailing nul) or -1 if the
+ * buffer is not big enough or metrics were never enabled.
+ */
+int          vortex_metrics_export       (VortexCtx             * ctx,
+					  char                  * buffer,
+					  int                     buffer_size)
+{
+	VortexMetric          metric;
+	VortexMetricCounter   counter;
+	const char          * name;
+	const char          * help;
+	int                   written = 0;
+	int                   iterator;
+
+	v_return_val_if_fail (ctx && ctx->metrics && buffer && buffer_size > 0, -1);
+
+	for (metric = 0; metric < VORTEX_METRIC_LAST; metric++) {
+		name = __vortex_metrics_name (metric, &help);
+		__vortex_metrics_append (buffer, buffer_size, &written, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+
+		/* global series, then profiles */
+		__vortex_metrics_export_series (ctx->metrics->global, metric, name, buffer, buffer_size, &written);
+		vortex_mutex_lock (&ctx->metrics->mutex);
+		for (iterator = 0; iterator < axl_list_length (ctx->metrics->series); iterator++) 
+			__vortex_metrics_export_series (axl_list_get_nth (ctx->metrics->series, iterator), metric, name,
+							buffer, buffer_size, &written);
+		vortex_mutex_unlock (&ctx->metrics->mutex);
+	} /* end for */
+
+	for (counter = 0; counter < VORTEX_COUNTER_LAST; counter++) {
+		name = __vortex_metrics_counter_name (counter, &help);
+		__vortex_metrics_append (buffer, buffer_size, &written, "# HELP %s %s\n# TYPE %s counter\n", name, help, name);
+
+		/* global series, then profiles */
+		__vortex_metrics_export_counter (ctx->metrics->global, counter, name, buffer, buffer_size, &written);
+		vortex_mutex_lock (&ctx->metrics->mutex);
+		for (iterator = 0; iterator < axl_list_length (ctx->metrics->series); iterator++) 
+			__vortex_metrics_export_counter (axl_list_get_nth (ctx->metrics->series, iterator), counter, name,
+							 buffer, buffer_size, &written);
+		vortex_mutex_unlock (&ctx->metrics->mutex);
+	} /* end for */
+
+	return written;
+}
+
+/** 
+ * @brief Writes all metrics collected in Prometheus text exposition
+ * format into the file provided (see \ref vortex_metrics_export). The
+ * file is replaced so it can be used by a node exporter textfile
+ * collector.
+ *
+ * @param ctx The context where metrics were collected.
+ *
+ * @param path The file to write.
+ *
+ * @return axl_true if the file was written, otherwise axl_false.
+ */
+axl_bool     vortex_metrics_export_file  (VortexCtx             * ctx,
+					  const char            * path)
+{
+	char  * buffer;
+	int     buffer_size = 65536;
+	int     written;
+	FILE  * file;
+
+	v_return_val_if_fail (ctx && ctx->metrics && path, axl_false);
+
+	/* export, growing the buffer until content fits */
+	while (axl_true) {
+		buffer = axl_new (char, buffer_size);
+		VORTEX_CHECK_REF (buffer, axl_false);
+		written = vortex_metrics_export (ctx, buffer, buffer_size);
+		if (written >= 0)
+			break;
+		axl_free (buffer);
+		buffer_size = buffer_size * 2;
+	} /* end while */
+
+	file = fopen (path, "w");
+	if (file == NULL) {
+		axl_free (buffer);
+		return axl_false;
+	} /* end if */
+	written = (fwrite (buffer, 1, written, file) == (size_t) written);
+	fclose (file);
+	axl_free (buffer);
+
+	return written;
+}
+
+/** 
+ * @internal Gets current stamp into the provided reference if
+ * metrics are enabled.
+ *
+ * @return axl_true if metrics are enabled (and stamp was updated).
+ */
+axl_bool     __vortex_metrics_start      (VortexCtx             * ctx,
+					  struct timeval        * stamp)
+{
+	if (! vortex_metrics_is_enabled (ctx))
+		return axl_false;
+	gettimeofday (stamp, NULL);
+	return axl_true;
+}
+
+/** 
+ * @internal Accounts time elapsed since the stamp provided.
+ */
+void         __vortex_metrics_record_since (VortexCtx           * ctx,
+					    VortexMetric          metric,
+					    VortexMetricsSeries * series,
+					    struct timeval      * stamp)
+{
+	struct timeval now;
+
+	if (stamp == NULL || stamp->tv_sec == 0)
+		return;
+
+	gettimeofday (&now, NULL);
+	__vortex_metrics_record_series (ctx, series, metric,
+					(long) (now.tv_sec - stamp->tv_sec) * 1000000 + (now.tv_usec - stamp->tv_usec));
+	return;
+}
+
+/** 
+ * @internal Called by frame received handler dispatchers before
+ * calling the handler: accounts the time the frame was waiting since
+ * the reader finished reading it and gets current stamp to measure
+ * handler execution.
+ *
+ * @return axl_true if metrics are enabled (and stamp was updated).
+ */
+axl_bool     __vortex_metrics_handler_start (VortexCtx          * ctx,
+					     VortexFrame        * frame,
+					     VortexMetricsSeries * series,
+					     struct timeval     * stamp)
+{
+	if (! vortex_metrics_is_enabled (ctx))
+		return axl_false;
+
+	__vortex_metrics_record_since (ctx, VORTEX_METRIC_READER_QUEUE, series, vortex_frame_get_received_stamp (frame));
+	gettimeofday (stamp, NULL);
+	return axl_true;
+}
+
+/** 
+ * @internal Releases metrics collected. Called when the context is
+ * finished.
+ */
+void         __vortex_metrics_cleanup    (VortexCtx             * ctx)
+{
+	VortexMetrics * metrics;
+
+	if (ctx == NULL || ctx->metrics == NULL)
+		return;
+
+	metrics      = ctx->metrics;
+	ctx->metrics = NULL;
+
+	axl_hash_free (metrics->profiles);
+	axl_list_free (metrics->series);
+	__vortex_metrics_series_free (metrics->global);
+	vortex_mutex_destroy (&metrics->mutex);
+	axl_free (metrics);
+
+	return;
+}
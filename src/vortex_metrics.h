@@ -0,0 +1,115 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+
+#ifndef __VORTEX_METRICS_H__
+#define __VORTEX_METRICS_H__
+
+#include <vortex.h>
+
+/** 
+ * \addtogroup vortex_metrics Vortex Metrics: latency histograms collected inside the library
+ * @{
+ */
+
+axl_bool     vortex_metrics_enable       (VortexCtx             * ctx,
+					  axl_bool                enable);
+
+axl_bool     vortex_metrics_is_enabled   (VortexCtx             * ctx);
+
+void         vortex_metrics_reset        (VortexCtx             * ctx);
+
+void         vortex_metrics_record       (VortexCtx             * ctx,
+					  VortexMetric            metric,
+					  const char            * profile,
+					  long                    usecs);
+
+void         vortex_metrics_count        (VortexCtx             * ctx,
+					  VortexMetricCounter     counter,
+					  const char            * profile,
+					  long                    value);
+
+long         vortex_metrics_get_counter  (VortexCtx             * ctx,
+					  VortexMetricCounter     counter,
+					  const char            * profile);
+
+axl_bool     vortex_metrics_get          (VortexCtx             * ctx,
+					  VortexMetric            metric,
+					  const char            * profile,
+					  VortexMetricsSnapshot * snapshot);
+
+int          vortex_metrics_export       (VortexCtx             * ctx,
+					  char                  * buffer,
+					  int                     buffer_size);
+
+axl_bool     vortex_metrics_export_file  (VortexCtx             * ctx,
+					  const char            * path);
+
+/* internal API */
+VortexMetricsSeries * __vortex_metrics_series_resolve (VortexCtx     * ctx,
+						       const char    * profile);
+
+void         __vortex_metrics_record_series (VortexCtx          * ctx,
+					     VortexMetricsSeries * series,
+					     VortexMetric         metric,
+					     long                 usecs);
+
+void         __vortex_metrics_count_series  (VortexCtx          * ctx,
+					     VortexMetricsSeries * series,
+					     VortexMetricCounter  counter,
+					     long                 value);
+
+axl_bool     __vortex_metrics_start      (VortexCtx             * ctx,
+					  struct timeval        * stamp);
+
+void         __vortex_metrics_record_since (VortexCtx           * ctx,
+					    VortexMetric          metric,
+					    VortexMetricsSeries * series,
+					    struct timeval      * stamp);
+
+axl_bool     __vortex_metrics_handler_start (VortexCtx          * ctx,
+					     VortexFrame        * frame,
+					     VortexMetricsSeries * series,
+					     struct timeval     * stamp);
+
+void         __vortex_metrics_cleanup    (VortexCtx             * ctx);
+
+#endif
+
+/** 
+ * @}
+ */
@@ -38,6 +38,9 @@
 #include <vortex_payload_feeder.h>
 #include <vortex_payload_feeder_private.h>
 
+/* INT_MAX */
+#include <limits.h>
+
 /** 
  * @brief Allows to create a new payload feeder object that will be
  * defined by feeder handler provided.
@@ -84,10 +87,21 @@ VortexPayloadFeeder * vortex_payload_feeder_new (VortexPayloadFeederHandler hand
 	return feeder;
 }
 
+/* seek support for files beyond 2GB */
+#if defined(AXL_OS_WIN32)
+#define VORTEX_FILE_SEEK(file,offset) _fseeki64 (file, offset, SEEK_SET)
+#else
+#define VORTEX_FILE_SEEK(file,offset) fseeko (file, (off_t) (offset), SEEK_SET)
+#endif
+
 typedef struct _VortexPayloadFileFeeder {
-	int             size;
+	long long       size;
 	FILE          * file_to_feed;
 	axl_bool        mime_pending;
+	/* file bytes already feeded */
+	long long       offset;
+	/* content can be sent with sendfile(2) */
+	axl_bool        zero_copy;
 } VortexPayloadFileFeeder;
 
 axl_bool __vortex_payload_feeder_file (VortexCtx               * ctx,
@@ -103,10 +117,11 @@ axl_bool __vortex_payload_feeder_file (VortexCtx               * ctx,
 
 	switch (op_type) {
 	case PAYLOAD_FEEDER_GET_SIZE:
-		vortex_log (VORTEX_LEVEL_DEBUG, "Requesting to return size: %d", state->size);
+		vortex_log (VORTEX_LEVEL_DEBUG, "Requesting to return size: %lld", state->size);
 		/* printf ("F: Requesting to return size: %d\n", state->size); */
-		/* return feeder size */
-		(* size) = state->size + 2;
+		/* return feeder size (checked to fit at
+		 * vortex_payload_feeder_file) */
+		(* size) = (int) state->size + 2;
 		return axl_true;
 	case PAYLOAD_FEEDER_GET_CONTENT:
 		vortex_log (VORTEX_LEVEL_DEBUG, "Requesting to return %d bytes content", (*size));
@@ -119,18 +134,22 @@ axl_bool __vortex_payload_feeder_file (VortexCtx               * ctx,
 			buffer [0] = '\r';
 			buffer [1] = '\n';
 			(* size) = fread (buffer + 2, 1, (*size) - 2, state->file_to_feed);
+			state->offset += (* size);
 			
 			/* ..and update (* size) to include two additional bytes */
 			(*size) += 2;
 		} else  {
 			/* read the provided amount of bytes on the provided buffer */
 			(* size) = fread (buffer, 1, (*size), state->file_to_feed);
+			state->offset += (* size);
 		}
 		vortex_log (VORTEX_LEVEL_DEBUG, "Returning %d bytes content", (*size));
 		return axl_true;
 	case PAYLOAD_FEEDER_IS_FINISHED:
-		/* return if the current feeder have no more content */
-		(* size) = feof (state->file_to_feed) != 0;
+		/* return if the current feeder have no more content
+		 * (offset is also checked because content sent with
+		 * sendfile(2) doesn't touch the stream eof flag) */
+		(* size) = (state->offset >= state->size) || (feof (state->file_to_feed) != 0);
 		/* printf ("F: asked if it is finished: %d\n", (*size)); */
 
 		return axl_true;
@@ -215,8 +234,9 @@ VortexPayloadFeeder * vortex_payload_feeder_file (const char * path,
 	if (file_to_feed == NULL)
 		return NULL;
 
-	/* get size */
-	if (stat (path, &stats) != 0) {
+	/* get size (feeder sizes are reported as int, including the
+	 * two bytes of the initial MIME header) */
+	if (stat (path, &stats) != 0 || (long long) stats.st_size > (long long) (INT_MAX - 2)) {
 		fclose (file_to_feed);
 		return NULL;
 	} /* end if */
@@ -226,11 +246,129 @@ VortexPayloadFeeder * vortex_payload_feeder_file (const char * path,
 	state->mime_pending = add_mime_head;
 	state->file_to_feed = file_to_feed;
 	state->size         = stats.st_size;
+#if defined(VORTEX_HAVE_SENDFILE)
+	state->zero_copy    = axl_true;
+#endif
 
 	/* ok, now create the feeder */
 	return vortex_payload_feeder_new (__vortex_payload_feeder_file, state);
 }
 
+/** 
+ * @brief Allows to enable or disable zero copy transfers for a feeder
+ * created with \ref vortex_payload_feeder_file.
+ *
+ * When enabled (the default on platforms with sendfile(2) support),
+ * the vortex sequencer sends file content directly from the file
+ * descriptor into the connection socket, avoiding to copy it into
+ * user space buffers. This is only done for connections using the
+ * default socket send handler (\ref vortex_connection_default_send)
+ * without write coalescing. For other connections (TLS or custom
+ * transports) the feeder transparently falls back to buffered reads.
+ *
+ * @param feeder The file feeder to configure.
+ * @param enable axl_true to enable zero copy transfers, axl_false to
+ * disable them.
+ *
+ * @return axl_true if the configuration was applied, axl_false if
+ * the feeder isn't a file feeder or the platform has no sendfile(2)
+ * support (in which case enabling it has no effect).
+ */
+axl_bool              vortex_payload_feeder_set_zero_copy (VortexPayloadFeeder * feeder,
+							   axl_bool              enable)
+{
+#if defined(VORTEX_HAVE_SENDFILE)
+	VortexPayloadFileFeeder * state;
+#endif
+
+	if (feeder == NULL || feeder->handler != __vortex_payload_feeder_file)
+		return axl_false;
+
+#if defined(VORTEX_HAVE_SENDFILE)
+	state            = feeder->user_data;
+	state->zero_copy = enable;
+
+	return axl_true;
+#else
+	return ! enable;
+#endif
+}
+
+/** 
+ * @internal Allows the vortex sequencer to get next content to be
+ * sent from a file feeder with zero copy support, as a file
+ * descriptor range, consuming it.
+ *
+ * @param feeder The feeder to get content from.
+ *
+ * @param size_to_copy Max amount of bytes to feed (including the
+ * head).
+ *
+ * @param head Buffer (at least 2 bytes) where content that must be
+ * sent before the file range is placed (initial MIME header).
+ *
+ * @param head_size Reference where the amount of bytes placed in head
+ * is reported.
+ *
+ * @param fd Reference where the file descriptor is reported.
+ *
+ * @param offset Reference where the file offset where the range
+ * starts is reported.
+ *
+ * @return Amount of bytes to send from the file descriptor or -1 if
+ * the feeder can't be handled this way (nothing is consumed).
+ */
+int                   __vortex_payload_feeder_zero_copy_content (VortexPayloadFeeder * feeder,
+								 int                   size_to_copy,
+								 char                * head,
+								 int                 * head_size,
+								 int                 * fd,
+								 long long           * offset)
+{
+#if defined(VORTEX_HAVE_SENDFILE)
+	VortexPayloadFileFeeder * state;
+	long long                 size;
+
+	if (feeder == NULL || feeder->status != 0 || feeder->handler != __vortex_payload_feeder_file)
+		return -1;
+	state = feeder->user_data;
+	if (! state->zero_copy)
+		return -1;
+
+	/* place initial mime header if pending */
+	(* head_size) = 0;
+	if (state->mime_pending) {
+		if (size_to_copy < 2)
+			return -1;
+		state->mime_pending = axl_false;
+		head[0]             = '\r';
+		head[1]             = '\n';
+		(* head_size)       = 2;
+		size_to_copy       -= 2;
+	} /* end if */
+
+	/* get the file range */
+	size = state->size - state->offset;
+	if (size > size_to_copy)
+		size = size_to_copy;
+
+	(* fd)        = fileno (state->file_to_feed);
+	(* offset)    = state->offset;
+	state->offset = state->offset + size;
+
+	/* keep stream position in sync in case next content is
+	 * read through the buffered path */
+	VORTEX_FILE_SEEK (state->file_to_feed, state->offset);
+
+	/* accumulate bytes transferred */
+	feeder->bytes_transferred += size + (* head_size);
+
+	return (int) size;
+#else
+	return -1;
+#endif
+}
+
 /** 
  * @internal Makes the feeder to return pending content size to be
  * feeded.
@@ -95,4 +95,11 @@ struct _VortexPayloadFeeder {
 	 */
 	VortexChannel              * channel;
 };
+
+int __vortex_payload_feeder_zero_copy_content (VortexPayloadFeeder * feeder,
+					       int                   size_to_copy,
+					       char                * head,
+					       int                 * head_size,
+					       int                 * fd,
+					       long long           * offset);
 #endif
@@ -0,0 +1,539 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+#define LOG_DOMAIN "vortex-payload-sink"
+
+#include <vortex_payload_sink.h>
+#include <vortex_payload_sink_private.h>
+
+/** 
+ * @internal Amount of bytes written by a sink with \ref
+ * PAYLOAD_SINK_HINT_DIRECT before flushing them into the storage.
+ */
+#define VORTEX_PAYLOAD_SINK_FLUSH_SIZE (1024 * 1024)
+
+/** 
+ * @brief Allows to create a new payload sink object that will be
+ * defined by the sink handler provided.
+ *
+ * Once created, the sink can be installed on a channel to receive
+ * the next incoming message (\ref vortex_channel_set_payload_sink) or
+ * returned by a profile sink handler (\ref
+ * vortex_profiles_set_payload_sink_handler).
+ *
+ * The handler provided must implement sink events defined by \ref
+ * VortexPayloadSinkOp. As an example, you can take a look on how is
+ * implemented \ref vortex_payload_sink_fd.
+ *
+ * Once a sink is installed, the user is not required to release
+ * it. This is already done by the vortex engine once the message is
+ * received.
+ *
+ * @param handler The sink handler that will define how this instance will work.
+ *
+ * @param user_data User defined pointer passed to the sink handler when it is called.
+ *
+ * @return A reference to the payload sink ready to use or NULL it
+ * if fails.
+ */
+VortexPayloadSink * vortex_payload_sink_new (VortexPayloadSinkHandler   handler,
+					     axlPointer                 user_data)
+{
+	VortexPayloadSink * sink;
+	if (handler == NULL)
+		return NULL;
+
+	/* build sink */
+	sink               = axl_new (VortexPayloadSink, 1);
+	sink->handler      = handler;
+	sink->user_data    = user_data;
+	sink->status       = axl_true;
+	sink->mime_pending = axl_true;
+	/* start as if a \r\n was already found so a MIME header
+	 * block that is just an empty line is also detected */
+	sink->mime_match   = 2;
+
+	/* init mutex and reference counting */
+	vortex_mutex_create (&sink->mutex);
+	sink->ref_count = 1;
+
+	return sink;
+}
+
+typedef struct _VortexPayloadFdSink {
+	int             fd;
+	axl_bool        close_fd;
+	int             hints;
+	long            expected_size;
+	/* file offset where the first byte was written */
+	long            start;
+	/* bytes written and bytes flushed into the storage */
+	long            written;
+	long            flushed;
+} VortexPayloadFdSink;
+
+void __vortex_payload_sink_fd_flush (VortexCtx * ctx, VortexPayloadFdSink * state)
+{
+	if (state->written == state->flushed)
+		return;
+
+#if defined(AXL_OS_UNIX)
+	/* write content through to the storage */
+	if (fsync (state->fd) != 0) 
+		vortex_log (VORTEX_LEVEL_WARNING, "failed to flush payload sink fd=%d, errno=%d", state->fd, errno);
+#endif
+
+#if defined(VORTEX_HAVE_POSIX_FADVISE)
+	/* ...and drop it from page cache */
+	posix_fadvise (state->fd, state->start + state->flushed, state->written - state->flushed, POSIX_FADV_DONTNEED);
+#endif
+	state->flushed = state->written;
+	return;
+}
+
+axl_bool __vortex_payload_sink_fd (VortexCtx               * ctx,
+				   VortexPayloadSinkOp       op_type,
+				   VortexPayloadSink       * sink,
+				   axlPointer                param1,
+				   axlPointer                param2,
+				   axlPointer                user_data)
+{
+	VortexPayloadFdSink * state   = user_data;
+	int                 * size    = param1;
+	const char          * content = param2;
+	int                   pending;
+	int                   result;
+
+	switch (op_type) {
+	case PAYLOAD_SINK_WRITE:
+		if (state->written == 0) {
+			/* record initial offset */
+			state->start = lseek (state->fd, 0, SEEK_CUR);
+			if (state->start < 0)
+				state->start = 0;
+
+#if defined(VORTEX_HAVE_POSIX_FALLOCATE)
+			/* preallocate expected size */
+			if ((state->hints & PAYLOAD_SINK_HINT_PREALLOCATE) && state->expected_size > 0) {
+				result = posix_fallocate (state->fd, state->start, state->expected_size);
+				if (result != 0) {
+					vortex_log (VORTEX_LEVEL_CRITICAL, "failed to preallocate %ld bytes on payload sink fd=%d, error=%d",
+						    state->expected_size, state->fd, result);
+					return axl_false;
+				} /* end if */
+			} /* end if */
+#endif
+		} /* end if */
+
+		/* write all content */
+		pending = (* size);
+		while (pending > 0) {
+			result = write (state->fd, content, pending);
+			if (result < 0) {
+				if (errno == EINTR)
+					continue;
+				vortex_log (VORTEX_LEVEL_CRITICAL, "failed to write %d bytes on payload sink fd=%d, errno=%d",
+					    pending, state->fd, errno);
+				return axl_false;
+			} /* end if */
+			content += result;
+			pending -= result;
+		} /* end while */
+		state->written += (* size);
+
+		/* check to flush */
+		if ((state->hints & PAYLOAD_SINK_HINT_DIRECT) && (state->written - state->flushed) >= VORTEX_PAYLOAD_SINK_FLUSH_SIZE)
+			__vortex_payload_sink_fd_flush (ctx, state);
+		return axl_true;
+	case PAYLOAD_SINK_FINISHED:
+#if defined(VORTEX_HAVE_POSIX_FALLOCATE)
+		/* remove space preallocated but not used */
+		if ((state->hints & PAYLOAD_SINK_HINT_PREALLOCATE) && state->written < state->expected_size) {
+			if (ftruncate (state->fd, state->start + state->written) != 0)
+				vortex_log (VORTEX_LEVEL_WARNING, "failed to truncate payload sink fd=%d, errno=%d", state->fd, errno);
+		} /* end if */
+#endif
+		if (state->hints & PAYLOAD_SINK_HINT_DIRECT)
+			__vortex_payload_sink_fd_flush (ctx, state);
+		return axl_true;
+	case PAYLOAD_SINK_RELEASE:
+		/* release current sink */
+		if (state->close_fd)
+			close (state->fd);
+
+		axl_free (state);
+		return axl_true;
+	} /* end switch */
+
+	/* this code is never reached */
+	return axl_true;
+}
+
+/** 
+ * @brief Creates a sink object that writes content received into the
+ * file descriptor provided.
+ *
+ * Content is appended at the current file descriptor position as
+ * frames are received, by a thread pool task rather than the vortex
+ * reader. The bytes received are only acknowledged (advancing the
+ * channel window with a SEQ frame) once they were written into the
+ * file descriptor, so a slow storage makes the remote peer to slow
+ * down instead of buffering content in memory.
+ *
+ * @param fd The file descriptor where content will be written.
+ *
+ * @param close_fd axl_true to close the file descriptor when the sink is released.
+ *
+ * @param hints Optional hints (\ref VortexPayloadSinkHint) or'ed
+ * together to configure how content is written. Hints not supported
+ * on the current platform are ignored.
+ *
+ * @param expected_size Expected message size, used by \ref
+ * PAYLOAD_SINK_HINT_PREALLOCATE (pass 0 if unknown).
+ *
+ * @return A reference to a \ref VortexPayloadSink object or NULL if it fails.
+ */
+VortexPayloadSink * vortex_payload_sink_fd            (int                        fd,
+						       axl_bool                   close_fd,
+						       int                        hints,
+						       long                       expected_size)
+{
+	VortexPayloadFdSink * state;
+
+	v_return_val_if_fail (fd >= 0, NULL);
+
+	/* create state */
+	state                = axl_new (VortexPayloadFdSink, 1);
+	state->fd            = fd;
+	state->close_fd      = close_fd;
+	state->hints         = hints;
+	state->expected_size = expected_size;
+
+	/* ok, now create the sink */
+	return vortex_payload_sink_new (__vortex_payload_sink_fd, state);
+}
+
+/** 
+ * @brief Creates a sink object that writes content received into the
+ * file found at the path provided (the file is created or truncated).
+ *
+ * See \ref vortex_payload_sink_fd for details about hints.
+ *
+ * @param path The path to the file where content will be written.
+ *
+ * @param hints Optional hints (\ref VortexPayloadSinkHint).
+ *
+ * @param expected_size Expected message size (pass 0 if unknown).
+ *
+ * @return A reference to a \ref VortexPayloadSink object or NULL if
+ * it fails (file can't be opened).
+ */
+VortexPayloadSink * vortex_payload_sink_file          (const char               * path,
+						       int                        hints,
+						       long                       expected_size)
+{
+	int fd;
+
+	v_return_val_if_fail (path, NULL);
+
+	/* open file */
+#if defined(AXL_OS_UNIX)
+	fd = open (path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#elif defined(AXL_OS_WIN32)
+	fd = open (path, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+#endif
+	if (fd < 0)
+		return NULL;
+
+	return vortex_payload_sink_fd (fd, axl_true, hints, expected_size);
+}
+
+/** 
+ * @brief Allows to configure if the content received by the sink
+ * starts with a MIME header block that must be skipped (by default
+ * axl_true).
+ *
+ * Messages sent with automatic MIME handling (or by a feeder created
+ * with add_mime_head, see \ref vortex_payload_feeder_file) start with
+ * MIME headers closed by an empty line. Those headers are not written
+ * into the sink. Disable it if the remote peer sends raw content.
+ *
+ * @param sink The sink to configure.
+ *
+ * @param has_mime_head axl_true to skip the initial MIME header block.
+ */
+void                vortex_payload_sink_set_mime_head (VortexPayloadSink        * sink,
+						       axl_bool                   has_mime_head)
+{
+	if (sink == NULL || sink->bound)
+		return;
+	sink->mime_pending = has_mime_head;
+	return;
+}
+
+/** 
+ * @brief Allows to configure a finished handler that will be called
+ * once the sink has received the complete message.
+ *
+ * @param sink The sink to be configured with the finished handler.
+ *
+ * @param on_finished The on finished handler to configure.
+ *
+ * @param user_data Optional user defined pointer to be passed to the on finished handler
+ */
+void                vortex_payload_sink_set_on_finished (VortexPayloadSink                * sink,
+							 VortexPayloadSinkFinishedHandler   on_finished,
+							 axlPointer                         user_data)
+{
+	/* check input data */
+	if (sink == NULL || on_finished == NULL)
+		return;
+
+	/* configure handler */
+	sink->finish_handler   = on_finished;
+	sink->finish_user_data = user_data;
+	return;
+}
+
+/** 
+ * @brief Returns the amount of bytes written into the sink so far.
+ *
+ * @param sink The sink to check.
+ *
+ * @return Bytes written or -1 if NULL is received.
+ */
+long                vortex_payload_sink_get_size      (VortexPayloadSink        * sink)
+{
+	if (sink == NULL)
+		return -1;
+	return sink->total_size;
+}
+
+/** 
+ * @internal Allows to check if the sink is bound to a message and, if
+ * a frame is provided, if the frame belongs to that message.
+ */
+axl_bool __vortex_payload_sink_is_bound (VortexPayloadSink * sink,
+					 VortexFrame       * frame)
+{
+	if (sink == NULL || ! sink->bound)
+		return axl_false;
+	if (frame == NULL)
+		return axl_true;
+	return (sink->msg_no == vortex_frame_get_msgno (frame)) && (sink->type == vortex_frame_get_type (frame));
+}
+
+/** 
+ * @internal Binds the sink to the message started by the frame
+ * provided.
+ */
+void     __vortex_payload_sink_bind     (VortexPayloadSink * sink,
+					 VortexChannel     * channel,
+					 VortexFrame       * frame)
+{
+	sink->ctx     = vortex_channel_get_ctx (channel);
+	sink->channel = channel;
+	sink->msg_no  = vortex_frame_get_msgno (frame);
+	sink->type    = vortex_frame_get_type (frame);
+	sink->bound   = axl_true;
+	return;
+}
+
+/** 
+ * @internal Writes frame content into the sink, skipping initial
+ * MIME headers if configured. Once a write fails, remaining content
+ * is discarded.
+ */
+void     __vortex_payload_sink_write    (VortexPayloadSink * sink,
+					 VortexFrame       * frame)
+{
+	const char * content = vortex_frame_get_content (frame);
+	int          size    = vortex_frame_get_content_size (frame);
+	VortexCtx  * ctx     = sink->ctx;
+	char         expected;
+
+	/* skip MIME headers until the empty line is found */
+	while (sink->mime_pending && size > 0) {
+		expected = (sink->mime_match % 2) == 0 ? '\r' : '\n';
+		if ((* content) == expected)
+			sink->mime_match++;
+		else
+			sink->mime_match = ((* content) == '\r') ? 1 : 0;
+		if (sink->mime_match == 4)
+			sink->mime_pending = axl_false;
+		content++;
+		size--;
+	} /* end while */
+
+	if (! sink->status || size == 0)
+		return;
+
+	/* call to write */
+	if (! sink->handler (ctx, PAYLOAD_SINK_WRITE, sink, &size, (axlPointer) content, sink->user_data)) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "payload sink failed to write content for msgno=%d, discarding the rest of the message",
+			    sink->msg_no);
+		sink->status = axl_false;
+		return;
+	} /* end if */
+	sink->total_size += size;
+
+	return;
+}
+
+axlPointer __vortex_payload_sink_finished_notification (VortexPayloadSink * sink)
+{
+	/* call to notify */
+	sink->finish_handler (sink->channel, sink, sink->msg_no, sink->total_size, sink->status, sink->finish_user_data);
+
+	/* release references */
+	vortex_channel_unref2 (sink->channel, "payload sink");
+	vortex_payload_sink_unref (sink);
+
+	return NULL;
+}
+
+/** 
+ * @internal Completes the message received into the sink, notifying
+ * the finished handler. The function consumes the reference owned by
+ * the caller.
+ */
+void     __vortex_payload_sink_finish   (VortexPayloadSink * sink)
+{
+	VortexCtx  * ctx     = sink->ctx;
+
+	/* signal the handler the message is complete */
+	if (sink->status && ! sink->handler (ctx, PAYLOAD_SINK_FINISHED, sink, &sink->total_size, NULL, sink->user_data))
+		sink->status = axl_false;
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "payload sink finished msgno=%d, total size=%ld, status=%d",
+		    sink->msg_no, sink->total_size, sink->status);
+
+	/* call to report finished handler */
+	if (sink->finish_handler && vortex_channel_ref2 (sink->channel, "payload sink")) {
+		vortex_thread_pool_new_task (ctx, (VortexThreadFunc)__vortex_payload_sink_finished_notification, sink);
+		return;
+	} /* end if */
+
+	vortex_payload_sink_unref (sink);
+	return;
+}
+
+/** 
+ * @brief Allows to increase the reference counting associated to the
+ * payload sink. A reference acquired can be released by using \ref
+ * vortex_payload_sink_unref.
+ *
+ * @param sink The sink to increase its reference counting.
+ *
+ * @return axl_true in the case reference counting was updated,
+ * otherwise axl_false is returned.
+ */
+axl_bool            vortex_payload_sink_ref           (VortexPayloadSink        * sink)
+{
+	if (sink == NULL || sink->handler == NULL || sink->ref_count == 0)
+		return axl_false;
+
+	/* acquire mutex */
+	vortex_mutex_lock (&sink->mutex);
+
+	/* increase reference counting */
+	sink->ref_count++;
+
+	/* release mutex */
+	vortex_mutex_unlock (&sink->mutex);
+
+	return axl_true;
+}
+
+/** 
+ * @brief Allows to reduce a reference from the provided payload
+ * sink.
+ *
+ * @param sink The payload sink that will be reduced.
+ */
+void                vortex_payload_sink_unref         (VortexPayloadSink        * sink)
+{
+	if (sink == NULL)
+		return;
+
+	/* call to current implementation */
+	vortex_payload_sink_free (sink);
+	return;
+}
+
+/** 
+ * @brief Function that releases all resources associated to the sink
+ * if the reference counting reaches 0.
+ *
+ * This function is equivalent to \ref vortex_payload_sink_unref. In
+ * most cases you don't need to call this function because the sink
+ * is released by the vortex engine once the message is received (or
+ * the channel is closed).
+ *
+ * @param sink The sink to be released.
+ */
+void                vortex_payload_sink_free          (VortexPayloadSink        * sink)
+{
+	if (sink == NULL)
+		return;
+
+	/* acquire mutex */
+	vortex_mutex_lock (&sink->mutex);
+
+	/* decrease reference counting */
+	sink->ref_count--;
+	if (sink->ref_count != 0) {
+		/* release mutex */
+		vortex_mutex_unlock (&sink->mutex);
+		return;
+	} /* end if */
+
+	/* call to release */
+	if (sink->handler) {
+		sink->handler (sink->ctx, PAYLOAD_SINK_RELEASE, sink, NULL, NULL, sink->user_data);
+		sink->handler = NULL;
+	} /* end if */
+
+	/* release mutex */
+	vortex_mutex_unlock (&sink->mutex);
+	vortex_mutex_destroy (&sink->mutex);
+
+	/* free sink */
+	axl_free (sink);
+
+	return;
+}
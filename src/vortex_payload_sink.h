@@ -0,0 +1,80 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+
+#ifndef __VORTEX_PAYLOAD_SINK_H__
+#define __VORTEX_PAYLOAD_SINK_H__
+
+#include <vortex.h>
+
+/** 
+ * \addtogroup vortex_payload_sink Vortex Payload Sink: an abstraction to stream incoming content into storage as it is received
+ * @{
+ */
+
+VortexPayloadSink * vortex_payload_sink_new           (VortexPayloadSinkHandler   handler,
+						       axlPointer                 user_data);
+
+VortexPayloadSink * vortex_payload_sink_fd            (int                        fd,
+						       axl_bool                   close_fd,
+						       int                        hints,
+						       long                       expected_size);
+
+VortexPayloadSink * vortex_payload_sink_file          (const char               * path,
+						       int                        hints,
+						       long                       expected_size);
+
+void                vortex_payload_sink_set_mime_head (VortexPayloadSink        * sink,
+						       axl_bool                   has_mime_head);
+
+void                vortex_payload_sink_set_on_finished (VortexPayloadSink                * sink,
+							 VortexPayloadSinkFinishedHandler   on_finished,
+							 axlPointer                         user_data);
+
+long                vortex_payload_sink_get_size      (VortexPayloadSink        * sink);
+
+axl_bool            vortex_payload_sink_ref           (VortexPayloadSink        * sink);
+
+void                vortex_payload_sink_unref         (VortexPayloadSink        * sink);
+
+void                vortex_payload_sink_free          (VortexPayloadSink        * sink);
+
+#endif
+
+/** 
+ * @}
+ */
@@ -0,0 +1,109 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+
+#ifndef __VORTEX_PAYLOAD_SINK_PRIVATE_H__
+#define __VORTEX_PAYLOAD_SINK_PRIVATE_H__
+struct _VortexPayloadSink {
+	/** 
+	 * @internal The context used by the payload sink.
+	 */
+	VortexCtx                  * ctx;
+	/** 
+	 * @internal The handler that defines how this sink behaves.
+	 */
+	VortexPayloadSinkHandler     handler;
+	/** 
+	 * @internal User defined pointer that is passed to the previous handler.
+	 */
+	axlPointer                   user_data;
+	/** 
+	 * @internal Mutex and reference counting used to track owned references.
+	 */
+	VortexMutex                  mutex;
+	int                          ref_count;
+
+	/** 
+	 * @internal Message the sink is receiving (msgno and frame
+	 * type). Set with the first frame received.
+	 */
+	axl_bool                     bound;
+	int                          msg_no;
+	VortexFrameType              type;
+
+	/** 
+	 * @internal Bytes written into the sink so far and write
+	 * status (axl_false once a write fails).
+	 */
+	long                         total_size;
+	axl_bool                     status;
+
+	/** 
+	 * @internal MIME header skipping state: if the content starts
+	 * with a MIME header, mime_pending is axl_true until the empty
+	 * line closing it is found (mime_match tracks \r\n\r\n
+	 * bytes matched so far).
+	 */
+	axl_bool                     mime_pending;
+	int                          mime_match;
+
+	/** 
+	 * @internal Handler used to notify that the message was
+	 * completely received.
+	 */
+	VortexPayloadSinkFinishedHandler finish_handler;
+	axlPointer                       finish_user_data;
+
+	/** 
+	 * @brief Pointer to the channel where content is received
+	 * (only owned while the finished notification is pending).
+	 */
+	VortexChannel              * channel;
+};
+
+axl_bool __vortex_payload_sink_is_bound (VortexPayloadSink * sink,
+					 VortexFrame       * frame);
+
+void     __vortex_payload_sink_bind     (VortexPayloadSink * sink,
+					 VortexChannel     * channel,
+					 VortexFrame       * frame);
+
+void     __vortex_payload_sink_write    (VortexPayloadSink * sink,
+					 VortexFrame       * frame);
+
+void     __vortex_payload_sink_finish   (VortexPayloadSink * sink);
+#endif
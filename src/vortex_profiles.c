@@ -57,6 +57,9 @@ typedef struct _VortexProfile
 	char                         * mime_type;
 	char                         * transfer_encoding;
 	int                            automatic_mime;
+	axl_bool                       mime_lazy;
+	VortexPayloadSinkCreateHandler sink_create;
+	axlPointer                     sink_create_user_data;
 	int                            ref_count;
 	VortexMutex                    mutex;
 } VortexProfile;
@@ -174,6 +177,69 @@ void __vortex_profiles_unref (VortexProfile * profile, const char * label)
 	return;
 }
 
+/** 
+ * @internal Returns the profile running on the channel provided
+ * without hashing the profile uri or locking the registry.
+ *
+ * The profile is resolved once and cached on the channel (which
+ * owns a reference to it) along with the registry epoch. It is only
+ * resolved again if a profile was registered or unregistered since
+ * then. The cache is only accessed from the vortex reader thread (or
+ * before the channel is published).
+ *
+ * @return The profile (reference owned by the channel) or NULL if
+ * the channel profile isn't registered.
+ */
+VortexProfile * __vortex_profiles_get_cached (VortexCtx * ctx, VortexChannel * channel)
+{
+	VortexProfile * profile;
+	int             epoch;
+	int             cached_epoch;
+
+	/* fast path: registry not changed since the profile was
+	 * resolved */
+	epoch   = ctx->profiles_epoch;
+	profile = vortex_channel_get_profile_cache (channel, &cached_epoch);
+	if (cached_epoch == epoch)
+		return profile;
+
+	/* resolve and cache (the previous reference is released) */
+	profile = __vortex_profiles_get_and_ref (ctx->registered_profiles, vortex_channel_get_profile (channel), "channel cache");
+	vortex_channel_set_profile_cache (channel, profile, epoch);
+
+	return profile;
+}
+
+/** 
+ * @internal Resolves the profile running on the channel provided,
+ * caching it on the channel so frame dispatch doesn't require
+ * registry lookups. Called at channel creation.
+ *
+ * @param channel The channel to resolve its profile.
+ *
+ * @return axl_true if the channel profile is registered, otherwise
+ * axl_false.
+ */
+axl_bool        vortex_profiles_resolve_channel (VortexChannel * channel)
+{
+	VortexCtx * ctx = vortex_channel_get_ctx (channel);
+
+	if (ctx == NULL || ctx->registered_profiles == NULL || vortex_channel_get_profile (channel) == NULL)
+		return axl_false;
+
+	return __vortex_profiles_get_cached (ctx, channel) != NULL;
+}
+
+/** 
+ * @internal Releases a profile reference cached by a channel (see
+ * vortex_channel_set_profile_cache).
+ */
+void            vortex_profiles_release_cache   (axlPointer profile)
+{
+	__vortex_profiles_unref (profile, "channel cache");
+	return;
+}
+
 
 /** 
  * @internal
@@ -347,6 +413,7 @@ axl_bool  vortex_profiles_register (VortexCtx             * ctx,
 
 		/* register the new profile */
 		vortex_hash_replace (ctx->registered_profiles, profile->profile_name, profile);
+		ctx->profiles_epoch++;
 
 		/* register in the list */
 		axl_list_append (ctx->profiles_list, profile->profile_name);
@@ -468,6 +535,7 @@ axl_bool vortex_profiles_unregister              (VortexCtx             * ctx,
 
 	/* unregister the profile */
 	vortex_hash_remove (ctx->registered_profiles, (axlPointer) uri);
+	ctx->profiles_epoch++;
 
 	/* release */
 	vortex_mutex_unlock (&ctx->profiles_list_mutex);
@@ -904,6 +972,8 @@ axlPointer __vortex_profiles_invoke_frame_received (axlPointer __data)
 	VortexFrame               * frame        = data->frame;
 	VortexChannel             * channel      = NULL;
 	axl_bool                    is_connected = axl_false;
+	axl_bool                    metrics;
+	struct timeval              stamp;
 #if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
 	VortexCtx                 * ctx          = vortex_connection_get_ctx (connection);
 #endif
@@ -962,8 +1032,14 @@ axlPointer __vortex_profiles_invoke_frame_received (axlPointer __data)
 
  deliver_frame:
 
-	/* invoke frame received on this channel */
+	/* invoke frame received on this channel (measuring how long
+	 * it takes if metrics are enabled) */
+	metrics = __vortex_metrics_handler_start (CONN_CTX (connection), frame, vortex_channel_get_metrics_series (channel), &stamp);
+	VORTEX_TRACE_FRAME (CONN_CTX (connection), connection, frame, VORTEX_TRACE_FRAME_DEQUEUED);
 	received (channel, connection, frame, user_data);
+	VORTEX_TRACE_FRAME (CONN_CTX (connection), connection, frame, VORTEX_TRACE_FRAME_HANDLED);
+	if (metrics)
+		__vortex_metrics_record_since (CONN_CTX (connection), VORTEX_METRIC_HANDLER, vortex_channel_get_metrics_series (channel), &stamp);
 
 	/* check serialize to broadcast other waiting threads */
 	if (vortex_channel_check_serialize_pending (CONN_CTX(connection), connection, channel, &frame)) {
@@ -1013,40 +1089,18 @@ axlPointer __vortex_profiles_invoke_frame_received (axlPointer __data)
 }
 
 /** 
- * @internal
- * 
- * Invoke the first level frame received handler for the given profile
- * into the selected channel. This function also frees the vortex
- * frame passed in.
- *
- * @param uri 
- * @param channel_num 
- * @param connection 
- * @param frame 
- * 
- * @return axl_true if frame was delivered to a handler or axl_false if
- * frame was not delivered.
+ * @internal Delivers the frame to the first level frame received
+ * handler of the profile provided, consuming the profile reference
+ * owned by the caller. The frame is not released if the function
+ * fails.
  */
-axl_bool      vortex_profiles_invoke_frame_received (const char       * uri,
-						     int                channel_num,
-						     VortexConnection * connection,
-						     VortexFrame      * frame)
+axl_bool      __vortex_profiles_deliver_frame_received (VortexCtx        * ctx,
+							VortexProfile    * profile,
+							VortexChannel    * channel,
+							VortexConnection * connection,
+							VortexFrame      * frame)
 {
-	VortexProfile             * profile;
 	VortexProfileReceivedData * data;
-	VortexCtx                 * ctx = vortex_connection_get_ctx (connection);
-	VortexChannel             * channel;
-
-	v_return_val_if_fail (uri,                             axl_false);
-	v_return_val_if_fail (channel_num >= 0,                axl_false);
-	v_return_val_if_fail (connection,                      axl_false); 
-	v_return_val_if_fail (frame,                           axl_false);
-	v_return_val_if_fail (ctx && ctx->registered_profiles, axl_false);
-
-	vortex_log (VORTEX_LEVEL_DEBUG, "delivering frame-id=%d", vortex_frame_get_id (frame));
-
-	/* get profile reference */
-	profile = __vortex_profiles_get_and_ref (ctx->registered_profiles, uri, "frame_received");
 
 	if ((profile == NULL) || (profile->received == NULL)) {
 		/* release profile */
@@ -1079,7 +1133,7 @@ axl_bool      vortex_profiles_invoke_frame_received (const char       * uri,
 		return axl_false;
 	} /* end if */
 	data->profile     = profile;
-	data->channel_num = channel_num;
+	data->channel_num = vortex_channel_get_number (channel);
 	data->connection  = connection;
 	data->frame       = frame;
 
@@ -1100,7 +1154,6 @@ axl_bool      vortex_profiles_invoke_frame_received (const char       * uri,
 	}
 
 	/* update channel reference */
-	channel = vortex_connection_get_channel (connection, channel_num);
 	if (! vortex_channel_ref2 (channel, "first level handler")) {
 		vortex_log (VORTEX_LEVEL_CRITICAL, "failed to acquire reference to channel (%p) over connection id=%d, skipping frame delivery",
 			    channel, vortex_connection_get_id (connection));
@@ -1117,6 +1170,86 @@ axl_bool      vortex_profiles_invoke_frame_received (const char       * uri,
 	return axl_true;
 }
 
+/** 
+ * @internal
+ * 
+ * Invoke the first level frame received handler for the given profile
+ * into the selected channel. This function also frees the vortex
+ * frame passed in.
+ *
+ * The vortex reader uses \ref
+ * vortex_profiles_channel_invoke_frame_received which avoids looking
+ * up the profile by its uri.
+ *
+ * @param uri 
+ * @param channel_num 
+ * @param connection 
+ * @param frame 
+ * 
+ * @return axl_true if frame was delivered to a handler or axl_false if
+ * frame was not delivered.
+ */
+axl_bool      vortex_profiles_invoke_frame_received (const char       * uri,
+						     int                channel_num,
+						     VortexConnection * connection,
+						     VortexFrame      * frame)
+{
+	VortexProfile             * profile;
+	VortexCtx                 * ctx = vortex_connection_get_ctx (connection);
+	VortexChannel             * channel;
+
+	v_return_val_if_fail (uri,                             axl_false);
+	v_return_val_if_fail (channel_num >= 0,                axl_false);
+	v_return_val_if_fail (connection,                      axl_false); 
+	v_return_val_if_fail (frame,                           axl_false);
+	v_return_val_if_fail (ctx && ctx->registered_profiles, axl_false);
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "delivering frame-id=%d", vortex_frame_get_id (frame));
+
+	/* get profile reference */
+	profile = __vortex_profiles_get_and_ref (ctx->registered_profiles, uri, "frame_received");
+	channel = vortex_connection_get_channel (connection, channel_num);
+
+	return __vortex_profiles_deliver_frame_received (ctx, profile, channel, connection, frame);
+}
+
+/** 
+ * @internal Invoke the first level frame received handler for the
+ * profile running on the channel provided. 
+ *
+ * Unlike \ref vortex_profiles_invoke_frame_received, the profile is
+ * taken from the reference cached on the channel so no registry lock
+ * is acquired and the profile uri is not hashed for each frame
+ * received.
+ *
+ * @param channel The channel where the frame was received.
+ * @param frame The frame to deliver.
+ * 
+ * @return axl_true if frame was delivered to a handler or axl_false if
+ * frame was not delivered (the frame is not released in such case).
+ */
+axl_bool      vortex_profiles_channel_invoke_frame_received (VortexChannel * channel,
+							     VortexFrame   * frame)
+{
+	VortexProfile             * profile;
+	VortexConnection          * connection = vortex_channel_get_connection (channel);
+	VortexCtx                 * ctx        = vortex_channel_get_ctx (channel);
+
+	v_return_val_if_fail (connection,                      axl_false); 
+	v_return_val_if_fail (frame,                           axl_false);
+	v_return_val_if_fail (ctx && ctx->registered_profiles, axl_false);
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "delivering frame-id=%d", vortex_frame_get_id (frame));
+
+	/* get cached profile and acquire a reference for the
+	 * delivery (the cache may be updated meanwhile) */
+	profile = __vortex_profiles_get_cached (ctx, channel);
+	if (! __vortex_profiles_ref (profile, "frame_received"))
+		profile = NULL;
+
+	return __vortex_profiles_deliver_frame_received (ctx, profile, channel, connection, frame);
+}
+
 /** 
  * @brief  Returns if the given profiles have actually defined the received  handler. 
  * 
@@ -1341,6 +1474,13 @@ axl_bool      vortex_profiles_is_registered (VortexCtx  * ctx,
  * - 2: Disable automatic MIME handling, making the configuration
  * process to not check next levels.
  *
+ * Any of the previous values can be or'ed with \ref
+ * VORTEX_AUTOMATIC_MIME_LAZY_PARSE to make MIME headers of messages
+ * received on channels running the profile to be parsed only when
+ * they are first accessed (\ref vortex_frame_get_mime_header, \ref
+ * vortex_frame_get_content_type...). Profiles that never read MIME
+ * headers avoid parsing and allocating them for each message.
+ *
  * @param ctx The context where the operation will be performed.
  *
  * @param uri The uri profile to be configured.
@@ -1352,9 +1492,14 @@ void      vortex_profiles_set_automatic_mime      (VortexCtx   * ctx,
 						   int           value)
 {
 	VortexProfile             * profile;
+	axl_bool                    mime_lazy;
 
 	v_return_if_fail (uri);
 	v_return_if_fail (ctx);
+
+	/* get lazy parse flag */
+	mime_lazy = (value & VORTEX_AUTOMATIC_MIME_LAZY_PARSE) == VORTEX_AUTOMATIC_MIME_LAZY_PARSE;
+	value     = value & ~VORTEX_AUTOMATIC_MIME_LAZY_PARSE;
 	v_return_if_fail (value == 0 || value == 1 || value == 2);
 
 	profile = vortex_hash_lookup (ctx->registered_profiles, (axlPointer)uri);
@@ -1367,6 +1512,7 @@ void      vortex_profiles_set_automatic_mime      (VortexCtx   * ctx,
 
 	/* configuring automatic MIME handling */
 	profile->automatic_mime = value;
+	profile->mime_lazy      = mime_lazy;
 	return;
 }
 
@@ -1383,7 +1529,8 @@ void      vortex_profiles_set_automatic_mime      (VortexCtx   * ctx,
  * @return The value associated to the automatic MIME handling
  * configured on the profile provided. The function return 0 (not
  * configured) if the parameter is NULL or the profile wasn't
- * registered.
+ * registered. \ref VORTEX_AUTOMATIC_MIME_LAZY_PARSE is not included
+ * (see \ref vortex_profiles_channel_mime_lazy).
  */
 int       vortex_profiles_get_automatic_mime      (VortexCtx   * ctx,
 						   const char  * uri)
@@ -1404,6 +1551,110 @@ int       vortex_profiles_get_automatic_mime      (VortexCtx   * ctx,
 	return profile->automatic_mime;
 }
 
+/** 
+ * @brief Allows to configure a handler that creates a payload sink
+ * (\ref VortexPayloadSink) for each incoming message received on
+ * channels running the profile provided.
+ *
+ * The handler is called with the first frame of each message (MSG,
+ * RPY or ANS) received on a channel that has no sink installed (see
+ * \ref vortex_channel_set_payload_sink). If the handler returns a
+ * sink, the message content is streamed into it instead of being
+ * delivered to the frame received handler. Returning NULL makes the
+ * message to be delivered as usual.
+ *
+ * The handler is called from the vortex reader thread so it must not
+ * block.
+ *
+ * @param ctx The context where the operation will be performed.
+ *
+ * @param uri The uri profile to be configured.
+ *
+ * @param handler The handler that creates sinks or NULL to disable
+ * the configuration.
+ *
+ * @param user_data User defined pointer passed to the handler.
+ *
+ * @return axl_true if the handler was configured, otherwise axl_false
+ * is returned (profile not registered).
+ */
+axl_bool  vortex_profiles_set_payload_sink_handler (VortexCtx                      * ctx,
+						    const char                     * uri,
+						    VortexPayloadSinkCreateHandler   handler,
+						    axlPointer                       user_data)
+{
+	VortexProfile             * profile;
+
+	v_return_val_if_fail (ctx && uri, axl_false);
+
+	profile = vortex_hash_lookup (ctx->registered_profiles, (axlPointer)uri);
+	if (profile == NULL) {
+		vortex_log (VORTEX_LEVEL_WARNING, 
+			    "Attempting to configure payload sink handler over a profile not registered (%s)", uri);
+		return axl_false;
+	} /* end if */
+
+	/* configure handler */
+	profile->sink_create           = handler;
+	profile->sink_create_user_data = user_data;
+	return axl_true;
+}
+
+/** 
+ * @internal Creates a payload sink for the message starting with the
+ * frame provided, in the case the channel profile has a sink handler
+ * configured.
+ *
+ * @param channel The channel where the frame was received.
+ *
+ * @param frame The first frame of the incoming message.
+ *
+ * @return A new sink reference or NULL if no sink was created.
+ */
+VortexPayloadSink * vortex_profiles_create_payload_sink (VortexChannel * channel,
+							 VortexFrame   * frame)
+{
+	VortexCtx                 * ctx = vortex_channel_get_ctx (channel);
+	VortexProfile             * profile;
+	VortexPayloadSink         * sink = NULL;
+
+	if (ctx == NULL || ctx->registered_profiles == NULL)
+		return NULL;
+
+	/* get profile (reference owned by the channel) */
+	profile = __vortex_profiles_get_cached (ctx, channel);
+	if (profile == NULL)
+		return NULL;
+
+	/* call to create the sink */
+	if (profile->sink_create)
+		sink = profile->sink_create (channel, frame, profile->sink_create_user_data);
+
+	return sink;
+}
+
+/** 
+ * @internal Allows to check if MIME headers of messages received on
+ * the channel provided must be parsed lazily (\ref
+ * VORTEX_AUTOMATIC_MIME_LAZY_PARSE configured on its profile).
+ *
+ * @param channel The channel to check.
+ *
+ * @return axl_true if lazy MIME parsing is enabled, otherwise axl_false.
+ */
+axl_bool  vortex_profiles_channel_mime_lazy       (VortexChannel    * channel)
+{
+	VortexCtx                 * ctx = vortex_channel_get_ctx (channel);
+	VortexProfile             * profile;
+
+	if (ctx == NULL || ctx->registered_profiles == NULL)
+		return axl_false;
+
+	/* get profile (reference owned by the channel) */
+	profile = __vortex_profiles_get_cached (ctx, channel);
+	return profile && profile->mime_lazy;
+}
+
 /** 
  * @internal Init profiles module.
  * 
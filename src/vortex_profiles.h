@@ -97,6 +97,9 @@ axl_bool  vortex_profiles_invoke_frame_received   (const char       * uri,
 						   VortexConnection * connection,
 						   VortexFrame      * frame);
 
+axl_bool  vortex_profiles_channel_invoke_frame_received (VortexChannel * channel,
+							 VortexFrame   * frame);
+
 axl_bool  vortex_profiles_is_defined_received     (VortexCtx        * ctx,
 						   const char       * uri);
 
@@ -122,6 +125,20 @@ void      vortex_profiles_set_automatic_mime      (VortexCtx        * ctx,
 int       vortex_profiles_get_automatic_mime      (VortexCtx        * ctx,
 						   const char       * uri);
 
+axl_bool  vortex_profiles_channel_mime_lazy       (VortexChannel    * channel);
+
+axl_bool  vortex_profiles_set_payload_sink_handler (VortexCtx                      * ctx,
+						    const char                     * uri,
+						    VortexPayloadSinkCreateHandler   handler,
+						    axlPointer                       user_data);
+
+VortexPayloadSink * vortex_profiles_create_payload_sink (VortexChannel * channel,
+							 VortexFrame   * frame);
+
+axl_bool  vortex_profiles_resolve_channel         (VortexChannel    * channel);
+
+void      vortex_profiles_release_cache           (axlPointer         profile);
+
 void      vortex_profiles_init                    (VortexCtx   * ctx);
 
 void      vortex_profiles_cleanup                 (VortexCtx   * ctx);
@@ -131,13 +131,6 @@ axl_bool      __vortex_reader_update_incoming_buffer_and_notify (VortexCtx
 								 VortexChannel     * channel,
 								 VortexFrame       * frame)
 {
-
-
-	VortexChannel     * channel0;
-	unsigned int        ackno;
-	int                 window;
-	VortexWriterData    writer;
-
 	/* now, we have to update current incoming max seq no allowed
 	 * for future checkings on this channel and to generate a SEQ
 	 * frame signaling this state to the remote peer. */
@@ -150,39 +143,14 @@ axl_bool      __vortex_reader_update_incoming_buffer_and_notify (VortexCtx
 		/* only perform this task for those frames that have
 		 * actually payload content to report and the current
 		 * window size have changed. */
-		if (vortex_channel_update_incoming_buffer (channel, frame, &ackno, &window)) {
-			/* It seems there are something to report.
-			 * 
-			 * Now create a SEQ frame with higher priority to
-			 * report remote side that the current max seq no
-			 * value have been updated. */
-			writer.type        = VORTEX_FRAME_TYPE_SEQ;
-			writer.msg_no      = 0;
-			writer.the_frame   = vortex_frame_seq_build_up_from_params_buffer (vortex_channel_get_number (channel),
-											   ackno,
-											   window,
-											   ctx->reader_seq_frame,
-											   /* the following size value is found at the 
-											      reader_seq_frame declaration found at vortex_ctx_private.h */
-											   50,
-											   &(writer.the_size));
-			/* writer.the_size    = strlen (writer.the_frame); */
-			writer.is_complete = axl_true;
-			vortex_log (VORTEX_LEVEL_DEBUG, "notifying remote side that current buffer status is %s",
-				    writer.the_frame);
-			/* Queue the vortex writer message to be sent with
-			 * higher priority, currently, the following function
-			 * will check if the packet to send is a SEQ frame to
-			 * apply this priority. */
-			channel0 = vortex_connection_get_channel (connection, 0);
-			if ((channel0 == NULL) || ! vortex_sequencer_direct_send (connection, channel0, &writer)) {
-				vortex_log (VORTEX_LEVEL_CRITICAL, "unable to queue a SEQ frame");
-				/* deallocate memory on error, because no one
-				 * will do it. */
-				vortex_frame_unref (frame);
-				return axl_false;
-			}
-			
+		/* the following buffer size (50) is found at the
+		 * reader_seq_frame declaration found at
+		 * vortex_ctx_private.h */
+		if (! vortex_channel_notify_incoming_buffer (channel, frame, ctx->reader_seq_frame)) {
+			/* deallocate memory on error, because no one
+			 * will do it. */
+			vortex_frame_unref (frame);
+			return axl_false;
 		} /* end if */
 		break;
 	default:
@@ -279,6 +247,9 @@ void __vortex_reader_process_socket (VortexCtx        * ctx,
 	VortexFrameType    type;
 	VortexChannel    * channel;
 	axl_bool           more;
+	axl_bool           to_sink;
+	axl_bool           metrics;
+	struct timeval     stamp;
 #if defined(ENABLE_VORTEX_LOG)
 	char             * raw_frame;
 	int                frame_id;
@@ -302,10 +273,18 @@ void __vortex_reader_process_socket (VortexCtx        * ctx,
 	if (connection->reader_unwatch)
 		return;
 
-	/* read all frames received from remote site */
+	/* read all frames received from remote site (measuring
+	 * parse time if metrics are enabled) */
+	metrics = __vortex_metrics_start (ctx, &stamp);
 	frame   = vortex_frame_get_next (connection);
 	if (frame == NULL) 
 		return;
+	if (metrics) {
+		__vortex_metrics_record_since (ctx, VORTEX_METRIC_FRAME_PARSE, NULL, &stamp);
+		__vortex_metrics_count_series (ctx, NULL, VORTEX_COUNTER_FRAMES_RECEIVED, 1);
+		__vortex_metrics_count_series (ctx, NULL, VORTEX_COUNTER_BYTES_RECEIVED, vortex_frame_get_payload_size (frame));
+	} /* end if */
+	VORTEX_TRACE_FRAME (ctx, connection, frame, VORTEX_TRACE_FRAME_READ);
 
 	/* get frame type to avoid calling everytime to
 	 * vortex_frame_get_type */
@@ -350,8 +329,14 @@ void __vortex_reader_process_socket (VortexCtx        * ctx,
 	}
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "passed frame id=%d connection id=%d existence stage", frame_id, vortex_connection_get_id (connection));
+
+	/* check if the frame content is going to be written into a
+	 * payload sink: in such case, the incoming buffer is updated
+	 * once the content is written */
+	to_sink = vortex_channel_payload_sink_accepts (channel, frame);
+
  	/* now update current incoming buffers to track SEQ frames */
- 	if (! __vortex_reader_update_incoming_buffer_and_notify (ctx, connection, channel, frame)) {
+ 	if (! to_sink && ! __vortex_reader_update_incoming_buffer_and_notify (ctx, connection, channel, frame)) {
  		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to notify SEQ channel status, connection broken or protocol violation");
  		return;
  	} /* end if */
@@ -508,6 +493,16 @@ void __vortex_reader_process_socket (VortexCtx        * ctx,
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "passed channel update status due to frame id=%d received stage type=%d", frame_id, type);
 
+	/* hand the frame to the payload sink worker: it is written
+	 * outside the reader and the window is reported as consumed
+	 * (SEQ frame) only once written, so the remote peer is
+	 * throttled by the sink speed */
+	if (to_sink) {
+		vortex_log (VORTEX_LEVEL_DEBUG, "frame id=%d queued to be written into channel payload sink", frame_id);
+		vortex_channel_payload_sink_write (channel, frame);
+		return;
+	} /* end if */
+
 	/* If we have a frame to be joined then threat it instead of
 	 * invoke frame received handler. This is done by checking for
 	 * more flag. */
@@ -579,12 +574,19 @@ void __vortex_reader_process_socket (VortexCtx        * ctx,
 
  	/* if the frame is complete, apply mime processing */
  	if (vortex_frame_get_more_flag (frame) == 0 && type != VORTEX_FRAME_TYPE_NUL && vortex_channel_have_complete_flag (channel)) {
- 		/* call to update frame MIME status */
- 		if (! vortex_frame_mime_process (frame))
+ 		/* call to update frame MIME status (only locating the
+		 * MIME body if the profile parses headers on demand) */
+ 		if (! (vortex_profiles_channel_mime_lazy (channel) ? vortex_frame_mime_process_lazy (frame) : vortex_frame_mime_process (frame)))
  			vortex_log (VORTEX_LEVEL_WARNING, "failed to update MIME status for the frame id=%d, continue delivery",
 				    frame_id);
  	} 
 
+	/* record when the frame was ready to measure how long it
+	 * waits until its handler is called */
+	if (metrics)
+		vortex_frame_set_received_stamp (frame);
+	VORTEX_TRACE_FRAME (ctx, connection, frame, VORTEX_TRACE_FRAME_VALIDATED);
+
 	/* check for general frame received (channel != 0) */
 	if (vortex_channel_get_number (channel) != 0 && 
 	    vortex_reader_invoke_frame_received (ctx, connection, channel, frame)) {
@@ -605,10 +607,7 @@ void __vortex_reader_process_socket (VortexCtx        * ctx,
 	/* if not, try to deliver to first level. If second level
 	 * invocation was ok, the frame have been freed. If not, the
 	 * first level will do this */
-	if (vortex_profiles_invoke_frame_received (vortex_channel_get_profile    (channel),
-						   vortex_channel_get_number     (channel),
-						   vortex_channel_get_connection (channel),
-						   frame)) {
+	if (vortex_profiles_channel_invoke_frame_received (channel, frame)) {
 		vortex_log (VORTEX_LEVEL_DEBUG, "frame id=%d delivered on first (profile) level handler channel",
 			    frame_id);
 		return; /* frame was successfully delivered */
@@ -1238,6 +1237,17 @@ void __vortex_reader_dispatch_connection (int                  fds,
 		/* call to process incoming data, activating all
 		 * invocation code (first and second level handler) */
 		__vortex_reader_process_socket (ctx, connection);
+
+		/* keep on processing while the receive handler has
+		 * content buffered, which is not notified by the I/O
+		 * waiting mechanism (for example TLS records already
+		 * read from the socket) */
+		while (connection->pending_input &&
+		       vortex_connection_is_ok (connection, axl_false) &&
+		       ! connection->reader_unwatch &&
+		       ! vortex_connection_is_defined_preread_handler (connection) &&
+		       connection->pending_input (connection)) 
+			__vortex_reader_process_socket (ctx, connection);
 		break;
 	} /* end if */
 	return;
@@ -1324,6 +1334,8 @@ axlPointer __vortex_reader_run (VortexCtx * ctx)
 	VORTEX_SOCKET      max_fds     = 0;
 	VORTEX_SOCKET      result;
 	int                error_tries = 0;
+	axl_bool           metrics     = axl_false;
+	struct timeval     stamp;
 
 	/* initialize the read set */
 	if (ctx->on_reading != NULL)
@@ -1360,6 +1372,7 @@ axlPointer __vortex_reader_run (VortexCtx * ctx)
 			vortex_ctx_check_on_finish (ctx);
 
 			vortex_log (VORTEX_LEVEL_DEBUG, "no more connection to watch for, putting thread to sleep");
+			metrics = axl_false;
 			goto __vortex_reader_run_first_connection;
 		}
 
@@ -1372,8 +1385,13 @@ axlPointer __vortex_reader_run (VortexCtx * ctx)
 			continue;
 		} /* end if */
 		
+		/* account work done since last wakeup */
+		if (metrics)
+			__vortex_metrics_record_since (ctx, VORTEX_METRIC_READER_LOOP, NULL, &stamp);
+
 		/* perform IO blocking wait for read operation */
 		result = vortex_io_waiting_invoke_wait (ctx, ctx->on_reading, max_fds, READ_OPERATIONS);
+		metrics = __vortex_metrics_start (ctx, &stamp);
 
 		/* do automatic thread pool resize here */
 		__vortex_thread_pool_automatic_resize (ctx);  
@@ -39,8 +39,13 @@
 
 /* local include */
 #include <vortex_ctx_private.h>
+#include <vortex_connection_private.h>
 #include <vortex_payload_feeder_private.h>
 
+#if defined(VORTEX_HAVE_SENDFILE)
+#include <sys/sendfile.h>
+#endif
+
 #define LOG_DOMAIN "vortex-sequencer"
 
 void __vortex_sequencer_channel_unref (axlPointer channel)
@@ -58,6 +63,7 @@ void vortex_sequencer_release_state (VortexSequencerState * state)
 
 	axl_hash_cursor_free (state->ready_cursor);
 	axl_hash_free (state->ready);
+	axl_list_free (state->batched);
 
 	axl_free (state);
 
@@ -76,6 +82,7 @@ VortexSequencerState * vortex_sequencer_create_state (void)
 
 	/* create cursors */
 	result->ready_cursor   = axl_hash_cursor_new (result->ready);
+	result->batched        = axl_list_new (axl_list_always_return_1, NULL);
 
 	/* init mutex and cond */
 	vortex_mutex_create (&result->mutex);
@@ -84,9 +91,30 @@ VortexSequencerState * vortex_sequencer_create_state (void)
 	return result;
 }
 
-axl_bool vortex_sequencer_add_channel (VortexCtx * ctx, VortexSequencerData * data)
+/** 
+ * @internal Releases sequencer data that couldn't be queued.
+ */
+void __vortex_sequencer_data_release (VortexSequencerData ** data, int count)
+{
+	int iterator;
+
+	for (iterator = 0; iterator < count; iterator++) {
+		vortex_payload_feeder_unref (data[iterator]->feeder);
+		axl_free (data[iterator]->message);
+		axl_free (data[iterator]);
+	} /* end for */
+	return;
+}
+
+/** 
+ * @internal Adds the channel to the sequencer ready set and queues
+ * the messages provided (all of them for the same channel) as
+ * pending to be sent.
+ */
+axl_bool vortex_sequencer_add_channel (VortexCtx * ctx, VortexSequencerData ** data, int count)
 {
 	VortexSequencerState * state;
+	VortexChannel        * channel = data[0]->channel;
 
 	/* get state reference */
 	state = ctx->sequencer_state;
@@ -95,24 +123,22 @@ axl_bool vortex_sequencer_add_channel (VortexCtx * ctx, VortexSequencerData * da
 	vortex_mutex_lock (&state->mutex);
 
 	/* check if the channel is already added */
-	if (axl_hash_get (state->ready, data->channel)) {
+	if (axl_hash_get (state->ready, channel)) {
 
 		/* queue message into the channel's pending structure */
-		vortex_channel_queue_pending_message (data->channel, data);
+		vortex_channel_queue_pending_messages (channel, (axlPointer *) data, count);
 
 		vortex_mutex_unlock (&state->mutex);
 		return axl_true;
 	}
 
 	/* seems channel is not added */
-	if (! vortex_channel_is_stalled (data->channel)) {
+	if (! vortex_channel_is_stalled (channel)) {
 		/* update channel reference (this reference is
 		   associated to the channel used by the sequencer) */
-		if (! vortex_channel_ref2 (data->channel, "sequencer")) {
+		if (! vortex_channel_ref2 (channel, "sequencer")) {
 			/* release data */
-			vortex_payload_feeder_unref (data->feeder);
-			axl_free (data->message);
-			axl_free (data);
+			__vortex_sequencer_data_release (data, count);
 
 			vortex_log (VORTEX_LEVEL_CRITICAL, "Failed to acquire reference to queue channel into sequencer");
 			vortex_mutex_unlock (&state->mutex);
@@ -120,11 +146,11 @@ axl_bool vortex_sequencer_add_channel (VortexCtx * ctx, VortexSequencerData * da
 		} /* end if */
 
 		/* add channel */
-		axl_hash_insert_full (state->ready, data->channel, (axlDestroyFunc) __vortex_sequencer_channel_unref, INT_TO_PTR (1), NULL);
+		axl_hash_insert_full (state->ready, channel, (axlDestroyFunc) __vortex_sequencer_channel_unref, INT_TO_PTR (1), NULL);
 	} /* end if */
 
 	/* queue message into the channel's pending structure */
-	vortex_channel_queue_pending_message (data->channel, data);
+	vortex_channel_queue_pending_messages (channel, (axlPointer *) data, count);
 
 	/* unlock */
 	vortex_mutex_unlock (&state->mutex);
@@ -150,9 +176,7 @@ axl_bool vortex_sequencer_queue_data (VortexCtx * ctx, VortexSequencerData * dat
 
 	/* check state before handling this message with the sequencer */
 	if (ctx->vortex_exit || ctx->sequencer_state == NULL || ctx->sequencer_state->exit) {
-		vortex_payload_feeder_unref (data->feeder);
-		axl_free (data->message);
-		axl_free (data);
+		__vortex_sequencer_data_release (&data, 1);
 		return axl_false;
 	}
 
@@ -177,8 +201,12 @@ axl_bool vortex_sequencer_queue_data (VortexCtx * ctx, VortexSequencerData * dat
 	/* get current is stalled status */
 	is_stalled = vortex_channel_is_stalled (data->channel);
 
+	/* record when the message was queued */
+	__vortex_metrics_start (ctx, &data->stamp);
+	VORTEX_TRACE_DATA (ctx, data->channel, data, NULL, VORTEX_TRACE_SEND_QUEUED);
+
 	/* add the channel to the sequencer structure */
-	if (! vortex_sequencer_add_channel (ctx, data)) 
+	if (! vortex_sequencer_add_channel (ctx, &data, 1)) 
 		return axl_false;
 
 	/* signal sequencer (but only if the channel is not stalled) */
@@ -188,6 +216,64 @@ axl_bool vortex_sequencer_queue_data (VortexCtx * ctx, VortexSequencerData * dat
 	return axl_true;
 }
 
+/** 
+ * @internal Queues several messages to be sent over the same
+ * channel, acquiring the sequencer state once and signaling the
+ * sequencer once for all of them (see \ref
+ * vortex_channel_send_msg_batch).
+ *
+ * @param ctx The context where the operation takes place.
+ *
+ * @param data Array of messages to be queued, all of them for the
+ * same channel and in the order they must be sent.
+ *
+ * @param count Number of messages in data.
+ *
+ * @return axl_true if all messages were queued, otherwise axl_false
+ * is returned and all messages are released.
+ */
+axl_bool vortex_sequencer_queue_data_batch (VortexCtx * ctx, VortexSequencerData ** data, int count)
+{
+	axl_bool is_stalled;
+	int      iterator;
+
+	v_return_val_if_fail (data && count > 0, axl_false);
+
+	/* check state before handling these messages */
+	if (ctx->vortex_exit || ctx->sequencer_state == NULL || ctx->sequencer_state->exit) {
+		__vortex_sequencer_data_release (data, count);
+		return axl_false;
+	}
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "new batch of %d messages to be sent: first msgno %d, channel %d, conn-id=%d",
+		    count, data[0]->msg_no, data[0]->channel_num,
+		    vortex_connection_get_id (vortex_channel_get_connection (data[0]->channel)));
+
+	/* get current is stalled status */
+	is_stalled = vortex_channel_is_stalled (data[0]->channel);
+
+	/* record when messages were queued */
+	if (__vortex_metrics_start (ctx, &data[0]->stamp)) {
+		for (iterator = 1; iterator < count; iterator++)
+			data[iterator]->stamp = data[0]->stamp;
+	} /* end if */
+#if defined(ENABLE_VORTEX_TRACE)
+	for (iterator = 0; iterator < count; iterator++)
+		VORTEX_TRACE_DATA (ctx, data[iterator]->channel, data[iterator], NULL, VORTEX_TRACE_SEND_QUEUED);
+#endif
+
+	/* add the channel to the sequencer structure */
+	if (! vortex_sequencer_add_channel (ctx, data, count))
+		return axl_false;
+
+	/* signal sequencer once (but only if the channel is not
+	 * stalled) */
+	if (! is_stalled)
+		vortex_sequencer_signal (ctx);
+
+	return axl_true;
+}
+
 /** 
  * @brief Allows to get current number of pending channel operations.
  *
@@ -286,6 +372,12 @@ int vortex_sequencer_build_packet_to_send (VortexCtx           * ctx,
  	int          size_to_copy        = 0;
  	unsigned int max_seq_no_accepted = vortex_channel_get_max_seq_no_remote_accepted (channel);
 	char       * payload             = NULL;
+	int          zero_copy           = -1;
+#if defined(VORTEX_HAVE_SENDFILE)
+	char         zero_copy_head[2];
+	int          zero_copy_head_size = 0;
+	int          header_size;
+#endif
 
 	/* clear packet */
 	memset (packet, 0, sizeof (VortexWriterData));
@@ -321,8 +413,25 @@ int vortex_sequencer_build_packet_to_send (VortexCtx           * ctx,
 			/* check and increase buffer */
 			CHECK_AND_INCREASE_BUFFER (size_to_copy, ctx->sequencer_feeder_buffer, ctx->sequencer_feeder_buffer_size);
 
+#if defined(VORTEX_HAVE_SENDFILE)
+			/* plain socket without write coalescing: try to
+			 * get content as a file range to be sent with
+			 * sendfile(2) (see vortex_sequencer_direct_send) */
+			if (conn->send == vortex_connection_default_send && conn->batch_max == 0 && conn->batch_size == 0) {
+				zero_copy = __vortex_payload_feeder_zero_copy_content (data->feeder, size_to_copy, 
+										       zero_copy_head, &zero_copy_head_size,
+										       &packet->sendfile_fd, &packet->sendfile_offset);
+				if (zero_copy >= 0) {
+					/* only the head is sent from the buffer */
+					memcpy (ctx->sequencer_feeder_buffer, zero_copy_head, zero_copy_head_size);
+					size_to_copy = zero_copy + zero_copy_head_size;
+				} /* end if */
+			} /* end if */
+#endif
+
 			/* get content available at this moment to be sent */
-			size_to_copy = vortex_payload_feeder_get_content (data->feeder, size_to_copy, ctx->sequencer_feeder_buffer);
+			if (zero_copy < 0)
+				size_to_copy = vortex_payload_feeder_get_content (data->feeder, size_to_copy, ctx->sequencer_feeder_buffer);
 		} else {
 			vortex_log (VORTEX_LEVEL_DEBUG, "feeder cancelled, close transfer status is: %d", data->feeder->close_transfer);
 			if (! data->feeder->close_transfer) {
@@ -389,6 +498,36 @@ build_frame:
 	} else
 		packet->is_complete = (size_to_copy == data->message_size);
 
+#if defined(VORTEX_HAVE_SENDFILE)
+	/* zero copy content: build only the header (followed by the
+	 * initial mime header if any), the rest is sent from the file
+	 * by vortex_sequencer_direct_send */
+	if (zero_copy > 0) {
+		header_size = vortex_frame_build_header_s_buffer (
+			data->type, data->channel_num, data->msg_no,
+			!packet->is_complete || data->fixed_more,
+			data->first_seq_no, size_to_copy, data->ansno,
+			ctx->sequencer_send_buffer, ctx->sequencer_send_buffer_size);
+		if (header_size < 0) {
+			__vortex_connection_shutdown_and_record_error (
+				conn, VortexProtocolError,
+				"unable to build frame header for zero copy content, shutdown connection id=%d",
+				vortex_connection_get_id (conn));
+			return 0;
+		} /* end if */
+
+		memcpy (ctx->sequencer_send_buffer + header_size, zero_copy_head, zero_copy_head_size);
+		ctx->sequencer_send_buffer[header_size + zero_copy_head_size] = 0;
+
+		packet->the_frame     = ctx->sequencer_send_buffer;
+		packet->the_size      = header_size + zero_copy_head_size;
+		packet->sendfile_size = zero_copy;
+		packet->fixed_more    = data->fixed_more;
+
+		return size_to_copy;
+	} /* end if */
+#endif
+
 	/* build frame */
 	packet->the_frame = vortex_frame_build_up_from_params_s_buffer (
 		data->type,        /* frame type to be created */
@@ -420,6 +559,143 @@ build_frame:
 	return size_to_copy;
 }
 
+/** 
+ * @internal Notifies a reply was written (RPY or NUL) to unblock
+ * threads waiting for it.
+ */
+void __vortex_sequencer_signal_reply_sent (VortexChannel * channel, int msg_no)
+{
+	/* update reply sent */
+	vortex_channel_update_status (channel, 0, msg_no, UPDATE_RPY_NO_WRITTEN);
+
+	/* unblock waiting thread for replies sent */
+	vortex_channel_signal_reply_sent_on_close_blocked (channel);
+		
+	/* signal reply sent */
+	vortex_channel_signal_rpy_sent (channel, msg_no);
+	return;
+}
+
+/** 
+ * @internal Writes all frames coalesced for the provided connection
+ * with a single send operation and then notifies replies written. If
+ * the write fails, replies aren't notified and the connection is
+ * closed.
+ */
+axl_bool __vortex_sequencer_batch_flush (VortexCtx * ctx, VortexConnection * conn)
+{
+	axl_bool                      result = axl_true;
+	VortexConnectionBatchSignal * signal;
+	int                           iterator;
+
+	if (conn->batch_size > 0) {
+		vortex_log (VORTEX_LEVEL_DEBUG, "writing %d bytes coalesced over connection id=%d",
+			    conn->batch_size, vortex_connection_get_id (conn));
+		if (! vortex_frame_send_raw (conn, conn->batch_buffer, conn->batch_size)) {
+			vortex_log (VORTEX_LEVEL_CRITICAL, "unable to send coalesced frames over connection id=%d: errno=(%d): %s", 
+				    vortex_connection_get_id (conn),
+				    errno, vortex_errno_get_error (errno));
+			result = axl_false;
+
+			/* frames were lost: the connection can't be used anymore */
+			if (vortex_connection_is_ok (conn, axl_false))
+				__vortex_connection_shutdown_and_record_error (
+					conn, VortexError, "unable to send coalesced frames, closing connection");
+		} /* end if */
+		conn->batch_size = 0;
+	} /* end if */
+
+	/* now notify replies written (only if they were) */
+	for (iterator = 0; iterator < conn->batch_signals_count; iterator++) {
+		signal = &conn->batch_signals[iterator];
+		if (result)
+			__vortex_sequencer_signal_reply_sent (signal->channel, signal->msg_no);
+		vortex_channel_unref2 (signal->channel, "sequencer-batch");
+	} /* end for */
+	conn->batch_signals_count = 0;
+
+	return result;
+}
+
+/** 
+ * @internal Writes frames coalesced for all connections and releases
+ * references acquired. Called by the sequencer thread at the end of
+ * each pass over ready channels (without holding the state mutex).
+ */
+void __vortex_sequencer_batch_flush_all (VortexCtx * ctx, VortexSequencerState * state)
+{
+	VortexConnection * conn;
+
+	while (axl_list_length (state->batched) > 0) {
+		conn = axl_list_get_first (state->batched);
+		axl_list_unlink_first (state->batched);
+
+		__vortex_sequencer_batch_flush (ctx, conn);
+		vortex_connection_unref (conn, "sequencer-batch");
+	} /* end while */
+
+	return;
+}
+
+/** 
+ * @internal Accumulates the packet built into the connection write
+ * coalescing buffer (see vortex_connection_set_write_coalescing). The
+ * buffer is written when the next frame does not fit or at the end of
+ * the sequencer pass over ready channels that filled it.
+ */
+axl_bool __vortex_sequencer_batch_packet (VortexCtx           * ctx, 
+					  VortexConnection    * conn, 
+					  VortexChannel       * channel, 
+					  VortexWriterData    * packet)
+{
+	VortexSequencerState        * state     = ctx->sequencer_state;
+	int                           batch_max = conn->batch_max;
+	VortexConnectionBatchSignal * signal;
+
+	/* next frame does not fit, write what we have */
+	if ((conn->batch_size + packet->the_size) > batch_max) {
+		if (! __vortex_sequencer_batch_flush (ctx, conn))
+			return axl_false;
+	} /* end if */
+
+	/* frame bigger than max coalescing size, send it directly */
+	if (packet->the_size > batch_max) 
+		return vortex_sequencer_direct_send (conn, channel, packet);
+
+	/* register connection to be flushed at the end of the
+	 * current pass */
+	if (conn->batch_size == 0 && conn->batch_signals_count == 0) {
+		if (! vortex_connection_ref (conn, "sequencer-batch"))
+			return axl_false;
+		axl_list_append (state->batched, conn);
+	} /* end if */
+
+	/* check buffer size */
+	if (conn->batch_buffer_size < batch_max) {
+		conn->batch_buffer      = axl_realloc (conn->batch_buffer, batch_max);
+		conn->batch_buffer_size = batch_max;
+	} /* end if */
+
+	/* copy frame content */
+	memcpy (conn->batch_buffer + conn->batch_size, packet->the_frame, packet->the_size);
+	conn->batch_size += packet->the_size;
+
+	/* record reply sent signal to be done once written */
+	if ((packet->type == VORTEX_FRAME_TYPE_RPY || packet->type == VORTEX_FRAME_TYPE_NUL) && packet->is_complete && ! packet->fixed_more) {
+		if (conn->batch_signals_count == conn->batch_signals_size) {
+			conn->batch_signals_size = (conn->batch_signals_size == 0) ? 16 : conn->batch_signals_size * 2;
+			conn->batch_signals      = axl_realloc (conn->batch_signals, sizeof (VortexConnectionBatchSignal) * conn->batch_signals_size);
+		} /* end if */
+		vortex_channel_ref2 (channel, "sequencer-batch");
+		signal          = &conn->batch_signals[conn->batch_signals_count];
+		signal->channel = channel;
+		signal->msg_no  = packet->msg_no;
+		conn->batch_signals_count++;
+	} /* end if */
+
+	return axl_true;
+}
+
 /** 
  * @internal Function that does a send round for a channel. The
  * function assumes the channel is not stalled (but can end stalled
@@ -446,6 +722,13 @@ void __vortex_sequencer_do_send_round (VortexCtx * ctx, VortexChannel * channel,
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "a new message to be sequenced: (conn-id=%d, channel=%d, size=%d)..",
 		    vortex_connection_get_id (conn), data->channel_num, data->message_size);
+
+	/* account time the message waited until its first frame is
+	 * sequenced */
+	if (data->stamp.tv_sec != 0) {
+		__vortex_metrics_record_since (ctx, VORTEX_METRIC_SEQUENCER_QUEUE, vortex_channel_get_metrics_series (channel), &data->stamp);
+		data->stamp.tv_sec = 0;
+	} /* end if */
 	
 	/* if feeder is defined, get pending message size */
 	if (data->feeder)
@@ -470,6 +753,7 @@ void __vortex_sequencer_do_send_round (VortexCtx * ctx, VortexChannel * channel,
 		*paused = axl_true;
 		return;
 	}
+	VORTEX_TRACE_DATA (ctx, channel, data, &packet, VORTEX_TRACE_SEND_BUILT);
 			
 	/* STEP 1: now queue the rest of the message if it wasn't
 	 * completly sequence. We do this before sending the frame to
@@ -514,7 +798,14 @@ void __vortex_sequencer_do_send_round (VortexCtx * ctx, VortexChannel * channel,
 	vortex_log (VORTEX_LEVEL_DEBUG, "frame built, send the frame directly (over channel=%d, conn-id=%d)",
 		    vortex_channel_get_number (channel), vortex_connection_get_id (conn));
 
-	if (! vortex_sequencer_direct_send (conn, channel, &packet)) {
+	if (conn->batch_max > 0 || conn->batch_size > 0) {
+		/* write coalescing enabled (or just disabled with
+		 * frames still coalesced): accumulate the frame */
+		if (! __vortex_sequencer_batch_packet (ctx, conn, channel, &packet)) {
+			vortex_log (VORTEX_LEVEL_WARNING, "unable to send data at this moment");
+			return;
+		}
+	} else if (! vortex_sequencer_direct_send (conn, channel, &packet)) {
 		vortex_log (VORTEX_LEVEL_WARNING, "unable to send data at this moment");
 		return;
 	}
@@ -550,6 +841,7 @@ void vortex_sequencer_process_channels (VortexCtx * ctx, VortexSequencerState *
 		if (vortex_channel_is_stalled (channel)) {
 			vortex_log (VORTEX_LEVEL_DEBUG, "channel=%d (%p) is stalled, removing from ready set",
 				    vortex_channel_get_number (channel), channel);
+			__vortex_channel_stall_begin (channel);
 			axl_hash_cursor_remove (state->ready_cursor);
 			continue;
 		} /* end if */
@@ -623,6 +915,8 @@ void vortex_sequencer_process_channels (VortexCtx * ctx, VortexSequencerState *
 		/* now check stalled channel */
 		if (is_stalled || paused) {
 			vortex_log (VORTEX_LEVEL_DEBUG, "Channel %p is stalled or paused, removing from sequencer", channel);
+			if (is_stalled)
+				__vortex_channel_stall_begin (channel);
 			/* no more send operations, remove channel from our registry but check
 			 * first it wasn't removed during the unlock  */ 				
 			axl_hash_cursor_remove (state->ready_cursor);
@@ -650,6 +944,15 @@ axlPointer __vortex_sequencer_run (axlPointer _data)
 	vortex_mutex_lock (&state->mutex);
 
 	while (axl_true) {
+		/* write frames coalesced still pending before
+		 * exiting */
+		if (axl_list_length (state->batched) > 0 && state->exit) {
+			vortex_mutex_unlock (&state->mutex);
+			__vortex_sequencer_batch_flush_all (ctx, state);
+			vortex_mutex_lock (&state->mutex);
+			continue;
+		} /* end if */
+
 		/* block until receive a new message to be sent (but
 		 * only if there are no ready events) */
 		vortex_log (VORTEX_LEVEL_DEBUG, "sequencer locking (ready channels: %d, exit: %d)",
@@ -681,6 +984,15 @@ axlPointer __vortex_sequencer_run (axlPointer _data)
 
 		/* now process the rest */
 		vortex_sequencer_process_channels (ctx, state, axl_false);
+
+		/* write frames coalesced during this pass, so they
+		 * aren't delayed by other connections keeping channels
+		 * ready */
+		if (axl_list_length (state->batched) > 0) {
+			vortex_mutex_unlock (&state->mutex);
+			__vortex_sequencer_batch_flush_all (ctx, state);
+			vortex_mutex_lock (&state->mutex);
+		} /* end if */
 		
 	} /* end while */
 
@@ -787,6 +1099,80 @@ void vortex_sequencer_stop (VortexCtx * ctx)
 
 
 
+#if defined(VORTEX_HAVE_SENDFILE)
+/** 
+ * @internal Writes the payload of a zero copy packet straight from
+ * its file descriptor into the connection socket. If the socket
+ * isn't ready to accept more content, the rest is read into the
+ * sequencer feeder buffer and written with vortex_frame_send_raw,
+ * which implements waiting for the socket.
+ */
+axl_bool __vortex_sequencer_sendfile (VortexConnection * connection, VortexWriterData * packet)
+{
+	VortexCtx * ctx     = vortex_connection_get_ctx (connection);
+	off_t       offset  = packet->sendfile_offset;
+	int         pending = packet->sendfile_size;
+	int         total   = 0;
+	ssize_t     written;
+
+	while (pending > 0) {
+		written = sendfile (vortex_connection_get_socket (connection), packet->sendfile_fd, &offset, pending);
+		if (written > 0) {
+			/* notify content written */
+			vortex_connection_set_receive_stamp (connection, 0, written);
+			pending -= written;
+			continue;
+		} /* end if */
+
+		if (written < 0 && errno == VORTEX_EINTR)
+			continue;
+
+		/* nothing was sent: the file is shorter than expected
+		 * (errno isn't updated in this case) */
+		if (written == 0) {
+			__vortex_connection_shutdown_and_record_error (
+				connection, VortexError, "unable to send file content with sendfile(2), unexpected end of file (pending %d bytes), conn-id=%d",
+				pending, vortex_connection_get_id (connection));
+			return axl_false;
+		} /* end if */
+
+		if (errno != VORTEX_EAGAIN && errno != VORTEX_EWOULDBLOCK) {
+			__vortex_connection_shutdown_and_record_error (
+				connection, VortexError, "unable to send file content with sendfile(2) (pending %d bytes), errno=%d (%s), conn-id=%d",
+				pending, errno, vortex_errno_get_last_error (), vortex_connection_get_id (connection));
+			return axl_false;
+		} /* end if */
+
+		/* socket not ready, use buffered path for the rest */
+		vortex_log (VORTEX_LEVEL_DEBUG, "socket not ready during sendfile(2), writing %d pending bytes through buffered path (conn-id=%d)",
+			    pending, vortex_connection_get_id (connection));
+		CHECK_AND_INCREASE_BUFFER (pending, ctx->sequencer_feeder_buffer, ctx->sequencer_feeder_buffer_size);
+		while (total < pending) {
+			written = pread (packet->sendfile_fd, ctx->sequencer_feeder_buffer + total, pending - total, offset + total);
+			if (written < 0 && errno == VORTEX_EINTR)
+				continue;
+			if (written == 0) {
+				__vortex_connection_shutdown_and_record_error (
+					connection, VortexError, "unable to read file content to be sent, unexpected end of file (pending %d bytes), conn-id=%d",
+					pending - total, vortex_connection_get_id (connection));
+				return axl_false;
+			} /* end if */
+			if (written < 0) {
+				__vortex_connection_shutdown_and_record_error (
+					connection, VortexError, "unable to read file content to be sent (pending %d bytes), errno=%d, conn-id=%d",
+					pending - total, errno, vortex_connection_get_id (connection));
+				return axl_false;
+			} /* end if */
+			total += written;
+		} /* end while */
+
+		return vortex_frame_send_raw (connection, ctx->sequencer_feeder_buffer, pending);
+	} /* end while */
+
+	return axl_true;
+}
+#endif
+
 axl_bool      vortex_sequencer_direct_send (VortexConnection    * connection,
 					    VortexChannel       * channel,
 					    VortexWriterData    * packet)
@@ -818,19 +1204,26 @@ axl_bool      vortex_sequencer_direct_send (VortexConnection    * connection,
 		/* set as non connected and flag the result */
 		result = axl_false;
 	}
+#if defined(VORTEX_HAVE_SENDFILE)
+	else if (packet->sendfile_size > 0) {
+		/* zero copy packet: send payload from the file and
+		 * then the frame trailer */
+		if (! __vortex_sequencer_sendfile (connection, packet) || 
+		    ! vortex_frame_send_raw (connection, "END\x0D\x0A", 5)) {
+			vortex_log (VORTEX_LEVEL_CRITICAL, "unable to send zero copy frame content over connection id=%d", 
+				    vortex_connection_get_id (connection));
+			result = axl_false;
+		} /* end if */
+	} /* end if */
+#endif
 	
-	/* signal the message have been sent */
-	if ((packet->type == VORTEX_FRAME_TYPE_RPY || packet->type == VORTEX_FRAME_TYPE_NUL) && packet->is_complete && ! packet->fixed_more) {  
+	/* report frame written */
+	if (result)
+		VORTEX_TRACE_PACKET (vortex_connection_get_ctx (connection), connection, channel, packet);
 
-		/* update reply sent */
-		vortex_channel_update_status (channel, 0, packet->msg_no, UPDATE_RPY_NO_WRITTEN);
-
-		/* unblock waiting thread for replies sent */
-		vortex_channel_signal_reply_sent_on_close_blocked (channel);
-		
-		/* signal reply sent */
-		vortex_channel_signal_rpy_sent (channel, packet->msg_no);
-	}
+	/* signal the message have been sent */
+	if ((packet->type == VORTEX_FRAME_TYPE_RPY || packet->type == VORTEX_FRAME_TYPE_NUL) && packet->is_complete && ! packet->fixed_more) 
+		__vortex_sequencer_signal_reply_sent (channel, packet->msg_no);
 
 	/* nothing more */
 	return result;
@@ -43,6 +43,10 @@
 axl_bool vortex_sequencer_queue_data               (VortexCtx           * ctx,
 						    VortexSequencerData * data);
 
+axl_bool vortex_sequencer_queue_data_batch         (VortexCtx            * ctx,
+						    VortexSequencerData ** data,
+						    int                    count);
+
 int      vortex_sequencer_channels_pending_ops     (VortexCtx           * ctx);
 
 axl_bool vortex_sequencer_run                      (VortexCtx * ctx);
@@ -408,6 +408,44 @@ void vortex_thread_set_destroy (VortexThreadDestroyFunc destroy_fn)
 		__vortex_thread_destroy = vortex_thread_destroy_internal;
 }
 
+/** 
+ * @internal Returns a key identifying the calling thread (used to
+ * implement per-thread affinity).
+ */
+axlPointer __vortex_thread_self_key (void)
+{
+#if defined(AXL_OS_WIN32)
+	return INT_TO_PTR (GetCurrentThreadId ());
+#else
+	return (axlPointer) pthread_self ();
+#endif
+}
+
+/** 
+ * @internal Returns an index in the range [0, size) for the calling
+ * thread, used to spread threads among several locks (shards).
+ *
+ * Thread keys are usually addresses of thread descriptors placed at
+ * a fixed distance (so their low bits are mostly equal), so all the
+ * key is mixed (64 bit finalizer from MurmurHash3) before getting
+ * the index.
+ */
+int        __vortex_thread_self_index (int size)
+{
+	unsigned long long key = (unsigned long long) (size_t) __vortex_thread_self_key ();
+
+	if (size <= 1)
+		return 0;
+
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+
+	return (int) (key % (unsigned long long) size);
+}
+
 /** 
  * @brief Allows to create a new non-recursive mutex to protect
  * critical sections to be executed by several threads at the same
@@ -59,6 +59,11 @@ void               vortex_thread_set_create (VortexThreadCreateFunc  create_fn);
 
 void               vortex_thread_set_destroy(VortexThreadDestroyFunc destroy_fn);
 
+/* internal api, do not use */
+axlPointer         __vortex_thread_self_key   (void);
+
+int                __vortex_thread_self_index (int size);
+
 axl_bool           vortex_mutex_create    (VortexMutex       * mutex_def);
 
 axl_bool           vortex_mutex_create_full (VortexMutex       * mutex_def, VortexMutexConf conf);
@@ -0,0 +1,263 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+#define LOG_DOMAIN "vortex-trace"
+
+#include <vortex_trace.h>
+
+/* local private header */
+#include <vortex_ctx_private.h>
+
+/** 
+ * @internal Returns if the stamp provided was configured.
+ */
+#define VORTEX_TRACE_STAMP_IS_SET(stamp) ((stamp)->tv_sec != 0 || (stamp)->tv_usec != 0)
+
+/** 
+ * @brief Allows to check if tracing hooks were compiled into the
+ * library (--enable-vortex-trace).
+ *
+ * @return axl_true if \ref vortex_trace_set_handler can be used,
+ * otherwise axl_false.
+ */
+axl_bool     vortex_trace_is_available   (void)
+{
+#if defined(ENABLE_VORTEX_TRACE)
+	return axl_true;
+#else
+	return axl_false;
+#endif
+}
+
+/** 
+ * @brief Installs a handler that is notified with a \ref
+ * VortexTraceSpan each time a frame or message reaches one of the
+ * points defined by \ref VortexTraceStage.
+ *
+ * Inbound frames are stamped when they are read
+ * (VORTEX_TRACE_FRAME_READ), validated by the reader
+ * (VORTEX_TRACE_FRAME_VALIDATED), picked to run its frame received
+ * handler (VORTEX_TRACE_FRAME_DEQUEUED) and when the handler returns
+ * (VORTEX_TRACE_FRAME_HANDLED). Outbound messages are stamped when
+ * queued into the sequencer (VORTEX_TRACE_SEND_QUEUED), for each
+ * frame built (VORTEX_TRACE_SEND_BUILT) and once each frame is
+ * written (VORTEX_TRACE_SEND_WRITTEN). Each span reports the time
+ * since the previous point so tail latency can be attributed to the
+ * reader, the thread pool queue, the handler, the sequencer or the
+ * writer without enabling debug log.
+ *
+ * Trace points are only compiled when the library is built with
+ * --enable-vortex-trace (see \ref vortex_trace_is_available). 
+ *
+ * @param ctx The context where the handler is installed.
+ *
+ * @param handler The handler to install or NULL to stop tracing.
+ *
+ * @param user_data User defined pointer passed to the handler.
+ *
+ * @return axl_true if the handler was installed, otherwise axl_false
+ * (tracing not compiled or NULL context).
+ */
+axl_bool     vortex_trace_set_handler    (VortexCtx             * ctx,
+					  VortexTraceHandler      handler,
+					  axlPointer              user_data)
+{
+	v_return_val_if_fail (ctx, axl_false);
+
+#if defined(ENABLE_VORTEX_TRACE)
+	/* configure data first so the handler never finds old data */
+	ctx->trace_handler_data = user_data;
+	ctx->trace_handler      = handler;
+	return axl_true;
+#else
+	vortex_log (VORTEX_LEVEL_WARNING, "unable to install trace handler, library built without tracing support (--enable-vortex-trace)");
+	return axl_false;
+#endif
+}
+
+/** 
+ * @brief Gets current time from the clock used by trace spans
+ * (monotonic when available, otherwise wall clock).
+ *
+ * @param stamp Reference where current time is placed.
+ */
+void         vortex_trace_stamp          (struct timeval        * stamp)
+{
+#if defined(CLOCK_MONOTONIC) && ! defined(AXL_OS_WIN32)
+	struct timespec now;
+
+	if (clock_gettime (CLOCK_MONOTONIC, &now) == 0) {
+		stamp->tv_sec  = now.tv_sec;
+		stamp->tv_usec = now.tv_nsec / 1000;
+		return;
+	} /* end if */
+#endif
+	gettimeofday (stamp, NULL);
+	return;
+}
+
+/** 
+ * @internal Reports a span to the handler installed.
+ */
+void __vortex_trace_notify (VortexCtx        * ctx,
+			    VortexTraceHandler handler,
+			    axlPointer         user_data,
+			    VortexTraceSpan  * span)
+{
+	span->usecs = (long) (span->stop.tv_sec - span->start.tv_sec) * 1000000 + (span->stop.tv_usec - span->start.tv_usec);
+	handler (ctx, span, user_data);
+	return;
+}
+
+/** 
+ * @internal Trace point for incoming frames: reports the span since
+ * the previous point (if any) and stamps the frame.
+ */
+void         __vortex_trace_frame        (VortexCtx             * ctx,
+					  VortexConnection      * connection,
+					  VortexFrame           * frame,
+					  VortexTraceStage        stage)
+{
+	VortexTraceHandler   handler;
+	axlPointer           user_data;
+	VortexTraceSpan      span;
+	struct timeval     * stamp;
+
+	if (ctx == NULL || frame == NULL)
+		return;
+
+	/* get a copy of the handler */
+	user_data = ctx->trace_handler_data;
+	handler   = ctx->trace_handler;
+	if (handler == NULL)
+		return;
+
+	stamp = vortex_frame_get_trace_stamp (frame);
+	vortex_trace_stamp (&span.stop);
+
+	if (stage != VORTEX_TRACE_FRAME_READ && VORTEX_TRACE_STAMP_IS_SET (stamp)) {
+		span.stage       = stage;
+		span.start       = (*stamp);
+		span.conn_id     = connection ? vortex_connection_get_id (connection) : -1;
+		span.channel_num = vortex_frame_get_channel (frame);
+		span.msg_no      = vortex_frame_get_msgno (frame);
+		span.type        = vortex_frame_get_type (frame);
+		span.size        = vortex_frame_get_payload_size (frame);
+		__vortex_trace_notify (ctx, handler, user_data, &span);
+	} /* end if */
+
+	(*stamp) = span.stop;
+	return;
+}
+
+/** 
+ * @internal Trace point for outgoing messages (queued and frame
+ * built): reports the span since the previous point (if any) and
+ * stamps the message (and the packet built, if provided).
+ */
+void         __vortex_trace_data         (VortexCtx             * ctx,
+					  VortexChannel         * channel,
+					  VortexSequencerData   * data,
+					  VortexWriterData      * packet,
+					  VortexTraceStage        stage)
+{
+	VortexTraceHandler   handler;
+	axlPointer           user_data;
+	VortexTraceSpan      span;
+
+	if (ctx == NULL || data == NULL)
+		return;
+
+	/* get a copy of the handler */
+	user_data = ctx->trace_handler_data;
+	handler   = ctx->trace_handler;
+	if (handler == NULL)
+		return;
+
+	vortex_trace_stamp (&span.stop);
+
+	if (stage != VORTEX_TRACE_SEND_QUEUED && VORTEX_TRACE_STAMP_IS_SET (&data->trace_stamp)) {
+		span.stage       = stage;
+		span.start       = data->trace_stamp;
+		span.conn_id     = vortex_connection_get_id (vortex_channel_get_connection (channel));
+		span.channel_num = data->channel_num;
+		span.msg_no      = data->msg_no;
+		span.type        = data->type;
+		span.size        = packet ? packet->the_size : data->message_size;
+		__vortex_trace_notify (ctx, handler, user_data, &span);
+	} /* end if */
+
+	data->trace_stamp = span.stop;
+	if (packet)
+		packet->trace_stamp = span.stop;
+	return;
+}
+
+/** 
+ * @internal Trace point for outgoing frames written: reports the span
+ * since the frame was built.
+ */
+void         __vortex_trace_packet       (VortexCtx             * ctx,
+					  VortexConnection      * connection,
+					  VortexChannel         * channel,
+					  VortexWriterData      * packet)
+{
+	VortexTraceHandler   handler;
+	axlPointer           user_data;
+	VortexTraceSpan      span;
+
+	if (ctx == NULL || packet == NULL || ! VORTEX_TRACE_STAMP_IS_SET (&packet->trace_stamp))
+		return;
+
+	/* get a copy of the handler */
+	user_data = ctx->trace_handler_data;
+	handler   = ctx->trace_handler;
+	if (handler == NULL)
+		return;
+
+	vortex_trace_stamp (&span.stop);
+	span.stage       = VORTEX_TRACE_SEND_WRITTEN;
+	span.start       = packet->trace_stamp;
+	span.conn_id     = vortex_connection_get_id (connection);
+	span.channel_num = vortex_channel_get_number (channel);
+	span.msg_no      = packet->msg_no;
+	span.type        = packet->type;
+	span.size        = packet->the_size + packet->sendfile_size;
+	__vortex_trace_notify (ctx, handler, user_data, &span);
+
+	return;
+}
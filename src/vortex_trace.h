@@ -0,0 +1,93 @@
+/*
+ *  LibVortex:  A BEEP (RFC3080/RFC3081) implementation.
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation; either version 2.1
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this program; if not, write to the Free
+ *  Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307 USA
+ *  
+ *  You may find a copy of the license under this software is released
+ *  at COPYING file. This is LGPL software: you are welcome to develop
+ *  proprietary applications using this library without any royalty or
+ *  fee but returning back any change, improvement or addition in the
+ *  form of source code, project image, documentation patches, etc.
+ *
+ *  For commercial support on build BEEP enabled solutions contact us:
+ *          
+ *      Postal address:
+ *         Advanced Software Production Line, S.L.
+ *         C/ Antonio Suarez Nº 10, 
+ *         Edificio Alius A, Despacho 102
+ *         Alcalá de Henares 28802 (Madrid)
+ *         Spain
+ *
+ *      Email address:
+ *         info@aspl.es - http://www.aspl.es/vortex
+ */
+#ifndef __VORTEX_TRACE_H__
+#define __VORTEX_TRACE_H__
+
+#include <vortex.h>
+
+/** 
+ * \addtogroup vortex_trace Vortex Trace: per frame tracing hooks
+ * @{
+ */
+
+axl_bool     vortex_trace_is_available   (void);
+
+axl_bool     vortex_trace_set_handler    (VortexCtx             * ctx,
+					  VortexTraceHandler      handler,
+					  axlPointer              user_data);
+
+void         vortex_trace_stamp          (struct timeval        * stamp);
+
+/* internal API */
+void         __vortex_trace_frame        (VortexCtx             * ctx,
+					  VortexConnection      * connection,
+					  VortexFrame           * frame,
+					  VortexTraceStage        stage);
+
+void         __vortex_trace_data         (VortexCtx             * ctx,
+					  VortexChannel         * channel,
+					  VortexSequencerData   * data,
+					  VortexWriterData      * packet,
+					  VortexTraceStage        stage);
+
+void         __vortex_trace_packet       (VortexCtx             * ctx,
+					  VortexConnection      * connection,
+					  VortexChannel         * channel,
+					  VortexWriterData      * packet);
+
+/** 
+ * @internal Trace points used inside the library. They are only
+ * compiled when the library is built with --enable-vortex-trace
+ * (ENABLE_VORTEX_TRACE), otherwise they are removed along with their
+ * arguments.
+ */
+#if defined(ENABLE_VORTEX_TRACE)
+#define VORTEX_TRACE_FRAME(ctx, conn, frame, stage)          __vortex_trace_frame (ctx, conn, frame, stage)
+#define VORTEX_TRACE_DATA(ctx, channel, data, packet, stage) __vortex_trace_data (ctx, channel, data, packet, stage)
+#define VORTEX_TRACE_PACKET(ctx, conn, channel, packet)      __vortex_trace_packet (ctx, conn, channel, packet)
+#else
+#define VORTEX_TRACE_FRAME(ctx, conn, frame, stage)          do { } while (0)
+#define VORTEX_TRACE_DATA(ctx, channel, data, packet, stage) do { } while (0)
+#define VORTEX_TRACE_PACKET(ctx, conn, channel, packet)      do { } while (0)
+#endif
+
+#endif
+
+/** 
+ * @}
+ */
@@ -132,6 +132,14 @@ typedef enum {
  */
 #define MIME_CONTENT_DESCRIPTION "Content-Description"
 
+/**
+ * @brief Flag that can be or'ed to the value configured with \ref
+ * vortex_profiles_set_automatic_mime to make MIME headers of complete
+ * messages received on channels running the profile to be parsed
+ * only when they are accessed (see \ref vortex_frame_mime_process_lazy).
+ */
+#define VORTEX_AUTOMATIC_MIME_LAZY_PARSE 4
+
 
 /** 
  * @brief Describes the type allowed for a frame or the type a frame actually have.
@@ -491,8 +499,32 @@ typedef enum {
 	 * to signal release after connection creation, otherwise
 	 * axl_false must be used (default value already configured).
 	 */
-	VORTEX_OPTS_RELEASE     = 3, 
-	
+	VORTEX_OPTS_RELEASE     = 3,
+
+	/**
+	 * @brief Allows to request a pipelined channel start during
+	 * connection creation. This option must be followed by a
+	 * constant string with the profile uri to be started.
+	 *
+	 * With this option enabled, \ref vortex_connection_new_full
+	 * sends client greetings and the channel 0 &lt;start> request
+	 * back to back, without waiting for listener greetings, saving
+	 * one round trip on session establishment.
+	 *
+	 * Once the connection is created, the channel can be found
+	 * with \ref vortex_connection_get_channel_by_uri. If remote
+	 * peer refused it, the connection is still created and the
+	 * error can be checked with \ref
+	 * vortex_connection_pop_channel_error.
+	 *
+	 * Because listener greetings are not available when the
+	 * &lt;start> request is sent, \ref
+	 * VORTEX_ENFORCE_PROFILES_SUPPORTED is not checked for this
+	 * channel. Tuning profiles (TLS, SASL) must not be requested
+	 * this way.
+	 */
+	VORTEX_OPTS_PIPELINED_START = 4,
+
 } VortexConnectionOptItem;
 
 /** 
@@ -822,8 +854,36 @@ typedef struct _VortexSequencerData {
 	 * should have all of them the more flag enabled.
 	 */
 	axl_bool              fixed_more;
+
+	/** 
+	 * @brief When the message was queued (only configured while
+	 * metrics are enabled, see \ref vortex_metrics_enable).
+	 */
+	struct timeval        stamp;
+
+	/** 
+	 * @brief Last trace point reached (only configured while
+	 * tracing, see \ref vortex_trace_set_handler).
+	 */
+	struct timeval        trace_stamp;
 } VortexSequencerData;
 
+/** 
+ * @brief Message entry used by \ref vortex_channel_send_msg_batch to
+ * describe each message to be sent.
+ */
+typedef struct _VortexMessageEntry {
+	/** 
+	 * @brief The message content to be sent.
+	 */
+	const void      * message;
+
+	/** 
+	 * @brief The message size.
+	 */
+	size_t            message_size;
+} VortexMessageEntry;
+
 
 
 /**
@@ -846,6 +906,15 @@ typedef struct _VortexWriterData {
 	axl_bool          the_size;
 	axl_bool          is_complete;
 	axl_bool          fixed_more;
+	/* zero copy payload: when sendfile_size > 0, the_frame only
+	 * holds the frame header and the payload is sent from
+	 * sendfile_fd (starting at sendfile_offset) followed by the
+	 * frame trailer */
+	int               sendfile_fd;
+	long long         sendfile_offset;
+	int               sendfile_size;
+	/* when the frame was built (only configured while tracing) */
+	struct timeval    trace_stamp;
 }VortexWriterData;
 
 /** 
@@ -1095,6 +1164,18 @@ typedef enum  {
  */
 typedef struct _WaitReplyData WaitReplyData;
 
+/**
+ * @brief Reply future returned by \ref vortex_channel_send_msg_future.
+ *
+ * A \ref VortexReply represents a reply that is still to be received
+ * for a message sent. It can be polled (\ref vortex_reply_is_ready),
+ * waited with a timeout (\ref vortex_reply_wait, \ref
+ * vortex_reply_wait_any) or configured with a continuation handler
+ * (\ref vortex_reply_set_handler). Once no longer needed it must be
+ * released with \ref vortex_reply_release.
+ */
+typedef struct _VortexReply VortexReply;
+
 /**
  * @brief Enumeration type that allows to use the waiting mechanism to
  * be used by the core library to perform wait on changes on sockets
@@ -1256,6 +1337,286 @@ typedef enum {
 	PAYLOAD_FEEDER_RELEASE = 4
 } VortexPayloadFeederOp;
 
+/** 
+ * @brief Type used to represent a payload sink. This object is the
+ * receiving side counterpart of \ref VortexPayloadFeeder: once
+ * installed on a channel, the content of the next incoming message
+ * is streamed into the sink as frames arrive (for example into a
+ * file) rather than being delivered (or joined in memory) to the
+ * frame received handler.
+ *
+ * See \ref vortex_payload_sink_file and \ref vortex_channel_set_payload_sink.
+ */
+typedef struct _VortexPayloadSink VortexPayloadSink;
+
+/**
+ * @brief Enumeration type used to represent the operations that must
+ * support a \ref VortexPayloadSink implementation.
+ */
+typedef enum {
+	/** 
+	 * @brief Notifies the sink handler that it must write the
+	 * content received. The handler receives in param1 an int
+	 * reference with the amount of bytes to write and in param2
+	 * the content. The handler must write all the content
+	 * provided (blocking if required) and return axl_false if it
+	 * fails.
+	 */
+	PAYLOAD_SINK_WRITE    = 1,
+	/** 
+	 * @brief Notifies the sink handler that the message has been
+	 * completely received. The handler receives in param1 a long
+	 * reference with the total amount of bytes written. The
+	 * handler can return axl_false to report a failure flushing
+	 * content.
+	 */
+	PAYLOAD_SINK_FINISHED = 2,
+	/** 
+	 * @brief Notifies the sink handler to release all resources
+	 * acquired. When this signal is received, the sink is about
+	 * to be collected.
+	 */
+	PAYLOAD_SINK_RELEASE  = 3
+} VortexPayloadSinkOp;
+
+/**
+ * @brief Hints that can be configured on a file descriptor payload
+ * sink (see \ref vortex_payload_sink_fd) to control how content is
+ * written into the storage. Hints not supported by the platform are
+ * ignored.
+ */
+typedef enum {
+	/** 
+	 * @brief No hint, content is written as received.
+	 */
+	PAYLOAD_SINK_HINT_NONE        = 0,
+	/** 
+	 * @brief Preallocate the expected size before writing the
+	 * first byte (posix_fallocate) to avoid fragmentation and
+	 * to fail early if there is no space available.
+	 */
+	PAYLOAD_SINK_HINT_PREALLOCATE = 1,
+	/** 
+	 * @brief Write content through to the storage, flushing it
+	 * periodically and dropping it from the page cache
+	 * (posix_fadvise) so large transfers don't evict other
+	 * content from memory.
+	 */
+	PAYLOAD_SINK_HINT_DIRECT      = 2
+} VortexPayloadSinkHint;
+
+/** 
+ * @brief Asynchronous log delivery state associated to a context
+ * (see \ref vortex_log_async_enable).
+ */
+typedef struct _VortexLogAsync VortexLogAsync;
+
+/** 
+ * @brief Measurements collected by the library when metrics are
+ * enabled (see \ref vortex_metrics_enable).
+ */
+typedef enum {
+	/** 
+	 * @brief Time spent reading and parsing an incoming frame.
+	 */
+	VORTEX_METRIC_FRAME_PARSE     = 0,
+	/** 
+	 * @brief Time since a frame is read until its frame received
+	 * handler starts (accounted by profile).
+	 */
+	VORTEX_METRIC_READER_QUEUE    = 1,
+	/** 
+	 * @brief Time spent inside frame received handlers
+	 * (accounted by profile).
+	 */
+	VORTEX_METRIC_HANDLER         = 2,
+	/** 
+	 * @brief Time since a message is queued until the sequencer
+	 * sends its first frame.
+	 */
+	VORTEX_METRIC_SEQUENCER_QUEUE = 3,
+	/** 
+	 * @brief Time spent writing a frame into the socket.
+	 */
+	VORTEX_METRIC_SEND            = 4,
+	/** 
+	 * @brief Time a channel was stalled waiting for a SEQ frame
+	 * to open the remote window.
+	 */
+	VORTEX_METRIC_SEQ_STALL       = 5,
+	/** 
+	 * @brief Time since a MSG is sent until its reply is received
+	 * (accounted by profile).
+	 */
+	VORTEX_METRIC_ROUND_TRIP      = 6,
+	/** 
+	 * @brief Time spent by the reader loop on each wakeup, since
+	 * the I/O wait returns until it is called again (building the
+	 * set of descriptors to watch and dispatching connections).
+	 */
+	VORTEX_METRIC_READER_LOOP     = 7,
+	/** 
+	 * @internal Number of metrics (not a metric).
+	 */
+	VORTEX_METRIC_LAST            = 8
+} VortexMetric;
+
+/** 
+ * @brief Counters collected by the library when metrics are enabled
+ * (see \ref vortex_metrics_enable and \ref vortex_metrics_get_counter).
+ */
+typedef enum {
+	/** 
+	 * @brief Frames read from connections.
+	 */
+	VORTEX_COUNTER_FRAMES_RECEIVED = 0,
+	/** 
+	 * @brief Payload bytes of the frames read.
+	 */
+	VORTEX_COUNTER_BYTES_RECEIVED  = 1,
+	/** 
+	 * @brief Frames written into connections.
+	 */
+	VORTEX_COUNTER_FRAMES_SENT     = 2,
+	/** 
+	 * @brief Bytes written into connections (headers included).
+	 */
+	VORTEX_COUNTER_BYTES_SENT      = 3,
+	/** 
+	 * @internal Number of counters (not a counter).
+	 */
+	VORTEX_COUNTER_LAST            = 4
+} VortexMetricCounter;
+
+/** 
+ * @brief Snapshot of a metric (see \ref vortex_metrics_get). All
+ * values are reported in microseconds. Percentiles are approximated
+ * with a 25% precision.
+ */
+typedef struct _VortexMetricsSnapshot {
+	/** 
+	 * @brief Number of values accounted.
+	 */
+	long count;
+	/** 
+	 * @brief Sum of all values accounted.
+	 */
+	long sum;
+	/** 
+	 * @brief Highest value accounted.
+	 */
+	long max;
+	/** 
+	 * @brief Median.
+	 */
+	long p50;
+	/** 
+	 * @brief 90th percentile.
+	 */
+	long p90;
+	/** 
+	 * @brief 99th percentile.
+	 */
+	long p99;
+} VortexMetricsSnapshot;
+
+/** 
+ * @brief Metrics collected on a context (see \ref vortex_metrics_enable).
+ */
+typedef struct _VortexMetrics VortexMetrics;
+
+/** 
+ * @internal Values accounted for a profile (or without profile),
+ * cached by channels so recording doesn't have to look it up.
+ */
+typedef struct _VortexMetricsSeries VortexMetricsSeries;
+
+/** 
+ * @brief Points where frames and messages are stamped while tracing
+ * is enabled (see \ref vortex_trace_set_handler). A span is reported
+ * each time a point is reached, starting at the previous point.
+ */
+typedef enum {
+	/** 
+	 * @brief Incoming frame read and parsed from the socket (no
+	 * span is reported, it starts inbound spans).
+	 */
+	VORTEX_TRACE_FRAME_READ       = 0,
+	/** 
+	 * @brief Incoming frame validated by the reader and ready to
+	 * be delivered (span: reader processing).
+	 */
+	VORTEX_TRACE_FRAME_VALIDATED  = 1,
+	/** 
+	 * @brief Incoming frame picked to be delivered to its frame
+	 * received handler (span: thread pool queue).
+	 */
+	VORTEX_TRACE_FRAME_DEQUEUED   = 2,
+	/** 
+	 * @brief Frame received handler returned (span: handler).
+	 */
+	VORTEX_TRACE_FRAME_HANDLED    = 3,
+	/** 
+	 * @brief Outgoing message queued into the sequencer (no span
+	 * is reported, it starts outbound spans).
+	 */
+	VORTEX_TRACE_SEND_QUEUED      = 4,
+	/** 
+	 * @brief Outgoing frame built by the sequencer (span:
+	 * sequencer queue, including time stalled).
+	 */
+	VORTEX_TRACE_SEND_BUILT       = 5,
+	/** 
+	 * @brief Outgoing frame written into the socket (span:
+	 * writer).
+	 */
+	VORTEX_TRACE_SEND_WRITTEN     = 6
+} VortexTraceStage;
+
+/** 
+ * @brief Span reported to the trace handler (see \ref
+ * vortex_trace_set_handler). Stamps are taken from a monotonic clock
+ * when available so only differences between them are meaningful.
+ */
+typedef struct _VortexTraceSpan {
+	/** 
+	 * @brief The point reached (the span finishes here).
+	 */
+	VortexTraceStage  stage;
+	/** 
+	 * @brief When the previous point was reached.
+	 */
+	struct timeval    start;
+	/** 
+	 * @brief When the point was reached.
+	 */
+	struct timeval    stop;
+	/** 
+	 * @brief Span duration (microseconds).
+	 */
+	long              usecs;
+	/** 
+	 * @brief Connection id (-1 if not available).
+	 */
+	int               conn_id;
+	/** 
+	 * @brief Channel number.
+	 */
+	int               channel_num;
+	/** 
+	 * @brief Message number.
+	 */
+	int               msg_no;
+	/** 
+	 * @brief Frame type.
+	 */
+	VortexFrameType   type;
+	/** 
+	 * @brief Frame (or message) size.
+	 */
+	int               size;
+} VortexTraceSpan;
+
 /** 
  * @brief Definition for supported network transports.
  */ 
@@ -23,41 +23,102 @@
 
 /* include xml-rpc library */
 #include <vortex_xml_rpc.h>
-XmlRpcMethodResponse *  service_dispatch (VortexChannel * channel, XmlRpcMethodCall * method_call, axlPointer user_data)
-{
+/* max number of parameters accepted by a service */
+#define SERVICE_DISPATCH_MAX_PARAMS 2
 
-	/* check for a match for a service */
-	if (method_call_is (method_call, "sum", 2, XML_RPC_INT_VALUE, XML_RPC_INT_VALUE,  -1))
-		return __sum_2_int_int (method_call, channel);
+/* service handler */
+typedef XmlRpcMethodResponse * (* ServiceDispatchHandler) (XmlRpcMethodCall * method_call, VortexChannel * channel);
+
+/* service dispatch table entry: services are located by method
+ * name and number of parameters, and then their type signature is
+ * checked (types ends at -1 if not all types are checked) */
+typedef struct _ServiceDispatchEntry {
+	const char             * method_name;
+	int                      param_num;
+	int                      types[SERVICE_DISPATCH_MAX_PARAMS];
+	ServiceDispatchHandler   handler;
+	/* next entry with the same slot or -1 */
+	int                      next;
+} ServiceDispatchEntry;
 
-	if (method_call_is (method_call, "operate", 2, XML_RPC_INT_VALUE, XML_RPC_INT_VALUE,  -1))
-		return __operate_2_int_int (method_call, channel);
+/* hash used to build the dispatch tables when this file was generated */
+static unsigned int __service_dispatch_hash (const char * method_name, int param_num)
+{
+	unsigned int hash = 2166136261u;
+
+	while (*method_name) {
+		hash ^= (unsigned char) *method_name;
+		hash *= 16777619u;
+		method_name++;
+	} /* end while */
 
-	if (method_call_is (method_call, "get_the_string", 0,  -1))
-		return __get_the_string_0 (method_call, channel);
+	hash ^= (unsigned int) param_num;
+	hash *= 16777619u;
 
-	if (method_call_is (method_call, "get_the_bool_1", 0,  -1))
-		return __get_the_bool_1_0 (method_call, channel);
+	return hash;
+}
 
-	if (method_call_is (method_call, "get_the_bool_2", 0,  -1))
-		return __get_the_bool_2_0 (method_call, channel);
+/* locate the service and invoke it */
+static XmlRpcMethodResponse * __service_dispatch_lookup (const ServiceDispatchEntry * entries,
+                                                         const int                  * slots,
+                                                         unsigned int                 slot_mask,
+                                                         VortexChannel              * channel,
+                                                         XmlRpcMethodCall           * method_call)
+{
+	const char                 * method_name = method_call_get_name (method_call);
+	int                          param_num   = method_call_get_num_params (method_call);
+	const ServiceDispatchEntry * entry;
+	XmlRpcMethodValue          * value;
+	int                          index;
+	int                          iterator;
 
-	if (method_call_is (method_call, "get_double_sum", 2, XML_RPC_DOUBLE_VALUE, XML_RPC_DOUBLE_VALUE,  -1))
-		return __get_double_sum_2_double_double (method_call, channel);
+	if (method_name == NULL)
+		return NULL;
 
-	if (method_call_is (method_call, "get_struct", 2, XML_RPC_STRUCT_VALUE, XML_RPC_STRUCT_VALUE,  -1))
-		return __get_struct_2_values_values (method_call, channel);
+	/* walk entries found at the slot */
+	index = slots[__service_dispatch_hash (method_name, param_num) & slot_mask];
+	while (index != -1) {
+		entry = &entries[index];
+		index = entry->next;
 
-	if (method_call_is (method_call, "get_array", 0,  -1))
-		return __get_array_0 (method_call, channel);
+		if (entry->param_num != param_num || ! axl_cmp (entry->method_name, method_name))
+			continue;
 
-	if (method_call_is (method_call, "get_list", 0,  -1))
-		return __get_list_0 (method_call, channel);
+		/* check type signature */
+		for (iterator = 0; iterator < param_num && entry->types[iterator] != -1; iterator++) {
+			value = method_call_get_param_value (method_call, iterator);
+			if (value == NULL || (int) method_value_get_type (value) != entry->types[iterator])
+				break;
+		} /* end for */
 
-	if (method_call_is (method_call, "aritmetic-operations/basic/sum", 2, XML_RPC_INT_VALUE, XML_RPC_INT_VALUE,  -1))
-		return __sum2_2_int_int (method_call, channel);
+		if (iterator == param_num || entry->types[iterator] == -1)
+			return entry->handler (method_call, channel);
+	} /* end while */
 
-	/* return that the method to be invoked, is not supported or recognized by this module */
+	/* method not supported or recognized */
 	return NULL;
 }
 
+/* services without resource */
+static const ServiceDispatchEntry __service_dispatch_entries[] = {
+	{"sum", 2, {XML_RPC_INT_VALUE, XML_RPC_INT_VALUE}, __sum_2_int_int, -1},
+	{"operate", 2, {XML_RPC_INT_VALUE, XML_RPC_INT_VALUE}, __operate_2_int_int, -1},
+	{"get_the_string", 0, {-1}, __get_the_string_0, -1},
+	{"get_the_bool_1", 0, {-1}, __get_the_bool_1_0, -1},
+	{"get_the_bool_2", 0, {-1}, __get_the_bool_2_0, -1},
+	{"get_double_sum", 2, {XML_RPC_DOUBLE_VALUE, XML_RPC_DOUBLE_VALUE}, __get_double_sum_2_double_double, -1},
+	{"get_struct", 2, {XML_RPC_STRUCT_VALUE, XML_RPC_STRUCT_VALUE}, __get_struct_2_values_values, -1},
+	{"get_array", 0, {-1}, __get_array_0, -1},
+	{"get_list", 0, {-1}, __get_list_0, -1},
+	{"aritmetic-operations/basic/sum", 2, {XML_RPC_INT_VALUE, XML_RPC_INT_VALUE}, __sum2_2_int_int, -1}
+};
+
+static const int __service_dispatch_slots[32] = {8, -1, -1, 4, -1, -1, -1, 1, 3, 6, -1, -1, -1, -1, -1, 7, -1, -1, -1, -1, -1, 9, -1, -1, -1, 5, -1, -1, -1, -1, 0, 2};
+
+XmlRpcMethodResponse *  service_dispatch (VortexChannel * channel, XmlRpcMethodCall * method_call, axlPointer user_data)
+{
+
+	/* check for a match for a service */
+	return __service_dispatch_lookup (__service_dispatch_entries, __service_dispatch_slots, 31, channel, method_call);
+}
+
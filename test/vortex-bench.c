@@ -0,0 +1,811 @@
+/*  LibVortex:  A BEEP implementation
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* include base library */
+#include <vortex.h>
+
+#if defined(ENABLE_TLS_SUPPORT)
+/* include tls library */
+#include <vortex_tls.h>
+#endif
+
+#if defined(ENABLE_XML_RPC_SUPPORT)
+/* include xml-rpc library */
+#include <vortex_xml_rpc.h>
+#endif
+
+/*
+ * Loopback benchmark driver: starts a listener and a client inside
+ * the same process (127.0.0.1) and runs a fixed set of scenarios
+ * with fixed parameters so results can be compared between builds:
+ *
+ *  - small-rtt / small-pipelined: 64 bytes MSG/RPY exchanges (plain
+ *    and, when available, TLS), reporting msgs/sec and p50/p99/p999
+ *    round trip times.
+ *  - bulk-rpy: 1MB replies using different client window sizes.
+ *  - ans-nul: one MSG answered with a long series of ANS frames.
+ *  - fan-in: many channels over one connection sending at once.
+ *  - idle-connect / idle-light-traffic: thousands of open
+ *    connections where only a few of them exchange messages.
+ *  - feeder-file: file transfer using a payload feeder.
+ *  - xml-rpc-sum: synchronous XML-RPC invocations.
+ *
+ * Each result is printed to stdout and, if --output is provided,
+ * written as one JSON object per line to the given file.
+ *
+ * Usage: vortex-bench [--output file] [--quick] [--idle-connections N]
+ *                     [--port port] [--only scenario]
+ */
+
+#define BENCH_PROFILE "http://fact.aspl.es/profiles/bench"
+#define BENCH_FILE    "vortex-bench.data"
+
+/* time to wait for a stream to be completed (microseconds) */
+#define BENCH_STREAM_TIMEOUT 120000000
+
+/* listener and client contexts */
+VortexCtx  * listener_ctx           = NULL;
+VortexCtx  * client_ctx             = NULL;
+
+/* bench configuration */
+const char * bench_port             = "44030";
+const char * bench_only             = NULL;
+FILE       * bench_output           = NULL;
+axl_bool     bench_quick            = axl_false;
+int          bench_idle_connections = 10000;
+
+/* state used to count frames received by streaming scenarios */
+typedef struct _BenchStream {
+	VortexAsyncQueue * queue;
+	long               frames;
+	double             bytes;
+} BenchStream;
+
+void bench_frame_received (VortexChannel    * channel,
+			   VortexConnection * connection,
+			   VortexFrame      * frame,
+			   axlPointer         user_data)
+{
+	const char          * payload = vortex_frame_get_payload (frame);
+	int                   size    = vortex_frame_get_payload_size (frame);
+	int                   msg_no  = vortex_frame_get_msgno (frame);
+	int                   count;
+	int                   iterator;
+	char                * content;
+	VortexPayloadFeeder * feeder;
+
+	if (size > 5 && axl_memcmp (payload, "bulk ", 5)) {
+		/* reply with the amount of bytes requested */
+		size    = atoi (payload + 5);
+		content = axl_new (char, size + 1);
+		memset (content, 'b', size);
+		vortex_channel_send_rpy (channel, content, size, msg_no);
+		axl_free (content);
+		return;
+	} /* end if */
+
+	if (size > 4 && axl_memcmp (payload, "ans ", 4)) {
+		/* reply with a series of ANS frames finished by NUL */
+		count   = atoi (payload + 4);
+		payload = strchr (payload + 4, ' ');
+		size    = payload ? atoi (payload + 1) : 64;
+		content = axl_new (char, size + 1);
+		memset (content, 'n', size);
+		for (iterator = 0; iterator < count; iterator++)
+			vortex_channel_send_ans_rpy (channel, content, size, msg_no);
+		vortex_channel_finalize_ans_rpy (channel, msg_no);
+		axl_free (content);
+		return;
+	} /* end if */
+
+	if (size > 5 && axl_memcmp (payload, "file ", 5)) {
+		/* reply with the file content using a feeder */
+		feeder = vortex_payload_feeder_file (payload + 5, axl_false);
+		if (feeder == NULL || ! vortex_channel_send_rpy_from_feeder (channel, feeder, msg_no))
+			vortex_channel_send_err (channel, "unable to send file", 19, msg_no);
+		return;
+	} /* end if */
+
+	/* echo small messages, acknowledge big ones */
+	if (size <= 4096)
+		vortex_channel_send_rpy (channel, payload, size, msg_no);
+	else
+		vortex_channel_send_rpy (channel, "ok", 2, msg_no);
+	return;
+}
+
+void bench_stream_received (VortexChannel    * channel,
+			    VortexConnection * connection,
+			    VortexFrame      * frame,
+			    axlPointer         user_data)
+{
+	BenchStream * stream = user_data;
+
+	switch (vortex_frame_get_type (frame)) {
+	case VORTEX_FRAME_TYPE_ANS:
+		stream->frames++;
+		stream->bytes += vortex_frame_get_payload_size (frame);
+		return;
+	case VORTEX_FRAME_TYPE_RPY:
+		stream->frames++;
+		stream->bytes += vortex_frame_get_payload_size (frame);
+		if (! vortex_frame_get_more_flag (frame))
+			vortex_async_queue_push (stream->queue, INT_TO_PTR (1));
+		return;
+	case VORTEX_FRAME_TYPE_NUL:
+		vortex_async_queue_push (stream->queue, INT_TO_PTR (1));
+		return;
+	default:
+		/* unexpected reply */
+		vortex_async_queue_push (stream->queue, INT_TO_PTR (2));
+		return;
+	} /* end switch */
+}
+
+#if defined(ENABLE_XML_RPC_SUPPORT)
+XmlRpcMethodResponse * bench_xml_rpc_dispatch (VortexChannel    * channel,
+					       XmlRpcMethodCall * method_call,
+					       axlPointer         user_data)
+{
+	int result;
+
+	if (axl_cmp (method_call_get_name (method_call), "sum") && method_call_get_num_params (method_call) == 2) {
+		result = method_call_get_param_value_as_int (method_call, 0) +
+			method_call_get_param_value_as_int (method_call, 1);
+		return CREATE_OK_REPLY (listener_ctx, XML_RPC_INT_VALUE, INT_TO_PTR (result));
+	} /* end if */
+
+	return NULL;
+}
+#endif
+
+axl_bool bench_selected (const char * name)
+{
+	return bench_only == NULL || axl_cmp (bench_only, name);
+}
+
+long bench_usecs (struct timeval * start, struct timeval * stop)
+{
+	struct timeval diff;
+
+	vortex_timeval_substract (stop, start, &diff);
+	return (diff.tv_sec * 1000000) + diff.tv_usec;
+}
+
+double bench_elapsed (struct timeval * start)
+{
+	struct timeval stop;
+	double         elapsed;
+
+	gettimeofday (&stop, NULL);
+	elapsed = bench_usecs (start, &stop) / 1000000.0;
+	if (elapsed <= 0)
+		elapsed = 0.000001;
+	return elapsed;
+}
+
+int bench_compare_samples (const void * a, const void * b)
+{
+	long _a = *((const long *) a);
+	long _b = *((const long *) b);
+
+	return (_a > _b) - (_a < _b);
+}
+
+long bench_percentile (long * samples, int count, double percentile)
+{
+	int index = (int) (count * percentile);
+
+	if (index >= count)
+		index = count - 1;
+	return samples[index];
+}
+
+void bench_emit (const char * bench,
+		 const char * transport,
+		 const char * params,
+		 long         ops,
+		 double       bytes,
+		 double       elapsed,
+		 long       * samples,
+		 int          count)
+{
+	long p50  = -1;
+	long p99  = -1;
+	long p999 = -1;
+
+	if (samples != NULL && count > 0) {
+		qsort (samples, count, sizeof (long), bench_compare_samples);
+		p50  = bench_percentile (samples, count, 0.50);
+		p99  = bench_percentile (samples, count, 0.99);
+		p999 = bench_percentile (samples, count, 0.999);
+	} /* end if */
+
+	printf ("%-20s %-6s %-28s %9ld ops  %8.3f secs  %10.0f ops/sec  %8.2f MB/sec",
+		bench, transport, params, ops, elapsed, ops / elapsed, bytes / (elapsed * 1024 * 1024));
+	if (p50 >= 0)
+		printf ("  p50=%ldus p99=%ldus p999=%ldus", p50, p99, p999);
+	printf ("\n");
+
+	if (bench_output == NULL)
+		return;
+
+	fprintf (bench_output,
+		 "{\"bench\": \"%s\", \"transport\": \"%s\", \"params\": \"%s\", \"ops\": %ld, \"bytes\": %.0f, "
+		 "\"elapsed_sec\": %.6f, \"ops_per_sec\": %.2f, \"mb_per_sec\": %.4f",
+		 bench, transport, params, ops, bytes, elapsed, ops / elapsed, bytes / (elapsed * 1024 * 1024));
+	if (p50 >= 0)
+		fprintf (bench_output, ", \"p50_us\": %ld, \"p99_us\": %ld, \"p999_us\": %ld}\n", p50, p99, p999);
+	else
+		fprintf (bench_output, ", \"p50_us\": null, \"p99_us\": null, \"p999_us\": null}\n");
+	fflush (bench_output);
+	return;
+}
+
+VortexConnection * bench_connect (axl_bool tls)
+{
+	VortexConnection * conn;
+#if defined(ENABLE_TLS_SUPPORT)
+	VortexStatus       status;
+	char             * status_message = NULL;
+#endif
+
+	conn = vortex_connection_new (client_ctx, "127.0.0.1", bench_port, NULL, NULL);
+	if (! vortex_connection_is_ok (conn, axl_false)) {
+		printf ("ERROR: failed to connect to 127.0.0.1:%s: %s\n", bench_port, vortex_connection_get_message (conn));
+		vortex_connection_close (conn);
+		return NULL;
+	} /* end if */
+
+#if defined(ENABLE_TLS_SUPPORT)
+	if (tls) {
+		conn = vortex_tls_start_negotiation_sync (conn, NULL, &status, &status_message);
+		if (status != VortexOk || ! vortex_connection_is_ok (conn, axl_false)) {
+			printf ("ERROR: failed to enable TLS: %s\n", status_message ? status_message : "");
+			vortex_connection_close (conn);
+			return NULL;
+		} /* end if */
+	} /* end if */
+#endif
+
+	return conn;
+}
+
+VortexChannel * bench_channel (VortexConnection * conn, VortexOnFrameReceived received, axlPointer user_data)
+{
+	VortexChannel * channel;
+
+	channel = vortex_channel_new (conn, 0, BENCH_PROFILE,
+				      NULL, NULL,
+				      received, user_data,
+				      NULL, NULL);
+	if (channel == NULL)
+		printf ("ERROR: failed to create bench channel\n");
+	return channel;
+}
+
+axl_bool bench_small (const char * transport, axl_bool tls)
+{
+	VortexConnection * conn;
+	VortexChannel    * channel;
+	VortexAsyncQueue * queue;
+	VortexFrame      * frame;
+	struct timeval     start;
+	struct timeval     sent;
+	struct timeval     stop;
+	char               message[64];
+	long             * samples;
+	int                messages = bench_quick ? 2000 : 20000;
+	int                iterator;
+
+	conn = bench_connect (tls);
+	if (conn == NULL)
+		return axl_false;
+	queue   = vortex_async_queue_new ();
+	channel = bench_channel (conn, vortex_channel_queue_reply, queue);
+	if (channel == NULL)
+		return axl_false;
+	memset (message, 'a', sizeof (message));
+	samples = axl_new (long, messages);
+
+	/* one message at a time to get round trip times */
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < messages; iterator++) {
+		gettimeofday (&sent, NULL);
+		if (! vortex_channel_send_msg (channel, message, sizeof (message), NULL)) {
+			printf ("ERROR: failed to send message %d\n", iterator);
+			return axl_false;
+		} /* end if */
+		frame = vortex_channel_get_reply (channel, queue);
+		if (frame == NULL) {
+			printf ("ERROR: failed to receive reply %d\n", iterator);
+			return axl_false;
+		} /* end if */
+		vortex_frame_unref (frame);
+		gettimeofday (&stop, NULL);
+		samples[iterator] = bench_usecs (&sent, &stop);
+	} /* end for */
+	bench_emit ("small-rtt", transport, "size=64", messages, (double) messages * sizeof (message),
+		    bench_elapsed (&start), samples, messages);
+
+	/* all messages at once to get the message rate */
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < messages; iterator++) {
+		if (! vortex_channel_send_msg (channel, message, sizeof (message), NULL)) {
+			printf ("ERROR: failed to send message %d\n", iterator);
+			return axl_false;
+		} /* end if */
+	} /* end for */
+	for (iterator = 0; iterator < messages; iterator++) {
+		frame = vortex_channel_get_reply (channel, queue);
+		if (frame == NULL) {
+			printf ("ERROR: failed to receive reply %d\n", iterator);
+			return axl_false;
+		} /* end if */
+		vortex_frame_unref (frame);
+	} /* end for */
+	bench_emit ("small-pipelined", transport, "size=64", messages, (double) messages * sizeof (message),
+		    bench_elapsed (&start), NULL, 0);
+
+	axl_free (samples);
+	vortex_async_queue_unref (queue);
+	vortex_connection_close (conn);
+	return axl_true;
+}
+
+axl_bool bench_bulk (void)
+{
+	int                windows[] = {4096, 32768, 262144, 0};
+	VortexConnection * conn;
+	VortexChannel    * channel;
+	VortexAsyncQueue * queue;
+	VortexFrame      * frame;
+	struct timeval     start;
+	char               request[64];
+	char               params[64];
+	int                size     = 1048576;
+	int                requests = bench_quick ? 16 : 64;
+	int                iterator;
+	int                window;
+
+	for (window = 0; windows[window] > 0; window++) {
+		conn = bench_connect (axl_false);
+		if (conn == NULL)
+			return axl_false;
+		queue   = vortex_async_queue_new ();
+		channel = bench_channel (conn, vortex_channel_queue_reply, queue);
+		if (channel == NULL)
+			return axl_false;
+		vortex_channel_set_window_size (channel, windows[window]);
+
+		snprintf (request, sizeof (request), "bulk %d", size);
+		gettimeofday (&start, NULL);
+		for (iterator = 0; iterator < requests; iterator++) {
+			if (! vortex_channel_send_msg (channel, request, strlen (request), NULL)) {
+				printf ("ERROR: failed to send bulk request %d\n", iterator);
+				return axl_false;
+			} /* end if */
+			frame = vortex_channel_get_reply (channel, queue);
+			if (frame == NULL || vortex_frame_get_payload_size (frame) != size) {
+				printf ("ERROR: failed to receive bulk reply %d\n", iterator);
+				return axl_false;
+			} /* end if */
+			vortex_frame_unref (frame);
+		} /* end for */
+
+		snprintf (params, sizeof (params), "window=%d,size=%d", windows[window], size);
+		bench_emit ("bulk-rpy", "plain", params, requests, (double) requests * size,
+			    bench_elapsed (&start), NULL, 0);
+
+		vortex_async_queue_unref (queue);
+		vortex_connection_close (conn);
+	} /* end for */
+
+	return axl_true;
+}
+
+axl_bool bench_ans (void)
+{
+	VortexConnection * conn;
+	VortexChannel    * channel;
+	BenchStream        stream;
+	struct timeval     start;
+	char               request[64];
+	char               params[64];
+	int                count = bench_quick ? 20000 : 200000;
+	int                size  = 256;
+
+	conn = bench_connect (axl_false);
+	if (conn == NULL)
+		return axl_false;
+	memset (&stream, 0, sizeof (BenchStream));
+	stream.queue = vortex_async_queue_new ();
+	channel      = bench_channel (conn, bench_stream_received, &stream);
+	if (channel == NULL)
+		return axl_false;
+	vortex_channel_set_serialize (channel, axl_true);
+
+	snprintf (request, sizeof (request), "ans %d %d", count, size);
+	gettimeofday (&start, NULL);
+	if (! vortex_channel_send_msg (channel, request, strlen (request), NULL) ||
+	    PTR_TO_INT (vortex_async_queue_timedpop (stream.queue, BENCH_STREAM_TIMEOUT)) != 1 ||
+	    stream.frames != count) {
+		printf ("ERROR: ANS/NUL stream failed (received %ld of %d frames)\n", stream.frames, count);
+		return axl_false;
+	} /* end if */
+
+	snprintf (params, sizeof (params), "frames=%d,size=%d", count, size);
+	bench_emit ("ans-nul", "plain", params, stream.frames, stream.bytes, bench_elapsed (&start), NULL, 0);
+
+	vortex_connection_close (conn);
+	vortex_async_queue_unref (stream.queue);
+	return axl_true;
+}
+
+axl_bool bench_fan_in (void)
+{
+	VortexConnection  * conn;
+	VortexChannel    ** channels;
+	VortexAsyncQueue  * queue;
+	VortexFrame       * frame;
+	struct timeval      start;
+	char                message[64];
+	char                params[64];
+	int                 count       = bench_quick ? 16 : 64;
+	int                 per_channel = bench_quick ? 200 : 1000;
+	int                 iterator;
+	int                 channel;
+
+	conn = bench_connect (axl_false);
+	if (conn == NULL)
+		return axl_false;
+
+	/* all channels deliver replies into the same queue */
+	queue    = vortex_async_queue_new ();
+	channels = axl_new (VortexChannel *, count);
+	for (channel = 0; channel < count; channel++) {
+		channels[channel] = bench_channel (conn, vortex_channel_queue_reply, queue);
+		if (channels[channel] == NULL)
+			return axl_false;
+	} /* end for */
+	memset (message, 'f', sizeof (message));
+
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < per_channel; iterator++) {
+		for (channel = 0; channel < count; channel++) {
+			if (! vortex_channel_send_msg (channels[channel], message, sizeof (message), NULL)) {
+				printf ("ERROR: failed to send message over channel %d\n", channel);
+				return axl_false;
+			} /* end if */
+		} /* end for */
+	} /* end for */
+	for (iterator = 0; iterator < count * per_channel; iterator++) {
+		frame = vortex_async_queue_timedpop (queue, BENCH_STREAM_TIMEOUT);
+		if (frame == NULL) {
+			printf ("ERROR: failed to receive fan-in reply %d\n", iterator);
+			return axl_false;
+		} /* end if */
+		vortex_frame_unref (frame);
+	} /* end for */
+
+	snprintf (params, sizeof (params), "channels=%d,size=64", count);
+	bench_emit ("fan-in", "plain", params, count * per_channel, (double) count * per_channel * sizeof (message),
+		    bench_elapsed (&start), NULL, 0);
+
+	axl_free (channels);
+	vortex_connection_close (conn);
+	vortex_async_queue_unref (queue);
+	return axl_true;
+}
+
+axl_bool bench_idle (void)
+{
+	VortexConnection ** conns;
+	VortexChannel     * channel;
+	VortexAsyncQueue  * queue;
+	VortexFrame       * frame;
+	struct timeval      start;
+	struct timeval      sent;
+	struct timeval      stop;
+	char                params[64];
+	long              * samples;
+	int                 count = bench_idle_connections;
+	int                 limit = 0;
+	int                 active = 0;
+	int                 iterator;
+
+	/* both peers live in this process so each connection uses
+	 * two descriptors */
+	vortex_conf_get (client_ctx, VORTEX_HARD_SOCK_LIMIT, &limit);
+	limit = (limit - 256) / 2;
+	if (count > limit) {
+		printf ("NOTE: reducing idle connections from %d to %d (descriptor limit)\n", count, limit);
+		count = limit;
+	} /* end if */
+	if (count <= 0)
+		return axl_true;
+
+	conns = axl_new (VortexConnection *, count);
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < count; iterator++) {
+		conns[iterator] = bench_connect (axl_false);
+		if (conns[iterator] == NULL) {
+			printf ("NOTE: stopped opening connections at %d\n", iterator);
+			count = iterator;
+			break;
+		} /* end if */
+	} /* end for */
+	snprintf (params, sizeof (params), "connections=%d", count);
+	bench_emit ("idle-connect", "plain", params, count, 0, bench_elapsed (&start), NULL, 0);
+
+	/* light traffic: one connection out of 100 exchanges a
+	 * message while the rest stay idle */
+	queue   = vortex_async_queue_new ();
+	samples = axl_new (long, (count / 100) + 1);
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < count; iterator += 100) {
+		channel = bench_channel (conns[iterator], vortex_channel_queue_reply, queue);
+		if (channel == NULL)
+			return axl_false;
+		gettimeofday (&sent, NULL);
+		if (! vortex_channel_send_msg (channel, "ping", 4, NULL)) {
+			printf ("ERROR: failed to send message over connection %d\n", iterator);
+			return axl_false;
+		} /* end if */
+		frame = vortex_channel_get_reply (channel, queue);
+		if (frame == NULL) {
+			printf ("ERROR: failed to receive reply over connection %d\n", iterator);
+			return axl_false;
+		} /* end if */
+		vortex_frame_unref (frame);
+		gettimeofday (&stop, NULL);
+		samples[active++] = bench_usecs (&sent, &stop);
+	} /* end for */
+	bench_emit ("idle-light-traffic", "plain", params, active, active * 4.0, bench_elapsed (&start), samples, active);
+
+	for (iterator = 0; iterator < count; iterator++)
+		vortex_connection_close (conns[iterator]);
+	axl_free (conns);
+	axl_free (samples);
+	vortex_async_queue_unref (queue);
+	return axl_true;
+}
+
+axl_bool bench_feeder (void)
+{
+	VortexConnection * conn;
+	VortexChannel    * channel;
+	BenchStream        stream;
+	struct timeval     start;
+	FILE             * file;
+	char               block[65536];
+	char               params[64];
+	int                size      = bench_quick ? 8388608 : 67108864;
+	int                transfers = 3;
+	int                iterator;
+
+	/* create the file to be transferred */
+	file = fopen (BENCH_FILE, "w");
+	if (file == NULL) {
+		printf ("ERROR: unable to create %s\n", BENCH_FILE);
+		return axl_false;
+	} /* end if */
+	memset (block, 'd', sizeof (block));
+	for (iterator = 0; iterator < size; iterator += sizeof (block))
+		fwrite (block, sizeof (block), 1, file);
+	fclose (file);
+
+	conn = bench_connect (axl_false);
+	if (conn == NULL)
+		return axl_false;
+	memset (&stream, 0, sizeof (BenchStream));
+	stream.queue = vortex_async_queue_new ();
+	channel      = bench_channel (conn, bench_stream_received, &stream);
+	if (channel == NULL)
+		return axl_false;
+	vortex_channel_set_serialize     (channel, axl_true);
+	vortex_channel_set_complete_flag (channel, axl_false);
+
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < transfers; iterator++) {
+		if (! vortex_channel_send_msg (channel, "file " BENCH_FILE, strlen ("file " BENCH_FILE), NULL) ||
+		    PTR_TO_INT (vortex_async_queue_timedpop (stream.queue, BENCH_STREAM_TIMEOUT)) != 1) {
+			printf ("ERROR: file transfer %d failed\n", iterator);
+			return axl_false;
+		} /* end if */
+	} /* end for */
+	if (stream.bytes != (double) size * transfers) {
+		printf ("ERROR: expected %.0f bytes but received %.0f\n", (double) size * transfers, stream.bytes);
+		return axl_false;
+	} /* end if */
+
+	snprintf (params, sizeof (params), "size=%d", size);
+	bench_emit ("feeder-file", "plain", params, transfers, stream.bytes, bench_elapsed (&start), NULL, 0);
+
+	vortex_connection_close (conn);
+	vortex_async_queue_unref (stream.queue);
+	remove (BENCH_FILE);
+	return axl_true;
+}
+
+#if defined(ENABLE_XML_RPC_SUPPORT)
+axl_bool bench_xml_rpc (void)
+{
+	VortexConnection     * conn;
+	VortexChannel        * channel;
+	VortexStatus           status;
+	char                 * status_message = NULL;
+	XmlRpcMethodCall     * method_call;
+	XmlRpcMethodResponse * response;
+	struct timeval         start;
+	struct timeval         sent;
+	struct timeval         stop;
+	long                 * samples;
+	int                    calls = bench_quick ? 1000 : 10000;
+	int                    iterator;
+
+	conn = bench_connect (axl_false);
+	if (conn == NULL)
+		return axl_false;
+	channel = vortex_xml_rpc_boot_channel_sync (conn, NULL, "/", &status, &status_message);
+	if (channel == NULL) {
+		printf ("ERROR: failed to boot XML-RPC channel: %s\n", status_message ? status_message : "");
+		return axl_false;
+	} /* end if */
+
+	samples = axl_new (long, calls);
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < calls; iterator++) {
+		method_call = vortex_xml_rpc_method_call_new (client_ctx, "sum", 2);
+		vortex_xml_rpc_method_call_add_value (method_call, vortex_xml_rpc_method_value_new_int (client_ctx, iterator));
+		vortex_xml_rpc_method_call_add_value (method_call, vortex_xml_rpc_method_value_new_int (client_ctx, 1));
+
+		/* method call is released by the invocation */
+		gettimeofday (&sent, NULL);
+		response = vortex_xml_rpc_invoke_sync (channel, method_call);
+		gettimeofday (&stop, NULL);
+		if (response == NULL || vortex_xml_rpc_method_response_get_status (response) != XML_RPC_OK ||
+		    vortex_xml_rpc_method_value_get_as_int (vortex_xml_rpc_method_response_get_value (response)) != iterator + 1) {
+			printf ("ERROR: XML-RPC invocation %d failed\n", iterator);
+			return axl_false;
+		} /* end if */
+		vortex_xml_rpc_method_response_free (response);
+		samples[iterator] = bench_usecs (&sent, &stop);
+	} /* end for */
+	bench_emit ("xml-rpc-sum", "plain", "params=2", calls, 0, bench_elapsed (&start), samples, calls);
+
+	axl_free (samples);
+	vortex_connection_close (conn);
+	return axl_true;
+}
+#endif
+
+axl_bool bench_init_ctx (VortexCtx * ctx)
+{
+	int limit = 0;
+
+	if (! vortex_init_ctx (ctx))
+		return axl_false;
+
+	/* use epoll when available: select(2) can't handle the idle
+	 * connections scenario */
+	if (vortex_io_waiting_is_available (VORTEX_IO_WAIT_EPOLL))
+		vortex_io_waiting_use (ctx, VORTEX_IO_WAIT_EPOLL);
+
+	/* raise descriptor limit up to the hard limit */
+	if (vortex_conf_get (ctx, VORTEX_HARD_SOCK_LIMIT, &limit) && limit > 0)
+		vortex_conf_set (ctx, VORTEX_SOFT_SOCK_LIMIT, limit, NULL);
+
+#if defined(ENABLE_TLS_SUPPORT)
+	if (! vortex_tls_init (ctx))
+		return axl_false;
+#endif
+	return axl_true;
+}
+
+int  main (int  argc, char  ** argv)
+{
+	int iterator;
+
+	for (iterator = 1; iterator < argc; iterator++) {
+		if (axl_cmp (argv[iterator], "--output") && (iterator + 1) < argc) {
+			bench_output = fopen (argv[++iterator], "w");
+			if (bench_output == NULL) {
+				printf ("ERROR: unable to open %s\n", argv[iterator]);
+				return -1;
+			} /* end if */
+		} else if (axl_cmp (argv[iterator], "--quick")) {
+			bench_quick = axl_true;
+		} else if (axl_cmp (argv[iterator], "--idle-connections") && (iterator + 1) < argc) {
+			bench_idle_connections = atoi (argv[++iterator]);
+		} else if (axl_cmp (argv[iterator], "--port") && (iterator + 1) < argc) {
+			bench_port = argv[++iterator];
+		} else if (axl_cmp (argv[iterator], "--only") && (iterator + 1) < argc) {
+			bench_only = argv[++iterator];
+		} else {
+			printf ("Usage: %s [--output file] [--quick] [--idle-connections N] [--port port] [--only scenario]\n", argv[0]);
+			printf ("Scenarios: small, bulk, ans, fan-in, idle, tls, feeder, xml-rpc\n");
+			return -1;
+		} /* end if */
+	} /* end for */
+
+	/* create and init contexts */
+	listener_ctx = vortex_ctx_new ();
+	client_ctx   = vortex_ctx_new ();
+	if (! bench_init_ctx (listener_ctx) || ! bench_init_ctx (client_ctx)) {
+		printf ("ERROR: unable to init vortex contexts\n");
+		return -1;
+	} /* end if */
+
+	/* prepare listener */
+#if defined(ENABLE_TLS_SUPPORT)
+	if (! vortex_tls_accept_negotiation (listener_ctx, NULL, NULL, NULL)) {
+		printf ("Unable to start accepting TLS profile requests\n");
+		return -1;
+	} /* end if */
+#endif
+#if defined(ENABLE_XML_RPC_SUPPORT)
+	if (! vortex_xml_rpc_accept_negotiation (listener_ctx, NULL, NULL, bench_xml_rpc_dispatch, NULL)) {
+		printf ("Unable to start accepting XML-RPC profile requests\n");
+		return -1;
+	} /* end if */
+#endif
+	vortex_profiles_register (listener_ctx, BENCH_PROFILE,
+				  NULL, NULL,
+				  NULL, NULL,
+				  bench_frame_received, NULL);
+	if (! vortex_connection_is_ok (vortex_listener_new (listener_ctx, "127.0.0.1", bench_port, NULL, NULL), axl_false)) {
+		printf ("ERROR: unable to start listener at 127.0.0.1:%s\n", bench_port);
+		return -1;
+	} /* end if */
+
+	if (bench_output != NULL) {
+		fprintf (bench_output, "{\"bench\": \"info\", \"version\": \"%s\", \"quick\": %s}\n",
+			 VERSION, bench_quick ? "true" : "false");
+	} /* end if */
+
+	/* run scenarios */
+	if (bench_selected ("small") && ! bench_small ("plain", axl_false))
+		return -1;
+#if defined(ENABLE_TLS_SUPPORT)
+	if (bench_selected ("tls") && ! bench_small ("tls", axl_true))
+		return -1;
+#endif
+	if (bench_selected ("bulk") && ! bench_bulk ())
+		return -1;
+	if (bench_selected ("ans") && ! bench_ans ())
+		return -1;
+	if (bench_selected ("fan-in") && ! bench_fan_in ())
+		return -1;
+	if (bench_selected ("feeder") && ! bench_feeder ())
+		return -1;
+#if defined(ENABLE_XML_RPC_SUPPORT)
+	if (bench_selected ("xml-rpc") && ! bench_xml_rpc ())
+		return -1;
+#endif
+	if (bench_selected ("idle") && ! bench_idle ())
+		return -1;
+
+	if (bench_output != NULL)
+		fclose (bench_output);
+
+	vortex_exit_ctx (client_ctx, axl_true);
+	vortex_exit_ctx (listener_ctx, axl_true);
+
+	return 0;
+}
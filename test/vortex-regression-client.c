@@ -1535,6 +1535,363 @@ axl_bool test_00g (void) {
 	return axl_true;
 }
 
+axl_bool test_00h (void) {
+
+	VortexCtx * log_ctx;
+
+	/* create a context that is not shared with other tests */
+	log_ctx = vortex_ctx_new ();
+
+	/* log disabled: no level must pass */
+	vortex_log_enable (log_ctx, axl_false);
+	if (vortex_log_level_is_enabled (log_ctx, VORTEX_LEVEL_CRITICAL)) {
+		printf ("ERROR: expected critical level to be disabled with log disabled..\n");
+		return axl_false;
+	} /* end if */
+
+#if defined(ENABLE_VORTEX_LOG)
+	/* enable log and filter debug messages */
+	vortex_log_enable (log_ctx, axl_true);
+	vortex_log_filter_level (log_ctx, "debug");
+	if (vortex_log_level_is_enabled (log_ctx, VORTEX_LEVEL_DEBUG)) {
+		printf ("ERROR: expected debug level to be filtered..\n");
+		return axl_false;
+	} /* end if */
+
+	if (! vortex_log_level_is_enabled (log_ctx, VORTEX_LEVEL_WARNING) ||
+	    ! vortex_log_level_is_enabled (log_ctx, VORTEX_LEVEL_CRITICAL)) {
+		printf ("ERROR: expected warning and critical levels to be enabled..\n");
+		return axl_false;
+	} /* end if */
+
+	/* disable log again */
+	vortex_log_enable (log_ctx, axl_false);
+	if (vortex_log_level_is_enabled (log_ctx, VORTEX_LEVEL_WARNING)) {
+		printf ("ERROR: expected warning level to be disabled after disabling log..\n");
+		return axl_false;
+	} /* end if */
+#endif
+
+	printf ("Test 00-h: log level gating ok\n");
+	vortex_ctx_free (log_ctx);
+
+	return axl_true;
+}
+
+axl_bool test_00i (void) {
+
+#if defined(ENABLE_VORTEX_LOG)
+	VortexCtx * ctx;
+	FILE      * handle;
+	char        content[4096];
+	int         size;
+	int         iterator;
+
+	/* create a context that is not shared with other tests (named
+	 * ctx so vortex_log can be used) */
+	ctx = vortex_ctx_new ();
+	vortex_log_enable (ctx, axl_true);
+
+	/* remove previous results */
+	unlink ("test_00i.log");
+
+	/* enable async log using small rings */
+	if (! vortex_log_async_enable (ctx, "test_00i.log", 16)) {
+		printf ("ERROR: failed to enable async log..\n");
+		return axl_false;
+	} /* end if */
+
+	if (! vortex_log_async_is_enabled (ctx) || vortex_log_async_enable (ctx, NULL, 16)) {
+		printf ("ERROR: expected async log to be enabled only once..\n");
+		return axl_false;
+	} /* end if */
+
+	/* log more records than the ring can hold */
+	for (iterator = 0; iterator < 100; iterator++) 
+		vortex_log (VORTEX_LEVEL_WARNING, "test_00i record %d", iterator);
+
+	/* flush and stop writer */
+	vortex_log_async_disable (ctx);
+	vortex_log_enable (ctx, axl_false);
+
+	if (vortex_log_async_get_dropped (ctx) <= 0) {
+		printf ("ERROR: expected to find dropped records but found %ld..\n", vortex_log_async_get_dropped (ctx));
+		return axl_false;
+	} /* end if */
+
+	/* first record must be found on the file */
+	handle = fopen ("test_00i.log", "r");
+	if (handle == NULL) {
+		printf ("ERROR: expected to find test_00i.log file..\n");
+		return axl_false;
+	} /* end if */
+	size          = fread (content, 1, sizeof (content) - 1, handle);
+	content[size] = 0;
+	fclose (handle);
+	if (strstr (content, "test_00i record 0") == NULL) {
+		printf ("ERROR: expected to find first async log record in test_00i.log..\n");
+		return axl_false;
+	} /* end if */
+
+	printf ("Test 00-i: async log ok, dropped records: %ld\n", vortex_log_async_get_dropped (ctx));
+	vortex_ctx_free (ctx);
+#endif
+
+	return axl_true;
+}
+
+/* checks values measured by the library doing an echo over a real
+ * channel */
+axl_bool test_00j_channel (void) {
+
+	VortexConnection      * connection;
+	VortexChannel         * channel;
+	VortexAsyncQueue      * queue;
+	VortexFrame           * frame;
+	VortexMetricsSnapshot   snapshot;
+
+	vortex_metrics_enable (ctx, axl_true);
+	vortex_metrics_reset (ctx);
+
+	connection = connection_new ();
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR: failed to connect..\n");
+		return axl_false;
+	} /* end if */
+
+	queue   = vortex_async_queue_new ();
+	channel = vortex_channel_new (connection, 0,
+				      REGRESSION_URI,
+				      /* no close handling */
+				      NULL, NULL,
+				      /* frame receive async handling */
+				      vortex_channel_queue_reply, queue,
+				      /* no async channel creation */
+				      NULL, NULL);
+	if (channel == NULL) {
+		printf ("ERROR: unable to create the channel..\n");
+		return axl_false;
+	} /* end if */
+
+	if (! vortex_channel_send_msg (channel, "measure me", 10, NULL)) {
+		printf ("ERROR: failed to send message..\n");
+		return axl_false;
+	} /* end if */
+	frame = vortex_channel_get_reply (channel, queue);
+	if (frame == NULL) {
+		printf ("ERROR: expected to find reply..\n");
+		return axl_false;
+	} /* end if */
+	vortex_frame_unref (frame);
+
+	vortex_metrics_get (ctx, VORTEX_METRIC_ROUND_TRIP, REGRESSION_URI, &snapshot);
+	if (snapshot.count <= 0) {
+		printf ("ERROR: expected round trip values for %s..\n", REGRESSION_URI);
+		return axl_false;
+	} /* end if */
+	vortex_metrics_get (ctx, VORTEX_METRIC_HANDLER, REGRESSION_URI, &snapshot);
+	if (snapshot.count <= 0) {
+		printf ("ERROR: expected handler values for %s..\n", REGRESSION_URI);
+		return axl_false;
+	} /* end if */
+	vortex_metrics_get (ctx, VORTEX_METRIC_SEND, NULL, &snapshot);
+	if (snapshot.count <= 0 ||
+	    vortex_metrics_get_counter (ctx, VORTEX_COUNTER_FRAMES_SENT, NULL) <= 0 ||
+	    vortex_metrics_get_counter (ctx, VORTEX_COUNTER_FRAMES_RECEIVED, NULL) <= 0) {
+		printf ("ERROR: expected send values and frame counters..\n");
+		return axl_false;
+	} /* end if */
+
+	vortex_metrics_enable (ctx, axl_false);
+	vortex_channel_close (channel, NULL);
+	vortex_connection_close (connection);
+	vortex_async_queue_unref (queue);
+
+	return axl_true;
+}
+
+axl_bool test_00j (void) {
+
+	VortexCtx             * ctx;
+	VortexMetricsSnapshot   snapshot;
+	char                    buffer[16384];
+	int                     iterator;
+
+	/* create a context that is not shared with other tests */
+	ctx = vortex_ctx_new ();
+
+	/* values are not accounted until enabled */
+	vortex_metrics_record (ctx, VORTEX_METRIC_HANDLER, "urn:test:metrics", 100);
+	if (vortex_metrics_is_enabled (ctx) || vortex_metrics_get (ctx, VORTEX_METRIC_HANDLER, NULL, &snapshot)) {
+		printf ("ERROR: expected metrics to be disabled by default..\n");
+		return axl_false;
+	} /* end if */
+
+	if (! vortex_metrics_enable (ctx, axl_true)) {
+		printf ("ERROR: failed to enable metrics..\n");
+		return axl_false;
+	} /* end if */
+
+	/* record ten fast values and a slow one */
+	for (iterator = 0; iterator < 10; iterator++)
+		vortex_metrics_record (ctx, VORTEX_METRIC_HANDLER, "urn:test:metrics", 100);
+	vortex_metrics_record (ctx, VORTEX_METRIC_HANDLER, "urn:test:metrics", 10000);
+	vortex_metrics_record (ctx, VORTEX_METRIC_HANDLER, NULL, 50);
+
+	/* check profile series */
+	if (! vortex_metrics_get (ctx, VORTEX_METRIC_HANDLER, "urn:test:metrics", &snapshot)) {
+		printf ("ERROR: failed to get metric snapshot..\n");
+		return axl_false;
+	} /* end if */
+	if (snapshot.count != 11 || snapshot.sum != 11000 || snapshot.max != 10000) {
+		printf ("ERROR: expected count=11 sum=11000 max=10000 but found count=%ld sum=%ld max=%ld..\n",
+			snapshot.count, snapshot.sum, snapshot.max);
+		return axl_false;
+	} /* end if */
+	if (snapshot.p50 < 100 || snapshot.p50 > 125 || snapshot.p99 != 10000) {
+		printf ("ERROR: expected p50 around 100 and p99=10000 but found p50=%ld p99=%ld..\n",
+			snapshot.p50, snapshot.p99);
+		return axl_false;
+	} /* end if */
+
+	/* check all series together */
+	vortex_metrics_get (ctx, VORTEX_METRIC_HANDLER, NULL, &snapshot);
+	if (snapshot.count != 12) {
+		printf ("ERROR: expected 12 values for all profiles but found %ld..\n", snapshot.count);
+		return axl_false;
+	} /* end if */
+
+	/* check export */
+	if (vortex_metrics_export (ctx, buffer, 16) != -1) {
+		printf ("ERROR: expected export to fail with a small buffer..\n");
+		return axl_false;
+	} /* end if */
+	if (vortex_metrics_export (ctx, buffer, sizeof (buffer)) <= 0) {
+		printf ("ERROR: failed to export metrics..\n");
+		return axl_false;
+	} /* end if */
+	if (strstr (buffer, "# TYPE vortex_handler_seconds histogram") == NULL ||
+	    strstr (buffer, "vortex_handler_seconds_count{profile=\"urn:test:metrics\"} 11") == NULL ||
+	    strstr (buffer, "vortex_handler_seconds_bucket{profile=\"urn:test:metrics\",le=\"+Inf\"} 11") == NULL ||
+	    strstr (buffer, "vortex_handler_seconds_sum{profile=\"urn:test:metrics\"} 0.011000") == NULL) {
+		printf ("ERROR: unexpected metrics export content:\n%s\n", buffer);
+		return axl_false;
+	} /* end if */
+
+	/* check counters */
+	vortex_metrics_count (ctx, VORTEX_COUNTER_FRAMES_SENT, "urn:test:metrics", 3);
+	if (vortex_metrics_get_counter (ctx, VORTEX_COUNTER_FRAMES_SENT, "urn:test:metrics") != 3) {
+		printf ("ERROR: expected counter value 3 but found %ld..\n",
+			vortex_metrics_get_counter (ctx, VORTEX_COUNTER_FRAMES_SENT, "urn:test:metrics"));
+		return axl_false;
+	} /* end if */
+	vortex_metrics_export (ctx, buffer, sizeof (buffer));
+	if (strstr (buffer, "# TYPE vortex_frames_sent_total counter") == NULL ||
+	    strstr (buffer, "vortex_frames_sent_total{profile=\"urn:test:metrics\"} 3") == NULL) {
+		printf ("ERROR: unexpected counters export content:\n%s\n", buffer);
+		return axl_false;
+	} /* end if */
+
+	/* reset values */
+	vortex_metrics_reset (ctx);
+	vortex_metrics_get (ctx, VORTEX_METRIC_HANDLER, NULL, &snapshot);
+	if (snapshot.count != 0 || vortex_metrics_get_counter (ctx, VORTEX_COUNTER_FRAMES_SENT, NULL) != 0) {
+		printf ("ERROR: expected no values after reset but found %ld..\n", snapshot.count);
+		return axl_false;
+	} /* end if */
+
+	vortex_ctx_free (ctx);
+
+	/* now check values measured by the library */
+	return test_00j_channel ();
+}
+
+/* spans received by test_00k_trace, by stage */
+int         test_00k_spans[VORTEX_TRACE_SEND_WRITTEN + 1];
+VortexMutex test_00k_mutex;
+
+void test_00k_trace (VortexCtx * _ctx, VortexTraceSpan * span, axlPointer user_data)
+{
+	vortex_mutex_lock (&test_00k_mutex);
+	test_00k_spans[span->stage]++;
+	vortex_mutex_unlock (&test_00k_mutex);
+	return;
+}
+
+axl_bool test_00k (void) {
+
+	VortexConnection  * connection;
+	VortexChannel     * channel;
+	VortexAsyncQueue  * queue;
+	VortexFrame       * frame;
+	int                 stage;
+
+	if (! vortex_trace_is_available ()) {
+		/* trace points not compiled: installing a handler must fail */
+		if (vortex_trace_set_handler (ctx, test_00k_trace, NULL)) {
+			printf ("ERROR: expected trace handler installation to fail without tracing support..\n");
+			return axl_false;
+		} /* end if */
+		printf ("Test 00-k: tracing not compiled (--enable-vortex-trace), skipping\n");
+		return axl_true;
+	} /* end if */
+
+	/* creates a new connection against localhost:44000 */
+	connection = connection_new ();
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR: failed to connect..\n");
+		return axl_false;
+	} /* end if */
+
+	queue   = vortex_async_queue_new ();
+	channel = vortex_channel_new (connection, 0,
+				      REGRESSION_URI,
+				      /* no close handling */
+				      NULL, NULL,
+				      /* frame receive async handling */
+				      vortex_channel_queue_reply, queue,
+				      /* no async channel creation */
+				      NULL, NULL);
+	if (channel == NULL) {
+		printf ("ERROR: unable to create the channel..\n");
+		return axl_false;
+	} /* end if */
+
+	/* install handler and do an echo */
+	vortex_mutex_create (&test_00k_mutex);
+	memset (test_00k_spans, 0, sizeof (test_00k_spans));
+	vortex_trace_set_handler (ctx, test_00k_trace, NULL);
+
+	if (! vortex_channel_send_msg (channel, "trace me", 8, NULL)) {
+		printf ("ERROR: failed to send message..\n");
+		return axl_false;
+	} /* end if */
+	frame = vortex_channel_get_reply (channel, queue);
+	if (frame == NULL) {
+		printf ("ERROR: expected to find reply..\n");
+		return axl_false;
+	} /* end if */
+	vortex_frame_unref (frame);
+
+	/* stop tracing and check all spans were reported */
+	vortex_trace_set_handler (ctx, NULL, NULL);
+	for (stage = VORTEX_TRACE_FRAME_VALIDATED; stage <= VORTEX_TRACE_SEND_WRITTEN; stage++) {
+		if (stage == VORTEX_TRACE_SEND_QUEUED)
+			continue;
+		if (test_00k_spans[stage] <= 0) {
+			printf ("ERROR: expected to find spans for stage %d..\n", stage);
+			return axl_false;
+		} /* end if */
+	} /* end for */
+	vortex_mutex_destroy (&test_00k_mutex);
+
+	vortex_channel_close (channel, NULL);
+	vortex_connection_close (connection);
+	vortex_async_queue_unref (queue);
+
+	return axl_true;
+}
+
 axl_bool call_enable_server_log (axl_bool enable_server_log) {
 	VortexConnection  * conn;
 	VortexChannel     * channel;
@@ -2465,6 +2822,53 @@ axl_bool  test_01d_07 (void)
 	return axl_true;
 }
 
+axl_bool  test_01d_08 (void)
+{
+	const char  * mime_message = "Content-Type: text/plain\x0D\x0A\x0D\x0A" "lazy body";
+	VortexFrame * frame;
+
+	printf ("Test 01-d: checking MIME support (lazy header parsing)..\n");
+
+	/* create an artificial frame */
+	frame = vortex_frame_create (ctx, VORTEX_FRAME_TYPE_MSG,
+				     0, 0, axl_false, 0, strlen (mime_message), 0, mime_message);
+	if (frame == NULL) {
+		printf ("ERROR: expected to create a frame but NULL reference was found..\n");
+		return axl_false;
+	}
+
+	/* activate lazy mime support on the frame */
+	if (! vortex_frame_mime_process_lazy (frame)) {
+		printf ("ERROR: expected to find proper lazy MIME process, but a failure was found..\n");
+		return axl_false;
+	} /* end if */
+
+	/* check mime body is available before headers are parsed */
+	if (vortex_frame_get_payload_size (frame) != 9 || ! axl_memcmp (vortex_frame_get_payload (frame), "lazy body", 9)) {
+		printf ("ERROR: expected to find MIME BODY 'lazy body' (9) but found (%d)..\n",
+			vortex_frame_get_payload_size (frame));
+		return axl_false;
+	}
+
+	/* check mime header size */
+	if (vortex_frame_get_mime_header_size (frame) != 28) {
+		printf ("ERROR: expected to find MIME Headers %d but found %d..\n",
+			28, vortex_frame_get_mime_header_size (frame));
+		return axl_false;
+	}
+
+	/* now force header parsing */
+	if (! axl_cmp (vortex_frame_get_content_type (frame), "text/plain")) {
+		printf ("ERROR: expected to find MIME header \"Content-Type\" equal to: %s, but found %s\n",
+			"text/plain", vortex_frame_get_content_type (frame));
+		return axl_false;
+	}
+
+	vortex_frame_unref (frame);
+
+	return axl_true;
+}
+
 axl_bool  test_01d (void) {
 	VortexConnection  * connection;
 	VortexAsyncQueue  * queue;
@@ -2496,6 +2900,9 @@ axl_bool  test_01d (void) {
 	if (! test_01d_07 ())
 		return axl_false;
 
+	if (! test_01d_08 ())
+		return axl_false;
+
 	/* creates a new connection against localhost:44000 */
 	connection = connection_new ();
 	if (!vortex_connection_is_ok (connection, axl_false)) {
@@ -3219,6 +3626,78 @@ axl_bool test_01g1 (void) {
 	return axl_true;
 }
 
+axl_bool test_01g2 (void) {
+	VortexConnection * connection;
+	VortexChannel    * channel;
+	VortexFrame      * frame;
+	VortexAsyncQueue * queue;
+	int                code;
+	char             * msg;
+
+	/* connect starting REGRESSION_URI along with greetings */
+	printf ("Test 01-g2: connecting with pipelined channel start..\n");
+	connection = vortex_connection_new_full (ctx, listener_host, LISTENER_PORT, 
+						 CONN_OPTS (VORTEX_OPTS_PIPELINED_START, REGRESSION_URI, VORTEX_OPTS_END),
+						 NULL, NULL);
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR (1): expected to find proper connection status..but not found..\n");
+		return axl_false;
+	} /* end if */
+
+	/* get the channel started with greetings */
+	channel = vortex_connection_get_channel_by_uri (connection, REGRESSION_URI);
+	if (channel == NULL) {
+		printf ("ERROR (2): expected to find channel started in pipelined mode, but found NULL reference..\n");
+		return axl_false;
+	} /* end if */
+
+	/* check channel is usable */
+	queue = vortex_async_queue_new ();
+	vortex_channel_set_received_handler (channel, vortex_channel_queue_reply, queue);
+	if (! vortex_channel_send_msg (channel, "GET serverName", 14, NULL)) {
+		printf ("ERROR (3): failed to send message over pipelined channel..\n");
+		return axl_false;
+	} /* end if */
+
+	frame = vortex_channel_get_reply (channel, queue);
+	if (frame == NULL) {
+		printf ("ERROR (4): Failed to get the reply from the server..\n");
+		return axl_false;
+	} /* end if */
+	vortex_frame_unref (frame);
+	vortex_async_queue_unref (queue);
+
+	vortex_connection_close (connection);
+
+	/* now request a profile not supported by the listener */
+	printf ("Test 01-g2: connecting with pipelined channel start (not supported profile)..\n");
+	connection = vortex_connection_new_full (ctx, listener_host, LISTENER_PORT, 
+						 CONN_OPTS (VORTEX_OPTS_PIPELINED_START, "urn:vortex:regression:not-supported", VORTEX_OPTS_END),
+						 NULL, NULL);
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR (5): expected to find proper connection status after channel denied..but not found..\n");
+		return axl_false;
+	} /* end if */
+
+	/* channel must not be found */
+	if (vortex_connection_get_channel_by_uri (connection, "urn:vortex:regression:not-supported") != NULL) {
+		printf ("ERROR (6): expected to not find channel denied by remote peer..\n");
+		return axl_false;
+	} /* end if */
+
+	/* check error reported */
+	if (! vortex_connection_pop_channel_error (connection, &code, &msg)) {
+		printf ("ERROR (7): expected to find channel error reported after channel denied..\n");
+		return axl_false;
+	} /* end if */
+	printf ("Test 01-g2: channel denied as expected: code=%d, msg=%s\n", code, msg);
+	axl_free (msg);
+
+	vortex_connection_close (connection);
+
+	return axl_true;
+}
+
 axl_bool test_01h_check (const char * string) {
 
 	VORTEX_SOCKET _socket;
@@ -5873,6 +6352,13 @@ axl_bool  test_02d (void) {
 	return axl_true;
 }
 
+void test_02e_reply_handler (VortexReply * reply, VortexFrame * frame, axlPointer user_data)
+{
+	/* notify frame received */
+	vortex_async_queue_push ((VortexAsyncQueue *) user_data, frame);
+	return;
+}
+
 axl_bool  test_02e (void) {
 
 	VortexConnection * connection;
@@ -5883,6 +6369,9 @@ axl_bool  test_02e (void) {
 	char             * message;
 	int                msg_no;
 	VortexAsyncQueue * queue;
+	VortexReply      * replies[5];
+	VortexReply      * reply;
+	int                completed;
 
 	/* creates a new connection against localhost:44000 */
 	connection = connection_new ();
@@ -5957,6 +6446,52 @@ axl_bool  test_02e (void) {
 
 	} /* end while */
 
+	/* now send using reply futures and wait for all of them from
+	 * a single thread */
+	iterator = 0;
+	while (iterator < 5) {
+		message            = axl_strdup_printf ("Message: %d\n", iterator);
+		replies[iterator]  = vortex_channel_send_msg_future (channel, message, strlen (message), NULL);
+		axl_free (message);
+		if (replies[iterator] == NULL) {
+			printf ("Unable to send message with reply future over channel=%d\n", vortex_channel_get_number (channel));
+			return axl_false;
+		} /* end if */
+		iterator++;
+	} /* end while */
+
+	completed = 0;
+	while (completed < 5) {
+		reply = vortex_reply_wait_any (replies, 5, 0);
+		if (reply == NULL || ! vortex_reply_is_ready (reply)) {
+			printf ("Expected to find a reply completed but a timeout was found..\n");
+			return axl_false;
+		} /* end if */
+
+		/* check content */
+		message = axl_strdup_printf ("Message: %d\n", completed);
+		frame   = vortex_reply_get_frame (reply);
+		if (reply != replies[completed] || frame == NULL || ! axl_cmp (vortex_frame_get_payload (frame), message)) {
+			printf ("Expected to find reply %d but found different content..\n", completed);
+			return axl_false;
+		} /* end if */
+		axl_free (message);
+
+		vortex_reply_release (reply);
+		replies[completed] = NULL;
+		completed++;
+	} /* end while */
+
+	/* check continuation handler */
+	reply = vortex_channel_send_msg_future (channel, "continuation", 12, NULL);
+	vortex_reply_set_handler (reply, test_02e_reply_handler, queue);
+	frame = vortex_async_queue_timedpop (queue, 5000000);
+	if (frame == NULL || ! axl_cmp (vortex_frame_get_payload (frame), "continuation")) {
+		printf ("Expected to receive continuation handler notification..\n");
+		return axl_false;
+	} /* end if */
+	vortex_reply_release (reply);
+
 	vortex_async_queue_unref (queue);
 
 	/* ok, close the connection */
@@ -6065,6 +6600,10 @@ axl_bool  test_02f (void) {
 	long               mss;
 	char             * message;
 	VortexAsyncQueue * queue;
+	VortexMessageEntry batch[100];
+	char             * batch_content[100];
+	VortexFrame      * frame;
+	int                msg_no;
 
 	/* creates a new connection against localhost:44000 */
 	connection = connection_new ();
@@ -6105,6 +6644,29 @@ axl_bool  test_02f (void) {
 	if (! test_02f_send_data (channel, message, queue, 1, 270000))
 		return axl_false;
 
+	/* now check batched sends: all replies must be received in
+	 * order using consecutive message numbers */
+	printf ("Test 02-f: checking batched send..\n");
+	for (iterator = 0; iterator < 100; iterator++) {
+		batch_content[iterator]      = axl_strdup_printf ("batch message %d", iterator);
+		batch[iterator].message      = batch_content[iterator];
+		batch[iterator].message_size  = strlen (batch_content[iterator]);
+	} /* end for */
+	if (! vortex_channel_send_msg_batch (channel, batch, 100, &msg_no)) {
+		printf ("ERROR: failed to send batch of messages..\n");
+		return axl_false;
+	} /* end if */
+	for (iterator = 0; iterator < 100; iterator++) {
+		frame = vortex_channel_get_reply (channel, queue);
+		if (frame == NULL || vortex_frame_get_msgno (frame) != (msg_no + iterator) ||
+		    ! axl_cmp (vortex_frame_get_payload (frame), batch_content[iterator])) {
+			printf ("ERROR: expected to receive reply for batch message %d (msgno %d)..\n", iterator, msg_no + iterator);
+			return axl_false;
+		} /* end if */
+		vortex_frame_unref (frame);
+		axl_free (batch_content[iterator]);
+	} /* end for */
+
 	/* free queue and message */
 	vortex_async_queue_unref (queue);
 	axl_free (message);
@@ -8168,9 +8730,13 @@ axl_bool  test_02h (void) {
 axl_bool  test_03a (void) {
 	
 	VortexConnection   * connection;
+	VortexConnection   * connection2;
 	VortexChannelPool  * pool;
 	axlList            * channels;
 	VortexChannel      * channel;
+	int                  iterator;
+	long                 histogram[VORTEX_CHANNEL_POOL_WAIT_BUCKETS];
+	long                 total;
 	
 
 	/* creates a new connection against localhost:44000 */
@@ -8269,6 +8835,101 @@ axl_bool  test_03a (void) {
 	if (channel != NULL) 
 		return axl_false;
 
+	/* release all channels: the last one released must be the
+	 * next one returned */
+	printf ("Test 03-a: releasing channels..\n");
+	for (iterator = 0; iterator < axl_list_length (channels); iterator++)
+		vortex_channel_pool_release_channel (pool, axl_list_get_nth (channels, iterator));
+	if (vortex_channel_pool_get_available_num (pool) != 4) {
+		fprintf (stderr, "expected to find 4 channels available but found %d\n", vortex_channel_pool_get_available_num (pool));
+		return axl_false;
+	}
+	channel = vortex_channel_pool_get_next_ready (pool, axl_false);
+	if (channel != axl_list_get_nth (channels, 3)) {
+		fprintf (stderr, "expected to get the last channel released from the pool\n");
+		return axl_false;
+	}
+	vortex_channel_pool_release_channel (pool, channel);
+
+	/* check thread affinity */
+	vortex_channel_pool_set_thread_affinity (pool, axl_true);
+	channel = vortex_channel_pool_get_next_ready (pool, axl_false);
+	vortex_channel_pool_release_channel (pool, channel);
+	if (channel == NULL || channel != vortex_channel_pool_get_next_ready (pool, axl_false)) {
+		fprintf (stderr, "expected to get the channel last released by the same thread\n");
+		return axl_false;
+	}
+	vortex_channel_pool_release_channel (pool, channel);
+
+	/* check background growth to the minimum configured */
+	printf ("Test 03-a: checking pool background growth..\n");
+	vortex_channel_pool_set_policy (pool, 6, 7, 2, 0);
+	iterator = 0;
+	while (vortex_channel_pool_get_num (pool) < 6 && iterator < 10) {
+		sleep (1);
+		iterator++;
+	}
+	if (vortex_channel_pool_get_num (pool) != 6) {
+		fprintf (stderr, "expected to find 6 channels after pool growth but found %d\n", vortex_channel_pool_get_num (pool));
+		return axl_false;
+	}
+
+	/* check the maximum size is not exceeded (channels beyond
+	 * the minimum may be still being created in background) */
+	for (iterator = 0; iterator < 7; iterator++) {
+		total   = 0;
+		channel = vortex_channel_pool_get_next_ready (pool, axl_true);
+		while (channel == NULL && total < 10) {
+			sleep (1);
+			channel = vortex_channel_pool_get_next_ready (pool, axl_true);
+			total++;
+		}
+		if (channel == NULL) {
+			fprintf (stderr, "expected to get a channel from the pool (%d)\n", iterator);
+			return axl_false;
+		}
+	}
+	if (vortex_channel_pool_get_num (pool) > 7 || vortex_channel_pool_get_next_ready (pool, axl_true) != NULL) {
+		fprintf (stderr, "expected to find the pool limited to 7 channels but found %d\n", vortex_channel_pool_get_num (pool));
+		return axl_false;
+	}
+
+	/* check wait times were accounted */
+	if (vortex_channel_pool_get_wait_histogram (pool, histogram, VORTEX_CHANNEL_POOL_WAIT_BUCKETS) != VORTEX_CHANNEL_POOL_WAIT_BUCKETS) {
+		fprintf (stderr, "expected to get the pool wait histogram\n");
+		return axl_false;
+	}
+	total = 0;
+	for (iterator = 0; iterator < VORTEX_CHANNEL_POOL_WAIT_BUCKETS; iterator++)
+		total += histogram[iterator];
+	if (total < 15) {
+		fprintf (stderr, "expected to find at least 15 waits accounted but found %ld\n", total);
+		return axl_false;
+	}
+
+	/* extend the pool to a second connection: all channels on
+	 * the first one are in use, so the next channel must be
+	 * created on the second one */
+	printf ("Test 03-a: checking multi-connection pool..\n");
+	connection2 = connection_new ();
+	if (! vortex_channel_pool_add_connection (pool, connection2, 2) ||
+	    vortex_channel_pool_get_connection_num (pool) != 2) {
+		fprintf (stderr, "expected to add a second connection to the pool\n");
+		return axl_false;
+	}
+	channel = vortex_channel_pool_get_next_ready (pool, axl_false);
+	if (channel == NULL || vortex_channel_get_connection (channel) != connection2) {
+		fprintf (stderr, "expected to get a channel from the second connection\n");
+		return axl_false;
+	}
+	vortex_channel_pool_release_channel (pool, channel);
+	if (vortex_channel_pool_get_next_ready (pool, axl_false) != channel) {
+		fprintf (stderr, "expected to get again the channel released from the second connection\n");
+		return axl_false;
+	}
+	vortex_channel_pool_release_channel (pool, channel);
+	vortex_connection_close (connection2);
+
 	/* free the list */
 	axl_list_free (channels);
 
@@ -9356,28 +10017,236 @@ axl_bool test_05_a1 (void)
 		return axl_true;
 	}
 
-	/* enable autotls */
-	vortex_tls_set_auto_tls (ctx, axl_true, axl_true, NULL);
-
-	/* set a default post check that always fails */
-	vortex_tls_set_default_post_check (ctx, test_05_a1_post_check, NULL);
+	/* enable autotls */
+	vortex_tls_set_auto_tls (ctx, axl_true, axl_true, NULL);
+
+	/* set a default post check that always fails */
+	vortex_tls_set_default_post_check (ctx, test_05_a1_post_check, NULL);
+
+	/* connect to the remote side */
+	connection = vortex_connection_new (ctx, listener_host, LISTENER_PORT, NULL, NULL);
+
+	if (vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR: expected to find connection reference error, but found it working..\n");
+		return axl_false;
+	}
+
+	/* close the conenction */
+	vortex_connection_close (connection);
+
+	/* uninstall default post check function */
+	vortex_tls_set_default_post_check (ctx, NULL, NULL);
+
+	/* disable auto tls */
+	vortex_tls_set_auto_tls (ctx, axl_false, axl_true, NULL);
+
+	return axl_true;
+#else
+	printf ("--- WARNING: Current build does not have TLS support.\n");
+	return axl_true;
+#endif	
+}
+
+axl_bool test_05_a2 (void) 
+{
+#if defined(ENABLE_TLS_SUPPORT)
+	/* vortex connection */
+	VortexConnection * connection;
+	VortexStatus       status;
+	char             * status_message = NULL;
+	char             * peer_certificate;
+
+	/* initialize and check if current vortex library supports TLS */
+	if (! vortex_tls_init (ctx)) {
+		printf ("--- WARNING: Unable to activate TLS, current vortex library has not TLS support activated. \n");
+		return axl_true;
+	}
+
+	/* connect to the remote side */
+	connection = vortex_connection_new (ctx, listener_host, LISTENER_PORT, NULL, NULL);
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR: expected to find connection reference error, but found it working..\n");
+		return axl_false;
+	}
+
+	/* get connection negotiation */
+	connection    = vortex_tls_start_negotiation_sync (connection, NULL, 
+							   &status,
+							   &status_message);
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR: expected to find connection reference..\n");
+		return axl_false;
+	}
+
+	printf ("Test 05-a2: connection ok with TLS enabled, get peer certificate..\n");
+
+	peer_certificate = vortex_tls_get_peer_ssl_digest (connection, VORTEX_MD5);
+	printf ("  - %s\n", peer_certificate);
+	
+	printf ("Test 05-a2: running vortex-digest-tool test-certificate.pem:\n");
+	printf ("            91:59:49:7A:61:8A:DB:6F:F1:90:FB:0E:9B:4B:74:89\n");
+
+	if (! axl_cmp (peer_certificate, "91:59:49:7A:61:8A:DB:6F:F1:90:FB:0E:9B:4B:74:89")) {
+		printf ("Certificate does not matches with value expected: %s\n", peer_certificate);
+		return axl_false;
+	} /* end if */
+
+	axl_free (peer_certificate);
+		
+	/* close the conenction */
+	vortex_connection_close (connection);
+
+	return axl_true;
+#else
+	printf ("--- WARNING: Current build does not have TLS support.\n");
+	return axl_true;
+#endif	
+}
+
+axl_bool test_05_a3 (void) 
+{
+#if defined(ENABLE_TLS_SUPPORT)
+	/* vortex connection */
+	VortexConnection * connection;
+	VortexStatus       status;
+	char             * status_message = NULL;
+	int                iterator;
+	int                client_hits   = 0;
+	int                client_misses = 0;
+
+	/* initialize and check if current vortex library supports TLS */
+	if (! vortex_tls_init (ctx)) {
+		printf ("--- WARNING: Unable to activate TLS, current vortex library has not TLS support activated. \n");
+		return axl_true;
+	}
+
+	/* enable session resumption */
+	vortex_tls_set_session_resumption (ctx, axl_true, 0);
+
+	iterator = 0;
+	while (iterator < 3) {
+		/* connect to the remote side */
+		connection = vortex_connection_new (ctx, listener_host, LISTENER_PORT, NULL, NULL);
+		if (! vortex_connection_is_ok (connection, axl_false)) {
+			printf ("ERROR: expected to find proper connection..\n");
+			return axl_false;
+		}
+
+		/* get connection negotiation */
+		connection    = vortex_tls_start_negotiation_sync (connection, NULL, 
+								   &status,
+								   &status_message);
+		if (! vortex_connection_is_ok (connection, axl_false)) {
+			printf ("ERROR: expected to find connection with TLS enabled..\n");
+			return axl_false;
+		}
+
+		/* close the conenction */
+		vortex_connection_close (connection);
+
+		iterator++;
+	} /* end while */
+
+	/* check counters: first handshake is a full one, next ones
+	 * must be resumed */
+	vortex_tls_get_session_stats (ctx, &client_hits, &client_misses, NULL, NULL);
+	printf ("Test 05-a3: session resumption hits=%d, misses=%d\n", client_hits, client_misses);
+
+	/* disable session resumption */
+	vortex_tls_set_session_resumption (ctx, axl_false, 0);
+
+	if (client_misses < 1 || client_hits < 2) {
+		printf ("ERROR: expected to find 2 resumed sessions and at least 1 full handshake, but found hits=%d, misses=%d\n",
+			client_hits, client_misses);
+		return axl_false;
+	} /* end if */
+
+	return axl_true;
+#else
+	printf ("--- WARNING: Current build does not have TLS support.\n");
+	return axl_true;
+#endif	
+}
+
+axl_bool test_05_a4 (void) 
+{
+#if defined(ENABLE_TLS_SUPPORT)
+	/* vortex connection */
+	VortexConnection * connection;
+	VortexChannel    * channel;
+	VortexAsyncQueue * queue;
+	VortexFrame      * frame;
+	VortexStatus       status;
+	char             * status_message = NULL;
+	char               message[1024];
+	int                iterator;
+
+	/* initialize and check if current vortex library supports TLS */
+	if (! vortex_tls_init (ctx)) {
+		printf ("--- WARNING: Unable to activate TLS, current vortex library has not TLS support activated. \n");
+		return axl_true;
+	}
+
+	/* request kernel TLS offload (falls back to default transport
+	 * if not available) */
+	vortex_tls_set_kernel_offload (ctx, axl_true);
 
 	/* connect to the remote side */
 	connection = vortex_connection_new (ctx, listener_host, LISTENER_PORT, NULL, NULL);
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR: expected to find proper connection..\n");
+		return axl_false;
+	}
 
-	if (vortex_connection_is_ok (connection, axl_false)) {
-		printf ("ERROR: expected to find connection reference error, but found it working..\n");
+	/* get connection negotiation */
+	connection    = vortex_tls_start_negotiation_sync (connection, NULL, 
+							   &status,
+							   &status_message);
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		printf ("ERROR: expected to find connection with TLS enabled..\n");
+		return axl_false;
+	}
+	printf ("Test 05-a4: TLS connection ok, kernel offload in use: %s\n", 
+		vortex_tls_is_kernel_offloaded (connection) ? "yes" : "no");
+
+	/* create a channel and exchange some messages */
+	queue   = vortex_async_queue_new ();
+	channel = vortex_channel_new (connection, 0, REGRESSION_URI,
+				      NULL, NULL, 
+				      vortex_channel_queue_reply, queue,
+				      NULL, NULL);
+	if (channel == NULL) {
+		printf ("ERROR: unable to create channel over TLS connection..\n");
 		return axl_false;
 	}
 
+	memset (message, 'a', 1024);
+	iterator = 0;
+	while (iterator < 20) {
+		if (! vortex_channel_send_msg (channel, message, 1024, NULL)) {
+			printf ("ERROR: failed to send message over TLS connection..\n");
+			return axl_false;
+		} /* end if */
+		iterator++;
+	} /* end while */
+
+	iterator = 0;
+	while (iterator < 20) {
+		frame = vortex_channel_get_reply (channel, queue);
+		if (frame == NULL || vortex_frame_get_type (frame) != VORTEX_FRAME_TYPE_RPY) {
+			printf ("ERROR: expected to receive echo reply over TLS connection..\n");
+			return axl_false;
+		} /* end if */
+		vortex_frame_unref (frame);
+		iterator++;
+	} /* end while */
+	vortex_async_queue_unref (queue);
+
 	/* close the conenction */
 	vortex_connection_close (connection);
 
-	/* uninstall default post check function */
-	vortex_tls_set_default_post_check (ctx, NULL, NULL);
-
-	/* disable auto tls */
-	vortex_tls_set_auto_tls (ctx, axl_false, axl_true, NULL);
+	/* restore default transport */
+	vortex_tls_set_kernel_offload (ctx, axl_false);
 
 	return axl_true;
 #else
@@ -9386,14 +10255,17 @@ axl_bool test_05_a1 (void)
 #endif	
 }
 
-axl_bool test_05_a2 (void) 
+axl_bool test_05_a5 (void) 
 {
 #if defined(ENABLE_TLS_SUPPORT)
 	/* vortex connection */
 	VortexConnection * connection;
+	VortexChannel    * channel;
+	VortexAsyncQueue * queue;
+	VortexFrame      * frame;
 	VortexStatus       status;
 	char             * status_message = NULL;
-	char             * peer_certificate;
+	int                iterator;
 
 	/* initialize and check if current vortex library supports TLS */
 	if (! vortex_tls_init (ctx)) {
@@ -9401,10 +10273,15 @@ axl_bool test_05_a2 (void)
 		return axl_true;
 	}
 
+	/* enable read ahead and write coalescing: several frames will
+	 * be sent inside the same TLS record */
+	vortex_tls_set_read_ahead (ctx, axl_true);
+	vortex_tls_set_write_coalescing (ctx, 16384);
+
 	/* connect to the remote side */
 	connection = vortex_connection_new (ctx, listener_host, LISTENER_PORT, NULL, NULL);
 	if (! vortex_connection_is_ok (connection, axl_false)) {
-		printf ("ERROR: expected to find connection reference error, but found it working..\n");
+		printf ("ERROR: expected to find proper connection..\n");
 		return axl_false;
 	}
 
@@ -9413,28 +10290,55 @@ axl_bool test_05_a2 (void)
 							   &status,
 							   &status_message);
 	if (! vortex_connection_is_ok (connection, axl_false)) {
-		printf ("ERROR: expected to find connection reference..\n");
+		printf ("ERROR: expected to find connection with TLS enabled..\n");
 		return axl_false;
 	}
 
-	printf ("Test 05-a2: connection ok with TLS enabled, get peer certificate..\n");
-
-	peer_certificate = vortex_tls_get_peer_ssl_digest (connection, VORTEX_MD5);
-	printf ("  - %s\n", peer_certificate);
-	
-	printf ("Test 05-a2: running vortex-digest-tool test-certificate.pem:\n");
-	printf ("            91:59:49:7A:61:8A:DB:6F:F1:90:FB:0E:9B:4B:74:89\n");
+	if (vortex_connection_get_write_coalescing (connection) != 16384) {
+		printf ("ERROR: expected to find write coalescing enabled (16384) but found %d..\n",
+			vortex_connection_get_write_coalescing (connection));
+		return axl_false;
+	}
 
-	if (! axl_cmp (peer_certificate, "91:59:49:7A:61:8A:DB:6F:F1:90:FB:0E:9B:4B:74:89")) {
-		printf ("Certificate does not matches with value expected: %s\n", peer_certificate);
+	/* create a channel and exchange small messages */
+	queue   = vortex_async_queue_new ();
+	channel = vortex_channel_new (connection, 0, REGRESSION_URI,
+				      NULL, NULL, 
+				      vortex_channel_queue_reply, queue,
+				      NULL, NULL);
+	if (channel == NULL) {
+		printf ("ERROR: unable to create channel over TLS connection..\n");
 		return axl_false;
-	} /* end if */
+	}
+
+	iterator = 0;
+	while (iterator < 100) {
+		if (! vortex_channel_send_msg (channel, "this is a small test message", 28, NULL)) {
+			printf ("ERROR: failed to send message over TLS connection..\n");
+			return axl_false;
+		} /* end if */
+		iterator++;
+	} /* end while */
+
+	iterator = 0;
+	while (iterator < 100) {
+		frame = vortex_channel_get_reply (channel, queue);
+		if (frame == NULL || vortex_frame_get_type (frame) != VORTEX_FRAME_TYPE_RPY) {
+			printf ("ERROR: expected to receive echo reply %d over TLS connection..\n", iterator);
+			return axl_false;
+		} /* end if */
+		vortex_frame_unref (frame);
+		iterator++;
+	} /* end while */
+	vortex_async_queue_unref (queue);
 
-	axl_free (peer_certificate);
-		
 	/* close the conenction */
 	vortex_connection_close (connection);
 
+	/* restore default transport */
+	vortex_tls_set_read_ahead (ctx, axl_false);
+	vortex_tls_set_write_coalescing (ctx, 0);
+
 	return axl_true;
 #else
 	printf ("--- WARNING: Current build does not have TLS support.\n");
@@ -10631,14 +11535,29 @@ axl_bool test_04_e_save (VortexFrame * frame, const char * file, axl_bool append
 	return axl_true;
 }
 
+void test_04_e_sink_finished (VortexChannel     * channel,
+			      VortexPayloadSink * sink,
+			      int                 msg_no,
+			      long                total_size,
+			      axl_bool            status,
+			      axlPointer          user_data)
+{
+	/* push total size received (or -1 if it failed) */
+	vortex_async_queue_push (user_data, INT_TO_PTR (status ? total_size : -1));
+	return;
+}
+
 axl_bool test_04_e (void)
 {
 	VortexConnection    * connection;
 	VortexChannel       * channel;
 	VortexAsyncQueue    * queue;
 	VortexPayloadFeeder * feeder;
+	VortexPayloadSink   * sink;
 	VortexFrame         * frame;
 	axl_bool              reply_by_feeder = axl_false;
+	axl_bool              buffered_sent   = axl_false;
+	int                   sink_size;
 
 	/* get start, stop and result */
  	struct timeval      start;
@@ -10744,6 +11663,24 @@ get_reply_and_check:
 		return axl_false;
 	} /* end if */
 
+	/* send again with zero copy disabled to check buffered
+	 * path produces the same content */
+	if (! buffered_sent && ! reply_by_feeder) {
+		buffered_sent = axl_true;
+		printf ("Test 04-e: sending content with zero copy disabled..\n");
+		feeder = vortex_payload_feeder_file ("vortex-regression-client.c", axl_true);
+		if (feeder == NULL) {
+			printf ("ERROR (7.2): expected to find proper feeder reference but found NULL..\n");
+			return axl_false;
+		} /* end if */
+		vortex_payload_feeder_set_zero_copy (feeder, axl_false);
+		if (! vortex_channel_send_msg_from_feeder (channel, feeder)) {
+			printf ("ERROR (7.3): expected to find proper send using feeder..\n");
+			return axl_false;
+		}
+		goto get_reply_and_check;
+	} /* end if */
+
 	/* now get the reply */
 	if (! reply_by_feeder) {
 		/* ok, now get the file by a reply feeded by the payload feeder */
@@ -10757,6 +11694,42 @@ get_reply_and_check:
 		goto get_reply_and_check;
 	} /* end if */
 
+	/* now get the file again, streaming it into a payload sink
+	 * (preallocating more than required to check it is removed) */
+	printf ("Test 04-e: getting content into a payload sink..\n");
+	sink = vortex_payload_sink_file ("test_04_e.sink", PAYLOAD_SINK_HINT_PREALLOCATE | PAYLOAD_SINK_HINT_DIRECT, 4 * 1024 * 1024);
+	if (sink == NULL) {
+		printf ("ERROR (10): expected to find proper sink reference but found NULL..\n");
+		return axl_false;
+	} /* end if */
+	vortex_payload_sink_set_on_finished (sink, test_04_e_sink_finished, queue);
+	if (! vortex_channel_set_payload_sink (channel, sink)) {
+		printf ("ERROR (11): expected to install payload sink on the channel..\n");
+		return axl_false;
+	} /* end if */
+	if (! vortex_channel_send_msg (channel, "get-file-by-feeder-rpy", 22, NULL)) {
+		printf ("ERROR (12): unable to send request to get the file using feeder..\n");
+		return axl_false;
+	} /* end if */
+
+	/* wait for the completion notification (pushed on the same
+	 * queue, the reply must not be delivered) */
+	sink_size = PTR_TO_INT (vortex_async_queue_timedpop (queue, 10000000));
+	if (sink_size <= 0) {
+		printf ("ERROR (13): expected to find sink finished notification with total size, but found: %d..\n", sink_size);
+		return axl_false;
+	} /* end if */
+	if (vortex_channel_get_payload_sink (channel) != NULL || vortex_async_queue_items (queue) != 0) {
+		printf ("ERROR (14): expected to find sink removed and no reply delivered..\n");
+		return axl_false;
+	} /* end if */
+	printf ("Test 04-e: %d bytes received into payload sink..\n", sink_size);
+
+	if (! file_cmp ("vortex-regression-client.c", "test_04_e.sink")) {
+		printf ("ERROR (15): found files differs..\n");
+		return axl_false;
+	} /* end if */
+
 	/* close connection */
 	vortex_connection_close (connection);
 
@@ -11362,6 +12335,18 @@ axl_bool test_06a (void) {
 	return axl_true;
 }
 
+#if defined(ENABLE_XML_RPC_SUPPORT)
+/* queue where pipelined xml-rpc replies are received */
+VortexAsyncQueue * test_07_pipeline_queue = NULL;
+
+void test_07_pipeline_reply (int result, XmlRpcResponseStatus status, int fault_code, char * fault_string)
+{
+	/* queue the result received (or -1 if the invocation failed) */
+	vortex_async_queue_push (test_07_pipeline_queue, INT_TO_PTR ((status == XML_RPC_OK) ? result : -1));
+	return;
+}
+#endif
+
 /** 
  * @brief Test XML-RPC support.
  * 
@@ -11390,6 +12375,9 @@ axl_bool  test_07 (void) {
 	/* test 07 */
 	Node             * node;
 	Node             * node_result;
+	/* test 09 */
+	int                iresult;
+	int                bitmask;
 
 	/* init xml-rpc module */
 	if (! vortex_xml_rpc_init (ctx)) {
@@ -11572,6 +12560,90 @@ axl_bool  test_07 (void) {
 	test_node_free (node_result);
 	printf ("Test 07: xml-rpc test 07..ok\n");
 
+	/*** TEST 08 ***/
+	/* binary encoding is disabled by default */
+	if (vortex_xml_rpc_channel_is_binary (channel)) {
+		fprintf (stderr, "Expected to find XML encoding on the XML-RPC channel (binary encoding not enabled)\n");
+		return axl_false;
+	}
+
+	/* enable it (listener enables it too) and check it is used on
+	 * the new channel */
+	vortex_xml_rpc_set_binary_encoding (ctx, axl_true);
+	channel = BOOT_CHANNEL (connection, NULL);
+	if (channel == NULL || ! vortex_xml_rpc_channel_is_binary (channel)) {
+		fprintf (stderr, "Expected to find binary encoding enabled on the XML-RPC channel\n");
+		return axl_false;
+	}
+	if (15.5 != test_get_double_sum_double_double_s (7.2, 8.3, channel, NULL, NULL, NULL) ||
+	    7 != test_sum_int_int_s (3, 4, channel, NULL, NULL, NULL) ||
+	    test_get_the_bool_1_s (channel, NULL, NULL, NULL) != axl_false ||
+	    test_get_the_bool_2_s (channel, NULL, NULL, NULL) != axl_true) {
+		fprintf (stderr, "ERROR: An error was found while invoking with binary encoding..\n");
+		return axl_false;
+	}
+	array = test_get_array_s (channel, NULL, NULL, NULL);
+	if (array == NULL || test_itemarray_get (array, 9) == NULL || test_itemarray_get (array, 9)->position != 9) {
+		fprintf (stderr, "ERROR: Expected to receive an array with binary encoding..\n");
+		return axl_false;
+	}
+	test_itemarray_free (array);
+
+	/* disable it and check XML is used on the new channel */
+	vortex_xml_rpc_set_binary_encoding (ctx, axl_false);
+	channel = BOOT_CHANNEL (connection, NULL);
+	if (channel == NULL || vortex_xml_rpc_channel_is_binary (channel)) {
+		fprintf (stderr, "Expected to find XML encoding on the XML-RPC channel after disabling binary encoding\n");
+		return axl_false;
+	}
+	if (15.5 != test_get_double_sum_double_double_s (7.2, 8.3, channel, NULL, NULL, NULL) ||
+	    7 != test_sum_int_int_s (3, 4, channel, NULL, NULL, NULL)) {
+		fprintf (stderr, "ERROR: An error was found while invoking with XML encoding..\n");
+		return axl_false;
+	}
+	printf ("Test 07: xml-rpc test 08..ok\n");
+
+	/*** TEST 09 ***/
+	/* several invocations in flight on the same channel */
+	vortex_xml_rpc_set_pipeline_depth (ctx, 4);
+	test_07_pipeline_queue = vortex_async_queue_new ();
+	for (iterator = 0; iterator < 4; iterator++)
+		test_sum_int_int (iterator, 10, channel, test_07_pipeline_reply);
+
+	/* each reply must be notified to its invocation (they are sent
+	 * from different threads so the order is not known) */
+	bitmask = 0;
+	for (iterator = 0; iterator < 4; iterator++) {
+		iresult = PTR_TO_INT (vortex_async_queue_timedpop (test_07_pipeline_queue, 10000000));
+		if (iresult < 10 || iresult > 13 || (bitmask & (1 << (iresult - 10)))) {
+			fprintf (stderr, "Received unexpected pipelined reply %d\n", iresult);
+			return axl_false;
+		}
+		bitmask |= (1 << (iresult - 10));
+	}
+	if (vortex_xml_rpc_channel_in_flight (channel) != 0) {
+		fprintf (stderr, "Expected to find no invocation in flight but found %d\n", 
+			 vortex_xml_rpc_channel_in_flight (channel));
+		return axl_false;
+	}
+	vortex_async_queue_unref (test_07_pipeline_queue);
+	vortex_xml_rpc_set_pipeline_depth (ctx, 1);
+	printf ("Test 07: xml-rpc test 09..ok\n");
+
+	/*** TEST 10 ***/
+	/* send method calls split into 5 bytes frames so elements and
+	 * text nodes are received across several frames by the
+	 * decoder (channel is using XML encoding) */
+	vortex_channel_set_next_frame_size_handler (channel, test_02g_frame_size, INT_TO_PTR (5));
+	for (iterator = 0; iterator < 10; iterator++) {
+		if (-530865 != test_sum_int_int_s (123456, -654321, channel, NULL, NULL, NULL)) {
+			fprintf (stderr, "ERROR: An error was found while invoking with method call split across frames..\n");
+			return axl_false;
+		}
+	}
+	vortex_channel_set_next_frame_size_handler (channel, NULL, NULL);
+	printf ("Test 07: xml-rpc test 10..ok\n");
+
 	/* close the connection */
 	vortex_connection_close (connection);
 
@@ -12383,6 +13455,115 @@ void __block_test (int value)
 }
 #endif
 
+/** 
+ * @brief Checks that a tunnel keeps forwarding content in order when
+ * the final peer stops reading for a while (the proxy finds its
+ * partner not accepting more content and must resume later).
+ * 
+ * @return axl_true if all test pass, otherwise axl_false is returned.
+ */
+axl_bool  test_13a (void)
+{
+	VortexConnection * connection;
+	VortexChannel    * channel;
+	VortexAsyncQueue * queue;
+	VortexFrame      * frame;
+	FILE             * file;
+	int                value;
+	int                iterator = 0;
+
+	/* creates a new connection (through the tunnel) */
+	connection = connection_new ();
+	if (! vortex_connection_is_ok (connection, axl_false)) {
+		vortex_connection_close (connection);
+		return axl_false;
+	}
+
+	/* reduce receive buffer so the proxy gets its writes
+	 * blocked */
+	value = 4096;
+	setsockopt (vortex_connection_get_socket (connection), SOL_SOCKET, SO_RCVBUF, (char *) &value, sizeof (value));
+
+	/* create the queue */
+	queue   = vortex_async_queue_new ();
+	channel = vortex_channel_new (connection, 0,
+				      REGRESSION_URI_5,
+				      /* no close handling */
+				      NULL, NULL,
+				      /* frame receive async handling */
+				      vortex_channel_queue_reply, queue,
+				      /* no async channel creation */
+				      NULL, NULL);
+	if (channel == NULL) {
+		printf ("Test 13-a: ERROR, unable to create the channel..\n");
+		return axl_false;
+	}
+
+	/* allow remote side to send the whole file without waiting
+	 * for SEQ frames */
+	vortex_channel_set_serialize (channel, axl_true);
+	vortex_channel_set_window_size (channel, 1048576);
+
+	while (iterator < 3) {
+		/* stop reading from the connection and request the
+		 * file */
+		vortex_connection_block (connection, axl_true);
+		if (! vortex_channel_send_msg (channel, "vortex-regression-client.c", 26, NULL)) {
+			printf ("Test 13-a: ERROR, failed to send file request..\n");
+			return axl_false;
+		} /* end if */
+
+		/* wait a bit so the proxy fills its partner */
+		vortex_async_queue_timedpop (queue, 1000000);
+		vortex_connection_block (connection, axl_false);
+
+		file = fopen ("vortex-regression-client-test-13-a.txt", "wb");
+		if (file == NULL) {
+			printf ("Test 13-a: ERROR, unable to create the file to hold content: %s\n", strerror (errno));
+			return axl_false;
+		}
+
+		while (axl_true) {
+			frame = vortex_async_queue_timedpop (queue, 10000000);
+			if (frame == NULL) {
+				printf ("Test 13-a: ERROR, timeout while waiting for replies (iterator=%d)..\n", iterator);
+				fclose (file);
+				return axl_false;
+			} /* end if */
+
+			/* last reply */
+			if (vortex_frame_get_type (frame) == VORTEX_FRAME_TYPE_NUL) {
+				vortex_frame_unref (frame);
+				break;
+			} /* end if */
+
+			fwrite (vortex_frame_get_payload (frame), 1, vortex_frame_get_payload_size (frame), file);
+			vortex_frame_unref (frame);
+		} /* end while */
+		fclose (file);
+
+		/* check content received */
+		if (! file_cmp ("vortex-regression-client.c", "vortex-regression-client-test-13-a.txt")) {
+			printf ("Test 13-a: ERROR, content transfered is not the expected, both files differs (iterator=%d)\n", iterator);
+			return axl_false;
+		} /* end if */
+
+		/* next iterator */
+		iterator++;
+	} /* end while */
+
+	/* free the queue */
+	vortex_async_queue_unref (queue);
+
+	if (! vortex_channel_close (channel, NULL)) {
+		printf ("Test 13-a: ERROR, failed to close channel..\n");
+		return axl_false;
+	}
+
+	vortex_connection_close (connection);
+	return axl_true;
+}
+
 /** 
  * @brief Allows to check tunnel implementation.
  * 
@@ -12482,6 +13663,14 @@ axl_bool  test_13 (void)
 		return axl_false;
 	}
 
+	printf ("Test 13::");
+	if (test_13a ()) {
+		printf ("Test 13-a: tunnel forwarding while final peer stops reading [   OK   ]\n");
+	} else {
+		printf ("Test 13-a: tunnel forwarding while final peer stops reading [ FAILED ]\n");
+		return axl_false;
+	}
+
 	/* free tunnel settings */
 	vortex_tunnel_settings_free (tunnel_settings);
 	tunnel_settings = NULL;
@@ -15363,8 +16552,8 @@ int main (int  argc, char ** argv)
 	printf ("**\n");
 	printf ("**       Providing --run-test=NAME will run only the provided regression test.\n");
 	printf ("**       Test available: test_00, test_001, test_00a, test_00b, test_00c, test_00c1, test_00c2,\n");
-	printf ("**                       test_00d, test_00e, test_00f, test_00g, test_01d, test_01, test_01a, test_01b, test_01c, test_01d, test_01e,\n");
-	printf ("**                       test_01f, test_01g, test_01g1, test_01h, test_01i, test_01j, test_01k, test_01l, test_01o,\n");
+	printf ("**                       test_00d, test_00e, test_00f, test_00g, test_00h, test_00i, test_00j, test_00k, test_01d, test_01, test_01a, test_01b, test_01c, test_01d, test_01e,\n");
+	printf ("**                       test_01f, test_01g, test_01g1, test_01g2, test_01h, test_01i, test_01j, test_01k, test_01l, test_01o,\n");
 	printf ("**                       test_01p, test_01q, test_01r, test_01s, test_01s1, test_01t, test_01u, test_01w, test_01y, test_01x\n");
 	printf ("**                       test_02, test_02a, test_02a1, test_02a2, test_02a3, test_02a4, test_02b, test_02c, test_02d, test_02e, \n"); 
 	printf ("**                       test_02f, test_02g, test_02h, test_02i, test_02j, test_02k,\n");
@@ -15582,6 +16771,18 @@ int main (int  argc, char ** argv)
 		if (check_and_run_test (run_test_name, "test_00g"))
 			run_test (test_00g, "Test 00-g", "Check digest API", -1, -1); 
 
+		if (check_and_run_test (run_test_name, "test_00h"))
+			run_test (test_00h, "Test 00-h", "Check log level gating", -1, -1); 
+
+		if (check_and_run_test (run_test_name, "test_00i"))
+			run_test (test_00i, "Test 00-i", "Check async log", -1, -1); 
+
+		if (check_and_run_test (run_test_name, "test_00j"))
+			run_test (test_00j, "Test 00-j", "Check metrics registry", -1, -1); 
+
+		if (check_and_run_test (run_test_name, "test_00k"))
+			run_test (test_00k, "Test 00-k", "Check trace hooks", -1, -1); 
+
 		if (check_and_run_test (run_test_name, "test_01"))
 			run_test (test_01, "Test 01", "basic BEEP support", -1, -1);
 
@@ -15612,6 +16813,9 @@ int main (int  argc, char ** argv)
 		if (check_and_run_test (run_test_name, "test_01g1"))
 			run_test (test_01g1, "Test 01-g1", "Try to flood server (DOS) with infinite greetings", -1, -1);
 
+		if (check_and_run_test (run_test_name, "test_01g2"))
+			run_test (test_01g2, "Test 01-g2", "Check pipelined channel start with greetings", -1, -1);
+
 		if (check_and_run_test (run_test_name, "test_01h"))
 			run_test (test_01h, "Test 01-h", "BEEP wrong header attack..", -1, -1);
 
@@ -15798,6 +17002,15 @@ int main (int  argc, char ** argv)
 		if (check_and_run_test (run_test_name, "test_05a2"))
 			run_test (test_05_a2, "Test 05-a2", "Check vortex-digest-tool and vortex_tls_get_peer_ssl_digest ()", -1, -1);
 
+		if (check_and_run_test (run_test_name, "test_05a3"))
+			run_test (test_05_a3, "Test 05-a3", "Check TLS session resumption", -1, -1);
+
+		if (check_and_run_test (run_test_name, "test_05a4"))
+			run_test (test_05_a4, "Test 05-a4", "Check TLS kernel offload (with fallback)", -1, -1);
+
+		if (check_and_run_test (run_test_name, "test_05a5"))
+			run_test (test_05_a5, "Test 05-a5", "Check TLS read ahead and write coalescing", -1, -1);
+
 		if (check_and_run_test (run_test_name, "test_05b"))
 			run_test (test_05_b, "Test 05-b", "TLS client blocked during connection close (14/12/2009)", -1, -1);
 
@@ -15940,6 +17153,14 @@ int main (int  argc, char ** argv)
 
 	run_test (test_00g, "Test 00-g", "Check digest API", -1, -1); 
 
+	run_test (test_00h, "Test 00-h", "Check log level gating", -1, -1); 
+
+	run_test (test_00i, "Test 00-i", "Check async log", -1, -1); 
+
+	run_test (test_00j, "Test 00-j", "Check metrics registry", -1, -1); 
+
+	run_test (test_00k, "Test 00-k", "Check trace hooks", -1, -1); 
+
  	run_test (test_01, "Test 01", "basic BEEP support", -1, -1);
   
  	run_test (test_01a, "Test 01-a", "transfer zeroed binary frames", -1, -1);
@@ -15960,6 +17181,8 @@ int main (int  argc, char ** argv)
 
  	run_test (test_01g1, "Test 01-g1", "Try to flood server (DOS) with infinite greetings", -1, -1);
 
+ 	run_test (test_01g2, "Test 01-g2", "Check pipelined channel start with greetings", -1, -1);
+
 	run_test (test_01h, "Test 01-h", "BEEP wrong header attack..", -1, -1);
 
 	run_test (test_01i, "Test 01-i", "BEEP connect to (usually) unreachable address..", -1, -1);
@@ -16084,6 +17307,12 @@ int main (int  argc, char ** argv)
 
 	run_test (test_05_a2, "Test 05-a2", "Check vortex-digest-tool and vortex_tls_get_peer_ssl_digest ()", -1, -1);
 
+	run_test (test_05_a3, "Test 05-a3", "Check TLS session resumption", -1, -1);
+
+	run_test (test_05_a4, "Test 05-a4", "Check TLS kernel offload (with fallback)", -1, -1);
+
+	run_test (test_05_a5, "Test 05-a5", "Check TLS read ahead and write coalescing", -1, -1);
+
 	run_test (test_05_b, "Test 05-b", "TLS client blocked during connection close (14/12/2009)", -1, -1);
 
 	run_test (test_05_c, "Test 05-c", "TLS client serverName after success (09/08/2010)", -1, -1);
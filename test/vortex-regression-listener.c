@@ -1803,6 +1803,9 @@ int main (int  argc, char ** argv)
 		printf ("Unable to start accepting TLS profile requests");
 		return -1;
 	}
+
+	/* enable session cache and tickets (checked by test_05_a3) */
+	vortex_tls_set_session_resumption (ctx, axl_true, 0);
 #else
 	printf ("--- WARNING: Current build does not have TLS support.\n");
 #endif
@@ -1877,6 +1880,9 @@ int main (int  argc, char ** argv)
                 service_dispatch,
                 /* no user space data for the dispatch function. */
                 NULL);
+
+	/* accept binary encoding if offered */
+	vortex_xml_rpc_set_binary_encoding (ctx, axl_true);
 #endif
 
 	/* configure close in transit profile */
@@ -0,0 +1,582 @@
+/*  LibVortex:  A BEEP implementation
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* include base library */
+#include <vortex.h>
+
+/*
+ * Connection scale stress tool: opens a large number of loopback
+ * BEEP sessions from several client contexts (one connector thread
+ * each) against one listener context, and measures:
+ *
+ *  - connect and accept rate.
+ *  - memory per session (RSS growth / sessions, both peers live in
+ *    this process so the value covers a client plus a listener
+ *    connection, each one with its channel 0).
+ *  - memory per additional channel.
+ *  - reader loop cost while sessions are idle or lightly active
+ *    (wakeups/sec and time per wakeup, see VORTEX_METRIC_READER_LOOP),
+ *    process CPU usage and round trip times of the active ones.
+ *  - time required by the listener to detect that all sessions were
+ *    closed by the remote peer.
+ *
+ * Sessions are spread over several listeners (127.0.0.1,
+ * 127.0.0.2, ...) so the number of sessions is not bounded by the
+ * ephemeral port range of a single address pair.
+ *
+ * Usage: vortex-stress-connections [--connections N] [--contexts N]
+ *           [--addresses N] [--port port] [--active-every N]
+ *           [--idle-seconds N] [--output file]
+ */
+
+#define STRESS_PROFILE "http://fact.aspl.es/profiles/stress"
+
+/* time to wait for the listener to detect all closures (microseconds) */
+#define STRESS_CLOSE_TIMEOUT 120000000
+
+/* stress configuration */
+const char        * stress_port         = "44040";
+int                 stress_connections  = 100000;
+int                 stress_contexts     = 4;
+int                 stress_addresses    = 8;
+int                 stress_active_every = 1000;
+int                 stress_idle_seconds = 10;
+FILE              * stress_output       = NULL;
+
+/* listener context and client contexts */
+VortexCtx         * listener_ctx        = NULL;
+VortexCtx        ** client_ctxs         = NULL;
+
+/* client connections */
+VortexConnection ** conns               = NULL;
+
+/* listener side accounting */
+VortexMutex         stress_mutex;
+VortexAsyncQueue  * stress_closed_queue = NULL;
+int                 stress_accepted     = 0;
+int                 stress_closed       = 0;
+int                 stress_close_target = 0;
+struct timeval      stress_first_accept;
+struct timeval      stress_last_accept;
+struct timeval      stress_last_close;
+
+/* connector thread state */
+typedef struct _StressConnector {
+	VortexCtx        * ctx;
+	int                index;
+	VortexAsyncQueue * done;
+	VortexThread       thread;
+} StressConnector;
+
+void stress_frame_received (VortexChannel    * channel,
+			    VortexConnection * connection,
+			    VortexFrame      * frame,
+			    axlPointer         user_data)
+{
+	/* echo content received */
+	vortex_channel_send_rpy (channel,
+				 vortex_frame_get_payload (frame),
+				 vortex_frame_get_payload_size (frame),
+				 vortex_frame_get_msgno (frame));
+	return;
+}
+
+void stress_on_close (VortexConnection * connection, axlPointer user_data)
+{
+	vortex_mutex_lock (&stress_mutex);
+	stress_closed++;
+	gettimeofday (&stress_last_close, NULL);
+	if (stress_close_target > 0 && stress_closed == stress_close_target)
+		vortex_async_queue_push (stress_closed_queue, INT_TO_PTR (1));
+	vortex_mutex_unlock (&stress_mutex);
+	return;
+}
+
+axl_bool stress_on_accepted (VortexConnection * connection, axlPointer user_data)
+{
+	/* get a notification once the remote peer closes */
+	vortex_connection_set_on_close_full (connection, stress_on_close, NULL);
+
+	vortex_mutex_lock (&stress_mutex);
+	gettimeofday (&stress_last_accept, NULL);
+	if (stress_accepted == 0)
+		stress_first_accept = stress_last_accept;
+	stress_accepted++;
+	vortex_mutex_unlock (&stress_mutex);
+
+	return axl_true;
+}
+
+axlPointer stress_connector (axlPointer _connector)
+{
+	StressConnector * connector = _connector;
+	char              host[32];
+	int               iterator;
+	int               opened    = 0;
+
+	for (iterator = connector->index; iterator < stress_connections; iterator += stress_contexts) {
+		snprintf (host, sizeof (host), "127.0.0.%d", (iterator % stress_addresses) + 1);
+		conns[iterator] = vortex_connection_new (connector->ctx, host, stress_port, NULL, NULL);
+		if (! vortex_connection_is_ok (conns[iterator], axl_false)) {
+			printf ("ERROR: connection %d to %s:%s failed: %s\n",
+				iterator, host, stress_port, vortex_connection_get_message (conns[iterator]));
+			vortex_connection_close (conns[iterator]);
+			conns[iterator] = NULL;
+			break;
+		} /* end if */
+		opened++;
+	} /* end for */
+
+	/* notify connections opened (plus one to avoid pushing 0) */
+	vortex_async_queue_push (connector->done, INT_TO_PTR (opened + 1));
+	return NULL;
+}
+
+void stress_emit (const char * metric, double value, const char * unit)
+{
+	printf ("%-32s %14.2f %s\n", metric, value, unit);
+	if (stress_output == NULL)
+		return;
+
+	fprintf (stress_output, "{\"metric\": \"%s\", \"value\": %.2f, \"unit\": \"%s\", \"connections\": %d, \"contexts\": %d}\n",
+		 metric, value, unit, stress_connections, stress_contexts);
+	fflush (stress_output);
+	return;
+}
+
+long stress_usecs (struct timeval * start, struct timeval * stop)
+{
+	struct timeval diff;
+
+	vortex_timeval_substract (stop, start, &diff);
+	return (diff.tv_sec * 1000000) + diff.tv_usec;
+}
+
+double stress_elapsed (struct timeval * start)
+{
+	struct timeval stop;
+	long           usecs;
+
+	gettimeofday (&stop, NULL);
+	usecs = stress_usecs (start, &stop);
+	return usecs > 0 ? usecs / 1000000.0 : 0.000001;
+}
+
+void stress_pause (long usecs)
+{
+	VortexAsyncQueue * queue = vortex_async_queue_new ();
+
+	if (usecs > 0)
+		vortex_async_queue_timedpop (queue, usecs);
+	vortex_async_queue_unref (queue);
+	return;
+}
+
+long stress_rss (void)
+{
+#if defined(AXL_OS_UNIX)
+	FILE * file;
+	long   size     = 0;
+	long   resident = -1;
+
+	file = fopen ("/proc/self/statm", "r");
+	if (file == NULL)
+		return -1;
+	if (fscanf (file, "%ld %ld", &size, &resident) != 2)
+		resident = -1;
+	fclose (file);
+
+	return resident < 0 ? -1 : resident * sysconf (_SC_PAGESIZE);
+#else
+	return -1;
+#endif
+}
+
+double stress_cpu (void)
+{
+#if defined(AXL_OS_UNIX)
+	struct rusage usage;
+
+	if (getrusage (RUSAGE_SELF, &usage) != 0)
+		return 0;
+	return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+		((usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0);
+#else
+	return 0;
+#endif
+}
+
+int stress_compare_samples (const void * a, const void * b)
+{
+	long _a = *((const long *) a);
+	long _b = *((const long *) b);
+
+	return (_a > _b) - (_a < _b);
+}
+
+long stress_percentile (long * samples, int count, double percentile)
+{
+	int index = (int) (count * percentile);
+
+	if (index >= count)
+		index = count - 1;
+	return samples[index];
+}
+
+axl_bool stress_init_ctx (VortexCtx * ctx)
+{
+	if (! vortex_init_ctx (ctx))
+		return axl_false;
+
+	/* select(2) can't handle this amount of descriptors */
+	if (vortex_io_waiting_is_available (VORTEX_IO_WAIT_EPOLL))
+		vortex_io_waiting_use (ctx, VORTEX_IO_WAIT_EPOLL);
+	else if (vortex_io_waiting_is_available (VORTEX_IO_WAIT_POLL))
+		vortex_io_waiting_use (ctx, VORTEX_IO_WAIT_POLL);
+	else
+		printf ("WARNING: neither epoll(2) nor poll(2) are available, select(2) will limit the test\n");
+	return axl_true;
+}
+
+void stress_raise_limits (void)
+{
+	int hard   = 0;
+	int wanted = (stress_connections * 2) + 1024;
+	int max;
+
+	/* both peers live in this process: each session uses two
+	 * descriptors. Raising the hard limit requires privileges */
+	vortex_conf_get (listener_ctx, VORTEX_HARD_SOCK_LIMIT, &hard);
+	if (hard < wanted) {
+		vortex_conf_set (listener_ctx, VORTEX_HARD_SOCK_LIMIT, wanted, NULL);
+		vortex_conf_get (listener_ctx, VORTEX_HARD_SOCK_LIMIT, &hard);
+	} /* end if */
+	vortex_conf_set (listener_ctx, VORTEX_SOFT_SOCK_LIMIT, hard, NULL);
+
+	max = (hard - 1024) / 2;
+	if (stress_connections > max) {
+		printf ("NOTE: reducing connections from %d to %d (descriptor hard limit is %d)\n",
+			stress_connections, max, hard);
+		stress_connections = max;
+	} /* end if */
+	return;
+}
+
+int stress_connect (void)
+{
+	StressConnector  * connectors;
+	VortexAsyncQueue * done;
+	struct timeval     start;
+	double             elapsed;
+	int                opened = 0;
+	int                iterator;
+
+	done       = vortex_async_queue_new ();
+	connectors = axl_new (StressConnector, stress_contexts);
+
+	/* one connector thread for each client context */
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < stress_contexts; iterator++) {
+		connectors[iterator].ctx   = client_ctxs[iterator];
+		connectors[iterator].index = iterator;
+		connectors[iterator].done  = done;
+		if (! vortex_thread_create (&connectors[iterator].thread, stress_connector, &connectors[iterator],
+					    VORTEX_THREAD_CONF_END)) {
+			printf ("ERROR: failed to create connector thread %d\n", iterator);
+			return -1;
+		} /* end if */
+	} /* end for */
+
+	for (iterator = 0; iterator < stress_contexts; iterator++)
+		opened += PTR_TO_INT (vortex_async_queue_pop (done)) - 1;
+	elapsed = stress_elapsed (&start);
+
+	for (iterator = 0; iterator < stress_contexts; iterator++)
+		vortex_thread_destroy (&connectors[iterator].thread, axl_false);
+	axl_free (connectors);
+	vortex_async_queue_unref (done);
+
+	stress_emit ("connections_opened", opened, "connections");
+	stress_emit ("connect_rate", opened / elapsed, "connections/sec");
+
+	return opened;
+}
+
+void stress_wait_accepted (int opened)
+{
+	int iterator;
+	int accepted = 0;
+
+	/* give the listener some time to process all accepts */
+	for (iterator = 0; iterator < 1000; iterator++) {
+		vortex_mutex_lock (&stress_mutex);
+		accepted = stress_accepted;
+		vortex_mutex_unlock (&stress_mutex);
+		if (accepted >= opened)
+			break;
+		stress_pause (10000);
+	} /* end for */
+
+	if (accepted > 1) {
+		stress_emit ("accept_rate",
+			     accepted / (stress_usecs (&stress_first_accept, &stress_last_accept) / 1000000.0 + 0.000001),
+			     "connections/sec");
+	} /* end if */
+	return;
+}
+
+axl_bool stress_activity (void)
+{
+	VortexChannel        ** channels;
+	VortexAsyncQueue      * queue;
+	VortexFrame           * frame;
+	VortexMetricsSnapshot   snapshot;
+	struct timeval          start;
+	struct timeval          round_start;
+	struct timeval          sent;
+	struct timeval          stop;
+	long                    rss;
+	long                  * samples;
+	double                  cpu;
+	double                  elapsed;
+	int                     active = 0;
+	int                     count  = 0;
+	int                     round;
+	int                     iterator;
+
+	/* open one channel over one of each N connections */
+	queue    = vortex_async_queue_new ();
+	channels = axl_new (VortexChannel *, (stress_active_every > 0 ? stress_connections / stress_active_every : 0) + 1);
+	rss      = stress_rss ();
+	for (iterator = 0; stress_active_every > 0 && iterator < stress_connections; iterator += stress_active_every) {
+		if (conns[iterator] == NULL)
+			continue;
+		channels[active] = vortex_channel_new (conns[iterator], 0, STRESS_PROFILE,
+						       NULL, NULL,
+						       vortex_channel_queue_reply, queue,
+						       NULL, NULL);
+		if (channels[active] == NULL) {
+			printf ("ERROR: failed to create channel over connection %d\n", iterator);
+			return axl_false;
+		} /* end if */
+		active++;
+	} /* end for */
+	if (active > 0 && rss > 0)
+		stress_emit ("rss_per_channel", (double) (stress_rss () - rss) / active, "bytes");
+	stress_emit ("active_connections", active, "connections");
+
+	/* reader loop cost and cpu usage while sessions are idle
+	 * (or lightly active) */
+	vortex_metrics_enable (listener_ctx, axl_true);
+	vortex_metrics_reset (listener_ctx);
+	samples = axl_new (long, (active * stress_idle_seconds) + 1);
+	cpu     = stress_cpu ();
+	gettimeofday (&start, NULL);
+	for (round = 0; round < stress_idle_seconds; round++) {
+		gettimeofday (&round_start, NULL);
+		for (iterator = 0; iterator < active; iterator++) {
+			gettimeofday (&sent, NULL);
+			if (! vortex_channel_send_msg (channels[iterator], "ping", 4, NULL)) {
+				printf ("ERROR: failed to send message over channel %d\n", iterator);
+				return axl_false;
+			} /* end if */
+			frame = vortex_channel_get_reply (channels[iterator], queue);
+			if (frame == NULL) {
+				printf ("ERROR: failed to receive reply over channel %d\n", iterator);
+				return axl_false;
+			} /* end if */
+			vortex_frame_unref (frame);
+			gettimeofday (&stop, NULL);
+			samples[count++] = stress_usecs (&sent, &stop);
+		} /* end for */
+
+		/* wait for the rest of the second */
+		gettimeofday (&stop, NULL);
+		stress_pause (1000000 - stress_usecs (&round_start, &stop));
+	} /* end for */
+	elapsed = stress_elapsed (&start);
+	cpu     = stress_cpu () - cpu;
+
+	stress_emit ("idle_cpu", (cpu * 100) / elapsed, "percent");
+	if (vortex_metrics_get (listener_ctx, VORTEX_METRIC_READER_LOOP, NULL, &snapshot)) {
+		stress_emit ("reader_wakeups", snapshot.count / elapsed, "wakeups/sec");
+		stress_emit ("reader_wakeup_p50", snapshot.p50, "usecs");
+		stress_emit ("reader_wakeup_p99", snapshot.p99, "usecs");
+		stress_emit ("reader_wakeup_max", snapshot.max, "usecs");
+	} /* end if */
+	if (count > 0) {
+		qsort (samples, count, sizeof (long), stress_compare_samples);
+		stress_emit ("active_rtt_p50", stress_percentile (samples, count, 0.50), "usecs");
+		stress_emit ("active_rtt_p99", stress_percentile (samples, count, 0.99), "usecs");
+		stress_emit ("active_rtt_p999", stress_percentile (samples, count, 0.999), "usecs");
+	} /* end if */
+
+	axl_free (samples);
+	axl_free (channels);
+	vortex_async_queue_unref (queue);
+	return axl_true;
+}
+
+void stress_close (void)
+{
+	struct timeval start;
+	int            target;
+	int            pending;
+	int            iterator;
+
+	vortex_mutex_lock (&stress_mutex);
+	target              = stress_accepted;
+	pending             = stress_accepted - stress_closed;
+	stress_close_target = target;
+	vortex_mutex_unlock (&stress_mutex);
+
+	/* close client sockets without BEEP close negotiation: the
+	 * listener has to detect it */
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < stress_connections; iterator++) {
+		if (conns[iterator] != NULL)
+			vortex_connection_shutdown (conns[iterator]);
+	} /* end for */
+
+	if (pending > 0 && vortex_async_queue_timedpop (stress_closed_queue, STRESS_CLOSE_TIMEOUT) == NULL) {
+		vortex_mutex_lock (&stress_mutex);
+		printf ("WARNING: listener detected %d of %d closures\n", stress_closed - (target - pending), pending);
+		vortex_mutex_unlock (&stress_mutex);
+	} /* end if */
+
+	if (pending > 0) {
+		vortex_mutex_lock (&stress_mutex);
+		stress_emit ("close_detect_all", stress_usecs (&start, &stress_last_close) / 1000.0, "msecs");
+		vortex_mutex_unlock (&stress_mutex);
+	} /* end if */
+
+	for (iterator = 0; iterator < stress_connections; iterator++) {
+		if (conns[iterator] != NULL)
+			vortex_connection_close (conns[iterator]);
+	} /* end for */
+	return;
+}
+
+int  main (int  argc, char  ** argv)
+{
+	char  host[32];
+	long  rss;
+	int   opened;
+	int   iterator;
+
+	for (iterator = 1; iterator < argc; iterator++) {
+		if (axl_cmp (argv[iterator], "--connections") && (iterator + 1) < argc) {
+			stress_connections = atoi (argv[++iterator]);
+		} else if (axl_cmp (argv[iterator], "--contexts") && (iterator + 1) < argc) {
+			stress_contexts = atoi (argv[++iterator]);
+		} else if (axl_cmp (argv[iterator], "--addresses") && (iterator + 1) < argc) {
+			stress_addresses = atoi (argv[++iterator]);
+		} else if (axl_cmp (argv[iterator], "--port") && (iterator + 1) < argc) {
+			stress_port = argv[++iterator];
+		} else if (axl_cmp (argv[iterator], "--active-every") && (iterator + 1) < argc) {
+			stress_active_every = atoi (argv[++iterator]);
+		} else if (axl_cmp (argv[iterator], "--idle-seconds") && (iterator + 1) < argc) {
+			stress_idle_seconds = atoi (argv[++iterator]);
+		} else if (axl_cmp (argv[iterator], "--output") && (iterator + 1) < argc) {
+			stress_output = fopen (argv[++iterator], "w");
+			if (stress_output == NULL) {
+				printf ("ERROR: unable to open %s\n", argv[iterator]);
+				return -1;
+			} /* end if */
+		} else {
+			printf ("Usage: %s [--connections N] [--contexts N] [--addresses N] [--port port]\n", argv[0]);
+			printf ("          [--active-every N] [--idle-seconds N] [--output file]\n");
+			return -1;
+		} /* end if */
+	} /* end for */
+
+	if (stress_contexts < 1)
+		stress_contexts = 1;
+	if (stress_addresses < 1 || stress_addresses > 254)
+		stress_addresses = 1;
+
+	/* create and init listener context */
+	listener_ctx = vortex_ctx_new ();
+	if (! stress_init_ctx (listener_ctx)) {
+		printf ("ERROR: unable to init vortex context\n");
+		return -1;
+	} /* end if */
+	stress_raise_limits ();
+	vortex_conf_set (listener_ctx, VORTEX_LISTENER_BACKLOG, 4096, NULL);
+
+	/* create client contexts */
+	client_ctxs = axl_new (VortexCtx *, stress_contexts);
+	for (iterator = 0; iterator < stress_contexts; iterator++) {
+		client_ctxs[iterator] = vortex_ctx_new ();
+		if (! stress_init_ctx (client_ctxs[iterator])) {
+			printf ("ERROR: unable to init vortex context\n");
+			return -1;
+		} /* end if */
+	} /* end for */
+
+	/* prepare listeners */
+	vortex_mutex_create (&stress_mutex);
+	stress_closed_queue = vortex_async_queue_new ();
+	vortex_listener_set_on_connection_accepted (listener_ctx, stress_on_accepted, NULL);
+	vortex_profiles_register (listener_ctx, STRESS_PROFILE,
+				  NULL, NULL,
+				  NULL, NULL,
+				  stress_frame_received, NULL);
+	for (iterator = 0; iterator < stress_addresses; iterator++) {
+		snprintf (host, sizeof (host), "127.0.0.%d", iterator + 1);
+		if (! vortex_connection_is_ok (vortex_listener_new (listener_ctx, host, stress_port, NULL, NULL), axl_false)) {
+			printf ("ERROR: unable to start listener at %s:%s\n", host, stress_port);
+			return -1;
+		} /* end if */
+	} /* end for */
+
+	printf ("INFO: opening %d connections from %d contexts against %d addresses (io: %d)\n",
+		stress_connections, stress_contexts, stress_addresses, vortex_io_waiting_get_current (listener_ctx));
+	if (stress_output != NULL) {
+		fprintf (stress_output, "{\"metric\": \"info\", \"version\": \"%s\", \"connections\": %d, \"contexts\": %d, \"addresses\": %d}\n",
+			 VERSION, stress_connections, stress_contexts, stress_addresses);
+	} /* end if */
+
+	/* open sessions and check memory used */
+	conns  = axl_new (VortexConnection *, stress_connections);
+	rss    = stress_rss ();
+	opened = stress_connect ();
+	if (opened < 0)
+		return -1;
+	stress_wait_accepted (opened);
+	if (opened > 0 && rss > 0)
+		stress_emit ("rss_per_session_pair", (double) (stress_rss () - rss) / opened, "bytes");
+
+	/* idle and light traffic phase */
+	if (! stress_activity ())
+		return -1;
+
+	/* closure detection */
+	stress_close ();
+
+	if (stress_output != NULL)
+		fclose (stress_output);
+
+	for (iterator = 0; iterator < stress_contexts; iterator++)
+		vortex_exit_ctx (client_ctxs[iterator], axl_true);
+	vortex_exit_ctx (listener_ctx, axl_true);
+	axl_free (client_ctxs);
+	axl_free (conns);
+
+	return 0;
+}
@@ -0,0 +1,187 @@
+/*  LibVortex:  A BEEP implementation
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* include base library */
+#include <vortex.h>
+
+/* include tls library */
+#include <vortex_tls.h>
+
+/*
+ * TLS throughput benchmark: starts a TLS listener and a client
+ * inside the same process and measures the time required to send a
+ * set of messages (waiting for all replies), first using the default
+ * TLS transport and then using read ahead and write coalescing.
+ *
+ * Usage: vortex-tls-bench [messages] [message-size] [port]
+ */
+
+#define BENCH_PROFILE "http://fact.aspl.es/profiles/tls-bench"
+
+/* listener and client contexts */
+VortexCtx * listener_ctx = NULL;
+VortexCtx * client_ctx   = NULL;
+
+void bench_frame_received (VortexChannel    * channel,
+			   VortexConnection * connection,
+			   VortexFrame      * frame,
+			   axlPointer         user_data)
+{
+	/* reply with a small message */
+	vortex_channel_send_rpy (channel, "ok", 2, vortex_frame_get_msgno (frame));
+	return;
+}
+
+void bench_configure (VortexCtx * ctx, axl_bool bulk)
+{
+	vortex_tls_set_read_ahead       (ctx, bulk);
+	vortex_tls_set_write_coalescing (ctx, bulk ? 16384 : 0);
+	return;
+}
+
+axl_bool bench_run (const char * label, const char * port, int messages, int size, axl_bool bulk)
+{
+	VortexConnection   * conn;
+	VortexChannel      * channel;
+	VortexAsyncQueue   * queue;
+	VortexFrame        * frame;
+	VortexStatus         status;
+	char               * status_message = NULL;
+	char               * message;
+	struct timeval       start;
+	struct timeval       stop;
+	struct timeval       diff;
+	double               elapsed;
+	int                  iterator;
+
+	/* configure both peers */
+	bench_configure (listener_ctx, bulk);
+	bench_configure (client_ctx, bulk);
+
+	/* connect and enable TLS */
+	conn = vortex_connection_new (client_ctx, "127.0.0.1", port, NULL, NULL);
+	if (! vortex_connection_is_ok (conn, axl_false)) {
+		printf ("ERROR: failed to connect to 127.0.0.1:%s: %s\n", port, vortex_connection_get_message (conn));
+		return axl_false;
+	}
+	conn = vortex_tls_start_negotiation_sync (conn, NULL, &status, &status_message);
+	if (status != VortexOk || ! vortex_connection_is_ok (conn, axl_false)) {
+		printf ("ERROR: failed to enable TLS: %s\n", status_message ? status_message : "");
+		return axl_false;
+	}
+
+	/* create the channel */
+	queue   = vortex_async_queue_new ();
+	channel = vortex_channel_new (conn, 0, BENCH_PROFILE,
+				      NULL, NULL,
+				      vortex_channel_queue_reply, queue,
+				      NULL, NULL);
+	if (channel == NULL) {
+		printf ("ERROR: failed to create bench channel\n");
+		return axl_false;
+	}
+
+	message = axl_new (char, size + 1);
+	memset (message, 'a', size);
+
+	/* send all messages and wait for all replies */
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < messages; iterator++) {
+		if (! vortex_channel_send_msg (channel, message, size, NULL)) {
+			printf ("ERROR: failed to send message %d\n", iterator);
+			return axl_false;
+		}
+	} /* end for */
+
+	for (iterator = 0; iterator < messages; iterator++) {
+		frame = vortex_channel_get_reply (channel, queue);
+		if (frame == NULL) {
+			printf ("ERROR: failed to receive reply %d\n", iterator);
+			return axl_false;
+		}
+		vortex_frame_unref (frame);
+	} /* end for */
+	gettimeofday (&stop, NULL);
+	vortex_timeval_substract (&stop, &start, &diff);
+
+	elapsed = diff.tv_sec + (diff.tv_usec / 1000000.0);
+	if (elapsed <= 0)
+		elapsed = 0.000001;
+
+	printf ("%-24s %8d msgs  %8d bytes  %8.3f secs  %10.0f msgs/sec  %8.2f MB/sec\n",
+		label, messages, size, elapsed, messages / elapsed,
+		((double) messages * size) / (elapsed * 1024 * 1024));
+
+	axl_free (message);
+	vortex_async_queue_unref (queue);
+	vortex_connection_close (conn);
+
+	return axl_true;
+}
+
+int  main (int  argc, char  ** argv)
+{
+	int          messages = 10000;
+	int          size     = 512;
+	const char * port     = "44020";
+
+	if (argc > 1)
+		messages = atoi (argv[1]);
+	if (argc > 2)
+		size     = atoi (argv[2]);
+	if (argc > 3)
+		port     = argv[3];
+
+	/* create and init contexts */
+	listener_ctx = vortex_ctx_new ();
+	client_ctx   = vortex_ctx_new ();
+	if (! vortex_init_ctx (listener_ctx) || ! vortex_init_ctx (client_ctx)) {
+		printf ("ERROR: unable to init vortex contexts\n");
+		return -1;
+	} /* end if */
+
+	if (! vortex_tls_init (listener_ctx) || ! vortex_tls_init (client_ctx)) {
+		printf ("Current Vortex Library is not prepared for TLS profile\n");
+		return -1;
+	}
+
+	/* prepare listener */
+	if (! vortex_tls_accept_negotiation (listener_ctx, NULL, NULL, NULL)) {
+		printf ("Unable to start accepting TLS profile requests\n");
+		return -1;
+	}
+	vortex_profiles_register (listener_ctx, BENCH_PROFILE,
+				  NULL, NULL,
+				  NULL, NULL,
+				  bench_frame_received, NULL);
+	if (! vortex_connection_is_ok (vortex_listener_new (listener_ctx, "127.0.0.1", port, NULL, NULL), axl_false)) {
+		printf ("ERROR: unable to start listener at 127.0.0.1:%s\n", port);
+		return -1;
+	}
+
+	/* run both modes */
+	if (! bench_run ("tls default", port, messages, size, axl_false))
+		return -1;
+	if (! bench_run ("tls read-ahead+coalesce", port, messages, size, axl_true))
+		return -1;
+
+	vortex_exit_ctx (client_ctx, axl_true);
+	vortex_exit_ctx (listener_ctx, axl_true);
+
+	return 0;
+}
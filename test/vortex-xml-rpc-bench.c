@@ -0,0 +1,152 @@
+/*  LibVortex:  A BEEP implementation
+ *  Copyright (C) 2025 Advanced Software Production Line, S.L.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* include base library */
+#include <vortex.h>
+
+/* include xml-rpc library */
+#include <vortex_xml_rpc.h>
+
+/*
+ * XML-RPC marshalling benchmark: builds method calls and method
+ * responses holding large arrays and structs and measures the time
+ * required to marshall them (no network involved).
+ *
+ * Usage: vortex-xml-rpc-bench [items] [rounds]
+ */
+
+/* context used to create values */
+VortexCtx * ctx = NULL;
+
+XmlRpcArray * bench_build_array (int items)
+{
+	XmlRpcArray * array = vortex_xml_rpc_array_new (items);
+	int           iterator;
+
+	for (iterator = 0; iterator < items; iterator++) {
+		if ((iterator % 2) == 0)
+			vortex_xml_rpc_array_add (array, vortex_xml_rpc_method_value_new_int (ctx, iterator));
+		else
+			vortex_xml_rpc_array_add (array, vortex_xml_rpc_method_value_new (ctx, XML_RPC_STRING_VALUE, "this is a test string"));
+	} /* end for */
+
+	return array;
+}
+
+XmlRpcStruct * bench_build_struct (int items)
+{
+	XmlRpcStruct * _struct = vortex_xml_rpc_struct_new (items);
+	char           name[32];
+	int            iterator;
+
+	for (iterator = 0; iterator < items; iterator++) {
+		snprintf (name, sizeof (name), "member%d", iterator);
+		vortex_xml_rpc_struct_add_member (_struct,
+						  vortex_xml_rpc_struct_member_new (name, vortex_xml_rpc_method_value_new_double (ctx, iterator * 1.5)));
+	} /* end for */
+
+	return _struct;
+}
+
+void bench_report (const char * label, struct timeval * start, int rounds, int size)
+{
+	struct timeval stop;
+	struct timeval diff;
+	double         elapsed;
+
+	gettimeofday (&stop, NULL);
+	vortex_timeval_substract (&stop, start, &diff);
+
+	elapsed = diff.tv_sec + (diff.tv_usec / 1000000.0);
+	printf ("%-28s %6d rounds  %10d bytes  %10.3f ms/round\n",
+		label, rounds, size, (elapsed * 1000) / rounds);
+	return;
+}
+
+int  main (int  argc, char  ** argv)
+{
+	int                    items  = 10000;
+	int                    rounds = 10;
+	int                    iterator;
+	int                    size = 0;
+	char                 * content;
+	struct timeval         start;
+	XmlRpcMethodCall     * method_call;
+	XmlRpcMethodResponse * response;
+
+	if (argc > 1)
+		items  = atoi (argv[1]);
+	if (argc > 2)
+		rounds = atoi (argv[2]);
+
+	/* create and init context */
+	ctx = vortex_ctx_new ();
+	if (! vortex_init_ctx (ctx)) {
+		printf ("ERROR: unable to init vortex context\n");
+		return -1;
+	} /* end if */
+
+	/* method call with a large array */
+	method_call = vortex_xml_rpc_method_call_new (ctx, "bench.array", 1);
+	vortex_xml_rpc_method_call_add_value (method_call,
+					      vortex_xml_rpc_method_value_new (ctx, XML_RPC_ARRAY_VALUE, bench_build_array (items)));
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < rounds; iterator++) {
+		content = vortex_xml_rpc_method_call_marshall (method_call, &size);
+		axl_free (content);
+	} /* end for */
+	bench_report ("method call (array)", &start, rounds, size);
+	vortex_xml_rpc_method_call_free (method_call);
+
+	/* method call with a large struct */
+	method_call = vortex_xml_rpc_method_call_new (ctx, "bench.struct", 1);
+	vortex_xml_rpc_method_call_add_value (method_call,
+					      vortex_xml_rpc_method_value_new (ctx, XML_RPC_STRUCT_VALUE, bench_build_struct (items)));
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < rounds; iterator++) {
+		content = vortex_xml_rpc_method_call_marshall (method_call, &size);
+		axl_free (content);
+	} /* end for */
+	bench_report ("method call (struct)", &start, rounds, size);
+	vortex_xml_rpc_method_call_free (method_call);
+
+	/* method response with a large array */
+	response = vortex_xml_rpc_method_response_new (XML_RPC_OK, -1, NULL,
+						       vortex_xml_rpc_method_value_new (ctx, XML_RPC_ARRAY_VALUE, bench_build_array (items)));
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < rounds; iterator++) {
+		content = vortex_xml_rpc_method_response_marshall (response, &size);
+		axl_free (content);
+	} /* end for */
+	bench_report ("method response (array)", &start, rounds, size);
+	vortex_xml_rpc_method_response_free (response);
+
+	/* method response with a large struct */
+	response = vortex_xml_rpc_method_response_new (XML_RPC_OK, -1, NULL,
+						       vortex_xml_rpc_method_value_new (ctx, XML_RPC_STRUCT_VALUE, bench_build_struct (items)));
+	gettimeofday (&start, NULL);
+	for (iterator = 0; iterator < rounds; iterator++) {
+		content = vortex_xml_rpc_method_response_marshall (response, &size);
+		axl_free (content);
+	} /* end for */
+	bench_report ("method response (struct)", &start, rounds, size);
+	vortex_xml_rpc_method_response_free (response);
+
+	vortex_exit_ctx (ctx, axl_true);
+	return 0;
+}
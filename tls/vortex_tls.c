@@ -52,6 +52,11 @@
 #include <openssl/x509v3.h>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
+#include <openssl/rand.h>
+#include <openssl/hmac.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#endif
 
 /* some keys to store creation handlers and its associate data */
 #define CTX_CREATION      "tls:ctx-creation"
@@ -60,6 +65,16 @@
 #define POST_CHECK_DATA   "tls:post-checks:data"
 #define TLS_CTX           "tls:ctx"
 
+/* default lifetime (in seconds) for a session ticket key before it
+ * is rotated */
+#define TLS_TICKET_KEY_LIFETIME   3600
+
+/* default amount of sessions cached by the server side SSL_CTX */
+#define TLS_SESSION_CACHE_SIZE    4096
+
+/* size of the buffered receive layer used with read ahead */
+#define TLS_READ_BUFFER_SIZE      16384
+
 /**
  * @internal Function that dumps all errors found on current ssl context.
  */
@@ -94,6 +109,17 @@ int vortex_tls_log_ssl (VortexCtx * ctx)
 }
 
 
+/** 
+ * @internal Key used to protect session tickets issued by the server
+ * side.
+ */
+typedef struct _VortexTlsTicketKey {
+	unsigned char                      name[16];
+	unsigned char                      hmac_key[32];
+	unsigned char                      aes_key[32];
+	long                               created;
+} VortexTlsTicketKey;
+
 typedef struct _VortexTlsCtx {
 
 	/* @internal Internal default handlers used to define the TLS
@@ -122,8 +148,78 @@ typedef struct _VortexTlsCtx {
 	int      	                   connection_auto_tls_allow_failures;
 	char  *                            connection_auto_tls_server_name;
 
+	/** 
+	 * @internal
+	 * @brief Session resumption support (see \ref vortex_tls_set_session_resumption).
+	 */
+	axl_bool                           session_resumption;
+	VortexMutex                        session_mutex;
+	/* shared SSL_CTX objects (client and server side) indexed by
+	 * method and certificate/private key */
+	axlHash                          * shared_ctxs;
+	/* client side sessions indexed by host:port:serverName */
+	axlHash                          * client_sessions;
+	/* ticket keys used by the server side: current and previous */
+	VortexTlsTicketKey                 ticket_keys[2];
+	int                                ticket_key_lifetime;
+	/* resumption hit/miss counters */
+	int                                client_hits;
+	int                                client_misses;
+	int                                server_hits;
+	int                                server_misses;
+
+	/** 
+	 * @internal
+	 * @brief Kernel TLS offload support (see \ref vortex_tls_set_kernel_offload).
+	 */
+	axl_bool                           kernel_offload;
+
+	/** 
+	 * @internal
+	 * @brief Bulk transfer support (see \ref vortex_tls_set_read_ahead
+	 * and \ref vortex_tls_set_write_coalescing).
+	 */
+	axl_bool                           read_ahead;
+	int                                write_coalescing;
+
 } VortexTlsCtx;
 
+/** 
+ * @internal Buffered receive layer used when read ahead is enabled
+ * so small reads (like frame header lines) are served without
+ * calling SSL_read.
+ */
+typedef struct _VortexTlsReadBuffer {
+	int                                start;
+	int                                end;
+	/* EOF or fatal error found by vortex_tls_pending_input while
+	 * refilling the buffer, reported by next read */
+	axl_bool                           failed;
+	int                                failure;
+	char                               data[TLS_READ_BUFFER_SIZE];
+} VortexTlsReadBuffer;
+
+/** 
+ * @internal Releases the tls context and all resources associated
+ * to session resumption.
+ */
+void __vortex_tls_ctx_free (VortexTlsCtx * tls_ctx)
+{
+	if (tls_ctx == NULL)
+		return;
+
+	axl_hash_free (tls_ctx->shared_ctxs);
+	axl_hash_free (tls_ctx->client_sessions);
+	vortex_mutex_destroy (&tls_ctx->session_mutex);
+
+	/* clear ticket keys from memory */
+	OPENSSL_cleanse (tls_ctx->ticket_keys, sizeof (tls_ctx->ticket_keys));
+
+	axl_free (tls_ctx->connection_auto_tls_server_name);
+	axl_free (tls_ctx);
+	return;
+}
+
 /** 
  * @internal Calls to the failure handler if it is defined with the
  * provided error message.
@@ -184,10 +280,14 @@ axl_bool      vortex_tls_init (VortexCtx * ctx)
 
 	/* create the tls context */
 	tls_ctx = axl_new (VortexTlsCtx, 1);
+	vortex_mutex_create (&tls_ctx->session_mutex);
+	tls_ctx->shared_ctxs         = axl_hash_new (axl_hash_string, axl_hash_equal_string);
+	tls_ctx->client_sessions     = axl_hash_new (axl_hash_string, axl_hash_equal_string);
+	tls_ctx->ticket_key_lifetime = TLS_TICKET_KEY_LIFETIME;
 	vortex_ctx_set_data_full (ctx,
 				  /* key and value */
 				  TLS_CTX, tls_ctx,
-				  NULL, axl_free);
+				  NULL, (axlDestroyFunc) __vortex_tls_ctx_free);
 
 	/* install connection action */
 	vortex_connection_set_connection_actions (ctx,
@@ -431,34 +531,19 @@ void               vortex_tls_set_failure_handler        (VortexCtx
 }
 
 /** 
- * @internal
- *
- * @brief Default handlers used to actually read from underlying
- * transport while a connection is working under TLS.
- * 
- * @param connection The connection where the read operation will be performed.
- * @param buffer     The buffer where the data read will be returned
- * @param buffer_len Buffer size
- * 
- * @return How many bytes was read.
+ * @internal Calls SSL_read on the provided ssl object translating
+ * errors found into values expected by the vortex reader.
  */
-int  vortex_tls_ssl_read (VortexConnection * connection, char  * buffer, int  buffer_len)
+int  __vortex_tls_ssl_read_raw (VortexConnection * connection, SSL * ssl, char  * buffer, int  buffer_len)
 {
-	SSL         * ssl;
 	VortexMutex * mutex;
 	VortexCtx   * ctx = vortex_connection_get_ctx (connection);
 	int    res;
 	int    ssl_err;
 
-	/* get ssl object */
-	ssl = vortex_connection_get_data (connection, "ssl-data:ssl");
-	if (ssl == NULL) {
-		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to find ssl object to read data");
-		return 0;
-	}
-
  retry:
-	/* get and lock the mutex */
+	/* get and lock the mutex (also with kernel TLS: SSL_read may
+	 * write alerts or KeyUpdate responses on the socket) */
 	mutex = vortex_connection_get_data (connection, "ssl-data:mutex");
 	if (mutex == NULL) {
 		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to find mutex to protect ssl object to read data");
@@ -513,6 +598,124 @@ int  vortex_tls_ssl_read (VortexConnection * connection, char  * buffer, int  bu
 	return -1;
 }
 
+/** 
+ * @internal
+ *
+ * @brief Default handlers used to actually read from underlying
+ * transport while a connection is working under TLS.
+ * 
+ * @param connection The connection where the read operation will be performed.
+ * @param buffer     The buffer where the data read will be returned
+ * @param buffer_len Buffer size
+ * 
+ * @return How many bytes was read.
+ */
+int  vortex_tls_ssl_read (VortexConnection * connection, char  * buffer, int  buffer_len)
+{
+	SSL                 * ssl;
+	VortexTlsReadBuffer * rbuf;
+	VortexCtx           * ctx = vortex_connection_get_ctx (connection);
+	int                   res;
+
+	/* get ssl object */
+	ssl = vortex_connection_get_data (connection, "ssl-data:ssl");
+	if (ssl == NULL) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to find ssl object to read data");
+		return 0;
+	}
+
+	/* no buffered receive layer, read directly */
+	rbuf = vortex_connection_get_data (connection, "ssl-data:rbuf");
+	if (rbuf == NULL)
+		return __vortex_tls_ssl_read_raw (connection, ssl, buffer, buffer_len);
+
+	if (rbuf->start == rbuf->end) {
+		/* report EOF or error found while refilling */
+		if (rbuf->failed)
+			return rbuf->failure;
+
+		/* buffer empty: big reads go directly to the caller
+		 * buffer, small reads refill the buffer */
+		if (buffer_len >= TLS_READ_BUFFER_SIZE)
+			return __vortex_tls_ssl_read_raw (connection, ssl, buffer, buffer_len);
+
+		res = __vortex_tls_ssl_read_raw (connection, ssl, rbuf->data, TLS_READ_BUFFER_SIZE);
+		if (res <= 0)
+			return res;
+		rbuf->start = 0;
+		rbuf->end   = res;
+	} /* end if */
+
+	/* serve content from buffer */
+	res = rbuf->end - rbuf->start;
+	if (res > buffer_len)
+		res = buffer_len;
+	memcpy (buffer, rbuf->data + rbuf->start, res);
+	rbuf->start += res;
+
+	return res;
+}
+
+/** 
+ * @internal Pending input handler installed on TLS connections with
+ * read ahead enabled (see vortex_connection_set_pending_input_handler).
+ * Reports content already decrypted (or read from the socket with
+ * read ahead) that will not be notified by the I/O waiting
+ * mechanism. EOF or errors found while decoding that content are
+ * also reported as pending input, so the reader gets them from the
+ * next read and closes the connection.
+ */
+axl_bool vortex_tls_pending_input (VortexConnection * connection)
+{
+	SSL                 * ssl;
+	VortexTlsReadBuffer * rbuf;
+	VortexMutex         * mutex;
+	int                   res;
+
+	ssl = vortex_connection_get_data (connection, "ssl-data:ssl");
+	if (ssl == NULL)
+		return axl_false;
+
+	rbuf = vortex_connection_get_data (connection, "ssl-data:rbuf");
+	if (rbuf && (rbuf->start < rbuf->end || rbuf->failed))
+		return axl_true;
+
+	/* check for records already decrypted */
+	mutex = vortex_connection_get_data (connection, "ssl-data:mutex");
+	if (mutex)
+		vortex_mutex_lock (mutex);
+	res   = SSL_pending (ssl);
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+	/* raw content read ahead from the socket: it may hold
+	 * complete records, so try to decode them */
+	if (res == 0 && rbuf && SSL_has_pending (ssl))
+		res = -1;
+#endif
+	if (mutex)
+		vortex_mutex_unlock (mutex);
+
+	if (res > 0)
+		return axl_true;
+	if (res < 0) {
+		/* refill buffer if a complete record is available */
+		res = __vortex_tls_ssl_read_raw (connection, ssl, rbuf->data, TLS_READ_BUFFER_SIZE);
+		if (res > 0) {
+			rbuf->start = 0;
+			rbuf->end   = res;
+			return axl_true;
+		} /* end if */
+
+		/* EOF or fatal error: keep it for the next read */
+		if (res != -2) {
+			rbuf->failed  = axl_true;
+			rbuf->failure = res;
+			return axl_true;
+		} /* end if */
+	} /* end if */
+
+	return axl_false;
+}
+
 /** 
  * @internal
  *
@@ -594,6 +797,42 @@ int  vortex_tls_ssl_write (VortexConnection * connection, const char  * buffer,
 	return -1;
 }
 
+/** 
+ * @internal Send handler used when kernel TLS handles the send
+ * direction: content written to the socket is encrypted by the
+ * kernel, but the write is still done holding the ssl-data:mutex
+ * because SSL_read may also write on the same socket (alerts,
+ * close_notify or KeyUpdate responses, which also replace the kernel
+ * send keys).
+ *
+ * @param connection The connection where the write operation will be performed.
+ * @param buffer     The buffer containing data to be sent.
+ * @param buffer_len The buffer size.
+ * 
+ * @return How many bytes was written.
+ */
+int  vortex_tls_ktls_write (VortexConnection * connection, const char  * buffer, int  buffer_len)
+{
+	VortexMutex * mutex;
+	int           res;
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+	VortexCtx   * ctx = vortex_connection_get_ctx (connection);
+#endif
+
+	mutex = vortex_connection_get_data (connection, "ssl-data:mutex");
+	if (mutex == NULL) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to find mutex to protect ssl object to write data");
+		return 0;
+	}
+	vortex_mutex_lock (mutex);
+
+	/* write data (record built by the kernel) */
+	res = send (vortex_connection_get_socket (connection), buffer, buffer_len, 0);
+
+	vortex_mutex_unlock (mutex);
+	return res;
+}
+
 /** 
  * @internal Internal function to release and free the mutex memory
  * allocated.
@@ -647,6 +886,389 @@ void vortex_tls_set_common_data (VortexConnection * connection,
 	return;
 }
 
+/** 
+ * @internal Requests kernel TLS offload on the provided ssl object
+ * (if enabled and supported by the OpenSSL library and kernel). Must
+ * be called before the handshake.
+ */
+void __vortex_tls_kernel_offload_request (VortexTlsCtx * tls_ctx, SSL * ssl)
+{
+#if defined(SSL_OP_ENABLE_KTLS)
+	if (tls_ctx->kernel_offload)
+		SSL_set_options (ssl, SSL_OP_ENABLE_KTLS);
+#endif
+	return;
+}
+
+/** 
+ * @internal Called once the handshake has finished. If the kernel
+ * took over record encryption for the send direction, a socket send
+ * handler is installed so the sequencer writes without encrypting
+ * through the ssl object (see vortex_tls_ktls_write). Writes and
+ * SSL_* calls are still serialized with the ssl-data:mutex, which is
+ * now only held during the send system call.
+ *
+ * The receive direction is kept on SSL_read because non application
+ * data records (for example TLSv1.3 tickets or key updates) must
+ * still be processed by OpenSSL (which uses the kernel offload
+ * transparently when available).
+ *
+ * @return axl_true if the send direction was offloaded.
+ */
+axl_bool __vortex_tls_kernel_offload_enable (VortexTlsCtx * tls_ctx, VortexConnection * connection, SSL * ssl)
+{
+#if defined(SSL_OP_ENABLE_KTLS)
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+	VortexCtx   * ctx = vortex_connection_get_ctx (connection);
+#endif
+
+	if (! tls_ctx->kernel_offload)
+		return axl_false;
+
+	if (! BIO_get_ktls_send (SSL_get_wbio (ssl))) {
+		vortex_log (VORTEX_LEVEL_DEBUG, "kernel TLS offload not available for connection id=%d, using SSL_write",
+			    vortex_connection_get_id (connection));
+		return axl_false;
+	} /* end if */
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "kernel TLS offload enabled for connection id=%d (send=yes, recv=%s)",
+		    vortex_connection_get_id (connection), BIO_get_ktls_recv (SSL_get_rbio (ssl)) ? "yes" : "no");
+
+	/* flag the connection and install the kernel TLS send handler */
+	vortex_connection_set_data (connection, "ssl-data:ktls-send", INT_TO_PTR (axl_true));
+	vortex_connection_set_send_handler (connection, vortex_tls_ktls_write);
+
+	return axl_true;
+#else
+	return axl_false;
+#endif
+}
+
+/** 
+ * @internal Configures read ahead (with its buffered receive layer)
+ * and write coalescing on a connection once the handshake has
+ * finished (see \ref vortex_tls_set_read_ahead and \ref
+ * vortex_tls_set_write_coalescing).
+ */
+void __vortex_tls_bulk_configure (VortexTlsCtx * tls_ctx, VortexConnection * connection, SSL * ssl)
+{
+	int max_size;
+
+	if (tls_ctx->read_ahead) {
+		SSL_set_read_ahead (ssl, 1);
+		vortex_connection_set_data_full (connection, "ssl-data:rbuf", axl_new (VortexTlsReadBuffer, 1),
+						 NULL, axl_free);
+
+		/* notify the reader about content already read from
+		 * the socket: a single read may hold several frames */
+		vortex_connection_set_pending_input_handler (connection, vortex_tls_pending_input);
+	} /* end if */
+
+	if (tls_ctx->write_coalescing > 0) {
+		/* never build records bigger than the max plain text
+		 * length allowed */
+		max_size = tls_ctx->write_coalescing;
+		if (max_size > SSL3_RT_MAX_PLAIN_LENGTH)
+			max_size = SSL3_RT_MAX_PLAIN_LENGTH;
+		vortex_connection_set_write_coalescing (connection, max_size);
+	} /* end if */
+
+	return;
+}
+
+/** 
+ * @internal Adds a reference to the provided SSL_CTX so it can be
+ * shared by several connections (each one releases its reference
+ * through SSL_CTX_free).
+ */
+void __vortex_tls_ctx_ref (SSL_CTX * ssl_ctx)
+{
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+	SSL_CTX_up_ref (ssl_ctx);
+#else
+	CRYPTO_add (&ssl_ctx->references, 1, CRYPTO_LOCK_SSL_CTX);
+#endif
+	return;
+}
+
+/** 
+ * @internal Returns the tls context associated to the connection
+ * that owns the provided SSL object (installed through SSL_set_app_data).
+ */
+VortexTlsCtx * __vortex_tls_ctx_from_ssl (SSL * ssl)
+{
+	VortexConnection * connection = SSL_get_app_data (ssl);
+
+	if (connection == NULL)
+		return NULL;
+	return vortex_ctx_get_data (vortex_connection_get_ctx (connection), TLS_CTX);
+}
+
+/** 
+ * @internal Builds the key used to index client side sessions:
+ * host:port:serverName.
+ */
+char * __vortex_tls_session_key (VortexConnection * connection)
+{
+	const char * server_name = vortex_connection_get_server_name (connection);
+
+	return axl_strdup_printf ("%s:%s:%s",
+				  vortex_connection_get_host (connection),
+				  vortex_connection_get_port (connection),
+				  server_name ? server_name : "");
+}
+
+/** 
+ * @internal Builds the key used to index server side shared SSL_CTX
+ * objects: method, certificate and private key.
+ */
+char * __vortex_tls_server_shared_key (VortexConnection * connection)
+{
+	const char * method = vortex_connection_get_data (connection, "tls:method");
+
+	return axl_strdup_printf ("server:%s:%s:%s",
+				  method ? method : "default",
+				  (const char *) vortex_connection_get_data (connection, "tls:certificate-file"),
+				  (const char *) vortex_connection_get_data (connection, "tls:private-file"));
+}
+
+/** 
+ * @internal Finds a shared SSL_CTX registered under the provided
+ * key. If found, a new reference is returned to the caller.
+ */
+SSL_CTX * __vortex_tls_shared_ctx_get (VortexTlsCtx * tls_ctx, const char * key)
+{
+	SSL_CTX * ssl_ctx;
+
+	vortex_mutex_lock (&tls_ctx->session_mutex);
+	ssl_ctx = axl_hash_get (tls_ctx->shared_ctxs, (axlPointer) key);
+	if (ssl_ctx)
+		__vortex_tls_ctx_ref (ssl_ctx);
+	vortex_mutex_unlock (&tls_ctx->session_mutex);
+
+	return ssl_ctx;
+}
+
+/** 
+ * @internal Registers the provided SSL_CTX to be shared by next
+ * connections (the hash holds its own reference).
+ */
+void __vortex_tls_shared_ctx_register (VortexTlsCtx * tls_ctx, const char * key, SSL_CTX * ssl_ctx)
+{
+	__vortex_tls_ctx_ref (ssl_ctx);
+
+	vortex_mutex_lock (&tls_ctx->session_mutex);
+	axl_hash_remove (tls_ctx->shared_ctxs, (axlPointer) key);
+	axl_hash_insert_full (tls_ctx->shared_ctxs, 
+			      axl_strdup (key), axl_free, 
+			      ssl_ctx, (axlDestroyFunc) SSL_CTX_free);
+	vortex_mutex_unlock (&tls_ctx->session_mutex);
+	return;
+}
+
+/** 
+ * @internal Called by OpenSSL at the client side every time a new
+ * session is established (including TLSv1.3 tickets received after
+ * the handshake) to store it for later resumption.
+ */
+int __vortex_tls_client_new_session (SSL * ssl, SSL_SESSION * session)
+{
+	VortexConnection * connection = SSL_get_app_data (ssl);
+	VortexTlsCtx     * tls_ctx    = __vortex_tls_ctx_from_ssl (ssl);
+	char             * key;
+
+	if (tls_ctx == NULL || ! tls_ctx->session_resumption)
+		return 0;
+
+	key = __vortex_tls_session_key (connection);
+
+	/* store session (we take the reference received) */
+	vortex_mutex_lock (&tls_ctx->session_mutex);
+	axl_hash_remove (tls_ctx->client_sessions, key);
+	axl_hash_insert_full (tls_ctx->client_sessions, 
+			      key, axl_free, 
+			      session, (axlDestroyFunc) SSL_SESSION_free);
+	vortex_mutex_unlock (&tls_ctx->session_mutex);
+
+	return 1;
+}
+
+/** 
+ * @internal Configures a client side SSL_CTX created by the library
+ * to notify new sessions so they can be resumed later.
+ */
+void __vortex_tls_client_prepare_ctx (SSL_CTX * ssl_ctx)
+{
+	SSL_CTX_set_session_cache_mode (ssl_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+	SSL_CTX_sess_set_new_cb (ssl_ctx, __vortex_tls_client_new_session);
+	return;
+}
+
+/** 
+ * @internal Configures the SSL object to resume a previous session
+ * stored for the same host:port:serverName (if any).
+ */
+void __vortex_tls_client_set_session (VortexTlsCtx * tls_ctx, VortexConnection * connection, SSL * ssl)
+{
+	SSL_SESSION * session;
+	char        * key;
+
+	key = __vortex_tls_session_key (connection);
+
+	vortex_mutex_lock (&tls_ctx->session_mutex);
+	session = axl_hash_get (tls_ctx->client_sessions, key);
+	if (session != NULL) {
+		/* SSL_set_session acquires its own reference */
+		SSL_set_session (ssl, session);
+	} /* end if */
+	vortex_mutex_unlock (&tls_ctx->session_mutex);
+
+	axl_free (key);
+	return;
+}
+
+/** 
+ * @internal Rotates session ticket keys when the current one has
+ * expired, keeping the previous one to accept (and renew) tickets
+ * still in use. Must be called with session_mutex locked.
+ */
+axl_bool __vortex_tls_ticket_key_rotate (VortexTlsCtx * tls_ctx, long now)
+{
+	VortexTlsTicketKey * key = &tls_ctx->ticket_keys[0];
+
+	if (key->created != 0 && (now - key->created) < tls_ctx->ticket_key_lifetime)
+		return axl_true;
+
+	/* move current key to previous slot and generate a new one */
+	memcpy (&tls_ctx->ticket_keys[1], key, sizeof (VortexTlsTicketKey));
+	if (RAND_bytes (key->name, sizeof (key->name)) != 1 ||
+	    RAND_bytes (key->hmac_key, sizeof (key->hmac_key)) != 1 ||
+	    RAND_bytes (key->aes_key, sizeof (key->aes_key)) != 1) {
+		/* restore previous key */
+		memcpy (key, &tls_ctx->ticket_keys[1], sizeof (VortexTlsTicketKey));
+		return axl_false;
+	} /* end if */
+	key->created = now;
+
+	return axl_true;
+}
+
+/** 
+ * @internal Session ticket key handler installed on server side
+ * SSL_CTX objects. Encrypts new tickets with the current key and
+ * decrypts tickets protected by the current or previous key
+ * (requesting ticket renewal in the latter case).
+ */
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int __vortex_tls_ticket_key_cb (SSL * ssl, unsigned char * key_name, unsigned char * iv, 
+				EVP_CIPHER_CTX * cipher_ctx, EVP_MAC_CTX * hmac_ctx, int enc)
+#else
+int __vortex_tls_ticket_key_cb (SSL * ssl, unsigned char * key_name, unsigned char * iv, 
+				EVP_CIPHER_CTX * cipher_ctx, HMAC_CTX * hmac_ctx, int enc)
+#endif
+{
+	VortexTlsCtx       * tls_ctx = __vortex_tls_ctx_from_ssl (ssl);
+	VortexTlsTicketKey * key     = NULL;
+	long                 now     = (long) time (NULL);
+	int                  result  = 1;
+	int                  iterator;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	OSSL_PARAM           params[3];
+#endif
+
+	if (tls_ctx == NULL)
+		return 0;
+
+	vortex_mutex_lock (&tls_ctx->session_mutex);
+	if (enc) {
+		/* issue a new ticket with current key */
+		if (! __vortex_tls_ticket_key_rotate (tls_ctx, now) || RAND_bytes (iv, EVP_CIPHER_iv_length (EVP_aes_256_cbc ())) != 1) {
+			vortex_mutex_unlock (&tls_ctx->session_mutex);
+			return -1;
+		} /* end if */
+		key = &tls_ctx->ticket_keys[0];
+		memcpy (key_name, key->name, sizeof (key->name));
+		EVP_EncryptInit_ex (cipher_ctx, EVP_aes_256_cbc (), NULL, key->aes_key, iv);
+	} else {
+		/* find the key used to protect the ticket received,
+		 * ignoring keys rotated more than one lifetime ago */
+		for (iterator = 0; iterator < 2; iterator++) {
+			if (tls_ctx->ticket_keys[iterator].created == 0)
+				continue;
+			if ((now - tls_ctx->ticket_keys[iterator].created) >= (2 * tls_ctx->ticket_key_lifetime))
+				continue;
+			if (memcmp (key_name, tls_ctx->ticket_keys[iterator].name, 16) == 0) {
+				key = &tls_ctx->ticket_keys[iterator];
+				break;
+			} /* end if */
+		} /* end for */
+
+		if (key == NULL) {
+			/* unknown key, do a full handshake */
+			vortex_mutex_unlock (&tls_ctx->session_mutex);
+			return 0;
+		} /* end if */
+
+		/* ask to renew ticket if it was protected by previous key */
+		result = (iterator == 0) ? 1 : 2;
+		EVP_DecryptInit_ex (cipher_ctx, EVP_aes_256_cbc (), NULL, key->aes_key, iv);
+	} /* end if */
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	params[0] = OSSL_PARAM_construct_octet_string (OSSL_MAC_PARAM_KEY, key->hmac_key, sizeof (key->hmac_key));
+	params[1] = OSSL_PARAM_construct_utf8_string (OSSL_MAC_PARAM_DIGEST, "sha256", 0);
+	params[2] = OSSL_PARAM_construct_end ();
+	EVP_MAC_CTX_set_params (hmac_ctx, params);
+#else
+	HMAC_Init_ex (hmac_ctx, key->hmac_key, sizeof (key->hmac_key), EVP_sha256 (), NULL);
+#endif
+	vortex_mutex_unlock (&tls_ctx->session_mutex);
+
+	return result;
+}
+
+/** 
+ * @internal Configures a server side SSL_CTX created by the library
+ * to keep a session cache and to issue session tickets protected by
+ * rotating keys.
+ */
+void __vortex_tls_server_prepare_ctx (SSL_CTX * ssl_ctx)
+{
+	SSL_CTX_set_session_cache_mode (ssl_ctx, SSL_SESS_CACHE_SERVER);
+	SSL_CTX_sess_set_cache_size (ssl_ctx, TLS_SESSION_CACHE_SIZE);
+	SSL_CTX_set_session_id_context (ssl_ctx, (const unsigned char *) LOG_DOMAIN, strlen (LOG_DOMAIN));
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	SSL_CTX_set_tlsext_ticket_key_evp_cb (ssl_ctx, __vortex_tls_ticket_key_cb);
+#else
+	SSL_CTX_set_tlsext_ticket_key_cb (ssl_ctx, __vortex_tls_ticket_key_cb);
+#endif
+	return;
+}
+
+/** 
+ * @internal Updates resumption counters once a handshake has
+ * finished.
+ */
+void __vortex_tls_session_count (VortexTlsCtx * tls_ctx, SSL * ssl, axl_bool client_side)
+{
+	axl_bool reused = SSL_session_reused (ssl);
+
+	vortex_mutex_lock (&tls_ctx->session_mutex);
+	if (client_side) {
+		if (reused)
+			tls_ctx->client_hits++;
+		else
+			tls_ctx->client_misses++;
+	} else {
+		if (reused)
+			tls_ctx->server_hits++;
+		else
+			tls_ctx->server_misses++;
+	} /* end if */
+	vortex_mutex_unlock (&tls_ctx->session_mutex);
+	return;
+}
+
 /** 
  * @internal
  * @brief Support data structure for \ref vortex_tls_start_negotiation function.
@@ -709,6 +1331,8 @@ int      vortex_tls_invoke_tls_activation (VortexConnection * connection)
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
 	const char           * method_requested = NULL;
 #endif	
+	char                 * shared_key       = NULL;
+	axl_bool               shared           = axl_false;
 
 	/* check if the tls ctx was created */
 	tls_ctx = vortex_ctx_get_data (ctx, TLS_CTX);
@@ -734,6 +1358,17 @@ int      vortex_tls_invoke_tls_activation (VortexConnection * connection)
 	method_requested = vortex_connection_get_data (connection, "tls:method");
 #endif
 
+	/* reuse the SSL_CTX shared by previous connections when
+	 * session resumption is enabled */
+	if (ctx_creation == NULL && tls_ctx->session_resumption) {
+		shared_key = axl_strdup_printf ("client:%s", 
+						vortex_connection_get_data (connection, "tls:method") ? 
+						(const char *) vortex_connection_get_data (connection, "tls:method") : "default");
+		ssl_ctx    = __vortex_tls_shared_ctx_get (tls_ctx, shared_key);
+		shared     = (ssl_ctx != NULL);
+		method_label = "shared";
+	} /* end if */
+
 	/* check ctx_creation is not defined to provide default method
 	   based on user preference or default Flexible method. */
 	if (ctx_creation == NULL) {
@@ -822,9 +1457,17 @@ int      vortex_tls_invoke_tls_activation (VortexConnection * connection)
 	if (ssl_ctx == NULL) {
 		vortex_log (VORTEX_LEVEL_CRITICAL, "error while creating TLS context");
 		vortex_tls_log_ssl (ctx);
+		axl_free (shared_key);
 		return axl_false;
 	}
 
+	/* register the new SSL_CTX to be shared by next connections */
+	if (shared_key != NULL && ! shared) {
+		__vortex_tls_client_prepare_ctx (ssl_ctx);
+		__vortex_tls_shared_ctx_register (tls_ctx, shared_key, ssl_ctx);
+	} /* end if */
+	axl_free (shared_key);
+
 	/* create the tls transport */
 	vortex_log (VORTEX_LEVEL_DEBUG, "initializing TLS transport");
 	ssl = SSL_new (ssl_ctx);       
@@ -833,6 +1476,13 @@ int      vortex_tls_invoke_tls_activation (VortexConnection * connection)
 		return axl_false;
 	}
 
+	/* link the connection to the ssl object (used by session
+	 * callbacks) and try to resume a previous session */
+	SSL_set_app_data (ssl, connection);
+	if (tls_ctx->session_resumption && ctx_creation == NULL)
+		__vortex_tls_client_set_session (tls_ctx, connection, ssl);
+	__vortex_tls_kernel_offload_request (tls_ctx, ssl);
+
 	/* set the file descriptor */
 	vortex_log (VORTEX_LEVEL_DEBUG, "setting file descriptor");
 	SSL_set_fd (ssl, vortex_connection_get_socket (connection));
@@ -879,6 +1529,16 @@ int      vortex_tls_invoke_tls_activation (VortexConnection * connection)
 	}
 	vortex_log (VORTEX_LEVEL_DEBUG, "seems SSL connect call have finished in a proper manner");
 
+	/* update resumption counters */
+	if (tls_ctx->session_resumption)
+		__vortex_tls_session_count (tls_ctx, ssl, axl_true);
+
+	/* move send direction to kernel TLS if available */
+	__vortex_tls_kernel_offload_enable (tls_ctx, connection, ssl);
+
+	/* configure read ahead and write coalescing */
+	__vortex_tls_bulk_configure (tls_ctx, connection, ssl);
+
 	/* check remote certificate (if it is present) */
 	server_cert = SSL_get_peer_certificate (ssl);
 	if (server_cert == NULL) {
@@ -1633,6 +2293,16 @@ void vortex_tls_initial_accept (VortexConnection * connection)
 	}else {
 		/* TLS-fication done */
 		status = axl_true;
+
+		/* update resumption counters */
+		if (tls_ctx->session_resumption)
+			__vortex_tls_session_count (tls_ctx, ssl, axl_false);
+
+		/* move send direction to kernel TLS if available */
+		__vortex_tls_kernel_offload_enable (tls_ctx, connection, ssl);
+
+		/* configure read ahead and write coalescing */
+		__vortex_tls_bulk_configure (tls_ctx, connection, ssl);
 	}
 	vortex_log (VORTEX_LEVEL_DEBUG, "TLS-fication status was (ssl_error=%d): %s", ssl_error, status ? "OK" : "*** FAIL ***");
 
@@ -1709,6 +2379,8 @@ void vortex_tls_prepare_listener (VortexConnection * connection)
 	BIO                  * bufio;
 	X509                 * x509;
 	EVP_PKEY             * pkey;
+	char                 * shared_key;
+	axl_bool               shared           = axl_false;
 
 	/* check if the tls ctx was created */
 	tls_ctx = vortex_ctx_get_data (ctx, TLS_CTX);
@@ -1734,7 +2406,19 @@ void vortex_tls_prepare_listener (VortexConnection * connection)
 	method_requested = vortex_connection_get_data (connection, "tls:method");
 #endif	
 
-	if (ctx_creation == NULL) {
+	/* reuse the SSL_CTX (already configured with certificate and
+	 * private key) shared by previous connections when session
+	 * resumption is enabled */
+	if (ctx_creation == NULL && tls_ctx->session_resumption) {
+		shared_key = __vortex_tls_server_shared_key (connection);
+		ssl_ctx    = __vortex_tls_shared_ctx_get (tls_ctx, shared_key);
+		shared     = (ssl_ctx != NULL);
+		axl_free (shared_key);
+		if (shared)
+			vortex_log (VORTEX_LEVEL_DEBUG, "reusing shared ssl context %p for listener", ssl_ctx);
+	} /* end if */
+
+	if (ctx_creation == NULL && ! shared) {
 
 	        /* First, select especific versions only if user requested
 		 * them. Otherwise, try first flexible method available
@@ -1828,9 +2512,10 @@ void vortex_tls_prepare_listener (VortexConnection * connection)
 	} /* end if */
 	
 
-	/* if the context creation is provided, do not perform the
-	 * following tasks */
-	if (ctx_creation == NULL) {
+	/* if the context creation is provided (or the context is
+	 * shared and already configured), do not perform the following
+	 * tasks */
+	if (ctx_creation == NULL && ! shared) {
 
 		/* configure certificate file */
 		certificate_file = vortex_connection_get_data (connection, "tls:certificate-file");
@@ -1908,6 +2593,15 @@ void vortex_tls_prepare_listener (VortexConnection * connection)
 			return;
 		} /* end if */
 
+		/* register the new SSL_CTX to be shared by next
+		 * connections, enabling session cache and tickets */
+		if (tls_ctx->session_resumption) {
+			__vortex_tls_server_prepare_ctx (ssl_ctx);
+			shared_key = __vortex_tls_server_shared_key (connection);
+			__vortex_tls_shared_ctx_register (tls_ctx, shared_key, ssl_ctx);
+			axl_free (shared_key);
+		} /* end if */
+
 	} /* end if */
 		
 	/* create ssl object */
@@ -1928,6 +2622,11 @@ void vortex_tls_prepare_listener (VortexConnection * connection)
 	/* prepare the new connection */
 	new_connection = vortex_connection_new_empty_from_connection (ctx, socket, connection, VortexRoleListener);
 
+	/* link the connection to the ssl object (used by session
+	 * callbacks) */
+	SSL_set_app_data (ssl, new_connection);
+	__vortex_tls_kernel_offload_request (tls_ctx, ssl);
+
 	/* release previous objet */
 	__vortex_connection_set_not_connected (connection, 
 					       "connection instance being closed, without closing session, due to TLS negotiation",
@@ -2935,4 +3634,237 @@ void                vortex_tls_set_auto_tls       (VortexCtx  * ctx,
 	return;
 }
 
+/** 
+ * @brief Enables or disables TLS session resumption for all
+ * connections created (client side) or accepted (listener side)
+ * inside the provided context.
+ *
+ * Once enabled, the SSL_CTX created by the library is shared by all
+ * connections using the same method (and, at the listener side, the
+ * same certificate and private key) instead of creating one per
+ * connection. Then:
+ *
+ * - Client side: sessions established are cached (indexed by
+ * host:port:serverName) and offered again on next TLS negotiation
+ * to the same peer, avoiding a full handshake.
+ *
+ * - Listener side: a session cache is enabled and session tickets
+ * are issued protected by keys that are rotated every
+ * <b>ticket_key_lifetime</b> seconds. Tickets protected by the
+ * previous key are still accepted (and renewed).
+ *
+ * Connections using a SSL_CTX created by the application (see \ref
+ * vortex_tls_set_ctx_creation and \ref
+ * vortex_tls_set_default_ctx_creation) are not affected.
+ *
+ * Use \ref vortex_tls_get_session_stats to check how many
+ * handshakes were resumed.
+ *
+ * @param ctx The context where the operation will be performed.
+ *
+ * @param enabled axl_true to enable session resumption, axl_false to
+ * disable it (releasing all cached sessions and shared contexts).
+ *
+ * @param ticket_key_lifetime Amount of seconds a ticket key is used
+ * before being rotated. Use 0 or a negative value to use the default
+ * value (3600).
+ */
+void                vortex_tls_set_session_resumption (VortexCtx  * ctx,
+						       axl_bool     enabled,
+						       int          ticket_key_lifetime)
+{
+	VortexTlsCtx * tls_ctx;
+
+	v_return_if_fail (ctx);
+
+	/* get a reference to the TLS context */
+	tls_ctx = vortex_ctx_get_data (ctx, TLS_CTX);
+	if (tls_ctx == NULL)
+		return;
+
+	vortex_mutex_lock (&tls_ctx->session_mutex);
+	tls_ctx->session_resumption  = enabled;
+	tls_ctx->ticket_key_lifetime = (ticket_key_lifetime > 0) ? ticket_key_lifetime : TLS_TICKET_KEY_LIFETIME;
+
+	if (! enabled) {
+		/* release shared contexts and cached sessions */
+		axl_hash_free (tls_ctx->shared_ctxs);
+		axl_hash_free (tls_ctx->client_sessions);
+		tls_ctx->shared_ctxs     = axl_hash_new (axl_hash_string, axl_hash_equal_string);
+		tls_ctx->client_sessions = axl_hash_new (axl_hash_string, axl_hash_equal_string);
+	} /* end if */
+	vortex_mutex_unlock (&tls_ctx->session_mutex);
+	
+	return;
+}
+
+/** 
+ * @brief Allows to get TLS session resumption counters (see \ref
+ * vortex_tls_set_session_resumption).
+ *
+ * A hit is a handshake where a previous session was resumed, a miss
+ * is a full handshake. Counters are only updated while session
+ * resumption is enabled. Any of the output parameters can be NULL.
+ *
+ * @param ctx The context where the operation will be performed.
+ * @param client_hits Resumed handshakes as client.
+ * @param client_misses Full handshakes as client.
+ * @param server_hits Resumed handshakes as listener.
+ * @param server_misses Full handshakes as listener.
+ */
+void                vortex_tls_get_session_stats  (VortexCtx  * ctx,
+						   int        * client_hits,
+						   int        * client_misses,
+						   int        * server_hits,
+						   int        * server_misses)
+{
+	VortexTlsCtx * tls_ctx;
+
+	v_return_if_fail (ctx);
+
+	/* get a reference to the TLS context */
+	tls_ctx = vortex_ctx_get_data (ctx, TLS_CTX);
+	if (tls_ctx == NULL)
+		return;
+
+	vortex_mutex_lock (&tls_ctx->session_mutex);
+	if (client_hits)
+		(*client_hits)   = tls_ctx->client_hits;
+	if (client_misses)
+		(*client_misses) = tls_ctx->client_misses;
+	if (server_hits)
+		(*server_hits)   = tls_ctx->server_hits;
+	if (server_misses)
+		(*server_misses) = tls_ctx->server_misses;
+	vortex_mutex_unlock (&tls_ctx->session_mutex);
+
+	return;
+}
+
+/** 
+ * @brief Enables or disables kernel TLS offload (kTLS) for
+ * connections negotiating TLS inside the provided context.
+ *
+ * By default, both directions of a TLS connection go through the same
+ * SSL object, which is protected by a lock, so the vortex reader and
+ * the vortex sequencer serialize on every read and write (a large
+ * write delays reads). When kernel offload is enabled and available
+ * (OpenSSL compiled with kTLS support, Linux kernel with the tls
+ * module loaded and a supported cipher negotiated), once the
+ * handshake finishes the kernel does record encryption for the send
+ * direction and the sequencer writes plain content to the socket.
+ * The lock is then only held during the send system call (instead
+ * of during the whole encryption), so large writes no longer delay
+ * reads. The lock is kept because SSL_read may write on the socket
+ * too (alerts, close_notify and TLSv1.3 KeyUpdate responses, which
+ * also replace the kernel send keys).
+ *
+ * If kernel offload is not available for a connection, the default
+ * locked transport is used. It only affects connections negotiated
+ * after this call.
+ *
+ * @param ctx The context where the operation will be performed.
+ *
+ * @param enabled axl_true to request kernel TLS offload, otherwise axl_false.
+ */
+void                vortex_tls_set_kernel_offload (VortexCtx  * ctx,
+						   axl_bool     enabled)
+{
+	VortexTlsCtx * tls_ctx;
+
+	v_return_if_fail (ctx);
+
+	/* get a reference to the TLS context */
+	tls_ctx = vortex_ctx_get_data (ctx, TLS_CTX);
+	if (tls_ctx == NULL)
+		return;
+
+	tls_ctx->kernel_offload = enabled;
+	return;
+}
+
+/** 
+ * @brief Allows to check if the send direction of the provided TLS
+ * connection is handled by the kernel (see \ref
+ * vortex_tls_set_kernel_offload).
+ *
+ * @param connection The connection to check.
+ *
+ * @return axl_true if kernel TLS offload is in use, otherwise axl_false.
+ */
+axl_bool            vortex_tls_is_kernel_offloaded (VortexConnection * connection)
+{
+	if (connection == NULL)
+		return axl_false;
+	return PTR_TO_INT (vortex_connection_get_data (connection, "ssl-data:ktls-send"));
+}
+
+/** 
+ * @brief Enables or disables TLS read ahead for connections
+ * negotiating TLS inside the provided context.
+ *
+ * When enabled, OpenSSL reads from the socket as much content as
+ * available (instead of one record at a time) and the TLS receive
+ * handler keeps a buffered receive layer so the small reads done by
+ * the vortex reader (for example, while reading frame headers) are
+ * served from memory without calling SSL_read. This reduces the
+ * amount of system calls and record bookkeeping for bulk transfers.
+ *
+ * It only affects connections negotiated after this call.
+ *
+ * @param ctx The context where the operation will be performed.
+ *
+ * @param enabled axl_true to enable read ahead, otherwise axl_false.
+ */
+void                vortex_tls_set_read_ahead     (VortexCtx  * ctx,
+						   axl_bool     enabled)
+{
+	VortexTlsCtx * tls_ctx;
+
+	v_return_if_fail (ctx);
+
+	/* get a reference to the TLS context */
+	tls_ctx = vortex_ctx_get_data (ctx, TLS_CTX);
+	if (tls_ctx == NULL)
+		return;
+
+	tls_ctx->read_ahead = enabled;
+	return;
+}
+
+/** 
+ * @brief Enables write coalescing for connections negotiating TLS
+ * inside the provided context.
+ *
+ * By default, each frame built by the vortex sequencer is written
+ * with its own SSL_write call, producing a TLS record (with its own
+ * header and MAC) per frame. Once enabled, frames queued for the same
+ * connection are coalesced and written with a single SSL_write (see
+ * \ref vortex_connection_set_write_coalescing) up to max_record_size
+ * bytes.
+ *
+ * It only affects connections negotiated after this call.
+ *
+ * @param ctx The context where the operation will be performed.
+ *
+ * @param max_record_size Max amount of bytes to write on each
+ * SSL_write (limited to 16384, the max TLS record plain text
+ * size). Use 0 to disable write coalescing.
+ */
+void                vortex_tls_set_write_coalescing (VortexCtx  * ctx,
+						     int          max_record_size)
+{
+	VortexTlsCtx * tls_ctx;
+
+	v_return_if_fail (ctx);
+
+	/* get a reference to the TLS context */
+	tls_ctx = vortex_ctx_get_data (ctx, TLS_CTX);
+	if (tls_ctx == NULL)
+		return;
+
+	tls_ctx->write_coalescing = (max_record_size > 0) ? max_record_size : 0;
+	return;
+}
+
 /* @} */
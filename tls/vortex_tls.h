@@ -396,6 +396,27 @@ void               vortex_tls_set_auto_tls               (VortexCtx         * ct
 							  axl_bool            allow_tls_failures,
 							  const char        * serverName);
 
+void               vortex_tls_set_session_resumption     (VortexCtx         * ctx,
+							  axl_bool            enabled,
+							  int                 ticket_key_lifetime);
+
+void               vortex_tls_get_session_stats          (VortexCtx         * ctx,
+							  int               * client_hits,
+							  int               * client_misses,
+							  int               * server_hits,
+							  int               * server_misses);
+
+void               vortex_tls_set_kernel_offload         (VortexCtx         * ctx,
+							  axl_bool            enabled);
+
+axl_bool           vortex_tls_is_kernel_offloaded        (VortexConnection  * connection);
+
+void               vortex_tls_set_read_ahead             (VortexCtx         * ctx,
+							  axl_bool            enabled);
+
+void               vortex_tls_set_write_coalescing       (VortexCtx         * ctx,
+							  int                 max_record_size);
+
 axl_bool           vortex_tls_accept_negotiation         (VortexCtx         * ctx, 
 							  VortexTlsAcceptQuery            accept_handler, 
 							  VortexTlsCertificateFileLocator certificate_handler,
@@ -47,6 +47,37 @@
 #define VORTEX_TUNNEL_ACCEPT_DATA        "vo:tu:ac:da"
 #define VORTEX_TUNNEL_RESOLVER           "vo:tu:re"
 #define VORTEX_TUNNEL_RESOLVER_DATA      "vo:tu:re:da"
+#define VORTEX_TUNNEL_SPLICE             "vo:tu:sp"
+
+#if defined(ENABLE_TUNNEL_SPLICE)
+#include <fcntl.h>
+#include <vortex_connection_private.h>
+
+/* max amount of bytes moved on each splice operation */
+#define VORTEX_TUNNEL_SPLICE_SIZE        65536
+
+/* period (microseconds) used to check if a partner that was not
+ * accepting more content is writable again */
+#define VORTEX_TUNNEL_SPLICE_PERIOD      2000
+
+/** 
+ * @internal Zero copy forwarding state for one direction of a tunnel
+ * pair (from the connection that owns it to its partner). Content
+ * read from the connection socket is moved into a pipe and from the
+ * pipe into the partner socket without being copied to user space.
+ */
+typedef struct _VortexTunnelSplice {
+	/* pipe used to move content between sockets */
+	int           pipe[2];
+	/* bytes available in the pipe not written yet into the
+	 * partner */
+	int           pending;
+	/* axl_true while an event is waiting for the partner to
+	 * accept more content */
+	axl_bool      waiting;
+	VortexMutex   mutex;
+} VortexTunnelSplice;
+#endif
 
 
 /**
@@ -806,6 +837,250 @@ void __vortex_tunnel_pass_octets (VortexConnection * connection)
 	return;
 }
 
+#if defined(ENABLE_TUNNEL_SPLICE)
+/** 
+ * @internal Releases the splice state associated to a connection.
+ */
+void __vortex_tunnel_splice_free (axlPointer _state)
+{
+	VortexTunnelSplice * state  = _state;
+
+	close (state->pipe[0]);
+	close (state->pipe[1]);
+	vortex_mutex_destroy (&state->mutex);
+	axl_free (state);
+	return;
+}
+
+/** 
+ * @internal Moves content pending in the splice pipe into the partner
+ * socket without blocking. 
+ *
+ * @return axl_false if the partner connection failed, otherwise
+ * axl_true is returned (even if some content is still pending).
+ */
+axl_bool __vortex_tunnel_splice_drain (VortexTunnelSplice * state, VortexConnection * partner)
+{
+	ssize_t written;
+
+	while (state->pending > 0) {
+		written = splice (state->pipe[0], NULL, vortex_connection_get_socket (partner), NULL, 
+				  state->pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		if (written < 0) {
+			if (errno == VORTEX_EAGAIN || errno == VORTEX_EWOULDBLOCK || errno == EINTR)
+				return axl_true;
+			return axl_false;
+		} /* end if */
+		if (written == 0)
+			return axl_false;
+
+		state->pending -= written;
+	} /* end while */
+
+	return axl_true;
+}
+
+/** 
+ * @internal Event used to move pending content into a partner that
+ * was not accepting more data. On each period, the pipe is drained
+ * without blocking (no thread pool worker is kept waiting for slow
+ * peers) and once it is empty, the source connection is watched
+ * again by the vortex reader. The event owns a reference to both
+ * connections.
+ */
+axl_bool __vortex_tunnel_splice_resume (VortexCtx * ctx, axlPointer _connection, axlPointer _partner)
+{
+	VortexConnection   * connection = _connection;
+	VortexConnection   * partner    = _partner;
+	VortexTunnelSplice * state      = vortex_connection_get_data (connection, VORTEX_TUNNEL_SPLICE);
+
+	if (vortex_connection_is_ok (connection, axl_false) && vortex_connection_is_ok (partner, axl_false)) {
+		/* move pending content if the partner accepts it */
+		vortex_mutex_lock (&state->mutex);
+		if (! __vortex_tunnel_splice_drain (state, partner)) {
+			vortex_mutex_unlock (&state->mutex);
+			vortex_log (VORTEX_LEVEL_CRITICAL, "failed to write data, seems connection is broken");
+			vortex_connection_shutdown (connection);
+			vortex_connection_shutdown (partner);
+		} else if (state->pending > 0) {
+			/* partner still not writable, check later */
+			vortex_mutex_unlock (&state->mutex);
+			return axl_false;
+		} else
+			vortex_mutex_unlock (&state->mutex);
+	} /* end if */
+
+	/* pipe drained (or pair closed), make the reader to watch the
+	 * connection again (we are not running inside the vortex
+	 * reader) */
+	vortex_mutex_lock (&state->mutex);
+	state->waiting = axl_false;
+	vortex_mutex_unlock (&state->mutex);
+
+	vortex_connection_block (connection, axl_false);
+	vortex_connection_unref (partner, "tunnel-splice-resume");
+	vortex_connection_unref (connection, "tunnel-splice-resume");
+	return axl_true; /* remove event */
+}
+
+/** 
+ * @internal Zero copy version of \ref __vortex_tunnel_pass_octets,
+ * used for tunnel pairs where both connections are plain TCP
+ * connections. Content is moved from the connection socket into its
+ * partner socket through a pipe with splice(2).
+ *
+ * In the case the partner is not accepting more content, the
+ * connection is blocked (so the vortex reader stops watching it)
+ * until the content pending is written.
+ * 
+ * @param connection The connection that was notified to have data to
+ * be read.
+ */
+void __vortex_tunnel_splice_octets (VortexConnection * connection)
+{
+	VortexConnection   * partner = vortex_connection_get_data (connection, VORTEX_TUNNEL_PARTNER_CONNECTION);
+	VortexTunnelSplice * state   = vortex_connection_get_data (connection, VORTEX_TUNNEL_SPLICE);
+	VortexCtx          * ctx     = vortex_connection_get_ctx (connection);
+	ssize_t              read;
+
+	vortex_mutex_lock (&state->mutex);
+
+	/* content still pending from a previous round: do not read
+	 * more until the partner accepts it */
+	if (state->pending > 0 || state->waiting) {
+		vortex_mutex_unlock (&state->mutex);
+		return;
+	} /* end if */
+
+	/* move content from the connection into the pipe */
+	read = splice (vortex_connection_get_socket (connection), NULL, state->pipe[1], NULL,
+		       VORTEX_TUNNEL_SPLICE_SIZE, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (read < 0 && (errno == VORTEX_EAGAIN || errno == VORTEX_EWOULDBLOCK || errno == EINTR)) {
+		vortex_mutex_unlock (&state->mutex);
+		return;
+	} /* end if */
+
+	if (read <= 0) {
+		vortex_mutex_unlock (&state->mutex);
+		vortex_log (VORTEX_LEVEL_DEBUG, "TUNNEL, nothing read from the connection(%s:%s) close connection", 
+			    vortex_connection_get_host (connection),
+			    vortex_connection_get_port (connection));
+		
+		/* close connections */
+		vortex_connection_shutdown (connection);
+		vortex_connection_shutdown (partner);
+		return;
+	} /* end if */
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "TUNNEL, splicing octects (%s:%s --> %s:%s): %d", 
+		    vortex_connection_get_host (connection),
+		    vortex_connection_get_port (connection),
+		    vortex_connection_get_host (partner),
+		    vortex_connection_get_port (partner),
+		    (int) read);
+
+	/* move content from the pipe into the partner */
+	state->pending += read;
+	if (! __vortex_tunnel_splice_drain (state, partner)) {
+		vortex_mutex_unlock (&state->mutex);
+		vortex_log (VORTEX_LEVEL_CRITICAL, "failed to write data, seems connection is broken");
+		vortex_connection_shutdown (connection);
+		vortex_connection_shutdown (partner);
+		return;
+	} /* end if */
+
+	if (state->pending > 0) {
+		/* partner is not accepting more content: stop
+		 * watching this connection (we are inside the vortex
+		 * reader, so it can't be restarted) and resume once
+		 * the partner is writable again */
+		if (! vortex_connection_ref (partner, "tunnel-splice-resume")) {
+			vortex_mutex_unlock (&state->mutex);
+			vortex_connection_shutdown (connection);
+			return;
+		} /* end if */
+		vortex_connection_ref (connection, "tunnel-splice-resume");
+		__vortex_connection_set_blocked (connection, axl_true);
+		state->waiting = axl_true;
+		vortex_thread_pool_new_event (ctx, VORTEX_TUNNEL_SPLICE_PERIOD, __vortex_tunnel_splice_resume, connection, partner);
+	} /* end if */
+
+	vortex_mutex_unlock (&state->mutex);
+	return;
+}
+
+/** 
+ * @internal Creates the splice state for the provided connection
+ * (content read from it is moved into its partner).
+ */
+axl_bool __vortex_tunnel_splice_prepare (VortexConnection * connection)
+{
+	VortexTunnelSplice * state;
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+	VortexCtx          * ctx = vortex_connection_get_ctx (connection);
+#endif
+
+	state           = axl_new (VortexTunnelSplice, 1);
+	if (pipe (state->pipe) != 0) {
+		vortex_log (VORTEX_LEVEL_WARNING, "unable to create pipe for TUNNEL splice (errno=%d), using buffered copy", errno);
+		axl_free (state);
+		return axl_false;
+	} /* end if */
+
+	/* pipe operations never block */
+	fcntl (state->pipe[0], F_SETFL, O_NONBLOCK);
+	fcntl (state->pipe[1], F_SETFL, O_NONBLOCK);
+	vortex_mutex_create (&state->mutex);
+
+	vortex_connection_set_data_full (connection, VORTEX_TUNNEL_SPLICE, state, NULL, __vortex_tunnel_splice_free);
+	return axl_true;
+}
+#endif
+
+/** 
+ * @internal Installs the forwarding engine on both connections of a
+ * tunnel pair. If both connections are plain TCP connections (no
+ * transport handler like TLS or WebSocket installed), and the system
+ * supports it, the zero copy engine based on splice(2) is used.
+ * Otherwise, content is forwarded by using a user space buffer.
+ */
+void __vortex_tunnel_install_forwarding (VortexConnection * connection, VortexConnection * partner)
+{
+	char             * buffer;
+#if defined(ENABLE_TUNNEL_SPLICE) && defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+	VortexCtx        * ctx = vortex_connection_get_ctx (connection);
+#endif
+
+#if defined(ENABLE_TUNNEL_SPLICE)
+	if (vortex_connection_has_default_io_handler (connection) &&
+	    vortex_connection_has_default_io_handler (partner) &&
+	    __vortex_tunnel_splice_prepare (connection)) {
+		if (__vortex_tunnel_splice_prepare (partner)) {
+			vortex_log (VORTEX_LEVEL_DEBUG, "using zero copy (splice) forwarding for TUNNEL pair id=%d <-> id=%d",
+				    vortex_connection_get_id (connection), vortex_connection_get_id (partner));
+			vortex_connection_set_preread_handler (connection, __vortex_tunnel_splice_octets);
+			vortex_connection_set_preread_handler (partner,    __vortex_tunnel_splice_octets);
+			return;
+		} /* end if */
+
+		/* remove splice state created */
+		vortex_connection_set_data (connection, VORTEX_TUNNEL_SPLICE, NULL);
+	} /* end if */
+#endif
+
+	/* allocate buffers */
+	buffer = axl_new (char, VORTEX_MAX_BUFFER_SIZE);
+	vortex_connection_set_data_full (connection, VORTEX_TUNNEL_BUFFER, buffer, NULL, axl_free);
+
+	buffer = axl_new (char, VORTEX_MAX_BUFFER_SIZE);
+	vortex_connection_set_data_full (partner,    VORTEX_TUNNEL_BUFFER, buffer, NULL, axl_free);
+		
+	/* configure the pre read handlers */
+	vortex_connection_set_preread_handler (connection, __vortex_tunnel_pass_octets);
+	vortex_connection_set_preread_handler (partner,    __vortex_tunnel_pass_octets);
+	return;
+}
+
 /** 
  * @internal Implementation for the start tunnel request on the
  * connection provided.
@@ -825,7 +1100,6 @@ axl_bool  __vortex_tunnel_start_request (const char       * profile,
 	axlError               * error;
 	VortexConnection       * new_connection;
 	VortexTunnelSettings   * settings = NULL;
-	char                   * buffer;
 	axl_bool                 result;
 	VortexCtx              * ctx;
 	
@@ -988,16 +1262,9 @@ axl_bool  __vortex_tunnel_start_request (const char       * profile,
 		vortex_connection_set_data (connection,     VORTEX_TUNNEL_PARTNER_CONNECTION, new_connection);
 		vortex_connection_set_data (new_connection, VORTEX_TUNNEL_PARTNER_CONNECTION, connection);
 		
-		/* allocate buffers */
-		buffer = axl_new (char, VORTEX_MAX_BUFFER_SIZE);
-		vortex_connection_set_data_full (connection,     VORTEX_TUNNEL_BUFFER, buffer, NULL, axl_free);
-
-		buffer = axl_new (char, VORTEX_MAX_BUFFER_SIZE);
-		vortex_connection_set_data_full (new_connection, VORTEX_TUNNEL_BUFFER, buffer, NULL, axl_free);
-		
-		/* configure the pre read handlers */
-		vortex_connection_set_preread_handler (connection,     __vortex_tunnel_pass_octets);
-		vortex_connection_set_preread_handler (new_connection, __vortex_tunnel_pass_octets);
+		/* install forwarding engine (zero copy if both
+		 * connections allows it, otherwise buffered) */
+		__vortex_tunnel_install_forwarding (connection, new_connection);
 
 		/* Make the vortex reader to have the only one
 		 * reference to this connection.  */
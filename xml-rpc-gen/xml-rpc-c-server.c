@@ -103,109 +103,278 @@ void xml_rpc_write_c_server_include_services (axlDoc * doc,
 	return;
 }
 
-/* write service dispatch */
-void __xml_rpc_c_server_service_dispach (axlNode * service)
+/**
+ * @internal
+ *
+ * Hash used to locate services by method name and number of
+ * parameters. The same function is written into the generated
+ * service_dispatch.c file (see
+ * __xml_rpc_c_server_write_dispatch_support), so both must be kept in
+ * sync.
+ */
+unsigned int __xml_rpc_c_server_dispatch_hash (const char * method_name, int param_num)
 {
-	const char * service_name;
+	unsigned int hash = 2166136261u;
 
-	/* alternative method name support */
-	axlNode * aux2;
-	const char * method_name;
-	axlDoc  * doc = axl_node_get_doc (service);
-	
-	axlNode * name;
-	axlNode * params;
-	axlNode * param;
+	while (*method_name) {
+		hash ^= (unsigned char) *method_name;
+		hash *= 16777619u;
+		method_name++;
+	} /* end while */
 
-	/* service type */
-	axlNode    * type;
-	const char * service_type;
+	hash ^= (unsigned int) param_num;
+	hash *= 16777619u;
 
-	/* check if the service was already handled */
-	if (axl_node_annotate_get_int (service, "service-handled", axl_false))
-		return;
+	return hash;
+}
 
-	/* get the service name */
-	name         = axl_node_get_child_called (service, "name");
-	service_name = axl_node_get_content_trim (name, NULL);
-	
-	/* get the params node */
-	params = axl_node_get_child_called (service, "params");
-	
-	/* check there is a method call defined (alternative
-	 * method call name) */
-	aux2 = axl_node_get_child_called (service, "method_name");
-	if (aux2 == NULL) {
-		/* write initial service dispath code */
-		xml_rpc_support_write ("if (method_call_is (method_call, \"%s\", %d, ", 
-				       service_name, axl_node_get_child_num (params));
-	} else {
-		/* we have method_name defined */
-		method_name = axl_node_get_content_trim (aux2, NULL);
-		xml_rpc_support_write ("if (method_call_is (method_call, \"%s\", %d, ", 
-				       method_name, axl_node_get_child_num (params));
-	}
-	
-	/* now write the service type especification */
-	if (axl_node_have_childs (params)) {
-		param = axl_node_get_child_nth (params, 0);
-		do {
-			/* get the type inside the param */
-			type         = axl_node_get_child_nth (param, 1);
-			service_type = axl_node_get_content_trim (type, NULL);
-
-			if (axl_cmp (service_type, "int"))
-				xml_rpc_support_sl_write ("XML_RPC_INT_VALUE, ");
-			else if (axl_cmp (service_type, "bool"))
-				xml_rpc_support_sl_write ("XML_RPC_BOOLEAN_VALUE, ");
-			else if (axl_cmp (service_type, "string"))
-				xml_rpc_support_sl_write ("XML_RPC_STRING_VALUE, ");
-			else if (axl_cmp (service_type, "base64"))
-				xml_rpc_support_sl_write ("XML_RPC_BASE64_VALUE, ");
-			else if (axl_cmp (service_type, "double"))
-				xml_rpc_support_sl_write ("XML_RPC_DOUBLE_VALUE, ");
-			else if (xml_rpc_c_stub_type_is_array (doc, service_type)) {
-				xml_rpc_support_sl_write ("XML_RPC_ARRAY_VALUE, ");
-			} else if (xml_rpc_c_stub_type_is_struct (doc, service_type)) { 
-				xml_rpc_support_sl_write ("XML_RPC_STRUCT_VALUE, ");
-			} 
-			
-			/* get the next param */
-		}while ((param = axl_node_get_next (param)) != NULL);
-	} /* if */
-	
-	/* write support ending */
-	xml_rpc_support_sl_write (" -1))\n");
-	
-	/* push again the indent */
-	xml_rpc_support_push_indent ();
-	
-	/* write service invocator */
-	xml_rpc_support_write ("return __%s_%d", service_name, axl_node_get_child_num (params));
-	
-	/* write type prefixes */
-	xml_rpc_support_write_function_type_prefix (params);
-	
-	/* write invocation termination */
-	xml_rpc_support_sl_write (" (method_call, channel);\n\n");
-	
-	/* pop the indent */
-	xml_rpc_support_pop_indent ();
+/**
+ * @internal
+ *
+ * Returns the method name used to invoke the provided service
+ * (alternative method name support).
+ */
+const char * __xml_rpc_c_server_service_method_name (axlNode * service)
+{
+	axlNode * node;
 
+	node = axl_node_get_child_called (service, "method_name");
+	if (node == NULL)
+		node = axl_node_get_child_called (service, "name");
+	return axl_node_get_content_trim (node, NULL);
+}
+
+/**
+ * @internal
+ *
+ * Returns the XmlRpcParamType value, as written in C, for the
+ * provided service parameter type or "-1" if it is not a type that is
+ * checked.
+ */
+const char * __xml_rpc_c_server_param_type (axlDoc * doc, const char * service_type)
+{
+	if (axl_cmp (service_type, "int"))
+		return "XML_RPC_INT_VALUE";
+	else if (axl_cmp (service_type, "bool"))
+		return "XML_RPC_BOOLEAN_VALUE";
+	else if (axl_cmp (service_type, "string"))
+		return "XML_RPC_STRING_VALUE";
+	else if (axl_cmp (service_type, "base64"))
+		return "XML_RPC_BASE64_VALUE";
+	else if (axl_cmp (service_type, "double"))
+		return "XML_RPC_DOUBLE_VALUE";
+	else if (xml_rpc_c_stub_type_is_array (doc, service_type))
+		return "XML_RPC_ARRAY_VALUE";
+	else if (xml_rpc_c_stub_type_is_struct (doc, service_type))
+		return "XML_RPC_STRUCT_VALUE";
+
+	/* type not checked */
+	return "-1";
+}
+
+/**
+ * @internal
+ *
+ * Writes the types, the hash function and the lookup function used by
+ * the service dispatch tables.
+ *
+ * @param max_params The max number of parameters found in a service.
+ */
+void __xml_rpc_c_server_write_dispatch_support (int max_params)
+{
+	write ("/* max number of parameters accepted by a service */\n");
+	write ("#define SERVICE_DISPATCH_MAX_PARAMS %d\n\n", max_params > 0 ? max_params : 1);
+
+	xml_rpc_support_multiple_write ("/* service handler */\n",
+					"typedef XmlRpcMethodResponse * (* ServiceDispatchHandler) (XmlRpcMethodCall * method_call, VortexChannel * channel);\n\n",
+					"/* service dispatch table entry: services are located by method\n",
+					" * name and number of parameters, and then their type signature is\n",
+					" * checked (types ends at -1 if not all types are checked) */\n",
+					"typedef struct _ServiceDispatchEntry {\n",
+					"\tconst char             * method_name;\n",
+					"\tint                      param_num;\n",
+					"\tint                      types[SERVICE_DISPATCH_MAX_PARAMS];\n",
+					"\tServiceDispatchHandler   handler;\n",
+					"\t/* next entry with the same slot or -1 */\n",
+					"\tint                      next;\n",
+					"} ServiceDispatchEntry;\n\n",
+					NULL);
+
+	xml_rpc_support_multiple_write ("/* hash used to build the dispatch tables when this file was generated */\n",
+					"static unsigned int __service_dispatch_hash (const char * method_name, int param_num)\n",
+					"{\n",
+					"\tunsigned int hash = 2166136261u;\n\n",
+					"\twhile (*method_name) {\n",
+					"\t\thash ^= (unsigned char) *method_name;\n",
+					"\t\thash *= 16777619u;\n",
+					"\t\tmethod_name++;\n",
+					"\t} /* end while */\n\n",
+					"\thash ^= (unsigned int) param_num;\n",
+					"\thash *= 16777619u;\n\n",
+					"\treturn hash;\n",
+					"}\n\n",
+					NULL);
+
+	xml_rpc_support_multiple_write ("/* locate the service and invoke it */\n",
+					"static XmlRpcMethodResponse * __service_dispatch_lookup (const ServiceDispatchEntry * entries,\n",
+					"                                                         const int                  * slots,\n",
+					"                                                         unsigned int                 slot_mask,\n",
+					"                                                         VortexChannel              * channel,\n",
+					"                                                         XmlRpcMethodCall           * method_call)\n",
+					"{\n",
+					"\tconst char                 * method_name = method_call_get_name (method_call);\n",
+					"\tint                          param_num   = method_call_get_num_params (method_call);\n",
+					"\tconst ServiceDispatchEntry * entry;\n",
+					"\tXmlRpcMethodValue          * value;\n",
+					"\tint                          index;\n",
+					"\tint                          iterator;\n\n",
+					"\tif (method_name == NULL)\n",
+					"\t\treturn NULL;\n\n",
+					"\t/* walk entries found at the slot */\n",
+					"\tindex = slots[__service_dispatch_hash (method_name, param_num) & slot_mask];\n",
+					"\twhile (index != -1) {\n",
+					"\t\tentry = &entries[index];\n",
+					"\t\tindex = entry->next;\n\n",
+					"\t\tif (entry->param_num != param_num || ! axl_cmp (entry->method_name, method_name))\n",
+					"\t\t\tcontinue;\n\n",
+					"\t\t/* check type signature */\n",
+					"\t\tfor (iterator = 0; iterator < param_num && entry->types[iterator] != -1; iterator++) {\n",
+					"\t\t\tvalue = method_call_get_param_value (method_call, iterator);\n",
+					"\t\t\tif (value == NULL || (int) method_value_get_type (value) != entry->types[iterator])\n",
+					"\t\t\t\tbreak;\n",
+					"\t\t} /* end for */\n\n",
+					"\t\tif (iterator == param_num || entry->types[iterator] == -1)\n",
+					"\t\t\treturn entry->handler (method_call, channel);\n",
+					"\t} /* end while */\n\n",
+					"\t/* method not supported or recognized */\n",
+					"\treturn NULL;\n",
+					"}\n\n",
+					NULL);
 	return;
 }
 
-/** 
+/**
  * @internal
- * 
+ *
+ * Writes the dispatch table for the provided list of services: an
+ * array of entries plus an array of slots, indexed by the service
+ * hash, pointing to the first entry with that hash (chained through
+ * next).
+ *
+ * @param services The list of services to include.
+ *
+ * @param suffix Suffix used to name the table.
+ *
+ * @return The slot mask to be used with the table.
+ */
+unsigned int __xml_rpc_c_server_write_dispatch_table (axlDoc * doc, axlList * services, const char * suffix)
+{
+	axlNode      * service;
+	axlNode      * params;
+	axlNode      * param;
+	axlNode      * type;
+	const char   * service_name;
+	int            count = axl_list_length (services);
+	int            slot_count;
+	int          * slots;
+	int          * next;
+	int            iterator;
+	int            index;
+	unsigned int   slot;
+
+	/* use at least two slots per service to keep chains short */
+	slot_count = 1;
+	while (slot_count < (count * 2))
+		slot_count = slot_count * 2;
+
+	/* place all services */
+	slots = axl_new (int, slot_count);
+	next  = axl_new (int, count);
+	for (iterator = 0; iterator < slot_count; iterator++)
+		slots[iterator] = -1;
+	for (iterator = 0; iterator < count; iterator++) {
+		service = axl_list_get_nth (services, iterator);
+		params  = axl_node_get_child_called (service, "params");
+		slot    = __xml_rpc_c_server_dispatch_hash (__xml_rpc_c_server_service_method_name (service),
+							   axl_node_get_child_num (params)) & (slot_count - 1);
+
+		/* append at the end of the chain to keep services
+		 * checked in the order they were declared */
+		next[iterator] = -1;
+		if (slots[slot] == -1) {
+			slots[slot] = iterator;
+			continue;
+		} /* end if */
+		index = slots[slot];
+		while (next[index] != -1)
+			index = next[index];
+		next[index] = iterator;
+	} /* end for */
+
+	/* write entries */
+	write ("static const ServiceDispatchEntry __service_dispatch_entries%s[] = {\n", suffix);
+	push_indent ();
+	for (iterator = 0; iterator < count; iterator++) {
+		service      = axl_list_get_nth (services, iterator);
+		service_name = axl_node_get_content_trim (axl_node_get_child_called (service, "name"), NULL);
+		params       = axl_node_get_child_called (service, "params");
+
+		write ("{\"%s\", %d, {", __xml_rpc_c_server_service_method_name (service), axl_node_get_child_num (params));
+
+		/* now write the service type especification */
+		if (axl_node_have_childs (params)) {
+			param = axl_node_get_child_nth (params, 0);
+			do {
+				/* get the type inside the param */
+				type = axl_node_get_child_nth (param, 1);
+				xml_rpc_support_sl_write ("%s%s", __xml_rpc_c_server_param_type (doc, axl_node_get_content_trim (type, NULL)),
+							  axl_node_get_next (param) != NULL ? ", " : "");
+
+				/* get the next param */
+			} while ((param = axl_node_get_next (param)) != NULL);
+		} else {
+			xml_rpc_support_sl_write ("-1");
+		} /* end if */
+
+		/* write service invocator */
+		xml_rpc_support_sl_write ("}, __%s_%d", service_name, axl_node_get_child_num (params));
+
+		/* write type prefixes */
+		xml_rpc_support_write_function_type_prefix (params);
+
+		xml_rpc_support_sl_write (", %d}%s\n", next[iterator], (iterator + 1) < count ? "," : "");
+	} /* end for */
+	pop_indent ();
+	write ("};\n\n");
+
+	/* write slots */
+	write ("static const int __service_dispatch_slots%s[%d] = {", suffix, slot_count);
+	for (iterator = 0; iterator < slot_count; iterator++)
+		xml_rpc_support_sl_write ("%s%d", iterator > 0 ? ", " : "", slots[iterator]);
+	xml_rpc_support_sl_write ("};\n\n");
+
+	axl_free (slots);
+	axl_free (next);
+
+	return slot_count - 1;
+}
+
+/**
+ * @internal
+ *
  * Writes the default service dispatch function, that recognizes the
  * service and dispath it to the appropiate handler.
  *
+ * Services are located through dispatch tables built at generation
+ * time (one for each resource declared and another for services
+ * without resource), so dispatching cost doesn't depend on the
+ * number of services.
+ *
  * @param doc The \ref axlDoc reference representing the interface.
  *
  * @param comp_name The XML-RPC server component name.
  */
-void xml_rpc_write_c_server_default_service_dispath (axlDoc   * doc, 
+void xml_rpc_write_c_server_default_service_dispath (axlDoc   * doc,
 						     char     * comp_name,
 						     axl_bool   also_body)
 {
@@ -213,133 +382,116 @@ void xml_rpc_write_c_server_default_service_dispath (axlDoc   * doc,
 	axlNode * service;
 	axlNode * node;
 
-	axlHash       * resources;
-	axlHashCursor * iter;
+	axlList      * resources;
+	axlList      * tables;
+	axlList      * default_services;
+	char         * suffix;
+	int            max_params = 0;
+	int            iterator;
+	unsigned int * masks;
+	unsigned int   mask       = 0;
 
 	/* write depedency to the xml-rpc implementation */
 	xml_rpc_support_write ("/* include xml-rpc library */\n");
 	xml_rpc_support_write ("#include <vortex_xml_rpc.h>\n");
 
-	/* write initial header */
-	xml_rpc_support_write ("XmlRpcMethodResponse *  service_dispatch (VortexChannel * channel, XmlRpcMethodCall * method_call, axlPointer user_data)%s\n\n",
-			       also_body ? "\n{" : ";");
-
 	/* check if the body source code must be generated */
-	if (!also_body)
+	if (!also_body) {
+		/* write the prototype */
+		xml_rpc_support_write ("XmlRpcMethodResponse *  service_dispatch (VortexChannel * channel, XmlRpcMethodCall * method_call, axlPointer user_data);\n\n");
 		return;
+	} /* end if */
 
-	/* push the indent */
-	xml_rpc_support_push_indent ();
-	
-	xml_rpc_support_write ("/* check for a match for a service */\n");
-
-	/* check if some service have a resource declaration */
-	service   = axl_doc_get (doc, "/xml-rpc-interface/service");
-	resources = axl_hash_new (axl_hash_string, axl_hash_equal_string);
+	/* group services by resource, keeping declaration order */
+	resources        = axl_list_new (axl_list_always_return_1, NULL);
+	tables           = axl_list_new (axl_list_always_return_1, (axlDestroyFunc) axl_list_free);
+	default_services = axl_list_new (axl_list_always_return_1, NULL);
+	service          = axl_doc_get (doc, "/xml-rpc-interface/service");
 	while (service != NULL) {
-		
+
+		/* check service node */
+		if (! (NODE_CMP_NAME (service, "service"))) {
+			/* get next service */
+			service = axl_node_get_next (service);
+			continue;
+		} /* end if */
+
+		/* update max params */
+		node = axl_node_get_child_called (service, "params");
+		if (axl_node_get_child_num (node) > max_params)
+			max_params = axl_node_get_child_num (node);
+
 		/* get the resource node */
 		node = axl_node_get_child_called (service, "resource");
-
-		if (node != NULL) {
-			/* check if the resource was already handled */
-			if (! axl_hash_exists (resources, (axlPointer) axl_node_get_content (node, NULL))) {
-				/* the resource do not exists, store it */
-				axl_hash_insert (resources, 
-						 (axlPointer) axl_node_get_content (node, NULL), 
-						 (axlPointer) axl_node_get_content (node, NULL));
+		if (node == NULL) {
+			axl_list_append (default_services, service);
+		} else {
+			/* find the resource or register it */
+			for (iterator = 0; iterator < axl_list_length (resources); iterator++) {
+				if (axl_cmp (axl_list_get_nth (resources, iterator), axl_node_get_content (node, NULL)))
+					break;
+			} /* end for */
+			if (iterator == axl_list_length (resources)) {
+				axl_list_append (resources, (axlPointer) axl_node_get_content (node, NULL));
+				axl_list_append (tables, axl_list_new (axl_list_always_return_1, NULL));
 			} /* end if */
+			axl_list_append (axl_list_get_nth (tables, iterator), service);
 		} /* end if */
 
 		/* get next service */
 		service = axl_node_get_next (service);
-	} /* end if */
-
-	/* now, for all resources found, create a particular
-	 * representation to group all services under the same
-	 * resource */
-	if (axl_hash_items (resources) > 0) {
-		/* create the hash cursor */
-		iter = axl_hash_cursor_new (resources);
-		while (axl_hash_cursor_has_item (iter)) {
-			
-			write ("/* handle all services under the resource=%s */\n", (char*) axl_hash_cursor_get_key (iter));
-			write ("if (axl_cmp (vortex_xml_rpc_channel_get_resource (channel), \"%s\")) {\n\n", (char*) axl_hash_cursor_get_key (iter));
-			push_indent ();
-
-			/* now write all services that have the same resource */
-			service   = axl_doc_get (doc, "/xml-rpc-interface/service");
-			while (service != NULL) {
-
-				/* get the resource node */
-				node = axl_node_get_child_called (service, "resource");
-				
-				if (node != NULL) {
-					/* check if the resource value is the one we are handling */
-					if (axl_cmp (axl_node_get_content (node, NULL),
-						     (char*) axl_hash_cursor_get_key (iter))) {
-						
-						/* good, found a service with the same resource, handle it  */
-						__xml_rpc_c_server_service_dispach (service);
-
-						/* now flag the service to not be handle in the non-resource section */
-						axl_node_annotate_int (service, "service-handled", 1);
-					} /* end if */
-
-				} /* end if */
-
-				/* get next service */
-				service = axl_node_get_next (service);
-				
-			} /* end while */
-
-			write ("/* no more services under resource=%s */\n", (char*) axl_hash_cursor_get_key (iter));
-			write ("return NULL;\n\n");
-			
-			pop_indent ();
-			write ("} /* end if */\n\n");
-
-			/* get the next resource  */
-			axl_hash_cursor_next (iter);
-
-		} /* end while */
+	} /* end while */
 
-		/* free the cursor */
-		axl_hash_cursor_free (iter);
-		
+	/* write support code and tables */
+	__xml_rpc_c_server_write_dispatch_support (max_params);
+	masks = axl_new (unsigned int, axl_list_length (resources) + 1);
+	for (iterator = 0; iterator < axl_list_length (resources); iterator++) {
+		write ("/* services under the resource=%s */\n", (char *) axl_list_get_nth (resources, iterator));
+		suffix          = axl_strdup_printf ("_%d", iterator + 1);
+		masks[iterator] = __xml_rpc_c_server_write_dispatch_table (doc, axl_list_get_nth (tables, iterator), suffix);
+		axl_free (suffix);
+	} /* end for */
+	if (axl_list_length (default_services) > 0) {
+		write ("/* services without resource */\n");
+		mask = __xml_rpc_c_server_write_dispatch_table (doc, default_services, "");
 	} /* end if */
 
-	/* free resources hash */
-
-	axl_hash_free (resources);
-	
-	/* get a reference to the first service node. */
-	service = axl_doc_get (doc, "/xml-rpc-interface/service");
-	while (service != NULL) {
-
-		/* check service node */
-		if (! (NODE_CMP_NAME (service, "service"))) {
-			/* get next service */
-			service = axl_node_get_next (service);
-			continue;
-		} /* end if */
+	/* write initial header */
+	xml_rpc_support_write ("XmlRpcMethodResponse *  service_dispatch (VortexChannel * channel, XmlRpcMethodCall * method_call, axlPointer user_data)\n{\n\n");
 
-		/* write service dispatch */
-		__xml_rpc_c_server_service_dispach (service);
+	/* push the indent */
+	xml_rpc_support_push_indent ();
 
-		/* all parameters written, get next node  */
-		service = axl_node_get_next_called (service, "service");
+	/* services under resources are only checked if the channel
+	 * was booted with the resource */
+	for (iterator = 0; iterator < axl_list_length (resources); iterator++) {
+		write ("/* handle all services under the resource=%s */\n", (char*) axl_list_get_nth (resources, iterator));
+		write ("if (axl_cmp (vortex_xml_rpc_channel_get_resource (channel), \"%s\"))\n", (char*) axl_list_get_nth (resources, iterator));
+		push_indent ();
+		write ("return __service_dispatch_lookup (__service_dispatch_entries_%d, __service_dispatch_slots_%d, %u, channel, method_call);\n\n",
+		       iterator + 1, iterator + 1, masks[iterator]);
+		pop_indent ();
+	} /* end for */
+
+	if (axl_list_length (default_services) > 0) {
+		xml_rpc_support_write ("/* check for a match for a service */\n");
+		write ("return __service_dispatch_lookup (__service_dispatch_entries, __service_dispatch_slots, %u, channel, method_call);\n", mask);
+	} else {
+		/* write the unrecognized method */
+		xml_rpc_support_write ("/* return that the method to be invoked, is not supported or recognized by this module */\n");
+		xml_rpc_support_write ("return NULL;\n");
 	} /* end if */
 
-	/* write the unrecognized method */
-	xml_rpc_support_write ("/* return that the method to be invoked, is not supported or recognized by this module */\n");
-	xml_rpc_support_write ("return NULL;\n");
-	
 	/* restore the indent before returning */
 	xml_rpc_support_pop_indent ();
 
 	xml_rpc_support_write ("}\n\n");
-	
+
+	axl_list_free (resources);
+	axl_list_free (tables);
+	axl_list_free (default_services);
+	axl_free (masks);
+
 	return;
 }
 
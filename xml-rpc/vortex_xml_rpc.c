@@ -53,6 +53,30 @@
  */
 #define VORTEX_XML_RPC_BOOT_DTD         "vo:xml-rpc:dtd"
 
+/**
+ * @internal Macro definition to access to the binary encoding
+ * configuration (flags the encoding as enabled).
+ */
+#define VORTEX_XML_RPC_USE_BINARY       "vo:xml-rpc:usebin"
+
+/**
+ * @internal Key used to flag channels that agreed to use the binary
+ * encoding at boot time.
+ */
+#define VORTEX_XML_RPC_BINARY_CHANNEL   "vo:xml-rpc:bin"
+
+/**
+ * @internal Key used to store, on each channel, the pipeline of
+ * invocations waiting for their reply.
+ */
+#define VORTEX_XML_RPC_PIPELINE         "vo:xml-rpc:pipeline"
+
+/**
+ * @internal Macro definition to access to the pipeline depth
+ * configured (invocations allowed in flight on the same channel).
+ */
+#define VORTEX_XML_RPC_PIPELINE_DEPTH   "vo:xml-rpc:pdepth"
+
 /** 
  * @internal The following data definition is used to hold one service
  * dispatch node and its associated data, along with the validation
@@ -86,6 +110,19 @@ typedef struct _VortexXmlRpcServiceDispatchNode {
 /* \addtogroup vortex_xml_rpc */
 /* @{ */
 
+/** 
+ * @internal Configures the channel to deliver XML-RPC frames as they
+ * are received (without joining them) so they are decoded while the
+ * rest of the message arrives. Frames are serialized to decode them
+ * in order.
+ */
+void __vortex_xml_rpc_configure_channel (VortexChannel * channel)
+{
+	vortex_channel_set_complete_flag (channel, axl_false);
+	vortex_channel_set_serialize (channel, axl_true);
+	return;
+}
+
 /** 
  * @internal
  * @brief Support user space notification for XML-RPC boot status notification.
@@ -122,6 +159,9 @@ void __vortex_xml_rpc_notify (VortexXmlRpcBootNotify    process_status,
 
 		/* set the channel to be ready. */
 		vortex_channel_set_data (channel, XML_RPC_BOOT_STATE, "ready");
+
+		/* decode replies while they are received */
+		__vortex_xml_rpc_configure_channel (channel);
 		break;
 	}
 
@@ -401,77 +441,1188 @@ XmlRpcMethodValue * __vortex_xml_rpc_parse_value (VortexCtx * ctx, axlNode * val
 		return method_value_new (ctx, XML_RPC_NONE_VALUE, NULL);
 	}
 
-	/* in the case of simple top level values, get the reference
-	 * to the internal content */
-	if (NODE_CMP_NAME (child, "i4") ||
-	    NODE_CMP_NAME (child, "int") ||
-	    NODE_CMP_NAME (child, "boolean") ||
-	    NODE_CMP_NAME (child, "string") ||
-	    NODE_CMP_NAME (child, "double") ||
-	    NODE_CMP_NAME (child, "dateTime.iso8601") ||
-	    NODE_CMP_NAME (child, "base64")) {
+	/* in the case of simple top level values, get the reference
+	 * to the internal content */
+	if (NODE_CMP_NAME (child, "i4") ||
+	    NODE_CMP_NAME (child, "int") ||
+	    NODE_CMP_NAME (child, "boolean") ||
+	    NODE_CMP_NAME (child, "string") ||
+	    NODE_CMP_NAME (child, "double") ||
+	    NODE_CMP_NAME (child, "dateTime.iso8601") ||
+	    NODE_CMP_NAME (child, "base64")) {
+
+		/* reference to the internal content for simple,
+		 * non-composite values. */
+		string_value = axl_node_get_content (child, NULL);
+		v_return_val_if_fail (string_value, NULL);
+
+		vortex_log (VORTEX_LEVEL_DEBUG, "received simple value='%s'", 
+			    string_value ? string_value : "NULL");
+
+		/* for each value tag, convert into XML-RPC parameter */
+		if (NODE_CMP_NAME (child, "i4") || NODE_CMP_NAME (child, "int"))
+			result        = method_value_new_from_string (ctx, XML_RPC_INT_VALUE, string_value);
+		
+		/* boolean case */
+		if (NODE_CMP_NAME (child, "boolean"))
+			result        = method_value_new_from_string (ctx, XML_RPC_BOOLEAN_VALUE, string_value);
+		
+		/* string case */
+		if (NODE_CMP_NAME (child, "string"))
+			result        = method_value_new_from_string (ctx, XML_RPC_STRING_VALUE, string_value);
+		       
+		/* double case */
+		if (NODE_CMP_NAME (child, "double"))
+			result        = method_value_new_from_string (ctx, XML_RPC_DOUBLE_VALUE, string_value);
+		
+		/* dateTime.iso8601 */
+		if (NODE_CMP_NAME (child, "dateTime.iso8601"))
+			result        = method_value_new_from_string (ctx, XML_RPC_DATE_VALUE, string_value);
+		
+		/* base64 case */
+		if (NODE_CMP_NAME (child, "base64"))
+			result        = method_value_new_from_string (ctx, XML_RPC_BASE64_VALUE, string_value);
+		
+		/* free and return */
+		return result;
+	}
+	
+	/* struct case */
+	if (NODE_CMP_NAME (child, "struct")) {
+		vortex_log (VORTEX_LEVEL_DEBUG, "received a complex value <struct>");
+		
+		/* parse the struct value */
+		result = __vortex_xml_rpc_parse_struct_value (ctx, child);
+		
+		vortex_log (VORTEX_LEVEL_DEBUG, "struct parsed: type %d", 
+			    method_value_get_type (result));
+
+	}else if (NODE_CMP_NAME (child, "array")) {
+		/* array case */
+		vortex_log (VORTEX_LEVEL_DEBUG, "received a complex value <array> (2)");
+		
+		/* parse the array value */
+		result = __vortex_xml_rpc_parse_array_value (ctx, child);
+
+		vortex_log (VORTEX_LEVEL_DEBUG, "array parsed: type %d", 
+			    method_value_get_type (result));
+	}
+	
+	/* release memory no longer used */
+	return result;
+}
+
+
+/**
+ * @internal Max element nesting accepted by the XML-RPC decoder.
+ */
+#define XML_RPC_DECODER_MAX_DEPTH 256
+
+/**
+ * @internal XML-RPC elements recognized by the decoder.
+ */
+typedef enum {
+	XML_RPC_NODE_UNKNOWN = 0,
+	XML_RPC_NODE_METHOD_CALL,
+	XML_RPC_NODE_METHOD_RESPONSE,
+	XML_RPC_NODE_METHOD_NAME,
+	XML_RPC_NODE_PARAMS,
+	XML_RPC_NODE_PARAM,
+	XML_RPC_NODE_FAULT,
+	XML_RPC_NODE_VALUE,
+	XML_RPC_NODE_STRUCT,
+	XML_RPC_NODE_MEMBER,
+	XML_RPC_NODE_NAME,
+	XML_RPC_NODE_ARRAY,
+	XML_RPC_NODE_DATA,
+	XML_RPC_NODE_INT,
+	XML_RPC_NODE_BOOLEAN,
+	XML_RPC_NODE_STRING,
+	XML_RPC_NODE_DOUBLE,
+	XML_RPC_NODE_DATE,
+	XML_RPC_NODE_BASE64,
+	XML_RPC_NODE_NONE
+} VortexXmlRpcNodeType;
+
+/**
+ * @internal Open element tracked by the decoder. Each node owns the
+ * objects it is building until it is closed and they are handed to
+ * its parent.
+ */
+typedef struct _VortexXmlRpcDecoderNode {
+	VortexXmlRpcNodeType   type;
+	/* <value> node: a typed child was found */
+	axl_bool               typed;
+	/* value built (<value> node) or member value (<member> node) */
+	XmlRpcMethodValue    * value;
+	/* containers being built (<struct> and <array> nodes) */
+	XmlRpcStruct         * _struct;
+	XmlRpcArray          * array;
+	/* member name (<member> node) */
+	char                 * name;
+} VortexXmlRpcDecoderNode;
+
+/**
+ * @internal Single pass XML-RPC decoder. Content is received in
+ * chunks (usually one per frame) and XML-RPC values are built while
+ * elements are found, without building an intermediate DOM
+ * document. Only the bytes of an element split across two chunks
+ * are kept between calls.
+ *
+ * Because the channel complete flag is disabled, the decoder applies
+ * the complete frame limit configured (\ref
+ * vortex_channel_get_complete_frame_limit) to the bytes received for
+ * each message.
+ */
+typedef struct _VortexXmlRpcDecoder {
+	VortexCtx               * ctx;
+	/* connection where the message is received and max amount of
+	 * bytes accepted for the message (-1 no limit) */
+	VortexConnection        * connection;
+	int                       limit;
+	int                       received;
+	/* decoding a <methodCall> (axl_true) or a <methodResponse> */
+	axl_bool                  is_call;
+	/* content is binary encoded: it is kept (in pending) and
+	 * decoded once the last frame is received */
+	axl_bool                  binary;
+
+	/* stack of open elements */
+	VortexXmlRpcDecoderNode * stack;
+	int                       depth;
+	int                       stack_size;
+
+	/* element not completed on the previous chunk */
+	char                    * pending;
+	int                       pending_length;
+	int                       pending_size;
+	/* inside a CDATA section */
+	axl_bool                  in_cdata;
+
+	/* text collected for the current element */
+	char                    * text;
+	int                       text_length;
+	int                       text_size;
+	/* text not copied yet, pointing to the chunk being
+	 * processed */
+	const char              * segment;
+	int                       segment_length;
+	axl_bool                  segment_raw;
+
+	/* decoding status and results */
+	axl_bool                  root_found;
+	axl_bool                  finished;
+	const char              * error;
+	char                    * method_name;
+	axlList                 * params;
+	XmlRpcMethodValue       * value;
+	axl_bool                  fault;
+	XmlRpcMethodCall        * method_call;
+} VortexXmlRpcDecoder;
+
+/**
+ * @internal Creates a new decoder.
+ *
+ * @param channel The channel where content is received.
+ *
+ * @param is_call axl_true to decode a <methodCall>, axl_false to
+ * decode a <methodResponse>.
+ */
+VortexXmlRpcDecoder * __vortex_xml_rpc_decoder_new (VortexChannel * channel, axl_bool is_call)
+{
+	VortexXmlRpcDecoder * decoder;
+
+	decoder             = axl_new (VortexXmlRpcDecoder, 1);
+	decoder->ctx        = vortex_channel_get_ctx (channel);
+	decoder->connection = vortex_channel_get_connection (channel);
+	decoder->limit      = vortex_channel_get_complete_frame_limit (channel);
+	decoder->is_call    = is_call;
+	decoder->binary     = vortex_xml_rpc_channel_is_binary (channel);
+	decoder->stack_size = 16;
+	decoder->stack      = axl_new (VortexXmlRpcDecoderNode, decoder->stack_size);
+	if (is_call)
+		decoder->params = axl_list_new (axl_list_always_return_1, NULL);
+
+	return decoder;
+}
+
+/**
+ * @internal Releases objects owned by the provided node.
+ */
+void __vortex_xml_rpc_decoder_node_release (VortexXmlRpcDecoderNode * node)
+{
+	if (node->value)
+		vortex_xml_rpc_method_value_free (node->value);
+	if (node->_struct)
+		vortex_xml_rpc_struct_free (node->_struct);
+	if (node->array)
+		vortex_xml_rpc_array_free (node->array);
+	axl_free (node->name);
+	memset (node, 0, sizeof (VortexXmlRpcDecoderNode));
+	return;
+}
+
+/**
+ * @internal Releases the decoder and all values not taken.
+ */
+void __vortex_xml_rpc_decoder_free (axlPointer _decoder)
+{
+	VortexXmlRpcDecoder * decoder = _decoder;
+	int                   iterator;
+
+	if (decoder == NULL)
+		return;
+
+	while (decoder->depth > 0) {
+		decoder->depth--;
+		__vortex_xml_rpc_decoder_node_release (&decoder->stack[decoder->depth]);
+	} /* end while */
+
+	if (decoder->params) {
+		for (iterator = 0; iterator < axl_list_length (decoder->params); iterator++) {
+			if (axl_list_get_nth (decoder->params, iterator))
+				vortex_xml_rpc_method_value_free (axl_list_get_nth (decoder->params, iterator));
+		} /* end for */
+		axl_list_free (decoder->params);
+	} /* end if */
+	if (decoder->value)
+		vortex_xml_rpc_method_value_free (decoder->value);
+	if (decoder->method_call)
+		vortex_xml_rpc_method_call_free (decoder->method_call);
+
+	axl_free (decoder->method_name);
+	axl_free (decoder->stack);
+	axl_free (decoder->pending);
+	axl_free (decoder->text);
+	axl_free (decoder);
+	return;
+}
+
+/**
+ * @internal Decodes XML entities found on the source provided into
+ * dest, which must have at least length + 1 bytes. Decoded content is
+ * never larger than the source.
+ *
+ * @return The amount of bytes written into dest.
+ */
+int __vortex_xml_rpc_decoder_unescape (char * dest, const char * source, int length)
+{
+	int            iterator = 0;
+	int            written  = 0;
+	const char   * end;
+	unsigned long  code;
+	char         * aux;
+
+	while (iterator < length) {
+		if (source[iterator] != '&') {
+			dest[written++] = source[iterator++];
+			continue;
+		} /* end if */
+
+		/* find entity end */
+		end = memchr (source + iterator, ';', length - iterator);
+		if (end == NULL) {
+			dest[written++] = source[iterator++];
+			continue;
+		} /* end if */
+
+		if (axl_memcmp (source + iterator, "&lt;", 4))
+			dest[written++] = '<';
+		else if (axl_memcmp (source + iterator, "&gt;", 4))
+			dest[written++] = '>';
+		else if (axl_memcmp (source + iterator, "&amp;", 5))
+			dest[written++] = '&';
+		else if (axl_memcmp (source + iterator, "&quot;", 6))
+			dest[written++] = '"';
+		else if (axl_memcmp (source + iterator, "&apos;", 6))
+			dest[written++] = '\'';
+		else if (source[iterator + 1] == '#') {
+			/* numeric reference, encode it as UTF-8 */
+			if (source[iterator + 2] == 'x' || source[iterator + 2] == 'X')
+				code = strtoul (source + iterator + 3, &aux, 16);
+			else
+				code = strtoul (source + iterator + 2, &aux, 10);
+
+			if (code < 0x80) {
+				dest[written++] = (char) code;
+			} else if (code < 0x800) {
+				dest[written++] = (char) (0xC0 | (code >> 6));
+				dest[written++] = (char) (0x80 | (code & 0x3F));
+			} else if (code < 0x10000) {
+				dest[written++] = (char) (0xE0 | (code >> 12));
+				dest[written++] = (char) (0x80 | ((code >> 6) & 0x3F));
+				dest[written++] = (char) (0x80 | (code & 0x3F));
+			} else {
+				dest[written++] = (char) (0xF0 | ((code >> 18) & 0x07));
+				dest[written++] = (char) (0x80 | ((code >> 12) & 0x3F));
+				dest[written++] = (char) (0x80 | ((code >> 6) & 0x3F));
+				dest[written++] = (char) (0x80 | (code & 0x3F));
+			} /* end if */
+		} else {
+			/* unknown entity, copy it as is */
+			memcpy (dest + written, source + iterator, (end - (source + iterator)) + 1);
+			written += (end - (source + iterator)) + 1;
+		} /* end if */
+
+		iterator = (end - source) + 1;
+	} /* end while */
+
+	dest[written] = 0;
+	return written;
+}
+
+/**
+ * @internal Copies text pending (segment) into the decoder text
+ * buffer.
+ */
+void __vortex_xml_rpc_decoder_text_flush (VortexXmlRpcDecoder * decoder)
+{
+	if (decoder->segment == NULL)
+		return;
+
+	/* reserve space */
+	if (decoder->text_length + decoder->segment_length + 1 > decoder->text_size) {
+		decoder->text_size = (decoder->text_length + decoder->segment_length + 1) * 2;
+		decoder->text      = axl_realloc (decoder->text, decoder->text_size);
+	} /* end if */
+
+	if (decoder->segment_raw) {
+		memcpy (decoder->text + decoder->text_length, decoder->segment, decoder->segment_length);
+		decoder->text_length += decoder->segment_length;
+		decoder->text[decoder->text_length] = 0;
+	} else {
+		decoder->text_length += __vortex_xml_rpc_decoder_unescape (decoder->text + decoder->text_length,
+									  decoder->segment, decoder->segment_length);
+	} /* end if */
+
+	decoder->segment = NULL;
+	return;
+}
+
+/**
+ * @internal Adds text found for the current element. The first
+ * segment is not copied: if it is the only one, it is decoded
+ * directly into the value created.
+ */
+void __vortex_xml_rpc_decoder_text_add (VortexXmlRpcDecoder * decoder, const char * text, int length, axl_bool raw)
+{
+	if (length <= 0)
+		return;
+
+	/* flush previous segment */
+	__vortex_xml_rpc_decoder_text_flush (decoder);
+
+	decoder->segment        = text;
+	decoder->segment_length = length;
+	decoder->segment_raw    = raw;
+	if (decoder->text_length > 0)
+		__vortex_xml_rpc_decoder_text_flush (decoder);
+	return;
+}
+
+/**
+ * @internal Returns a newly allocated string with the text collected
+ * for the current element.
+ */
+char * __vortex_xml_rpc_decoder_text_take (VortexXmlRpcDecoder * decoder)
+{
+	char * result;
+
+	if (decoder->segment != NULL && decoder->text_length == 0) {
+		/* only one segment found, decode it directly */
+		result = axl_new (char, decoder->segment_length + 1);
+		if (decoder->segment_raw)
+			memcpy (result, decoder->segment, decoder->segment_length);
+		else
+			__vortex_xml_rpc_decoder_unescape (result, decoder->segment, decoder->segment_length);
+		decoder->segment = NULL;
+		return result;
+	} /* end if */
+
+	__vortex_xml_rpc_decoder_text_flush (decoder);
+	result = axl_new (char, decoder->text_length + 1);
+	if (decoder->text_length > 0)
+		memcpy (result, decoder->text, decoder->text_length);
+	decoder->text_length = 0;
+	return result;
+}
+
+/**
+ * @internal Returns the text collected for the current element
+ * (reference to the decoder buffer, do not release it).
+ */
+const char * __vortex_xml_rpc_decoder_text_get (VortexXmlRpcDecoder * decoder)
+{
+	__vortex_xml_rpc_decoder_text_flush (decoder);
+	if (decoder->text_length == 0)
+		return "";
+	return decoder->text;
+}
+
+/**
+ * @internal Returns axl_true if text found must be collected for the
+ * current element.
+ */
+axl_bool __vortex_xml_rpc_decoder_collects_text (VortexXmlRpcDecoder * decoder)
+{
+	VortexXmlRpcDecoderNode * node;
+
+	if (decoder->depth == 0)
+		return axl_false;
+
+	node = &decoder->stack[decoder->depth - 1];
+	switch (node->type) {
+	case XML_RPC_NODE_METHOD_NAME:
+	case XML_RPC_NODE_NAME:
+	case XML_RPC_NODE_INT:
+	case XML_RPC_NODE_BOOLEAN:
+	case XML_RPC_NODE_STRING:
+	case XML_RPC_NODE_DOUBLE:
+	case XML_RPC_NODE_DATE:
+	case XML_RPC_NODE_BASE64:
+		return axl_true;
+	case XML_RPC_NODE_VALUE:
+		/* untyped values are strings */
+		return ! node->typed;
+	default:
+		return axl_false;
+	}
+}
+
+/**
+ * @internal Translates the element name into its type.
+ */
+VortexXmlRpcNodeType __vortex_xml_rpc_decoder_node_type (const char * name, int length)
+{
+	switch (length) {
+	case 2:
+		if (axl_memcmp (name, "i4", 2))
+			return XML_RPC_NODE_INT;
+		break;
+	case 3:
+		if (axl_memcmp (name, "int", 3))
+			return XML_RPC_NODE_INT;
+		break;
+	case 4:
+		if (axl_memcmp (name, "name", 4))
+			return XML_RPC_NODE_NAME;
+		if (axl_memcmp (name, "data", 4))
+			return XML_RPC_NODE_DATA;
+		if (axl_memcmp (name, "none", 4))
+			return XML_RPC_NODE_NONE;
+		break;
+	case 5:
+		if (axl_memcmp (name, "value", 5))
+			return XML_RPC_NODE_VALUE;
+		if (axl_memcmp (name, "param", 5))
+			return XML_RPC_NODE_PARAM;
+		if (axl_memcmp (name, "array", 5))
+			return XML_RPC_NODE_ARRAY;
+		if (axl_memcmp (name, "fault", 5))
+			return XML_RPC_NODE_FAULT;
+		break;
+	case 6:
+		if (axl_memcmp (name, "struct", 6))
+			return XML_RPC_NODE_STRUCT;
+		if (axl_memcmp (name, "member", 6))
+			return XML_RPC_NODE_MEMBER;
+		if (axl_memcmp (name, "params", 6))
+			return XML_RPC_NODE_PARAMS;
+		if (axl_memcmp (name, "string", 6))
+			return XML_RPC_NODE_STRING;
+		if (axl_memcmp (name, "double", 6))
+			return XML_RPC_NODE_DOUBLE;
+		if (axl_memcmp (name, "base64", 6))
+			return XML_RPC_NODE_BASE64;
+		break;
+	case 7:
+		if (axl_memcmp (name, "boolean", 7))
+			return XML_RPC_NODE_BOOLEAN;
+		break;
+	case 10:
+		if (axl_memcmp (name, "methodCall", 10))
+			return XML_RPC_NODE_METHOD_CALL;
+		if (axl_memcmp (name, "methodName", 10))
+			return XML_RPC_NODE_METHOD_NAME;
+		break;
+	case 14:
+		if (axl_memcmp (name, "methodResponse", 14))
+			return XML_RPC_NODE_METHOD_RESPONSE;
+		break;
+	case 16:
+		if (axl_memcmp (name, "dateTime.iso8601", 16))
+			return XML_RPC_NODE_DATE;
+		break;
+	default:
+		break;
+	}
+	return XML_RPC_NODE_UNKNOWN;
+}
+
+/**
+ * @internal Closes the current element, handing the value it built
+ * to its parent.
+ */
+axl_bool __vortex_xml_rpc_decoder_close (VortexXmlRpcDecoder * decoder, VortexXmlRpcNodeType type)
+{
+	VortexXmlRpcDecoderNode * node;
+	VortexXmlRpcDecoderNode * parent = NULL;
+	XmlRpcMethodValue       * value  = NULL;
+	VortexCtx               * ctx    = decoder->ctx;
+
+	if (decoder->depth == 0 || decoder->stack[decoder->depth - 1].type != type) {
+		decoder->error = "found unbalanced or unexpected closing element";
+		return axl_false;
+	} /* end if */
+
+	node = &decoder->stack[decoder->depth - 1];
+	if (decoder->depth > 1)
+		parent = &decoder->stack[decoder->depth - 2];
+
+	switch (type) {
+	case XML_RPC_NODE_METHOD_CALL:
+	case XML_RPC_NODE_METHOD_RESPONSE:
+		decoder->finished = axl_true;
+		break;
+	case XML_RPC_NODE_METHOD_NAME:
+		axl_free (decoder->method_name);
+		decoder->method_name = __vortex_xml_rpc_decoder_text_take (decoder);
+		break;
+	case XML_RPC_NODE_NAME:
+		axl_free (parent->name);
+		parent->name = __vortex_xml_rpc_decoder_text_take (decoder);
+		break;
+	case XML_RPC_NODE_INT:
+	case XML_RPC_NODE_BOOLEAN:
+	case XML_RPC_NODE_DOUBLE:
+		value = method_value_new_from_string (ctx,
+						      type == XML_RPC_NODE_DOUBLE ? XML_RPC_DOUBLE_VALUE :
+						      (type == XML_RPC_NODE_INT ? XML_RPC_INT_VALUE : XML_RPC_BOOLEAN_VALUE),
+						      __vortex_xml_rpc_decoder_text_get (decoder));
+		decoder->text_length = 0;
+		if (value == NULL) {
+			decoder->error = "found wrong numeric value";
+			return axl_false;
+		} /* end if */
+		parent->value = value;
+		break;
+	case XML_RPC_NODE_DATE:
+		/* accepted as the DOM based parser did: date values
+		 * are not supported yet, so no value is produced */
+		parent->value = method_value_new_from_string (ctx, XML_RPC_DATE_VALUE, __vortex_xml_rpc_decoder_text_get (decoder));
+		decoder->text_length = 0;
+		break;
+	case XML_RPC_NODE_STRING:
+		/* the value owns the string decoded */
+		parent->value = method_value_new (ctx, XML_RPC_STRING_REF_VALUE, __vortex_xml_rpc_decoder_text_take (decoder));
+		break;
+	case XML_RPC_NODE_BASE64:
+		parent->value = method_value_new (ctx, XML_RPC_BASE64_REF_VALUE, __vortex_xml_rpc_decoder_text_take (decoder));
+		break;
+	case XML_RPC_NODE_NONE:
+		parent->value = method_value_new (ctx, XML_RPC_NONE_VALUE, NULL);
+		break;
+	case XML_RPC_NODE_STRUCT:
+		/* structs without members are reported as no value */
+		__vortex_xml_rpc_struct_close (node->_struct);
+		if (vortex_xml_rpc_struct_get_member_count (node->_struct) > 0) {
+			parent->value  = method_value_new (ctx, XML_RPC_STRUCT_VALUE, node->_struct);
+			node->_struct  = NULL;
+		} /* end if */
+		break;
+	case XML_RPC_NODE_ARRAY:
+		__vortex_xml_rpc_array_close (node->array);
+		parent->value = method_value_new (ctx, XML_RPC_ARRAY_VALUE, node->array);
+		node->array   = NULL;
+		break;
+	case XML_RPC_NODE_MEMBER:
+		if (node->name == NULL) {
+			decoder->error = "found struct member without name";
+			return axl_false;
+		} /* end if */
+		__vortex_xml_rpc_struct_append (parent->_struct, vortex_xml_rpc_struct_member_new (node->name, node->value));
+		node->value = NULL;
+		break;
+	case XML_RPC_NODE_VALUE:
+		/* untyped values are strings */
+		if (! node->typed)
+			node->value = method_value_new (ctx, XML_RPC_STRING_REF_VALUE, __vortex_xml_rpc_decoder_text_take (decoder));
+
+		switch (parent->type) {
+		case XML_RPC_NODE_PARAM:
+			if (decoder->is_call) {
+				/* as before, empty structs are passed as
+				 * no value */
+				axl_list_append (decoder->params, node->value);
+			} else {
+				if (node->value == NULL) {
+					decoder->error = "found parameter without a proper value";
+					return axl_false;
+				} /* end if */
+				if (decoder->value != NULL) {
+					decoder->error = "found more than one value inside <methodResponse>";
+					return axl_false;
+				} /* end if */
+				decoder->value = node->value;
+			} /* end if */
+			break;
+		case XML_RPC_NODE_FAULT:
+			decoder->fault = axl_true;
+			decoder->value = node->value;
+			break;
+		case XML_RPC_NODE_MEMBER:
+			parent->value  = node->value;
+			break;
+		case XML_RPC_NODE_DATA:
+			__vortex_xml_rpc_array_append (decoder->stack[decoder->depth - 3].array, node->value);
+			break;
+		default:
+			break;
+		}
+		node->value = NULL;
+		break;
+	default:
+		break;
+	}
+
+	/* release the node */
+	decoder->depth--;
+	__vortex_xml_rpc_decoder_node_release (node);
+	decoder->text_length = 0;
+	decoder->segment     = NULL;
+	return axl_true;
+}
+
+/**
+ * @internal Opens a new element, checking it is found at the right
+ * place.
+ */
+axl_bool __vortex_xml_rpc_decoder_open (VortexXmlRpcDecoder * decoder, VortexXmlRpcNodeType type, axl_bool empty)
+{
+	VortexXmlRpcDecoderNode * parent = NULL;
+	VortexXmlRpcNodeType      parent_type;
+	VortexXmlRpcDecoderNode * node;
+
+	if (decoder->depth > 0)
+		parent = &decoder->stack[decoder->depth - 1];
+	parent_type = parent ? parent->type : XML_RPC_NODE_UNKNOWN;
+
+	switch (type) {
+	case XML_RPC_NODE_METHOD_CALL:
+	case XML_RPC_NODE_METHOD_RESPONSE:
+		if (parent != NULL || decoder->root_found ||
+		    (decoder->is_call != (type == XML_RPC_NODE_METHOD_CALL)))
+			goto wrong_place;
+		decoder->root_found = axl_true;
+		break;
+	case XML_RPC_NODE_METHOD_NAME:
+		if (parent_type != XML_RPC_NODE_METHOD_CALL)
+			goto wrong_place;
+		break;
+	case XML_RPC_NODE_PARAMS:
+		if (parent_type != XML_RPC_NODE_METHOD_CALL && parent_type != XML_RPC_NODE_METHOD_RESPONSE)
+			goto wrong_place;
+		break;
+	case XML_RPC_NODE_PARAM:
+		if (parent_type != XML_RPC_NODE_PARAMS)
+			goto wrong_place;
+		break;
+	case XML_RPC_NODE_FAULT:
+		if (parent_type != XML_RPC_NODE_METHOD_RESPONSE)
+			goto wrong_place;
+		break;
+	case XML_RPC_NODE_VALUE:
+		if (parent_type != XML_RPC_NODE_PARAM && parent_type != XML_RPC_NODE_MEMBER &&
+		    parent_type != XML_RPC_NODE_DATA && parent_type != XML_RPC_NODE_FAULT)
+			goto wrong_place;
+		break;
+	case XML_RPC_NODE_MEMBER:
+		if (parent_type != XML_RPC_NODE_STRUCT)
+			goto wrong_place;
+		break;
+	case XML_RPC_NODE_NAME:
+		if (parent_type != XML_RPC_NODE_MEMBER)
+			goto wrong_place;
+		break;
+	case XML_RPC_NODE_DATA:
+		if (parent_type != XML_RPC_NODE_ARRAY)
+			goto wrong_place;
+		break;
+	case XML_RPC_NODE_UNKNOWN:
+		decoder->error = "found unsupported element";
+		return axl_false;
+	default:
+		/* typed values */
+		if (parent_type != XML_RPC_NODE_VALUE || parent->typed)
+			goto wrong_place;
+		parent->typed = axl_true;
+		break;
+	}
+
+	/* grow the stack */
+	if (decoder->depth == decoder->stack_size) {
+		if (decoder->stack_size >= XML_RPC_DECODER_MAX_DEPTH) {
+			decoder->error = "max element nesting reached";
+			return axl_false;
+		} /* end if */
+		decoder->stack      = axl_realloc (decoder->stack, sizeof (VortexXmlRpcDecoderNode) * decoder->stack_size * 2);
+		memset (decoder->stack + decoder->stack_size, 0, sizeof (VortexXmlRpcDecoderNode) * decoder->stack_size);
+		decoder->stack_size = decoder->stack_size * 2;
+	} /* end if */
+
+	node       = &decoder->stack[decoder->depth];
+	node->type = type;
+	if (type == XML_RPC_NODE_STRUCT)
+		node->_struct = vortex_xml_rpc_struct_new (4);
+	else if (type == XML_RPC_NODE_ARRAY)
+		node->array   = vortex_xml_rpc_array_new (0);
+	decoder->depth++;
+
+	/* text is collected per element */
+	decoder->text_length = 0;
+	decoder->segment     = NULL;
+
+	/* <element /> */
+	if (empty)
+		return __vortex_xml_rpc_decoder_close (decoder, type);
+	return axl_true;
+
+ wrong_place:
+	decoder->error = "found element at an unexpected place";
+	return axl_false;
+}
+
+/**
+ * @internal Finds the provided terminator inside data.
+ *
+ * @return Terminator position or -1 if it was not found.
+ */
+int __vortex_xml_rpc_decoder_find (const char * data, int from, int length, const char * term, int term_length)
+{
+	const char * aux;
+
+	while (from + term_length <= length) {
+		aux = memchr (data + from, term[0], length - from - term_length + 1);
+		if (aux == NULL)
+			return -1;
+		from = aux - data;
+		if (memcmp (aux, term, term_length) == 0)
+			return from;
+		from++;
+	} /* end while */
+	return -1;
+}
+
+/**
+ * @internal Processes all complete items found in data.
+ *
+ * @return Bytes consumed (the rest must be provided again with more
+ * content) or -1 if an error was found.
+ */
+int __vortex_xml_rpc_decoder_process (VortexXmlRpcDecoder * decoder, const char * data, int length)
+{
+	int                    pos = 0;
+	int                    end;
+	int                    name;
+	int                    name_end;
+	const char           * aux;
+	axl_bool               closing;
+
+	while (pos < length) {
+		/* inside CDATA section: all content is text */
+		if (decoder->in_cdata) {
+			end = __vortex_xml_rpc_decoder_find (data, pos, length, "]]>", 3);
+			if (end == -1) {
+				/* keep last bytes in case they are part
+				 * of the terminator */
+				end = length - 2;
+				if (end > pos && __vortex_xml_rpc_decoder_collects_text (decoder))
+					__vortex_xml_rpc_decoder_text_add (decoder, data + pos, end - pos, axl_true);
+				if (end > pos)
+					pos = end;
+				break;
+			} /* end if */
+			if (__vortex_xml_rpc_decoder_collects_text (decoder))
+				__vortex_xml_rpc_decoder_text_add (decoder, data + pos, end - pos, axl_true);
+			decoder->in_cdata = axl_false;
+			pos = end + 3;
+			continue;
+		} /* end if */
+
+		/* text content */
+		if (data[pos] != '<') {
+			aux = memchr (data + pos, '<', length - pos);
+			end = aux ? (aux - data) : length;
+
+			if (__vortex_xml_rpc_decoder_collects_text (decoder)) {
+				/* do not split entities */
+				if (aux == NULL) {
+					aux = memchr (data + pos, '&', length - pos);
+					while (aux != NULL && memchr (aux, ';', length - (aux - data)) != NULL)
+						aux = memchr (aux + 1, '&', length - (aux - data) - 1);
+					if (aux != NULL)
+						end = aux - data;
+				} /* end if */
+				__vortex_xml_rpc_decoder_text_add (decoder, data + pos, end - pos, axl_false);
+			} /* end if */
+
+			if (end == pos)
+				break;
+			pos = end;
+			continue;
+		} /* end if */
+
+		/* check for CDATA start, comments and processing
+		 * instructions */
+		if ((length - pos) < 9 && memcmp (data + pos, "<![CDATA[", length - pos) == 0)
+			break;
+		if (axl_memcmp (data + pos, "<![CDATA[", 9)) {
+			decoder->in_cdata = axl_true;
+			pos += 9;
+			continue;
+		} /* end if */
+		if ((length - pos) < 4)
+			break;
+		if (axl_memcmp (data + pos, "<!--", 4)) {
+			end = __vortex_xml_rpc_decoder_find (data, pos + 4, length, "-->", 3);
+			if (end == -1)
+				break;
+			pos = end + 3;
+			continue;
+		} /* end if */
+		if (data[pos + 1] == '?' || data[pos + 1] == '!') {
+			end = __vortex_xml_rpc_decoder_find (data, pos + 2, length, ">", 1);
+			if (end == -1)
+				break;
+			pos = end + 1;
+			continue;
+		} /* end if */
+
+		/* element */
+		end = __vortex_xml_rpc_decoder_find (data, pos + 1, length, ">", 1);
+		if (end == -1)
+			break;
+
+		closing  = (data[pos + 1] == '/');
+		name     = pos + (closing ? 2 : 1);
+		name_end = name;
+		while (name_end < end && data[name_end] != ' ' && data[name_end] != '\t' &&
+		       data[name_end] != '\r' && data[name_end] != '\n' && data[name_end] != '/')
+			name_end++;
+
+		if (closing) {
+			if (! __vortex_xml_rpc_decoder_close (decoder, __vortex_xml_rpc_decoder_node_type (data + name, name_end - name)))
+				return -1;
+		} else {
+			if (! __vortex_xml_rpc_decoder_open (decoder, __vortex_xml_rpc_decoder_node_type (data + name, name_end - name),
+							     data[end - 1] == '/'))
+				return -1;
+		} /* end if */
+		pos = end + 1;
+	} /* end while */
+
+	/* text found points to data, copy it before returning */
+	__vortex_xml_rpc_decoder_text_flush (decoder);
+	return pos;
+}
+
+/**
+ * @internal Feeds the decoder with the next chunk of content.
+ *
+ * @return axl_false if the content is not a valid XML-RPC message.
+ */
+axl_bool __vortex_xml_rpc_decoder_feed (VortexXmlRpcDecoder * decoder, const char * data, int length)
+{
+	int consumed;
+
+	if (decoder->error)
+		return axl_false;
+	if (length <= 0)
+		return axl_true;
+
+	if (decoder->pending_length == 0 && ! decoder->binary) {
+		/* process content in place */
+		consumed = __vortex_xml_rpc_decoder_process (decoder, data, length);
+		if (consumed < 0)
+			return axl_false;
+		data    += consumed;
+		length  -= consumed;
+	} /* end if */
+
+	if (length == 0)
+		return axl_true;
+
+	/* keep (or join) content not completed */
+	if (decoder->pending_length + length > decoder->pending_size) {
+		decoder->pending_size = (decoder->pending_length + length) * 2;
+		decoder->pending      = axl_realloc (decoder->pending, decoder->pending_size);
+	} /* end if */
+	memcpy (decoder->pending + decoder->pending_length, data, length);
+	decoder->pending_length += length;
+
+	/* process joined content if it wasn't just stored */
+	if (decoder->pending_length > length && ! decoder->binary) {
+		consumed = __vortex_xml_rpc_decoder_process (decoder, decoder->pending, decoder->pending_length);
+		if (consumed < 0)
+			return axl_false;
+		memmove (decoder->pending, decoder->pending + consumed, decoder->pending_length - consumed);
+		decoder->pending_length -= consumed;
+	} /* end if */
+
+	return axl_true;
+}
+
+/**
+ * @internal Decodes binary content received once the last frame is
+ * received.
+ */
+void __vortex_xml_rpc_decoder_binary_finish (VortexXmlRpcDecoder * decoder)
+{
+	if (decoder->is_call) {
+		decoder->method_call = __vortex_xml_rpc_method_call_unmarshall_binary (decoder->ctx, decoder->pending, decoder->pending_length);
+		decoder->finished    = (decoder->method_call != NULL);
+	} else {
+		decoder->value       = __vortex_xml_rpc_method_response_unmarshall_binary (decoder->ctx, decoder->pending, decoder->pending_length,
+											    &decoder->fault);
+		decoder->finished    = (decoder->value != NULL);
+	} /* end if */
+
+	if (! decoder->finished)
+		decoder->error = "unable to decode binary encoded content";
+	return;
+}
+
+/**
+ * @internal Feeds the decoder with the frame content provided. MIME
+ * headers are skipped on the first frame of the message.
+ */
+axl_bool __vortex_xml_rpc_decoder_feed_frame (VortexXmlRpcDecoder * decoder, VortexFrame * frame, axl_bool first)
+{
+	const char * payload;
+	int          size;
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
+	VortexCtx  * ctx = decoder->ctx;
+#endif
+
+	/* check complete frame limit for the message */
+	if (decoder->error)
+		return axl_false;
+	decoder->received += vortex_frame_get_payload_size (frame);
+	if (decoder->limit > 0 && decoder->received > decoder->limit) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "Reached complete frame limit=%d for XML-RPC message (received %d bytes), closing conection id=%d",
+			    decoder->limit, decoder->received, vortex_connection_get_id (decoder->connection));
+		decoder->error = "reached complete frame limit";
+		vortex_connection_shutdown (decoder->connection);
+		return axl_false;
+	} /* end if */
+
+	/* frames are received without being joined, so MIME headers
+	 * were not processed by the reader */
+	if (first) {
+		payload = vortex_frame_get_payload (frame);
+		size    = vortex_frame_get_payload_size (frame);
+		if (size > 0 && payload[0] != '<' && ! __vortex_xml_rpc_is_binary (payload, size))
+			vortex_frame_mime_process (frame);
+	} /* end if */
+
+	if (! __vortex_xml_rpc_decoder_feed (decoder, vortex_frame_get_payload (frame), vortex_frame_get_payload_size (frame)))
+		return axl_false;
+
+	/* binary content is decoded at once */
+	if (decoder->binary && ! vortex_frame_get_more_flag (frame))
+		__vortex_xml_rpc_decoder_binary_finish (decoder);
+	return axl_true;
+}
+
+/**
+ * @internal Returns axl_true if a complete message was decoded.
+ */
+axl_bool __vortex_xml_rpc_decoder_is_finished (VortexXmlRpcDecoder * decoder)
+{
+	return decoder->error == NULL && decoder->finished;
+}
+
+/**
+ * @internal Builds the method call decoded. Values are moved into the
+ * method call returned.
+ */
+XmlRpcMethodCall * __vortex_xml_rpc_decoder_get_method_call (VortexXmlRpcDecoder * decoder)
+{
+	XmlRpcMethodCall * method_call;
+	int                iterator;
+
+	if (! __vortex_xml_rpc_decoder_is_finished (decoder))
+		return NULL;
+
+	/* binary content is decoded into a method call */
+	if (decoder->method_call) {
+		method_call          = decoder->method_call;
+		decoder->method_call = NULL;
+		return method_call;
+	} /* end if */
+	if (decoder->method_name == NULL)
+		return NULL;
+
+	method_call = method_call_new (decoder->ctx, decoder->method_name, axl_list_length (decoder->params));
+	for (iterator = 0; iterator < axl_list_length (decoder->params); iterator++)
+		method_call_add_value (method_call, axl_list_get_nth (decoder->params, iterator));
+
+	/* values are now owned by the method call */
+	axl_list_free (decoder->params);
+	decoder->params = NULL;
+
+	return method_call;
+}
+
+/**
+ * @internal Returns the value decoded (and ownership) for a method
+ * response, and if it is a fault reply.
+ */
+XmlRpcMethodValue * __vortex_xml_rpc_decoder_get_value (VortexXmlRpcDecoder * decoder, axl_bool * fault)
+{
+	XmlRpcMethodValue * value;
+
+	if (! __vortex_xml_rpc_decoder_is_finished (decoder))
+		return NULL;
+
+	value          = decoder->value;
+	decoder->value = NULL;
+	if (fault)
+		*fault = decoder->fault;
+	return value;
+}
+
+/** 
+ * @internal
+ *
+ * @brief Internal definition to transport parameters from \ref
+ * vortex_xml_rpc_invoke to the threaded function that finally do the
+ * work.
+ */
+typedef struct _VortexXmlRpcInvokeData {
+	VortexChannel        * channel;
+	XmlRpcMethodCall     * invocator;
+	XmlRpcInvokeNotify     reply_notify;
+	axlPointer             user_data;
+	/* reply being decoded */
+	VortexXmlRpcDecoder  * decoder;
+	/* msgno used to send the invocation */
+	int                    msg_no;
+}VortexXmlRpcInvokeData;
+
+/** 
+ * @internal
+ *
+ * @brief Invocations sent over a channel that are waiting for their
+ * reply. Several invocations can be in flight on the same channel
+ * (up to the pipeline depth configured), each reply being matched to
+ * its invocation by msgno.
+ */
+typedef struct _VortexXmlRpcPipeline {
+	VortexMutex            mutex;
+	/* invocations sent (VortexXmlRpcInvokeData), in msgno order */
+	axlList              * pending;
+	/* invocations accepted and not replied yet, including those
+	 * still not sent */
+	int                    in_flight;
+}VortexXmlRpcPipeline;
+
+/** 
+ * @internal Releases an invocation that is no longer pending.
+ */
+void __vortex_xml_rpc_invoke_data_free (axlPointer _data)
+{
+	VortexXmlRpcInvokeData * data = _data;
+
+	if (data == NULL)
+		return;
+	if (data->decoder != NULL)
+		__vortex_xml_rpc_decoder_free (data->decoder);
+	axl_free (data);
+	return;
+}
+
+/** 
+ * @internal Releases the pipeline associated to a channel (called
+ * once the channel is released).
+ */
+void __vortex_xml_rpc_pipeline_free (axlPointer _pipeline)
+{
+	VortexXmlRpcPipeline * pipeline = _pipeline;
+
+	if (pipeline == NULL)
+		return;
+	axl_list_free (pipeline->pending);
+	vortex_mutex_destroy (&pipeline->mutex);
+	axl_free (pipeline);
+	return;
+}
+
+/** 
+ * @internal Installs the invocation pipeline on a channel that has
+ * reached the ready state.
+ */
+void __vortex_xml_rpc_pipeline_install (VortexChannel * channel)
+{
+	VortexXmlRpcPipeline * pipeline;
+
+	pipeline = axl_new (VortexXmlRpcPipeline, 1);
+	if (pipeline == NULL)
+		return;
+	vortex_mutex_create (&pipeline->mutex);
+	pipeline->pending = axl_list_new (axl_list_always_return_1, __vortex_xml_rpc_invoke_data_free);
 
-		/* reference to the internal content for simple,
-		 * non-composite values. */
-		string_value = axl_node_get_content (child, NULL);
-		v_return_val_if_fail (string_value, NULL);
+	vortex_channel_set_data_full (channel, VORTEX_XML_RPC_PIPELINE, pipeline, NULL, __vortex_xml_rpc_pipeline_free);
+	return;
+}
 
-		vortex_log (VORTEX_LEVEL_DEBUG, "received simple value='%s'", 
-			    string_value ? string_value : "NULL");
+/** 
+ * @internal Reserves a slot on the channel pipeline for a new
+ * invocation.
+ *
+ * @return axl_true if the invocation can be sent, otherwise axl_false
+ * is returned (the pipeline depth was reached).
+ */
+axl_bool __vortex_xml_rpc_pipeline_reserve (VortexChannel * channel, int depth)
+{
+	VortexXmlRpcPipeline * pipeline = vortex_channel_get_data (channel, VORTEX_XML_RPC_PIPELINE);
+	axl_bool               result   = axl_false;
 
-		/* for each value tag, convert into XML-RPC parameter */
-		if (NODE_CMP_NAME (child, "i4") || NODE_CMP_NAME (child, "int"))
-			result        = method_value_new_from_string (ctx, XML_RPC_INT_VALUE, string_value);
-		
-		/* boolean case */
-		if (NODE_CMP_NAME (child, "boolean"))
-			result        = method_value_new_from_string (ctx, XML_RPC_BOOLEAN_VALUE, string_value);
-		
-		/* string case */
-		if (NODE_CMP_NAME (child, "string"))
-			result        = method_value_new_from_string (ctx, XML_RPC_STRING_VALUE, string_value);
-		       
-		/* double case */
-		if (NODE_CMP_NAME (child, "double"))
-			result        = method_value_new_from_string (ctx, XML_RPC_DOUBLE_VALUE, string_value);
-		
-		/* dateTime.iso8601 */
-		if (NODE_CMP_NAME (child, "dateTime.iso8601"))
-			result        = method_value_new_from_string (ctx, XML_RPC_DATE_VALUE, string_value);
-		
-		/* base64 case */
-		if (NODE_CMP_NAME (child, "base64"))
-			result        = method_value_new_from_string (ctx, XML_RPC_BASE64_VALUE, string_value);
-		
-		/* free and return */
-		return result;
-	}
-	
-	/* struct case */
-	if (NODE_CMP_NAME (child, "struct")) {
-		vortex_log (VORTEX_LEVEL_DEBUG, "received a complex value <struct>");
-		
-		/* parse the struct value */
-		result = __vortex_xml_rpc_parse_struct_value (ctx, child);
-		
-		vortex_log (VORTEX_LEVEL_DEBUG, "struct parsed: type %d", 
-			    method_value_get_type (result));
+	if (pipeline == NULL)
+		return axl_false;
 
-	}else if (NODE_CMP_NAME (child, "array")) {
-		/* array case */
-		vortex_log (VORTEX_LEVEL_DEBUG, "received a complex value <array> (2)");
-		
-		/* parse the array value */
-		result = __vortex_xml_rpc_parse_array_value (ctx, child);
+	vortex_mutex_lock (&pipeline->mutex);
+	if (pipeline->in_flight < depth) {
+		pipeline->in_flight++;
+		result = axl_true;
+	} /* end if */
+	vortex_mutex_unlock (&pipeline->mutex);
 
-		vortex_log (VORTEX_LEVEL_DEBUG, "array parsed: type %d", 
-			    method_value_get_type (result));
-	}
-	
-	/* release memory no longer used */
 	return result;
 }
 
+/** 
+ * @internal Returns the invocation waiting for the reply with the
+ * provided msgno.
+ */
+VortexXmlRpcInvokeData * __vortex_xml_rpc_pipeline_find (VortexXmlRpcPipeline * pipeline, int msg_no)
+{
+	VortexXmlRpcInvokeData * data = NULL;
+	int                      iterator;
+
+	vortex_mutex_lock (&pipeline->mutex);
+	/* replies are received in order, so the first one is usually
+	 * the one looked up */
+	for (iterator = 0; iterator < axl_list_length (pipeline->pending); iterator++) {
+		data = axl_list_get_nth (pipeline->pending, iterator);
+		if (data->msg_no == msg_no)
+			break;
+		data = NULL;
+	} /* end for */
+	vortex_mutex_unlock (&pipeline->mutex);
+
+	return data;
+}
 
 typedef struct _VortexXmlRpcBootData {
 	VortexConnection        * connection;
@@ -495,9 +1646,7 @@ typedef struct _VortexXmlRpcBootData {
 axlPointer __vortex_xml_rpc_boot_channel_process (VortexXmlRpcBootData * data)
 {
 	VortexConnection        * connection      = data->connection;
-#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
 	VortexCtx               * ctx             = vortex_connection_get_ctx (connection);
-#endif
 	char                    * serverName      = data->serverName;
 	char                    * resourceName    = data->resourceName;
 	VortexXmlRpcBootNotify    process_status  = data->process_status;
@@ -508,12 +1657,14 @@ axlPointer __vortex_xml_rpc_boot_channel_process (VortexXmlRpcBootData * data)
 	char                    * msg;
 	int                       code;
 	char                    * string_aux;
-	
+	axl_bool                  binary          = PTR_TO_INT (vortex_ctx_get_data (ctx, VORTEX_XML_RPC_USE_BINARY));
+
 	/* unref no longer needed data */
 	axl_free (data);
 
+ boot_channel:
 	/* create the channel piggybacking initial data (the bootmsg
-	 * token) */
+	 * token), offering the binary encoding if enabled */
 	queue   = vortex_async_queue_new ();
 	channel = vortex_channel_new_fullv (connection,   /* the connection where the channel will be created */
 					    0,            /* let Vortex Library to choose the next channel num ready */
@@ -523,20 +1674,42 @@ axlPointer __vortex_xml_rpc_boot_channel_process (VortexXmlRpcBootData * data)
 					    NULL, NULL,   /* default close channel handling */
 					    vortex_channel_queue_reply, queue,   /* set frame receiving handling using the queue */
 					    NULL, NULL,   /* perform channel creation in a blocking fashion */
-					    "<bootmsg resource='%s' />",
-					    (resourceName != NULL) ? resourceName : "/");
+					    "<bootmsg resource='%s'%s />",
+					    (resourceName != NULL) ? resourceName : "/",
+					    binary ? " encoding='binary'" : "");
 
-	/* record resource */
-	vortex_channel_set_data_full (channel, 
-				      /* key */
-				      XML_RPC_RESOURCE, resourceName,
-				      /* value */
-				      NULL, axl_free);
+	/* check for the channel returned. */
+	if (channel == NULL && binary && vortex_connection_pop_channel_error (connection, &code, &string_aux)) {
+		/* keep the error on the connection */
+		vortex_connection_push_channel_error (connection, code, string_aux);
+
+		/* peers without binary encoding support reject the
+		 * encoding attribute (bootmsg DTD validation, 501),
+		 * retry without it */
+		if (code == 501) {
+			vortex_log (VORTEX_LEVEL_WARNING, "XML-RPC channel boot with binary encoding rejected (%d: %s), retrying without it",
+				    code, string_aux);
+			axl_free (string_aux);
+			vortex_async_queue_unref (queue);
+			binary = axl_false;
+			goto boot_channel;
+		} /* end if */
+		axl_free (string_aux);
+	} /* end if */
 
+	/* record resource */
+	if (channel != NULL) {
+		vortex_channel_set_data_full (channel,
+					      /* key */
+					      XML_RPC_RESOURCE, resourceName,
+					      /* value */
+					      NULL, axl_free);
+	} else
+		axl_free (resourceName);
 
 	/* free no longer needed data */
 	axl_free (serverName);
-	
+
 	/* check for the channel returned. */
 	if (channel == NULL) {
 		/* unref queue */
@@ -593,9 +1766,13 @@ axlPointer __vortex_xml_rpc_boot_channel_process (VortexXmlRpcBootData * data)
 	/* seems that the remote peer have accepted to create the
 	 * XML-RPC channel. Because it is not a good idea to exec the
 	 * xml engine to parse only one tag against the DTD, we simply
-	 * check for the tag to be received and its content-lenght. */
-	if (!axl_cmp (vortex_frame_get_payload (reply), "<bootrpy />") ||
-	    vortex_frame_get_payload_size (reply) != 11) {
+	 * check for the tag to be received and its content-lenght
+	 * (the encoding is only accepted if it was offered) */
+	if (binary && axl_cmp (vortex_frame_get_payload (reply), "<bootrpy encoding='binary' />")) {
+		vortex_log (VORTEX_LEVEL_DEBUG, "XML-RPC channel will use binary encoding");
+		vortex_channel_set_data (channel, VORTEX_XML_RPC_BINARY_CHANNEL, INT_TO_PTR (axl_true));
+	} else if (!axl_cmp (vortex_frame_get_payload (reply), "<bootrpy />") ||
+		   vortex_frame_get_payload_size (reply) != 11) {
 		
 		/* notify error while booting XML-RPC channel */
 		__vortex_xml_rpc_notify (process_status, channel, VortexError, 
@@ -609,6 +1786,9 @@ axlPointer __vortex_xml_rpc_boot_channel_process (VortexXmlRpcBootData * data)
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "XML-RPC channel accepted");
 
+	/* install invocation pipeline */
+	__vortex_xml_rpc_pipeline_install (channel);
+
 	/* notify user space level */
 	__vortex_xml_rpc_notify (process_status, channel, VortexOk,
 				 "Channel XML-RPC ready and waiting, now let's RPC", user_data);
@@ -1083,70 +2263,48 @@ VortexChannel     * vortex_xml_rpc_channel_pool_get_next   (VortexConnection * c
 }
 
 
-/** 
+/**
  * @internal
  *
- * @brief Internal definition to transport parameters from \ref
- * vortex_xml_rpc_invoke to the threaded function that finally do the
- * work.
- */
-typedef struct _VortexXmlRpcInvokeData {
-	VortexChannel        * channel;
-	XmlRpcMethodCall     * invocator;
-	XmlRpcInvokeNotify     reply_notify;
-	axlPointer             user_data;
-}VortexXmlRpcInvokeData;
-
-
-/** 
- * @internal
- * 
  * Internal function used to get faultCode and faultString values,
- * from the XML-RPC response received. The node received points to the
- * <value> node which contains the <struct> structure with the desired
- * values.
+ * from the XML-RPC response received. The value received is the one
+ * found inside the <fault> node, which must be the <struct> structure
+ * with the desired values.
  */
-axl_bool      __vortex_xml_rpc_get_fault_values (VortexCtx          * ctx,
-						 axlNode            * node, 
-						 int                * faultCode, 
-						 char              ** faultString,
-						 XmlRpcMethodValue ** _value)
+axl_bool      __vortex_xml_rpc_get_fault_values (XmlRpcMethodValue  * value,
+						 int                * faultCode,
+						 char              ** faultString)
 {
-	XmlRpcMethodValue * value;
 	XmlRpcStruct      * _struct;
 
-	/* get the struct */
-	value = __vortex_xml_rpc_parse_value (ctx, node);
-
 	/* check that we have received an struct */
-	if (method_value_get_type (value) != XML_RPC_STRUCT_VALUE) {
-		method_value_free (value);
+	if (value == NULL || method_value_get_type (value) != XML_RPC_STRUCT_VALUE)
 		return axl_false;
-	}
 
 	/* get the struct inside */
 	_struct = vortex_xml_rpc_method_value_get_as_struct (value);
 
 	/* get the fault code */
 	*faultCode   = vortex_xml_rpc_struct_get_member_value_as_int (_struct, "faultCode");
-	
+
 	/* get the fault String */
 	*faultString = vortex_xml_rpc_struct_get_member_value_as_string (_struct, "faultString");
 
-	/* set the value reference */
-	*_value    = value;
-	
 	return axl_true;
 }
 
-/** 
+/**
  * @internal
  *
  * @brief Support function for the \ref __vortex_xml_rpc_invoke
  * function which actually perform the work of unmarshalling data
  * received due to a previous request performed, and executing the
  * proper handler into the application space.
- * 
+ *
+ * The reply is decoded as frames are received (the channel does not
+ * join them), so the handler is called once per frame and the reply
+ * is notified once the last one is received.
+ *
  * @param channel The channel where the XML-RPC reply is being
  * received.
  *
@@ -1154,82 +2312,90 @@ axl_bool      __vortex_xml_rpc_get_fault_values (VortexCtx          * ctx,
  *
  * @param frame The frame containing the XML-RPC method response data.
  *
- * @param user_data A VortexXmlRpcInvokeData containing, among other
- * data, the method to invoke.
+ * @param __pipeline The channel \ref VortexXmlRpcPipeline, used to
+ * find the invocation (VortexXmlRpcInvokeData) the reply belongs to.
  */
-void __vortex_xml_rpc_invoke_process_reply (VortexChannel      * channel, 
-					    VortexConnection   * connection, 
-					    VortexFrame        * frame, 
-					    axlPointer           __invocator_data)
+void __vortex_xml_rpc_invoke_process_reply (VortexChannel      * channel,
+					    VortexConnection   * connection,
+					    VortexFrame        * frame,
+					    axlPointer           __pipeline)
 {
-	/* invocation specific data received inside user_data and
-	 * provided once the invocation was initiated at
-	 * __vortex_xml_rpc_invoke */
-	VortexXmlRpcInvokeData * invocator_data  = __invocator_data;
-	XmlRpcInvokeNotify       reply_notify    = invocator_data->reply_notify;
-	axlPointer               user_data       = invocator_data->user_data;
+	VortexXmlRpcPipeline   * pipeline        = __pipeline;
+	VortexXmlRpcInvokeData * invocator_data;
+	XmlRpcInvokeNotify       reply_notify;
+	axlPointer               user_data;
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
 	VortexCtx              * ctx             = vortex_connection_get_ctx (connection);
+#endif
 	XmlRpcMethodValue      * value;
 	XmlRpcMethodResponse   * response        = NULL;
-
-	/* variable declaration for the xml stuff */
-	axlDoc                 * doc;
-	axlNode                * node;
-	axlError               * error;
+	VortexXmlRpcDecoder    * decoder;
+	axl_bool                 fault           = axl_false;
 
 	/* variables for fault errors */
 	char                   * faultString;
 	int                      faultCode;
-	
 
-	/* release memory hold by user_data, which contains a node of
-	   type VortexXmlRpcInvokeData */
+	/* find the invocation, provided once it was initiated at
+	 * __vortex_xml_rpc_invoke, associated to the reply */
+	invocator_data = (pipeline != NULL) ? __vortex_xml_rpc_pipeline_find (pipeline, vortex_frame_get_msgno (frame)) : NULL;
+	if (invocator_data == NULL) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "received reply msgno=%d on channel=%d without a pending XML-RPC invocation, dropping",
+			    vortex_frame_get_msgno (frame), vortex_channel_get_number (channel));
+		return;
+	} /* end if */
+	reply_notify = invocator_data->reply_notify;
+	user_data    = invocator_data->user_data;
+
+	/* decode frame content */
+	decoder = invocator_data->decoder;
+	if (decoder == NULL) {
+		decoder                 = __vortex_xml_rpc_decoder_new (channel, axl_false);
+		invocator_data->decoder = decoder;
+		__vortex_xml_rpc_decoder_feed_frame (decoder, frame, axl_true);
+	} else
+		__vortex_xml_rpc_decoder_feed_frame (decoder, frame, axl_false);
+
+	/* wait for the rest of the reply */
+	if (vortex_frame_get_more_flag (frame))
+		return;
+
+	/* remove the invocation from the pipeline, allowing the next
+	 * one to be sent, and release it (the decoder is kept) */
+	vortex_mutex_lock (&pipeline->mutex);
+	axl_list_unlink_ptr (pipeline->pending, invocator_data);
+	pipeline->in_flight--;
+	vortex_mutex_unlock (&pipeline->mutex);
 	axl_free (invocator_data);
 	vortex_log (VORTEX_LEVEL_DEBUG, "reply received, processing..");
 
 	/* flag the channel to have its reply processed */
 	vortex_channel_flag_reply_processed (channel, axl_true);
-	
-	/* parse incoming data */
-	doc = axl_doc_parse (vortex_frame_get_payload (frame), 
-			     vortex_frame_get_payload_size (frame), &error);
-	if (!doc) {
+
+	/* check decoding status */
+	if (! __vortex_xml_rpc_decoder_is_finished (decoder)) {
 		/* drop a log */
-		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to parse document received, error was: %s", axl_error_get (error));
-		axl_error_free (error);
+		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to parse document received, error was: %s",
+			    decoder->error ? decoder->error : "incomplete <methodResponse>");
 
 		/* notify user space  */
 		__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_BAD_REPLY_RECEIVED,
 						  -1, "unable to parse reply received due to a XML-RPC invocation, xml parsing in memory has failed.",
 						  channel, NULL, user_data);
 		/* nothing more to do */
-		return;
-	}
-	
-	/* get the root node */
-	node = axl_doc_get_root (doc);
-	if (! NODE_CMP_NAME (node, "methodResponse")) {
-
-		/* notify user space  */
-		__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_BAD_REPLY_RECEIVED,
-						  -1, "received a different top level tag where expected a <methodResponse>",
-						  channel, NULL, user_data);
-		/* nothing more to do */
-		axl_doc_free (doc);
+		__vortex_xml_rpc_decoder_free (decoder);
 		return;
 	}
 
-	/* walk into the first child */
-	node = axl_node_get_child_nth (node, 0);
+	/* get the value received */
+	value = __vortex_xml_rpc_decoder_get_value (decoder, &fault);
+	__vortex_xml_rpc_decoder_free (decoder);
 
 	/* check if we have received a fault reply */
-	if (NODE_CMP_NAME (node, "fault")) {
-
-		/* we got a fault reply, now point to the <value />  */
-		node = axl_node_get_child_nth (node, 0);
+	if (fault) {
 
 		/* get the fault error code and the fault string */
-		if (! __vortex_xml_rpc_get_fault_values (ctx, node, &faultCode, &faultString, &value)) {
+		if (! __vortex_xml_rpc_get_fault_values (value, &faultCode, &faultString)) {
 			/* notify the user space */
 			__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_BAD_REPLY_RECEIVED,
 							  -1, "Unable to decode the fault structure received, the remote peer is sending a not properly formated fault struct",
@@ -1239,64 +2405,35 @@ void __vortex_xml_rpc_invoke_process_reply (VortexChannel      * channel,
 			__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_FAULT_REPLY,
 							  faultCode,  faultString,
 							  channel, NULL, user_data);
-			/* free the struct received */
-			method_value_free (value);
 		}
 
-		/* free the document */
-		axl_doc_free (doc);
+		/* free the struct received */
+		if (value != NULL)
+			method_value_free (value);
 		return;
 	}
-	
-	/* we got something else, check if that is a params as a first
-	 * top level node */
-	if (NODE_CMP_NAME (node, "params")) {
-		/* perform here the code to read data received */
-		vortex_log (VORTEX_LEVEL_DEBUG, "received a positive response..");
-
-		/* we got a fault reply, now point to the <param />  */
-		node = axl_node_get_child_nth (node, 0);
-
-		/* now get the <value> node */
-		node = axl_node_get_child_nth (node, 0);
-
-		/* get the value */
-		value    = __vortex_xml_rpc_parse_value (ctx, node);
-		if (value != NULL) {
 
-			vortex_log (VORTEX_LEVEL_DEBUG, "received method value with type: (%d)", 
-				    method_value_get_type (value));
-			
-			/* create the response object */
-			response = vortex_xml_rpc_method_response_new (XML_RPC_OK,
-								       -1, NULL, /* fault code especification */
-								       value);
-			/* notify reply received */
-			__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_OK,
-							  -1, NULL,
-							  channel, response, user_data);
-		}else {
-			/* notify reply received */
-			__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_BAD_REPLY_RECEIVED,
-							  -1, "received a positive formated method response but, the content inside, is not properly formated",
-							  channel, NULL, user_data);
-		}
+	/* perform here the code to read data received */
+	if (value != NULL) {
+		vortex_log (VORTEX_LEVEL_DEBUG, "received method value with type: (%d)",
+			    method_value_get_type (value));
 
-		/* free the document */
-		axl_doc_free (doc);
+		/* create the response object */
+		response = vortex_xml_rpc_method_response_new (XML_RPC_OK,
+							       -1, NULL, /* fault code especification */
+							       value);
+		/* notify reply received */
+		__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_OK,
+						  -1, NULL,
+						  channel, response, user_data);
 		return;
 	}
-	
-	
+
 	/* it seems that we have received something that is not the
 	 * data expected */
 	__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_BAD_REPLY_RECEIVED,
-					  -1, "received a bad child top level node to <methodResponse>",
+					  -1, "received a positive formated method response but, the content inside, is not properly formated",
 					  channel, NULL, user_data);
-	/* nothing more to do */
-	axl_doc_free (doc);
-
-
 	return;
 }
 
@@ -1330,28 +2467,49 @@ axlPointer __vortex_xml_rpc_invoke (VortexXmlRpcInvokeData * data)
 #if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
 	VortexCtx            * ctx           = CHANNEL_CTX(channel);
 #endif
+	VortexXmlRpcPipeline * pipeline      = vortex_channel_get_data (channel, VORTEX_XML_RPC_PIPELINE);
 	char                 * message;
 	int                    message_size;
+	int                    msg_no        = -1;
 
-	/* marshall the message */
-	message = vortex_xml_rpc_method_call_marshall (invocator, &message_size);
+	/* marshall the message, using the binary encoding if it was
+	 * agreed at boot time */
+	if (vortex_xml_rpc_channel_is_binary (channel))
+		message = __vortex_xml_rpc_method_call_marshall_binary (invocator, &message_size);
+	else
+		message = vortex_xml_rpc_method_call_marshall (invocator, &message_size);
 	
-	/* set the new frame receive handler and its data */
-	vortex_channel_set_received_handler (channel, __vortex_xml_rpc_invoke_process_reply, data);
+	/* set the frame receive handler, which finds the invocation
+	 * each reply belongs to on the channel pipeline */
+	vortex_channel_set_received_handler (channel, __vortex_xml_rpc_invoke_process_reply, pipeline);
 	
-	/* perform the invocation */
-	vortex_log (VORTEX_LEVEL_DEBUG, "sending XML-RPC message: %s", message ? message : "null");
-	if (!vortex_channel_send_msg (channel, message, message_size, NULL)) {
+	/* register the invocation with the msgno it will use before
+	 * sending it, so its reply can't be processed before. The
+	 * pipeline isn't held while sending: the vortex reader takes
+	 * it to process replies */
+	vortex_mutex_lock (&pipeline->mutex);
+	msg_no       = vortex_channel_get_next_msg_no (channel);
+	data->msg_no = msg_no;
+	axl_list_append (pipeline->pending, data);
+	vortex_mutex_unlock (&pipeline->mutex);
+
+	vortex_log (VORTEX_LEVEL_DEBUG, "sending XML-RPC message (msgno=%d): %s", msg_no,
+		    message ? (vortex_xml_rpc_channel_is_binary (channel) ? "(binary)" : message) : "null");
+	if (! vortex_channel_send_msg_common (channel, message, message_size, msg_no, NULL, NULL, NULL, axl_false)) {
+		/* remove the invocation and release the slot
+		 * reserved */
+		vortex_mutex_lock (&pipeline->mutex);
+		axl_list_unlink_ptr (pipeline->pending, data);
+		pipeline->in_flight--;
+		vortex_mutex_unlock (&pipeline->mutex);
+
 		/* seems the invocation has failed */
 		__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_INVOCATION_FAILURE, 
 						  -1, "An error have happened while sending the XML-RPC request message.",
 						  channel, NULL, user_data);
 		/* release data node */
 		axl_free (data);
-
-		/* update the reference of the data refernce to NULL */
-		vortex_channel_set_received_handler (channel, __vortex_xml_rpc_invoke_process_reply, NULL);
-	}
+	} /* end if */
 	
 	/* release data no longer needed */
 	if (vortex_xml_rpc_method_call_must_release (invocator))
@@ -1385,6 +2543,10 @@ axlPointer __vortex_xml_rpc_invoke (VortexXmlRpcInvokeData * data)
  * function. If a blocking invocation mode is required check \ref
  * vortex_xml_rpc_invoke_sync.
  *
+ * By default, only one invocation can be waiting for its reply on
+ * the same channel. See \ref vortex_xml_rpc_set_pipeline_depth to
+ * allow several invocations in flight on the same channel.
+ *
  * See also: \ref XmlRpcMethodCall
  * 
  * @param channel The channel, running the XML-RPC profile, where the
@@ -1433,8 +2595,9 @@ axl_bool                 vortex_xml_rpc_invoke                  (VortexChannel
 		return axl_false;
 	}
 
-	/* check if the channel is waiting for a previous reply */
-	if (! vortex_channel_is_ready (channel)) {
+	/* check if the channel is waiting for previous replies (more
+	 * than the pipeline depth allows) */
+	if (! __vortex_xml_rpc_pipeline_reserve (channel, vortex_xml_rpc_get_pipeline_depth (ctx))) {
 		__vortex_xml_rpc_notify_response (reply_notify, XML_RPC_WAITING_PREVIOUS,
 						  -1, "An XML-RPC invocation was detected over a channel that is actually waiting for a previous invocation.",
 						  channel, NULL, user_data);
@@ -1616,86 +2779,57 @@ VortexXmlRpcState   vortex_xml_rpc_channel_status   (VortexChannel * channel)
  *
  * @brief Support function which perform the unmarshalling from an xml
  * representation into the XmlRpcMethodCall representation.
+ *
+ * Frames are decoded as they are received, keeping the decoder on
+ * the channel until the last frame of the message is received.
  * 
+ * @param channel The channel where the frame was received.
+ *
  * @param frame The frame containing a xml rpc method call object.
  * 
- * @return A newly allocated XmlRpcMethodCall or NULL if fails.
+ * @param more Reference that is set to axl_true if more frames are
+ * expected to complete the method call.
+ * 
+ * @return A newly allocated XmlRpcMethodCall or NULL if fails (or the
+ * method call is still not completed).
  */
-XmlRpcMethodCall * __vortex_xml_rpc_frame_received_parse_method_call (VortexFrame * frame)
+XmlRpcMethodCall * __vortex_xml_rpc_frame_received_parse_method_call (VortexChannel * channel,
+								      VortexFrame   * frame,
+								      axl_bool      * more)
 {
-	axlDoc            * doc;
-	axlNode           * node;
-	axlNode           * node_aux;
-	
-	const char        * method_name;
-	int                 param_count;
-	int                 iterator;
-
-	XmlRpcMethodCall  * method_call;
-	XmlRpcMethodValue * value;
+	VortexXmlRpcDecoder * decoder;
+	XmlRpcMethodCall    * method_call;
+#if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
 	/* get a reference to the context */
-	VortexCtx         * ctx = vortex_frame_get_ctx (frame);
-
-	/* parse incoming xml data */
-	doc = axl_doc_parse (vortex_frame_get_payload (frame), 
-			     vortex_frame_get_payload_size (frame), NULL);
-	if (!doc) {
-		vortex_log (VORTEX_LEVEL_DEBUG, "unable to parse incoming xml data");
-		return NULL;
-	}
-	
-	/* get method name */
-	method_name = axl_doc_get_content_at (doc, "/methodCall/methodName", NULL);
-	if (method_name == NULL) {
-		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to get method name value");
+	VortexCtx           * ctx = vortex_frame_get_ctx (frame);
+#endif
 
-		/* free the document */
-		axl_doc_free (doc);
+	/* get current decoder or create a new one */
+	decoder = vortex_channel_get_data (channel, XML_RPC_DECODER);
+	if (decoder == NULL) {
+		decoder = __vortex_xml_rpc_decoder_new (channel, axl_true);
+		vortex_channel_set_data_full (channel, XML_RPC_DECODER, decoder, NULL, __vortex_xml_rpc_decoder_free);
+		__vortex_xml_rpc_decoder_feed_frame (decoder, frame, axl_true);
+	} else
+		__vortex_xml_rpc_decoder_feed_frame (decoder, frame, axl_false);
+
+	/* wait for the rest of the method call */
+	(* more) = vortex_frame_get_more_flag (frame);
+	if (* more)
 		return NULL;
-	}
-
-	/* get a reference to the <params> node */
-	node        = axl_doc_get (doc, "/methodCall/params");
-
-	/* get how many childs have the <params> tag */
-	if (node != NULL)
-		param_count = axl_node_get_child_num (node);
-	else
-		param_count = 0;
-
-	vortex_log (VORTEX_LEVEL_DEBUG, "invocation detected for: %s, with %d parameters", method_name, param_count);
-
-	/* build the method call */
-	method_call = method_call_new (vortex_frame_get_ctx (frame), method_name, param_count);
-
-	/* now get all parameters */
-	iterator = 0;
-	while ((param_count > 0) && (iterator < axl_node_get_child_num (node))) {
-		
-		/* get a reference a reference to the <param> tag */
-		node_aux = axl_node_get_child_nth (node, iterator);
-
-		vortex_log (VORTEX_LEVEL_DEBUG, "node name=<%s>", 
-		       axl_node_get_name (node_aux));
-		
-		/* get a referece to the <value> tag inside */
-		node_aux = axl_node_get_child_nth (node_aux, 0);
 
-		vortex_log (VORTEX_LEVEL_DEBUG, "node name(2)=<%s>", 
-		       axl_node_get_name (node_aux));
-
-		/* parse param value and add it to the method call */
-		value = __vortex_xml_rpc_parse_value (ctx, node_aux);
-		
-		/* add the value to the method call */
-		method_call_add_value (method_call, value);
-		
-		/* get a reference to the next element */
-		iterator++;
-	}
+	/* get the method call decoded */
+	method_call = __vortex_xml_rpc_decoder_get_method_call (decoder);
+	if (method_call == NULL) {
+		vortex_log (VORTEX_LEVEL_CRITICAL, "unable to parse incoming xml data: %s",
+			    decoder->error ? decoder->error : "incomplete <methodCall>");
+	} else {
+		vortex_log (VORTEX_LEVEL_DEBUG, "invocation detected for: %s, with %d parameters", 
+			    method_call_get_name (method_call), method_call_get_num_params (method_call));
+	} /* end if */
 
-	/* free xml document */
-	axl_doc_free (doc);
+	/* release the decoder (set_data_full releases it) */
+	vortex_channel_delete_data (channel, XML_RPC_DECODER);
 
 	/* return method call received */
 	return method_call;
@@ -1717,13 +2851,15 @@ void __vortex_xml_rpc_frame_received (VortexChannel    * channel,
 	VortexXmlRpcServiceDispatchNode  * dispatch_node;
 	int                                iterator;
 	axlList                          * service_dispatch;
+	axl_bool                           more = axl_false;
 
 	vortex_log (VORTEX_LEVEL_DEBUG, "frame received on XML-RPC channel");
 
 	/* get method call received */
-	method_call = __vortex_xml_rpc_frame_received_parse_method_call (frame);
+	method_call = __vortex_xml_rpc_frame_received_parse_method_call (channel, frame, &more);
 	if (method_call == NULL) {
-		/* return without doing nothing */
+		/* return without doing nothing (or wait for the rest
+		 * of the method call) */
 		return;
 	}
 
@@ -1821,8 +2957,9 @@ void __vortex_xml_rpc_frame_received (VortexChannel    * channel,
  * filled.
  */
 axl_bool      __vortex_xml_rpc_parse_bootmsg (VortexCtx   * ctx,
-					      const char  *  profile_content, 
-					      char       ** resource, 
+					      const char  *  profile_content,
+					      char       ** resource,
+					      axl_bool    *  binary,
 					      char       ** profile_content_reply)
 {
 	axlDtd    * xml_rpc_dtd;
@@ -1885,6 +3022,9 @@ axl_bool      __vortex_xml_rpc_parse_bootmsg (VortexCtx   * ctx,
 		return axl_false;
 	}
 
+	/* check if binary encoding was requested */
+	(* binary) = axl_cmp (axl_node_get_attribute_value (bootmsg, "encoding"), "binary");
+
 	/* free the document loaded */
 	axl_doc_free (doc);
 
@@ -1933,10 +3073,15 @@ axl_bool      __vortex_xml_rpc_start_msg (const char        * profile,
 	axl_bool                           accept = axl_false;
 	VortexChannel                    * channel;
 	axlList                          * service_dispatch;
+	axl_bool                           binary = axl_false;
 
-	if (!__vortex_xml_rpc_parse_bootmsg (ctx, profile_content, &resource, profile_content_reply))
+	if (!__vortex_xml_rpc_parse_bootmsg (ctx, profile_content, &resource, &binary, profile_content_reply))
 		return axl_false;
 
+	/* only use binary encoding if it is enabled */
+	if (! PTR_TO_INT (vortex_ctx_get_data (ctx, VORTEX_XML_RPC_USE_BINARY)))
+		binary = axl_false;
+
 	vortex_log (VORTEX_LEVEL_DEBUG, "start message received on XML-RPC channel resource=%s",
 	       resource);
 
@@ -1965,14 +3110,23 @@ axl_bool      __vortex_xml_rpc_start_msg (const char        * profile,
 	
 	/* reply with a bootrpy or an error message, accepting the channel to be created */
 	if (accept) {
-		/* configure positive reply */
-		(* profile_content_reply) = axl_strdup ("<bootrpy />");
-		
+		/* configure positive reply (accepting the binary
+		 * encoding if it was offered) */
+		(* profile_content_reply) = axl_strdup (binary ? "<bootrpy encoding='binary' />" : "<bootrpy />");
+
 		/* set the resource booted to allow the channel to be classified */
 		channel = vortex_connection_get_channel (connection, channel_num);
-		vortex_log (VORTEX_LEVEL_DEBUG, "configure channel=%d resource=%s", 
-			    channel_num, resource);
+		vortex_log (VORTEX_LEVEL_DEBUG, "configure channel=%d resource=%s binary=%d",
+			    channel_num, resource, binary);
 		vortex_channel_set_data_full (channel, XML_RPC_RESOURCE, resource, NULL, axl_free);
+		if (binary)
+			vortex_channel_set_data (channel, VORTEX_XML_RPC_BINARY_CHANNEL, INT_TO_PTR (axl_true));
+
+		/* decode method calls while they are received */
+		__vortex_xml_rpc_configure_channel (channel);
+
+		/* install invocation pipeline */
+		__vortex_xml_rpc_pipeline_install (channel);
 		
 	} else {
 		/* free resource because a negative reply is being generated */
@@ -2001,6 +3155,133 @@ const char  * vortex_xml_rpc_channel_get_resource (VortexChannel * channel)
 	return vortex_channel_get_data (channel, XML_RPC_RESOURCE);
 }
 
+/**
+ * @brief Allows to configure if XML-RPC channels created or accepted
+ * on the provided context can use the binary encoding.
+ *
+ * The encoding is disabled by default. When enabled, channels
+ * created by \ref vortex_xml_rpc_boot_channel offer the binary
+ * encoding to the remote peer, and channels accepted use it if the
+ * remote peer offered it. The encoding is only used if both peers
+ * enable it, so peers not supporting it keep using XML. Peers
+ * without binary encoding support reject the offer (the bootmsg
+ * fails DTD validation with a 501 error): in that case, the channel
+ * boot is retried without it (the error is kept on the connection,
+ * see \ref vortex_connection_pop_channel_error).
+ *
+ * The binary encoding represents values with a compact type-length
+ * value format, which reduces the size and the time required to
+ * encode and decode method calls and responses, especially for
+ * numeric values.
+ *
+ * @param ctx The context to configure.
+ *
+ * @param enable axl_true to enable the binary encoding, otherwise
+ * axl_false to always use XML.
+ */
+void          vortex_xml_rpc_set_binary_encoding (VortexCtx * ctx, axl_bool enable)
+{
+	if (ctx == NULL)
+		return;
+
+	/* store the configuration */
+	vortex_ctx_set_data (ctx, VORTEX_XML_RPC_USE_BINARY, INT_TO_PTR (enable));
+	return;
+}
+
+/**
+ * @brief Allows to check if the provided XML-RPC channel is using the
+ * binary encoding (see \ref vortex_xml_rpc_set_binary_encoding).
+ *
+ * @param channel The XML-RPC channel to check.
+ *
+ * @return axl_true if the channel is using the binary encoding,
+ * otherwise axl_false is returned.
+ */
+axl_bool      vortex_xml_rpc_channel_is_binary (VortexChannel * channel)
+{
+	if (channel == NULL)
+		return axl_false;
+	return PTR_TO_INT (vortex_channel_get_data (channel, VORTEX_XML_RPC_BINARY_CHANNEL));
+}
+
+/**
+ * @brief Allows to configure how many XML-RPC invocations can be in
+ * flight on the same channel (pipeline depth).
+ *
+ * By default, the depth is 1: \ref vortex_xml_rpc_invoke rejects an
+ * invocation (\ref XML_RPC_WAITING_PREVIOUS) while the channel is
+ * waiting for the reply to a previous one. With a depth greater than
+ * 1, new invocations are sent without waiting for previous replies,
+ * up to the depth configured. Each reply is notified to the handler
+ * provided with its invocation.
+ *
+ * Replies are processed in the same order invocations were sent
+ * (BEEP requires replies to be sent in order), so a slow service
+ * delays replies to the invocations that follow it on the same
+ * channel.
+ *
+ * @param ctx The context to configure.
+ *
+ * @param depth The number of invocations allowed in flight on each
+ * channel. Values lower than 1 are taken as 1.
+ */
+void          vortex_xml_rpc_set_pipeline_depth (VortexCtx * ctx, int depth)
+{
+	if (ctx == NULL)
+		return;
+	if (depth < 1)
+		depth = 1;
+
+	/* store the configuration */
+	vortex_ctx_set_data (ctx, VORTEX_XML_RPC_PIPELINE_DEPTH, INT_TO_PTR (depth));
+	return;
+}
+
+/**
+ * @brief Allows to get current pipeline depth configured (see \ref
+ * vortex_xml_rpc_set_pipeline_depth).
+ *
+ * @param ctx The context where the depth is checked.
+ *
+ * @return The pipeline depth (1 if not configured).
+ */
+int           vortex_xml_rpc_get_pipeline_depth (VortexCtx * ctx)
+{
+	int depth;
+
+	if (ctx == NULL)
+		return 1;
+	depth = PTR_TO_INT (vortex_ctx_get_data (ctx, VORTEX_XML_RPC_PIPELINE_DEPTH));
+	return (depth < 1) ? 1 : depth;
+}
+
+/**
+ * @brief Allows to get the number of XML-RPC invocations in flight
+ * (not replied yet) on the provided channel.
+ *
+ * @param channel The XML-RPC channel to check.
+ *
+ * @return The number of invocations in flight or -1 if the channel
+ * is not an XML-RPC channel at the ready state.
+ */
+int           vortex_xml_rpc_channel_in_flight (VortexChannel * channel)
+{
+	VortexXmlRpcPipeline * pipeline;
+	int                    result;
+
+	if (channel == NULL)
+		return -1;
+	pipeline = vortex_channel_get_data (channel, VORTEX_XML_RPC_PIPELINE);
+	if (pipeline == NULL)
+		return -1;
+
+	vortex_mutex_lock (&pipeline->mutex);
+	result = pipeline->in_flight;
+	vortex_mutex_unlock (&pipeline->mutex);
+	return result;
+}
+
 /** 
  * @brief Allows to notify a reply that has been generated from the
  * given \ref XmlRpcMethodCall object.
@@ -2044,8 +3325,11 @@ axl_bool  vortex_xml_rpc_notify_reply (XmlRpcMethodCall     * method_call,
 	ctx = vortex_channel_get_ctx (channel);
 #endif
 
-	/* get the xml representation for the method reply */
-	reply_string = vortex_xml_rpc_method_response_marshall (method_response, &reply_size);
+	/* get the xml (or binary) representation for the method reply */
+	if (vortex_xml_rpc_channel_is_binary (channel))
+		reply_string = __vortex_xml_rpc_method_response_marshall_binary (method_response, &reply_size);
+	else
+		reply_string = vortex_xml_rpc_method_response_marshall (method_response, &reply_size);
 
 	/* check if a marshalled reply was received */
 	if (reply_string != NULL && reply_size > 0) {
@@ -67,6 +67,12 @@ BEGIN_C_DECLS
  */
 #define XML_RPC_RESOURCE "vortex-xml-rpc:resource"
 
+/** 
+ * @brief String used to store the method call being decoded on a
+ * xml-rpc channel.
+ */
+#define XML_RPC_DECODER "vortex-xml-rpc:decoder"
+
 /** 
  * @brief Async notification handler for the XML-RPC channel boot.
  *
@@ -313,6 +319,18 @@ VortexXmlRpcState   vortex_xml_rpc_channel_status          (VortexChannel * chan
 
 const char        * vortex_xml_rpc_channel_get_resource    (VortexChannel * channel);
 
+void                vortex_xml_rpc_set_binary_encoding     (VortexCtx     * ctx,
+							    axl_bool        enable);
+
+axl_bool            vortex_xml_rpc_channel_is_binary       (VortexChannel * channel);
+
+void                vortex_xml_rpc_set_pipeline_depth      (VortexCtx     * ctx,
+							    int             depth);
+
+int                 vortex_xml_rpc_get_pipeline_depth      (VortexCtx     * ctx);
+
+int                 vortex_xml_rpc_channel_in_flight       (VortexChannel * channel);
+
 axl_bool            vortex_xml_rpc_accept_negotiation      (VortexCtx                    * ctx,
 							    VortexXmlRpcValidateResource   validate_resource,
 							    axlPointer                     validate_user_data,
@@ -1271,8 +1271,176 @@ XmlRpcArray       * vortex_xml_rpc_method_call_get_param_value_as_array  (XmlRpc
 	return vortex_xml_rpc_method_value_get_as_array (value);	
 }
 
+/** 
+ * @internal Growable buffer used to marshall XML-RPC content. Content
+ * is appended at the end, doubling the buffer when required, so
+ * marshalling a value with N items takes linear time (instead of
+ * copying the whole content built so far for each item).
+ */
+typedef struct _XmlRpcMarshallStream {
+	char  * content;
+	int     length;
+	int     size;
+} XmlRpcMarshallStream;
+
+/** 
+ * @internal Initial size for marshall streams.
+ */
+#define XML_RPC_MARSHALL_STREAM_SIZE 512
+
+/** 
+ * @internal Appends the provided content into the stream.
+ * 
+ * @param stream The stream where the content will be appended.
+ * @param content The content to append.
+ * @param length Content length or -1 to use strlen.
+ */
+void __vortex_xml_rpc_stream_append (XmlRpcMarshallStream * stream, const char * content, int length)
+{
+	if (content == NULL)
+		return;
+	if (length < 0)
+		length = strlen (content);
+
+	/* check if the content fits (including the trailing \0) */
+	if (stream->length + length + 1 > stream->size) {
+		if (stream->size == 0)
+			stream->size = XML_RPC_MARSHALL_STREAM_SIZE;
+		while (stream->length + length + 1 > stream->size)
+			stream->size = stream->size * 2;
+		stream->content = axl_realloc (stream->content, stream->size);
+	} /* end if */
+
+	memcpy (stream->content + stream->length, content, length);
+	stream->length += length;
+	stream->content[stream->length] = 0;
+	return;
+}
+
+/** 
+ * @internal Appends the provided constant string into the stream.
+ */
+#define __vortex_xml_rpc_stream_append_const(stream, content) __vortex_xml_rpc_stream_append (stream, content, sizeof (content) - 1)
+
+/** 
+ * @internal Appends the provided integer value into the stream.
+ */
+void __vortex_xml_rpc_stream_append_int (XmlRpcMarshallStream * stream, int value)
+{
+	char buffer[24];
+	int  length;
+
+	length = snprintf (buffer, sizeof (buffer), "%d", value);
+	__vortex_xml_rpc_stream_append (stream, buffer, length);
+	return;
+}
+
+/** 
+ * @internal Appends the provided double value into the stream.
+ */
+void __vortex_xml_rpc_stream_append_double (XmlRpcMarshallStream * stream, double value)
+{
+	char buffer[64];
+	int  length;
+
+	length = snprintf (buffer, sizeof (buffer), "%g", value);
+	__vortex_xml_rpc_stream_append (stream, buffer, length);
+	return;
+}
+
 /* function prototype */
-char  * vortex_xml_rpc_marshall_method_value (XmlRpcMethodValue * value);
+void __vortex_xml_rpc_stream_marshall_value (XmlRpcMarshallStream * stream, XmlRpcMethodValue * value);
+
+/** 
+ * @internal Marshalls the provided struct into the stream.
+ */
+void __vortex_xml_rpc_stream_marshall_struct (XmlRpcMarshallStream * stream, XmlRpcStruct * _struct)
+{
+	int iterator;
+
+	__vortex_xml_rpc_stream_append_const (stream, "<struct>");
+	for (iterator = 0; iterator < _struct->added_count; iterator++) {
+		__vortex_xml_rpc_stream_append_const (stream, "<member><name>");
+		__vortex_xml_rpc_stream_append (stream, _struct->members[iterator]->name, -1);
+		__vortex_xml_rpc_stream_append_const (stream, "</name>");
+		__vortex_xml_rpc_stream_marshall_value (stream, _struct->members[iterator]->value);
+		__vortex_xml_rpc_stream_append_const (stream, "</member>");
+	} /* end for */
+	__vortex_xml_rpc_stream_append_const (stream, "</struct>");
+	return;
+}
+
+/** 
+ * @internal Marshalls the provided array into the stream.
+ */
+void __vortex_xml_rpc_stream_marshall_array (XmlRpcMarshallStream * stream, XmlRpcArray * array)
+{
+	int iterator;
+
+	__vortex_xml_rpc_stream_append_const (stream, "<array><data>");
+	for (iterator = 0; iterator < array->added_count; iterator++) 
+		__vortex_xml_rpc_stream_marshall_value (stream, array->values[iterator]);
+	__vortex_xml_rpc_stream_append_const (stream, "</data></array>");
+	return;
+}
+
+/** 
+ * @internal Marshalls the provided method value into the stream
+ * (including its <value> node).
+ */
+void __vortex_xml_rpc_stream_marshall_value (XmlRpcMarshallStream * stream, XmlRpcMethodValue * value)
+{
+	switch (method_value_get_type (value)) {
+	case XML_RPC_INT_VALUE:
+		__vortex_xml_rpc_stream_append_const (stream, "<value><i4>");
+		__vortex_xml_rpc_stream_append_int (stream, value->value.int_value);
+		__vortex_xml_rpc_stream_append_const (stream, "</i4></value>");
+		break;
+	case XML_RPC_BOOLEAN_VALUE:
+		__vortex_xml_rpc_stream_append_const (stream, "<value><boolean>");
+		__vortex_xml_rpc_stream_append_int (stream, value->value.int_value);
+		__vortex_xml_rpc_stream_append_const (stream, "</boolean></value>");
+		break;
+	case XML_RPC_DOUBLE_VALUE:
+		__vortex_xml_rpc_stream_append_const (stream, "<value><double>");
+		__vortex_xml_rpc_stream_append_double (stream, value->value.double_value);
+		__vortex_xml_rpc_stream_append_const (stream, "</double></value>");
+		break;
+	case XML_RPC_STRING_VALUE:
+	case XML_RPC_STRING_REF_VALUE:
+		__vortex_xml_rpc_stream_append_const (stream, "<value><string><![CDATA[");
+		__vortex_xml_rpc_stream_append (stream, value->value.string_value, -1);
+		__vortex_xml_rpc_stream_append_const (stream, "]]></string></value>");
+		break;
+	case XML_RPC_DATE_VALUE:
+		/* not implemented yet */
+		break;
+	case XML_RPC_BASE64_VALUE:
+	case XML_RPC_BASE64_REF_VALUE:
+		/* content is already encoded */
+		__vortex_xml_rpc_stream_append_const (stream, "<value><base64>");
+		__vortex_xml_rpc_stream_append (stream, value->value.string_value, -1);
+		__vortex_xml_rpc_stream_append_const (stream, "</base64></value>");
+		break;
+	case XML_RPC_STRUCT_VALUE:
+		__vortex_xml_rpc_stream_append_const (stream, "<value>");
+		__vortex_xml_rpc_stream_marshall_struct (stream, value->value.rpc_struct);
+		__vortex_xml_rpc_stream_append_const (stream, "</value>");
+		break;
+	case XML_RPC_ARRAY_VALUE:
+		__vortex_xml_rpc_stream_append_const (stream, "<value>");
+		__vortex_xml_rpc_stream_marshall_array (stream, value->value.rpc_array);
+		__vortex_xml_rpc_stream_append_const (stream, "</value>");
+		break;
+	case XML_RPC_NONE_VALUE:
+		__vortex_xml_rpc_stream_append_const (stream, "<value><none /></value>");
+		break;
+	default:
+		/* nothing to do */
+		break;
+	}
+	return;
+}
 
 /** 
  * @internal
@@ -1287,44 +1455,10 @@ char  * vortex_xml_rpc_marshall_method_value (XmlRpcMethodValue * value);
  */
 char  * vortex_xml_rpc_types_marshall_struct (XmlRpcStruct * _struct)
 {
-	char  * stream_aux;
-	char  * stream_aux2;
-	char  * stream_result;
-	int     iterator;
-	
-
-	/* initial struct header */
-	stream_result = axl_strdup ("<struct>");
-	iterator      = 0;
+	XmlRpcMarshallStream stream = {NULL, 0, 0};
 
-	while (iterator < _struct->added_count) {
-
-		/* marshall the method member */
-		stream_aux2 = vortex_xml_rpc_marshall_method_value (_struct->members[iterator]->value);
-		
-		/* get the member representation */
-		stream_aux  = axl_strdup_printf ("%s<member><name>%s</name>%s</member>",
-						 stream_result,
-						 _struct->members[iterator]->name,
-						 stream_aux2);
-
-		/* release the member method value allocated */
-		axl_free (stream_aux2);
-		axl_free (stream_result);
-
-		/* update the new stream result */
-		stream_result = stream_aux;
-
-		/* update iterator count */
-		iterator++;
-	}
-	
-	/* add final representation for the struct */
-	stream_aux   = stream_result;
-	stream_result = axl_strdup_printf ("%s</struct>", stream_result);
-	axl_free (stream_aux);
-	
-	return stream_result;
+	__vortex_xml_rpc_stream_marshall_struct (&stream, _struct);
+	return stream.content;
 }
 
 
@@ -1340,42 +1474,10 @@ char  * vortex_xml_rpc_types_marshall_struct (XmlRpcStruct * _struct)
  */
 char  * vortex_xml_rpc_types_marshall_array (XmlRpcArray * array)
 {
-	char  * stream_aux;
-	char  * stream_aux2;
-	char  * stream_result;
-	int     iterator;
-
-	/* initial struct header */
-	stream_result = axl_strdup ("<array><data>");
-	iterator      = 0;
-
-	while (iterator < array->added_count) {
-
-		/* marshall the method member */
-		stream_aux2 = vortex_xml_rpc_marshall_method_value (array->values[iterator]);
-		
-		/* get the member representation */
-		stream_aux  = axl_strdup_printf ("%s%s",
-						 stream_result,
-						 stream_aux2);
+	XmlRpcMarshallStream stream = {NULL, 0, 0};
 
-		/* release the member method value allocated */
-		axl_free (stream_aux2);
-		axl_free (stream_result);
-
-		/* update the new stream result */
-		stream_result = stream_aux;
-
-		/* update iterator count */
-		iterator++;
-	}
-	
-	/* add final representation for the struct */
-	stream_aux    = stream_result;
-	stream_result = axl_strdup_printf ("%s</data></array>", stream_result);
-	axl_free (stream_aux);
-	
-	return stream_result;
+	__vortex_xml_rpc_stream_marshall_array (&stream, array);
+	return stream.content;
 }
 
 /** 
@@ -1389,65 +1491,10 @@ char  * vortex_xml_rpc_types_marshall_array (XmlRpcArray * array)
  */
 char  * vortex_xml_rpc_marshall_method_value (XmlRpcMethodValue * value)
 {
-	char  * stream_result;
-	char  * stream_aux;
-
-	switch (method_value_get_type (value)) {
-	case XML_RPC_INT_VALUE:
-		return axl_strdup_printf ("<value><i4>%d</i4></value>", 
-					  method_value_get_as_int (value));
-		break;
-	case XML_RPC_BOOLEAN_VALUE:
-		return axl_strdup_printf ("<value><boolean>%d</boolean></value>", 
-					  method_value_get_as_int (value));
-	case XML_RPC_DOUBLE_VALUE:
-		return axl_strdup_printf ("<value><double>%g</double></value>", 
-					  method_value_get_as_double (value));
-		break;
-	case XML_RPC_STRING_VALUE:
-		return axl_strdup_printf ("<value><string><![CDATA[%s]]></string></value>",
-					  (char  *) value->value.string_value);
-		break;
-	case XML_RPC_DATE_VALUE:
-		/* not implemented yet */
-		break;
+	XmlRpcMarshallStream stream = {NULL, 0, 0};
 
-	case XML_RPC_BASE64_VALUE:
-		/* not implemented yet */
-		break;
-	case XML_RPC_STRUCT_VALUE:
-		/* marshall the value */
-		stream_aux    = vortex_xml_rpc_types_marshall_struct (value->value.rpc_struct);
-		
-		/* use the value marshalled */
-		stream_result = axl_strdup_printf ("<value>%s</value>",
-						   stream_aux);
-		/* free the marshalled value */
-		axl_free (stream_aux);
-
-		return stream_result;
-	case XML_RPC_ARRAY_VALUE:
-		/* marshall the value */
-		stream_aux    = vortex_xml_rpc_types_marshall_array (value->value.rpc_array);
-		
-		/* use the value marshalled */
-		stream_result = axl_strdup_printf ("<value>%s</value>",
-						   stream_aux);
-		/* free the marshalled value */
-		axl_free (stream_aux);
-
-		return stream_result;
-		break;
-	case XML_RPC_NONE_VALUE:
-		/* return the none value */
-		return axl_strdup_printf ("<value><none /></value>");
-	default:
-		/* nothing to do */
-		return NULL;
-	}
-	
-	/* this point is never reached */
-	return NULL;
+	__vortex_xml_rpc_stream_marshall_value (&stream, value);
+	return stream.content;
 }
 
 /**
@@ -1501,12 +1548,8 @@ char              * vortex_xml_rpc_method_call_marshall     (XmlRpcMethodCall  *
 #if defined(ENABLE_VORTEX_LOG) && ! defined(SHOW_FORMAT_BUGS)
 	VortexCtx         * ctx = METHOD_CALL_CTX(method_call);
 #endif
-	XmlRpcMethodValue * value;
-	char              * stream_result;
-	char              * stream_aux;
-	char              * stream_aux2;
-
-	int                 iterator;
+	XmlRpcMarshallStream stream = {NULL, 0, 0};
+	int                  iterator;
 
 	v_return_val_if_fail_msg (method_call, NULL, 
 				  "failed to marshall method call, received null reference for method call");
@@ -1514,60 +1557,35 @@ char              * vortex_xml_rpc_method_call_marshall     (XmlRpcMethodCall  *
 				  "failed to marshall method call, number of parameters added do not match (added count != count)");
 
 	/* get initial method header */
-	stream_result = axl_strdup_printf ("<?xml version=\"1.0\"?><methodCall><methodName>%s</methodName>",
-					   method_call->methodName);
+	__vortex_xml_rpc_stream_append_const (&stream, "<?xml version=\"1.0\"?><methodCall><methodName>");
+	__vortex_xml_rpc_stream_append (&stream, method_call->methodName, -1);
+	__vortex_xml_rpc_stream_append_const (&stream, "</methodName>");
 
 	/* if the method have at least one parameter, add them */
 	if (method_call->count > 0) {
-		/* get a refence to the previous message, add initial
-		 * <params> header and release no longer used
-		 * memory */
-		stream_aux    = stream_result;
-		stream_result = axl_strdup_printf ("%s<params>", stream_aux);
-		axl_free (stream_aux);
+		__vortex_xml_rpc_stream_append_const (&stream, "<params>");
 
 		/* iterate over all param values */
 		for (iterator = 0; iterator < method_call->count; iterator++) {
-			/* get a reference to the value */
-			value       = method_call_get_param_value (method_call, iterator);
-			
 			/* marshall the param value according to its type */
-			stream_aux  = vortex_xml_rpc_marshall_method_value (value);
-			
-			/* get the concatenated result */
-			stream_aux2 = axl_strdup_printf ("%s<param>%s</param>", stream_result, stream_aux);
-			
-			/* free previous data */
-			axl_free (stream_aux);
-			axl_free (stream_result);
-
-			/* set the new stream result */
-			stream_result = stream_aux2;
-
+			__vortex_xml_rpc_stream_append_const (&stream, "<param>");
+			__vortex_xml_rpc_stream_marshall_value (&stream, method_call_get_param_value (method_call, iterator));
+			__vortex_xml_rpc_stream_append_const (&stream, "</param>");
 		}
 
 		/* finally close the param values section for the
 		 * invocation xml message */
-		stream_aux    = stream_result;
-		stream_result = axl_strdup_printf ("%s</params>", 
-						   (stream_aux != NULL) ? stream_aux : NULL);
-		axl_free (stream_aux);
+		__vortex_xml_rpc_stream_append_const (&stream, "</params>");
 	}
 
 	/* close the message and return the value */
-	stream_aux    = stream_result;
-	stream_result = axl_strdup_printf ("%s</methodCall>", stream_aux);
-	axl_free (stream_aux);
+	__vortex_xml_rpc_stream_append_const (&stream, "</methodCall>");
 	
-	/* return current result, setting current size. The following
-	 * operation is based on strlen operation. This is ok because
-	 * XML-RPC standard doesn't support raw binary formats. To
-	 * include binary data, it should be encoded into a base64
-	 * format.
-	 */
+	/* return current result, setting current size (already
+	 * tracked by the stream, no strlen required) */
 	if (size != NULL) 
-		(* size ) = strlen (stream_result);
-	return stream_result;
+		(* size ) = stream.length;
+	return stream.content;
 }
 
 
@@ -2146,8 +2164,8 @@ void                   vortex_xml_rpc_method_response_nullify          (XmlRpcMe
 char                 * vortex_xml_rpc_method_response_marshall         (XmlRpcMethodResponse * response,
 									int                  * size)
 {
-	char  * result     = NULL;
-	char  * string_aux = NULL;
+	char                 * result     = NULL;
+	XmlRpcMarshallStream   stream     = {NULL, 0, 0};
 	
 	/* check received method response */
 	v_return_val_if_fail (response, NULL);
@@ -2190,19 +2208,16 @@ char                 * vortex_xml_rpc_method_response_marshall         (XmlRpcMe
 						    response->value->value.string_value);
 			break;
 		case XML_RPC_STRUCT_VALUE:
-			/* marshall the struct */
-			string_aux = vortex_xml_rpc_types_marshall_struct (response->value->value.rpc_struct);
-			result     = axl_strdup_printf ("<?xml version=\"1.0\"?><methodResponse><params><param><value>%s</value></param></params></methodResponse>",
-							string_aux);
-			axl_free (string_aux);
-			break;
 		case XML_RPC_ARRAY_VALUE:
-			/* marshall the array received */
-			string_aux = vortex_xml_rpc_types_marshall_array (response->value->value.rpc_array);
-			result     = axl_strdup_printf ("<?xml version=\"1.0\"?><methodResponse><params><param><value>%s</value></param></params></methodResponse>",
-						      string_aux);
-			axl_free (string_aux);
-			break;
+			/* marshall the struct or array received into
+			 * the stream, and return it directly */
+			__vortex_xml_rpc_stream_append_const (&stream, "<?xml version=\"1.0\"?><methodResponse><params><param>");
+			__vortex_xml_rpc_stream_marshall_value (&stream, response->value);
+			__vortex_xml_rpc_stream_append_const (&stream, "</param></params></methodResponse>");
+
+			if (size != NULL)
+				(* size ) = stream.length;
+			return stream.content;
 		default:
 			/* nothing to do, seems an error */
 			return NULL;
@@ -2226,6 +2241,448 @@ char                 * vortex_xml_rpc_method_response_marshall         (XmlRpcMe
 	return result;
 }
 
+/**
+ * @internal First byte of content encoded with the binary XML-RPC
+ * encoding (never found at the start of an XML document or MIME
+ * headers).
+ */
+#define XML_RPC_BINARY_MAGIC     0xB1
+
+/**
+ * @internal Max nesting accepted while decoding binary content.
+ */
+#define XML_RPC_BINARY_MAX_DEPTH 256
+
+/**
+ * @internal Appends the provided unsigned value into the stream
+ * using 7 bits per byte (high bit flags more bytes).
+ */
+void __vortex_xml_rpc_stream_append_varint (XmlRpcMarshallStream * stream, unsigned int value)
+{
+	char buffer[5];
+	int  length = 0;
+
+	while (value >= 0x80) {
+		buffer[length++] = (char) ((value & 0x7F) | 0x80);
+		value          >>= 7;
+	} /* end while */
+	buffer[length++] = (char) value;
+
+	__vortex_xml_rpc_stream_append (stream, buffer, length);
+	return;
+}
+
+/**
+ * @internal Appends the provided byte into the stream.
+ */
+void __vortex_xml_rpc_stream_append_byte (XmlRpcMarshallStream * stream, unsigned char value)
+{
+	__vortex_xml_rpc_stream_append (stream, (const char *) &value, 1);
+	return;
+}
+
+/**
+ * @internal Appends the provided string into the stream (length
+ * followed by its content).
+ */
+void __vortex_xml_rpc_stream_append_lstring (XmlRpcMarshallStream * stream, const char * value)
+{
+	int length = value ? strlen (value) : 0;
+
+	__vortex_xml_rpc_stream_append_varint (stream, length);
+	if (length > 0)
+		__vortex_xml_rpc_stream_append (stream, value, length);
+	return;
+}
+
+/**
+ * @internal Binary encodes the provided method value into the
+ * stream: one byte with the type followed by the value.
+ *
+ * - int: zigzag varint
+ * - boolean: one byte (0 or 1)
+ * - double: 8 bytes, IEEE 754 big endian
+ * - string, base64: varint length followed by the content
+ * - struct: varint member count followed by name/value pairs
+ * - array: varint item count followed by the values
+ */
+void __vortex_xml_rpc_binary_marshall_value (XmlRpcMarshallStream * stream, XmlRpcMethodValue * value)
+{
+	XmlRpcStruct         * _struct;
+	XmlRpcArray          * array;
+	int                    iterator;
+	unsigned char          buffer[8];
+	union {
+		double             d;
+		unsigned long long u;
+	} aux;
+
+	switch (method_value_get_type (value)) {
+	case XML_RPC_INT_VALUE:
+		__vortex_xml_rpc_stream_append_byte (stream, 'i');
+		__vortex_xml_rpc_stream_append_varint (stream, ((unsigned int) value->value.int_value << 1) ^ (unsigned int) (value->value.int_value >> 31));
+		break;
+	case XML_RPC_BOOLEAN_VALUE:
+		__vortex_xml_rpc_stream_append_byte (stream, 'b');
+		__vortex_xml_rpc_stream_append_byte (stream, value->value.int_value ? 1 : 0);
+		break;
+	case XML_RPC_DOUBLE_VALUE:
+		__vortex_xml_rpc_stream_append_byte (stream, 'd');
+		aux.d = value->value.double_value;
+		for (iterator = 7; iterator >= 0; iterator--) {
+			buffer[iterator] = (unsigned char) (aux.u & 0xFF);
+			aux.u          >>= 8;
+		} /* end for */
+		__vortex_xml_rpc_stream_append (stream, (const char *) buffer, 8);
+		break;
+	case XML_RPC_STRING_VALUE:
+	case XML_RPC_STRING_REF_VALUE:
+		__vortex_xml_rpc_stream_append_byte (stream, 's');
+		__vortex_xml_rpc_stream_append_lstring (stream, value->value.string_value);
+		break;
+	case XML_RPC_BASE64_VALUE:
+	case XML_RPC_BASE64_REF_VALUE:
+		/* content is already encoded */
+		__vortex_xml_rpc_stream_append_byte (stream, '6');
+		__vortex_xml_rpc_stream_append_lstring (stream, value->value.string_value);
+		break;
+	case XML_RPC_STRUCT_VALUE:
+		_struct = value->value.rpc_struct;
+		__vortex_xml_rpc_stream_append_byte (stream, 'S');
+		__vortex_xml_rpc_stream_append_varint (stream, _struct->added_count);
+		for (iterator = 0; iterator < _struct->added_count; iterator++) {
+			__vortex_xml_rpc_stream_append_lstring (stream, _struct->members[iterator]->name);
+			__vortex_xml_rpc_binary_marshall_value (stream, _struct->members[iterator]->value);
+		} /* end for */
+		break;
+	case XML_RPC_ARRAY_VALUE:
+		array = value->value.rpc_array;
+		__vortex_xml_rpc_stream_append_byte (stream, 'A');
+		__vortex_xml_rpc_stream_append_varint (stream, array->added_count);
+		for (iterator = 0; iterator < array->added_count; iterator++)
+			__vortex_xml_rpc_binary_marshall_value (stream, array->values[iterator]);
+		break;
+	case XML_RPC_DATE_VALUE:
+		/* not implemented yet (as in the XML encoding) */
+	case XML_RPC_NONE_VALUE:
+	default:
+		__vortex_xml_rpc_stream_append_byte (stream, 'n');
+		break;
+	}
+	return;
+}
+
+/**
+ * @internal Marshalls the provided method call using the binary
+ * encoding negotiated on channels booted with
+ * encoding='binary'. See \ref vortex_xml_rpc_method_call_marshall.
+ */
+char              * __vortex_xml_rpc_method_call_marshall_binary (XmlRpcMethodCall  * method_call,
+								  int               * size)
+{
+	XmlRpcMarshallStream stream = {NULL, 0, 0};
+	int                  iterator;
+
+	v_return_val_if_fail (method_call, NULL);
+	v_return_val_if_fail (method_call->count == method_call->added_count, NULL);
+
+	/* header, method name and parameters */
+	__vortex_xml_rpc_stream_append_byte    (&stream, XML_RPC_BINARY_MAGIC);
+	__vortex_xml_rpc_stream_append_byte    (&stream, 'C');
+	__vortex_xml_rpc_stream_append_lstring (&stream, method_call->methodName);
+	__vortex_xml_rpc_stream_append_varint  (&stream, method_call->count);
+	for (iterator = 0; iterator < method_call->count; iterator++)
+		__vortex_xml_rpc_binary_marshall_value (&stream, method_call_get_param_value (method_call, iterator));
+
+	if (size != NULL)
+		(* size) = stream.length;
+	return stream.content;
+}
+
+/**
+ * @internal Marshalls the provided method response using the binary
+ * encoding. Faults are encoded as a struct with faultCode and
+ * faultString members, as done by the XML encoding. See \ref
+ * vortex_xml_rpc_method_response_marshall.
+ */
+char              * __vortex_xml_rpc_method_response_marshall_binary (XmlRpcMethodResponse * response,
+								      int                  * size)
+{
+	XmlRpcMarshallStream stream = {NULL, 0, 0};
+
+	v_return_val_if_fail (response, NULL);
+	v_return_val_if_fail (response->status != XML_RPC_OK || response->value, NULL);
+
+	__vortex_xml_rpc_stream_append_byte (&stream, XML_RPC_BINARY_MAGIC);
+	if (response->status == XML_RPC_OK) {
+		__vortex_xml_rpc_stream_append_byte (&stream, 'R');
+		__vortex_xml_rpc_binary_marshall_value (&stream, response->value);
+	} else {
+		__vortex_xml_rpc_stream_append_byte    (&stream, 'F');
+		__vortex_xml_rpc_stream_append_byte    (&stream, 'S');
+		__vortex_xml_rpc_stream_append_varint  (&stream, 2);
+		__vortex_xml_rpc_stream_append_lstring (&stream, "faultCode");
+		__vortex_xml_rpc_stream_append_byte    (&stream, 'i');
+		__vortex_xml_rpc_stream_append_varint  (&stream, ((unsigned int) response->fault_code << 1) ^ (unsigned int) (response->fault_code >> 31));
+		__vortex_xml_rpc_stream_append_lstring (&stream, "faultString");
+		__vortex_xml_rpc_stream_append_byte    (&stream, 's');
+		__vortex_xml_rpc_stream_append_lstring (&stream, response->fault_string);
+	} /* end if */
+
+	if (size != NULL)
+		(* size) = stream.length;
+	return stream.content;
+}
+
+/**
+ * @internal Binary content being decoded.
+ */
+typedef struct _XmlRpcBinaryReader {
+	VortexCtx            * ctx;
+	const unsigned char  * content;
+	int                    size;
+	int                    pos;
+	int                    depth;
+} XmlRpcBinaryReader;
+
+/**
+ * @internal Reads a varint from the content.
+ */
+axl_bool __vortex_xml_rpc_binary_read_varint (XmlRpcBinaryReader * reader, unsigned int * value)
+{
+	int shift = 0;
+
+	(* value) = 0;
+	while (reader->pos < reader->size && shift < 35) {
+		(* value) |= (unsigned int) (reader->content[reader->pos] & 0x7F) << shift;
+		if ((reader->content[reader->pos++] & 0x80) == 0)
+			return axl_true;
+		shift += 7;
+	} /* end while */
+
+	/* truncated or wrong varint */
+	return axl_false;
+}
+
+/**
+ * @internal Reads a string from the content, returning a newly
+ * allocated copy or NULL if it fails.
+ */
+char * __vortex_xml_rpc_binary_read_string (XmlRpcBinaryReader * reader)
+{
+	unsigned int   length;
+	char         * result;
+
+	if (! __vortex_xml_rpc_binary_read_varint (reader, &length))
+		return NULL;
+	if (length > (unsigned int) (reader->size - reader->pos))
+		return NULL;
+
+	result = axl_new (char, length + 1);
+	memcpy (result, reader->content + reader->pos, length);
+	reader->pos += length;
+	return result;
+}
+
+/**
+ * @internal Reads a value from the content.
+ *
+ * @param ok Set to axl_false if content is not properly encoded.
+ */
+XmlRpcMethodValue * __vortex_xml_rpc_binary_read_value (XmlRpcBinaryReader * reader, axl_bool * ok)
+{
+	XmlRpcMethodValue  * value = NULL;
+	XmlRpcMethodValue  * item;
+	XmlRpcStruct       * _struct;
+	XmlRpcArray        * array;
+	char               * string;
+	unsigned int         count;
+	unsigned int         iterator;
+	unsigned int         number;
+	unsigned char        type;
+	union {
+		double             d;
+		unsigned long long u;
+	} aux;
+
+	if (reader->pos >= reader->size || reader->depth >= XML_RPC_BINARY_MAX_DEPTH) {
+		(* ok) = axl_false;
+		return NULL;
+	} /* end if */
+
+	type = reader->content[reader->pos++];
+	switch (type) {
+	case 'i':
+		if (! __vortex_xml_rpc_binary_read_varint (reader, &number))
+			break;
+		return method_value_new (reader->ctx, XML_RPC_INT_VALUE, INT_TO_PTR ((int) ((number >> 1) ^ (0 - (number & 1)))));
+	case 'b':
+		if (reader->pos >= reader->size)
+			break;
+		return method_value_new (reader->ctx, XML_RPC_BOOLEAN_VALUE, INT_TO_PTR (reader->content[reader->pos++] ? 1 : 0));
+	case 'd':
+		if (reader->size - reader->pos < 8)
+			break;
+		aux.u = 0;
+		for (iterator = 0; iterator < 8; iterator++)
+			aux.u = (aux.u << 8) | reader->content[reader->pos++];
+		return method_value_new (reader->ctx, XML_RPC_DOUBLE_VALUE, &aux.d);
+	case 's':
+	case '6':
+		string = __vortex_xml_rpc_binary_read_string (reader);
+		if (string == NULL)
+			break;
+		/* the value owns the string decoded */
+		return method_value_new (reader->ctx, type == 's' ? XML_RPC_STRING_REF_VALUE : XML_RPC_BASE64_REF_VALUE, string);
+	case 'n':
+		return method_value_new (reader->ctx, XML_RPC_NONE_VALUE, NULL);
+	case 'S':
+		/* each member takes at least 2 bytes */
+		if (! __vortex_xml_rpc_binary_read_varint (reader, &count) || count > (unsigned int) (reader->size - reader->pos) / 2)
+			break;
+
+		/* empty structs are created too (closed with no
+		 * members) */
+		reader->depth++;
+		_struct = vortex_xml_rpc_struct_new (count > 0 ? count : 1);
+		value   = method_value_new (reader->ctx, XML_RPC_STRUCT_VALUE, _struct);
+		for (iterator = 0; iterator < count; iterator++) {
+			string = __vortex_xml_rpc_binary_read_string (reader);
+			if (string == NULL) {
+				(* ok) = axl_false;
+				break;
+			} /* end if */
+			item = __vortex_xml_rpc_binary_read_value (reader, ok);
+			if (! (* ok)) {
+				axl_free (string);
+				break;
+			} /* end if */
+			if (item != NULL)
+				vortex_xml_rpc_struct_add_member (_struct, vortex_xml_rpc_struct_member_new (string, item));
+			axl_free (string);
+		} /* end for */
+		__vortex_xml_rpc_struct_close (_struct);
+		reader->depth--;
+
+		if (! (* ok)) {
+			method_value_free (value);
+			return NULL;
+		} /* end if */
+		return value;
+	case 'A':
+		/* each item takes at least 1 byte */
+		if (! __vortex_xml_rpc_binary_read_varint (reader, &count) || count > (unsigned int) (reader->size - reader->pos))
+			break;
+
+		reader->depth++;
+		array = vortex_xml_rpc_array_new (count);
+		value = method_value_new (reader->ctx, XML_RPC_ARRAY_VALUE, array);
+		for (iterator = 0; iterator < count; iterator++) {
+			item = __vortex_xml_rpc_binary_read_value (reader, ok);
+			if (! (* ok))
+				break;
+			vortex_xml_rpc_array_add (array, item);
+		} /* end for */
+		__vortex_xml_rpc_array_close (array);
+		reader->depth--;
+
+		if (! (* ok)) {
+			method_value_free (value);
+			return NULL;
+		} /* end if */
+		return value;
+	default:
+		break;
+	}
+
+	/* wrong or truncated value */
+	(* ok) = axl_false;
+	return NULL;
+}
+
+/**
+ * @internal Returns axl_true if the provided content is encoded with
+ * the binary XML-RPC encoding.
+ */
+axl_bool            __vortex_xml_rpc_is_binary (const char * content, int size)
+{
+	return size > 1 && (unsigned char) content[0] == XML_RPC_BINARY_MAGIC;
+}
+
+/**
+ * @internal Decodes a method call encoded with \ref
+ * __vortex_xml_rpc_method_call_marshall_binary.
+ *
+ * @return A newly allocated method call or NULL if it fails.
+ */
+XmlRpcMethodCall  * __vortex_xml_rpc_method_call_unmarshall_binary (VortexCtx  * ctx,
+								    const char * content,
+								    int          size)
+{
+	XmlRpcBinaryReader   reader = {ctx, (const unsigned char *) content, size, 2, 0};
+	XmlRpcMethodCall   * method_call;
+	XmlRpcMethodValue  * value;
+	char               * method_name;
+	unsigned int         count;
+	unsigned int         iterator;
+	axl_bool             ok     = axl_true;
+
+	if (! __vortex_xml_rpc_is_binary (content, size) || content[1] != 'C')
+		return NULL;
+
+	/* method name and parameter count (each parameter takes at
+	 * least 1 byte) */
+	method_name = __vortex_xml_rpc_binary_read_string (&reader);
+	if (method_name == NULL)
+		return NULL;
+	if (! __vortex_xml_rpc_binary_read_varint (&reader, &count) || count > (unsigned int) (size - reader.pos)) {
+		axl_free (method_name);
+		return NULL;
+	} /* end if */
+
+	method_call = method_call_new (ctx, method_name, count);
+	axl_free (method_name);
+	for (iterator = 0; iterator < count; iterator++) {
+		value = __vortex_xml_rpc_binary_read_value (&reader, &ok);
+		if (! ok) {
+			method_call_free (method_call);
+			return NULL;
+		} /* end if */
+		method_call_add_value (method_call, value);
+	} /* end for */
+
+	return method_call;
+}
+
+/**
+ * @internal Decodes a method response encoded with \ref
+ * __vortex_xml_rpc_method_response_marshall_binary.
+ *
+ * @param fault Set to axl_true if a fault reply was decoded (the
+ * value returned is the fault struct).
+ *
+ * @return The value decoded or NULL if it fails.
+ */
+XmlRpcMethodValue * __vortex_xml_rpc_method_response_unmarshall_binary (VortexCtx  * ctx,
+									const char * content,
+									int          size,
+									axl_bool   * fault)
+{
+	XmlRpcBinaryReader   reader = {ctx, (const unsigned char *) content, size, 2, 0};
+	axl_bool             ok     = axl_true;
+	XmlRpcMethodValue  * value;
+
+	if (! __vortex_xml_rpc_is_binary (content, size) || (content[1] != 'R' && content[1] != 'F'))
+		return NULL;
+
+	value = __vortex_xml_rpc_binary_read_value (&reader, &ok);
+	if (! ok)
+		return NULL;
+
+	(* fault) = (content[1] == 'F');
+	return value;
+}
+
 /** 
  * @brief Returns current status for the invocation performed which
  * has return the given \ref XmlRpcMethodResponse.
@@ -3184,4 +3641,65 @@ void                   vortex_xml_rpc_array_add                        (XmlRpcAr
 	return;
 }
 
+/** 
+ * @internal Adds the provided member into the struct, growing its
+ * capacity if required (see \ref vortex_xml_rpc_struct_add_member).
+ */
+void                __vortex_xml_rpc_struct_append (XmlRpcStruct       * _struct,
+						    XmlRpcStructMember * member)
+{
+	v_return_if_fail (_struct);
+	v_return_if_fail (member);
+
+	/* grow the members array */
+	if (_struct->added_count == _struct->count) {
+		_struct->count   = _struct->count > 0 ? _struct->count * 2 : 4;
+		_struct->members = axl_realloc (_struct->members, sizeof (XmlRpcStructMember *) * _struct->count);
+	} /* end if */
+
+	_struct->members [_struct->added_count] = member;
+	_struct->added_count++;
+	return;
+}
+
+/** 
+ * @internal Adds the provided value into the array, growing its
+ * capacity if required (see \ref vortex_xml_rpc_array_add).
+ */
+void                __vortex_xml_rpc_array_append  (XmlRpcArray        * array,
+						    XmlRpcMethodValue  * value)
+{
+	v_return_if_fail (array);
+
+	/* grow the values array */
+	if (array->added_count == array->count) {
+		array->count  = array->count > 0 ? array->count * 2 : 4;
+		array->values = axl_realloc (array->values, sizeof (XmlRpcMethodValue *) * array->count);
+	} /* end if */
+
+	array->values [array->added_count] = value;
+	array->added_count++;
+	return;
+}
+
+/** 
+ * @internal Adjusts struct capacity to the members added.
+ */
+void                __vortex_xml_rpc_struct_close  (XmlRpcStruct       * _struct)
+{
+	v_return_if_fail (_struct);
+	_struct->count = _struct->added_count;
+	return;
+}
+
+/** 
+ * @internal Adjusts array capacity to the values added.
+ */
+void                __vortex_xml_rpc_array_close   (XmlRpcArray        * array)
+{
+	v_return_if_fail (array);
+	array->count = array->added_count;
+	return;
+}
+
 /* @} */
@@ -636,6 +636,48 @@ void                __vortex_xml_rpc_method_call_get_reply_data (XmlRpcMethodCal
 								 VortexChannel    ** channel,
 								 int              * msg_no);
 
+/** 
+ * @internal
+ *
+ * @brief Functions used by the XML-RPC decoder to add items into
+ * structs and arrays whose size is not known in advance. Capacity is
+ * grown as required and adjusted to the items added once the
+ * container is closed.
+ */
+void                __vortex_xml_rpc_struct_append (XmlRpcStruct       * _struct,
+						    XmlRpcStructMember * member);
+
+void                __vortex_xml_rpc_array_append  (XmlRpcArray        * array,
+						    XmlRpcMethodValue  * value);
+
+void                __vortex_xml_rpc_struct_close  (XmlRpcStruct       * _struct);
+
+void                __vortex_xml_rpc_array_close   (XmlRpcArray        * array);
+
+/** 
+ * @internal
+ *
+ * @brief Binary encoding used on XML-RPC channels where both peers
+ * agreed to use it at boot time (encoding='binary').
+ */
+char              * __vortex_xml_rpc_method_call_marshall_binary      (XmlRpcMethodCall     * method_call,
+								       int                  * size);
+
+char              * __vortex_xml_rpc_method_response_marshall_binary  (XmlRpcMethodResponse * response,
+								       int                  * size);
+
+axl_bool            __vortex_xml_rpc_is_binary                        (const char           * content,
+								       int                    size);
+
+XmlRpcMethodCall  * __vortex_xml_rpc_method_call_unmarshall_binary    (VortexCtx            * ctx,
+								       const char           * content,
+								       int                    size);
+
+XmlRpcMethodValue * __vortex_xml_rpc_method_response_unmarshall_binary (VortexCtx           * ctx,
+									const char          * content,
+									int                   size,
+									axl_bool            * fault);
+
 /** 
  * @brief Alias definition for \ref vortex_xml_rpc_method_value_free.
  */
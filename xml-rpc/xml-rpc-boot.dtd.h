@@ -10,8 +10,11 @@
   -->                                                                \
 <!ELEMENT bootmsg     EMPTY>                                         \
 <!ATTLIST bootmsg                                                    \
-          resource    CDATA       #REQUIRED>                         \
+          resource    CDATA       #REQUIRED                          \
+          encoding    CDATA       #IMPLIED>                          \
 <!ELEMENT bootrpy     EMPTY>                                         \
+<!ATTLIST bootrpy                                                    \
+          encoding    CDATA       #IMPLIED>                          \
                                                                      \
 \n"
 #endif